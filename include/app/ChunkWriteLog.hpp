@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+namespace app {
+
+// Chunk files written and removed since the world's catalog was last
+// updated. SaveManager keeps one per world folder and records into it,
+// possibly from worker threads; WorldCatalog folds the totals in on flush.
+class ChunkWriteLog {
+  public:
+    struct Totals {
+        std::int64_t chunks = 0;
+        std::int64_t bytes = 0;
+    };
+
+    void recordWrite(bool existed, std::uint64_t oldBytes, std::uint64_t newBytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        totals_.chunks += existed ? 0 : 1;
+        totals_.bytes += static_cast<std::int64_t>(newBytes) - static_cast<std::int64_t>(oldBytes);
+    }
+
+    void recordRemoval(std::uint64_t oldBytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        totals_.chunks -= 1;
+        totals_.bytes -= static_cast<std::int64_t>(oldBytes);
+    }
+
+    // Returns everything recorded so far and starts over.
+    Totals take() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Totals totals = totals_;
+        totals_ = Totals{};
+        return totals;
+    }
+
+  private:
+    std::mutex mutex_;
+    Totals totals_;
+};
+
+} // namespace app
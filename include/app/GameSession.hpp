@@ -5,6 +5,10 @@
 struct GLFWwindow;
 struct GLFWcursor;
 
+namespace core {
+class AssetLoader;
+} // namespace core
+
 namespace gfx {
 class Shader;
 class TextureAtlas;
@@ -12,6 +16,7 @@ class HudRenderer;
 } // namespace gfx
 
 namespace game {
+class AudioSystem;
 class MapSystem;
 class Camera;
 class DebugMenu;
@@ -28,6 +33,7 @@ struct WorldDebugStats;
 
 namespace app::menus {
 class PauseMenu;
+class LoadingScreen;
 class CraftingMenu;
 class FurnaceMenu;
 class RecipeMenu;
@@ -42,10 +48,12 @@ class GameSession {
   public:
     GameSession(GLFWwindow *window, GLFWcursor *arrowCursor,
                 const menus::WorldSelection &worldSelection, gfx::Shader &shader,
-                gfx::TextureAtlas &atlas, gfx::HudRenderer &hud, menus::PauseMenu &pauseMenu,
+                gfx::TextureAtlas &atlas, gfx::HudRenderer &hud, game::AudioSystem &audio,
+                core::AssetLoader &assetLoader, menus::PauseMenu &pauseMenu,
                 menus::CraftingMenu &craftingMenu, menus::FurnaceMenu &furnaceMenu,
                 menus::RecipeMenu &recipeMenu, menus::CreativeMenu &creativeMenu,
-                menus::WorldMapMenu &worldMapMenu, menus::MiniMapMenu &miniMapMenu);
+                menus::WorldMapMenu &worldMapMenu, menus::MiniMapMenu &miniMapMenu,
+                menus::LoadingScreen &loadingScreen);
 
     bool run();
 
@@ -56,6 +64,8 @@ class GameSession {
     gfx::Shader &shader_;
     gfx::TextureAtlas &atlas_;
     gfx::HudRenderer &hud_;
+    game::AudioSystem &audio_;
+    core::AssetLoader &assetLoader_;
     menus::PauseMenu &pauseMenu_;
     menus::CraftingMenu &craftingMenu_;
     menus::FurnaceMenu &furnaceMenu_;
@@ -63,6 +73,7 @@ class GameSession {
     menus::CreativeMenu &creativeMenu_;
     menus::WorldMapMenu &worldMapMenu_;
     menus::MiniMapMenu &miniMapMenu_;
+    menus::LoadingScreen &loadingScreen_;
 };
 
 } // namespace app
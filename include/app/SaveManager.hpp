@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <vector>
 
+#include "app/ChunkWriteLog.hpp"
 #include "game/SmeltingSystem.hpp"
 
 #include <glm/vec3.hpp>
@@ -19,9 +20,11 @@ class Chunk;
 
 namespace world {
 struct ChunkCoord;
+struct ChunkEdits;
 struct FurnaceRecordLocal;
 struct FurnaceState;
 class World;
+class WorldGen;
 } // namespace world
 
 namespace app {
@@ -48,13 +51,28 @@ class SaveManager {
                                  const std::optional<glm::ivec3> &activeFurnaceCell,
                                  game::SmeltingSystem::State &smelting);
 
+    // With edits, writes only the listed cells as a delta over generated
+    // terrain and deletes the file when there are none and no furnaces;
+    // without, writes every block. File growth is recorded for
+    // takeChunkWrites.
     static bool saveChunk(const std::filesystem::path &worldDir, std::uint32_t generatorVersion,
                           const voxel::Chunk &chunk, world::ChunkCoord cc,
-                          const std::vector<world::FurnaceRecordLocal> *furnaces = nullptr);
+                          const std::vector<world::FurnaceRecordLocal> *furnaces = nullptr,
+                          const world::ChunkEdits *edits = nullptr);
 
+    // Reads either format; delta chunks need baseGen to rebuild their base.
+    // editsOut receives the cells a delta file changed; a full chunk leaves it
+    // not over generated terrain unless migrateFull diffs it once against
+    // baseGen and rewrites the file as a delta.
     static bool loadChunk(const std::filesystem::path &worldDir, std::uint32_t generatorVersion,
                           voxel::Chunk &chunk, world::ChunkCoord cc,
-                          std::vector<world::FurnaceRecordLocal> *furnacesOut = nullptr);
+                          std::vector<world::FurnaceRecordLocal> *furnacesOut = nullptr,
+                          const world::WorldGen *baseGen = nullptr,
+                          world::ChunkEdits *editsOut = nullptr, bool migrateFull = false);
+
+    // Chunk files written and removed in worldDir since the last call, from
+    // any thread. WorldCatalog folds them into the world's catalog.
+    static ChunkWriteLog::Totals takeChunkWrites(const std::filesystem::path &worldDir);
 };
 
 } // namespace app
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "game/MapTilePyramid.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace game {
+class MapSystem;
+}
+
+namespace app {
+
+// Summary of one saved world. Each world keeps its own in catalog.dat and the
+// worlds root mirrors all of them in index.dat, so listing worlds never has to
+// walk chunk files.
+struct WorldCatalogEntry {
+    std::filesystem::path path;
+    std::string name;
+    std::uint32_t seed = 1337u;
+    // Seconds since the Unix epoch; 0 when unknown.
+    std::int64_t lastPlayed = 0;
+    std::uint32_t chunkCount = 0;
+    std::uint64_t sizeBytes = 0;
+    // kThumbnailSize^2 RGBA8 texels of the explored map, or empty.
+    std::vector<std::uint8_t> thumbnail;
+    // Write time of the catalog.dat this entry was read from (index only).
+    std::int64_t catalogStamp = 0;
+};
+
+class WorldCatalog {
+  public:
+    static constexpr int kThumbnailSize = 32;
+    // World columns per thumbnail texel.
+    static constexpr int kThumbnailStride = 8;
+
+    // Applies the chunk writes SaveManager recorded for the world to its
+    // existing catalog, so growth never needs a folder rescan.
+    static void flushChunkWrites(const std::filesystem::path &worldDir);
+    // Flushes chunk writes and stamps name, seed, last-played time and a map
+    // thumbnail centred on the given column. Scans the folder once when the
+    // world has no catalog yet.
+    static bool update(const std::filesystem::path &worldDir, const std::string &name,
+                       std::uint32_t seed, const game::MapSystem &map, int centerWX,
+                       int centerWZ, const game::MapTilePyramid::ColorFn &colorOf);
+
+    static bool loadCatalog(const std::filesystem::path &worldDir, WorldCatalogEntry &out);
+    static bool saveCatalog(const std::filesystem::path &worldDir, const WorldCatalogEntry &entry);
+    // Slow path: walks every file in the world folder.
+    static WorldCatalogEntry scanWorld(const std::filesystem::path &worldDir,
+                                       const std::string &name, std::uint32_t seed);
+    static bool readWorldMeta(const std::filesystem::path &worldDir, std::string &outName,
+                              std::uint32_t &outSeed);
+
+    static std::vector<WorldCatalogEntry> readIndex(const std::filesystem::path &root);
+    static bool writeIndex(const std::filesystem::path &root,
+                           const std::vector<WorldCatalogEntry> &entries);
+    // Reconciles the index with the world folders under root plus the legacy
+    // folder: unchanged catalogs reuse their index row, newer ones are re-read
+    // and worlds without one are scanned and given one. Meant for a
+    // background thread; once cancel is set it stops between worlds, leaves
+    // the index as it was and returns nothing.
+    static std::vector<WorldCatalogEntry> refresh(const std::filesystem::path &root,
+                                                  const std::filesystem::path &legacyDir,
+                                                  const std::atomic<bool> *cancel = nullptr);
+};
+
+} // namespace app
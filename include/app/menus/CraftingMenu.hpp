@@ -6,7 +6,6 @@
 #include "game/Inventory.hpp"
 
 #include <array>
-#include <functional>
 #include <vector>
 
 namespace game {
@@ -34,12 +33,10 @@ class CraftingMenu : public BaseMenu {
     int inventorySlotAtCursor(double mx, double my, int width, int height, bool showInventory,
                               float hudScale, int craftingGridSize, bool usingFurnace) const;
     void renderPanel(
-        int width, int height, float uiScale, bool usingCraftingTable, int hoveredSlotIndex,
-        int craftingGridSize,
+        int width, int height, float uiScale, bool usingCraftingTable, int craftingGridSize,
         const std::array<game::Inventory::Slot, game::CraftingSystem::kInputCount> &craftInput,
         const game::Inventory::Slot &craftOutput, const voxel::BlockRegistry &registry,
-        const HudDrawContext &draw, std::vector<SlotLabel> &slotLabels,
-        const std::function<void(voxel::BlockId, int)> &setHoverTip) const;
+        const HudDrawContext &draw, std::vector<SlotLabel> &slotLabels) const;
     bool isLookingAtCraftingTable(world::World &world, const game::Camera &camera,
                                   float raycastDistance) const;
 };
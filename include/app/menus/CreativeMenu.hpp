@@ -4,6 +4,7 @@
 #include "app/menus/HudDrawContext.hpp"
 
 #include "game/CraftingSystem.hpp"
+#include "game/SearchIndex.hpp"
 
 #include "voxel/Block.hpp"
 
@@ -45,18 +46,31 @@ class CreativeMenu : public BaseMenu {
     }
 
     const std::vector<voxel::BlockId> &catalog() const;
-    bool itemMatchesSearch(voxel::BlockId id, const std::string &search) const;
+    // Catalog items whose name contains the search text, cached until the
+    // text changes.
+    const std::vector<voxel::BlockId> &matchingItems(const std::string &search);
 
     CreativeMenuLayout computeLayout(int width, int height, float hudScale, int craftingGridSize,
                                      bool usingFurnace, std::size_t itemCount) const;
     int itemAtCursor(double mx, double my, const CreativeMenuLayout &layout, float scroll,
                      std::size_t itemCount) const;
     void renderOverlay(int width, int height, float uiScale, int craftingGridSize,
-                       bool usingFurnace, float cursorX, float cursorY, float creativeScroll,
-                       float uiTimeSeconds, const std::string &creativeSearch,
+                       bool usingFurnace, float creativeScroll,
+                       const std::string &creativeSearch,
                        const std::vector<voxel::BlockId> &creativeItems,
-                       const voxel::BlockRegistry &registry,
-                       const HudDrawContext &draw, TooltipState &tooltip) const;
+                       const voxel::BlockRegistry &registry, const HudDrawContext &draw) const;
+    // The parts that follow the cursor and clock: the search caret and the
+    // hovered item's tooltip.
+    void renderHover(int width, int height, float uiScale, int craftingGridSize, bool usingFurnace,
+                     float cursorX, float cursorY, float creativeScroll, float uiTimeSeconds,
+                     const std::string &creativeSearch,
+                     const std::vector<voxel::BlockId> &creativeItems, const HudDrawContext &draw,
+                     TooltipState &tooltip) const;
+
+  private:
+    game::SearchIndex searchIndex_{};
+    std::string matchingQuery_{};
+    std::vector<voxel::BlockId> matchingItems_{};
 };
 
 } // namespace app::menus
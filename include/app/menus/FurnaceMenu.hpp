@@ -7,7 +7,6 @@
 #include "game/Inventory.hpp"
 
 #include <array>
-#include <functional>
 
 #include <optional>
 #include <vector>
@@ -32,13 +31,12 @@ class FurnaceMenu : public BaseMenu {
 
     std::optional<glm::ivec3> lookedAtCell(world::World &world, const game::Camera &camera,
                                            float raycastDistance) const;
-    void renderPanel(
-        int width, int height, float uiScale, int hoveredSlotIndex, int craftingGridSize,
-        const game::Inventory::Slot &smeltInput, const game::Inventory::Slot &smeltFuel,
-        const game::Inventory::Slot &smeltOutput, float smeltProgress01, float smeltFuel01,
-        const voxel::BlockRegistry &registry, const HudDrawContext &draw,
-        std::vector<SlotLabel> &slotLabels,
-        const std::function<void(voxel::BlockId, int)> &setHoverTip) const;
+    void renderPanel(int width, int height, float uiScale, int craftingGridSize,
+                     const game::Inventory::Slot &smeltInput,
+                     const game::Inventory::Slot &smeltFuel,
+                     const game::Inventory::Slot &smeltOutput, float smeltProgress01,
+                     float smeltFuel01, const voxel::BlockRegistry &registry,
+                     const HudDrawContext &draw, std::vector<SlotLabel> &slotLabels) const;
     bool isLookingAtFurnace(world::World &world, const game::Camera &camera,
                             float raycastDistance) const;
 };
@@ -7,6 +7,11 @@
 
 namespace app::menus {
 
+// Rates at which the recipe/creative menus animate (caret blink, wood-type
+// cycling). HudRenderer only rebuilds the hover overlay when one of these ticks.
+inline constexpr float kMenuBlinkStepsPerSecond = 2.0f;
+inline constexpr float kMenuCycleStepsPerSecond = 0.6f;
+
 struct SlotLabel {
     float x = 0.0f;
     float y = 0.0f;
@@ -57,6 +62,10 @@ struct HudDrawContext {
     std::function<void(std::size_t)> endIconClipBatch;
     std::function<float(const std::string &)> textWidthPx;
     std::function<bool(voxel::BlockId)> isFlatItemId;
+    // Records a hoverable slot (index, x, y, size, contents). Its hover outline
+    // and tooltip are drawn on the overlay, so the slot's panel need not
+    // rebuild as the cursor moves.
+    std::function<void(int, float, float, float, voxel::BlockId, int)> markSlot;
 };
 
 } // namespace app::menus
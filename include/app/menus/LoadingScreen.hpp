@@ -0,0 +1,24 @@
+#pragma once
+
+#include "app/menus/BaseMenu.hpp"
+#include "app/menus/UiMenuRenderer.hpp"
+
+#include <string>
+
+namespace app::menus {
+
+// Full-window progress panel drawn while a world loads, before the first
+// game frame.
+class LoadingScreen : public BaseMenu {
+  public:
+    const char *menuId() const override {
+        return "loading";
+    }
+
+    void render(int width, int height, const std::string &title, int done, int total) const;
+
+  private:
+    mutable UiMenuRenderer ui_;
+};
+
+} // namespace app::menus
@@ -4,6 +4,7 @@
 #include "app/menus/UiMenuRenderer.hpp"
 
 #include "game/MapSystem.hpp"
+#include "game/MiniMapRaster.hpp"
 
 namespace gfx {
 class HudRenderer;
@@ -45,6 +46,12 @@ struct MiniMapLayout {
 
 class MiniMapMenu : public BaseMenu {
   public:
+    MiniMapMenu() = default;
+    ~MiniMapMenu() override;
+
+    MiniMapMenu(const MiniMapMenu &) = delete;
+    MiniMapMenu &operator=(const MiniMapMenu &) = delete;
+
     const char *menuId() const override {
         return "mini_map";
     }
@@ -57,7 +64,12 @@ class MiniMapMenu : public BaseMenu {
                 const gfx::TextureAtlas &atlas) const;
 
   private:
+    // Uploads the raster's dirty rectangles, creating the texture on first use.
+    unsigned int rasterTexture() const;
+
     mutable UiMenuRenderer ui_;
+    mutable game::MiniMapRaster raster_;
+    mutable unsigned int rasterTexture_ = 0;
 };
 
 } // namespace app::menus
@@ -4,6 +4,7 @@
 #include "app/menus/HudDrawContext.hpp"
 
 #include "game/CraftingSystem.hpp"
+#include "game/SearchIndex.hpp"
 #include "game/SmeltingSystem.hpp"
 #include "voxel/Block.hpp"
 
@@ -66,15 +67,20 @@ class RecipeMenu : public BaseMenu {
     int rowAtCursor(double mx, double my, const RecipeMenuLayout &layout, float scroll,
                     std::size_t recipeCount) const;
 
-    bool matchesSearch(const game::CraftingSystem::RecipeInfo &recipe,
-                       const std::string &search) const;
+    // Indices of recipes whose label, output or ingredient names contain the
+    // search text; the list is indexed the first time it is searched.
+    const std::vector<int> &
+    matchingRecipes(const std::vector<game::CraftingSystem::RecipeInfo> &recipes,
+                    const std::string &search);
+    const std::vector<int> &
+    matchingSmeltingRecipes(const std::vector<game::SmeltingSystem::Recipe> &recipes,
+                            const std::string &search);
     bool usesIngredient(const game::CraftingSystem::RecipeInfo &recipe,
                         voxel::BlockId targetId) const;
-    bool smeltingMatchesSearch(const game::SmeltingSystem::Recipe &recipe,
-                               const std::string &search) const;
+    // Ingredients that accept any wood or planks are left empty here;
+    // renderHover draws them with the type the clock cycles to.
     void renderOverlay(int width, int height, float uiScale, int craftingGridSize,
-                       bool usingFurnace, float cursorX, float cursorY, float recipeScroll,
-                       float uiTimeSeconds, const std::string &recipeSearch,
+                       bool usingFurnace, float recipeScroll, const std::string &recipeSearch,
                        bool recipeCraftableOnly,
                        const std::optional<voxel::BlockId> &recipeIngredientFilter,
                        const std::vector<game::CraftingSystem::RecipeInfo> &recipes,
@@ -82,8 +88,20 @@ class RecipeMenu : public BaseMenu {
                        const std::vector<bool> &recipeCraftable,
                        const voxel::BlockRegistry &registry,
                        const HudDrawContext &draw,
-                       std::vector<RecipeNameLabel> &recipeNameLabels,
-                       TooltipState &tooltip) const;
+                       std::vector<RecipeNameLabel> &recipeNameLabels) const;
+    // The parts that follow the cursor and clock: the search caret, cycling
+    // wood/plank icons, the hovered card's highlight and ingredient tooltip.
+    void renderHover(int width, int height, float uiScale, int craftingGridSize,
+                     bool usingFurnace, float cursorX, float cursorY, float recipeScroll,
+                     float uiTimeSeconds, const std::string &recipeSearch,
+                     const std::vector<game::CraftingSystem::RecipeInfo> &recipes,
+                     const std::vector<game::SmeltingSystem::Recipe> &smeltingRecipes,
+                     const voxel::BlockRegistry &registry, const HudDrawContext &draw,
+                     TooltipState &tooltip) const;
+
+  private:
+    game::SearchIndex recipeIndex_{};
+    game::SearchIndex smeltingIndex_{};
 };
 
 } // namespace app::menus
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -11,21 +12,40 @@ class UiMenuRenderer {
     void drawRect(float x, float y, float w, float h, float r, float g, float b, float a);
     void drawText(float x, float y, const std::string &text, unsigned char r, unsigned char g,
                   unsigned char b, unsigned char a);
+    // Textured quad sampling [u0,u1]x[v0,v1] of a GL texture, tinted by alpha.
+    // Draw order with rects and text is preserved.
+    void drawImage(unsigned int texture, float x, float y, float w, float h, float u0, float v0,
+                   float u1, float v1, float a);
+    // Same, with a UV pair per corner (top-left, top-right, bottom-right,
+    // bottom-left) for rotated or wrapped sampling. UVs must not be negative.
+    void drawImageCorners(unsigned int texture, float x, float y, float w, float h,
+                          const float (&uv)[8], float a);
     void end();
 
     static float textWidthPx(const std::string &text);
 
   private:
+    // Solid vertices carry u = -1 and skip the texture fetch.
     struct UiVertex {
         float x;
         float y;
+        float u;
+        float v;
         float r;
         float g;
         float b;
         float a;
     };
 
+    struct Batch {
+        unsigned int texture = 0;
+        std::size_t first = 0;
+        std::size_t count = 0;
+    };
+
     void init();
+    void pushQuad(const UiVertex &v0, const UiVertex &v1, const UiVertex &v2, const UiVertex &v3,
+                  unsigned int texture);
 
     bool ready_ = false;
     unsigned int shader_ = 0;
@@ -33,7 +53,10 @@ class UiMenuRenderer {
     unsigned int vbo_ = 0;
     int width_ = 1;
     int height_ = 1;
+    int uScreen_ = -1;
+    int uImage_ = -1;
     std::vector<UiVertex> verts_;
+    std::vector<Batch> batches_;
 };
 
 } // namespace app::menus
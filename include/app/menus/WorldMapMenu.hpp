@@ -4,9 +4,11 @@
 #include "app/menus/UiMenuRenderer.hpp"
 
 #include "game/MapSystem.hpp"
+#include "game/MapTilePyramid.hpp"
 
 #include <cstdint>
 #include <string>
+#include <unordered_map>
 
 namespace gfx {
 class HudRenderer;
@@ -67,6 +69,12 @@ struct WaypointEditorLayout {
 
 class WorldMapMenu : public BaseMenu {
   public:
+    WorldMapMenu() = default;
+    ~WorldMapMenu() override;
+
+    WorldMapMenu(const WorldMapMenu &) = delete;
+    WorldMapMenu &operator=(const WorldMapMenu &) = delete;
+
     const char *menuId() const override {
         return "world_map";
     }
@@ -85,7 +93,23 @@ class WorldMapMenu : public BaseMenu {
                 const gfx::TextureAtlas &atlas) const;
 
   private:
+    struct TileTexture {
+        unsigned int texture = 0;
+        std::uint64_t version = 0;
+        int level = 0;
+        int tx = 0;
+        int tz = 0;
+    };
+
+    // Uploads the tile if it changed since last drawn and returns its texture.
+    unsigned int tileTexture(const game::MapTilePyramid::Tile &tile) const;
+    // Deletes textures whose tile did not come back after a full rebuild.
+    void evictStaleTileTextures() const;
+
     mutable UiMenuRenderer ui_;
+    mutable game::MapTilePyramid pyramid_;
+    mutable std::unordered_map<std::uint64_t, TileTexture> tileTextures_;
+    mutable std::uint64_t sweptRebuild_ = 0;
 };
 
 } // namespace app::menus
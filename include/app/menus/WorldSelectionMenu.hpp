@@ -5,11 +5,17 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 struct GLFWwindow;
 
+namespace core {
+class AssetLoader;
+}
+
 namespace gfx {
 class HudRenderer;
 }
@@ -25,18 +31,38 @@ struct WorldSelection {
 
 class WorldSelectionMenu : public BaseMenu {
   public:
+    WorldSelectionMenu();
+    ~WorldSelectionMenu() override;
+
+    WorldSelectionMenu(const WorldSelectionMenu &) = delete;
+    WorldSelectionMenu &operator=(const WorldSelectionMenu &) = delete;
+
     const char *menuId() const override {
         return "world_selection";
     }
 
-    WorldSelection run(GLFWwindow *window, gfx::HudRenderer &hud);
+    // Pumps the loader's uploads every frame so assets finish loading while
+    // the player picks a world.
+    WorldSelection run(GLFWwindow *window, gfx::HudRenderer &hud, core::AssetLoader &assets);
     void render(gfx::HudRenderer &hud, int width, int height,
-                const std::vector<std::string> &worlds, int selectedWorld, bool createMode,
+                const std::vector<std::string> &worlds,
+                const std::vector<unsigned int> &thumbnails, int selectedWorld, bool createMode,
                 bool editSeed, const std::string &createName, const std::string &createSeed,
-                float cursorX, float cursorY) const;
+                float cursorX, float cursorY, const std::string &statusText) const;
 
   private:
+    struct CatalogRefresh;
+
+    // The catalog refresh runs on a thread owned by the menu, not by run(), so
+    // picking a world never waits on it. Leaving run() cancels it; it is
+    // joined before the next refresh starts and on destruction.
+    void startCatalogRefresh();
+    void cancelCatalogRefresh();
+    void joinCatalogRefresh();
+
     mutable UiMenuRenderer ui_;
+    std::unique_ptr<CatalogRefresh> refresh_;
+    std::thread refreshThread_;
 };
 
 } // namespace app::menus
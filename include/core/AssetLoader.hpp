@@ -0,0 +1,59 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+// Decodes assets on a small worker pool and hands the results back to the
+// thread that owns the GL/AL context. A job runs on a worker and returns the
+// upload step, which pump() runs on the calling thread within a time budget so
+// loading never stalls a frame for long. Uploads run in completion order.
+class AssetLoader {
+  public:
+    using Upload = std::function<void()>;
+    using Job = std::function<Upload()>;
+
+    // Upload time a render loop spends per frame; keeps the frame under 60 Hz.
+    static constexpr double kFrameBudgetSeconds = 0.002;
+
+    // workerCount 0 picks one less than the hardware threads, capped at 4.
+    explicit AssetLoader(unsigned int workerCount = 0);
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader &) = delete;
+    AssetLoader &operator=(const AssetLoader &) = delete;
+
+    void submit(Job job);
+    // Runs finished uploads until budgetSeconds have elapsed; at least one
+    // runs when any is ready. Returns the number run.
+    std::size_t pump(double budgetSeconds);
+    // Blocks until every submitted job has been decoded and uploaded.
+    void finish();
+
+    std::size_t submittedCount() const;
+    std::size_t completedCount() const;
+    // Fraction of submitted jobs fully uploaded; 1 when idle.
+    float progress() const;
+    bool done() const;
+
+  private:
+    void workerLoop();
+
+    std::vector<std::thread> workers_{};
+    mutable std::mutex mutex_;
+    std::condition_variable jobCv_;
+    std::condition_variable uploadCv_;
+    std::deque<Job> jobs_{};
+    std::deque<Upload> uploads_{};
+    std::size_t submitted_ = 0;
+    std::size_t completed_ = 0;
+    bool stopping_ = false;
+};
+
+} // namespace core
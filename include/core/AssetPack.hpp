@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace core {
+
+// PCM samples as found in a WAV data chunk. The samples point into the
+// buffer the sound was parsed from.
+struct SoundData {
+    std::uint16_t channels = 0;
+    std::uint16_t bitsPerSample = 0;
+    std::uint32_t sampleRate = 0;
+    const std::uint8_t *samples = nullptr;
+    std::size_t sampleBytes = 0;
+};
+
+// Pre-decoded RGBA8 image with its mip chain and per-tile average colours
+// (RGB triples, alpha weighted). Pointers stay valid while the pack is open.
+struct ImageData {
+    int width = 0;
+    int height = 0;
+    int tileW = 0;
+    int tileH = 0;
+    std::vector<const std::uint8_t *> levels;
+    const float *tileColors = nullptr;
+    int tileCount = 0;
+};
+
+// Parses a RIFF/WAVE file held in memory; only uncompressed PCM is accepted.
+bool parseWav(const std::uint8_t *bytes, std::size_t size, SoundData &out, std::string &error);
+
+// Alpha-weighted average colour of every tile, row-major, as RGB triples.
+// Fully transparent tiles average to mid grey.
+std::vector<float> computeTileAverageColors(const std::uint8_t *rgba, int width, int height,
+                                            int tileW, int tileH);
+
+// Read-only view of an asset pack: the atlas and sounds decoded ahead of time
+// by asset_packer and memory-mapped at startup. Entries are named by the
+// loose file path they replace, so callers look up the path they would have
+// opened and fall back to the file when the pack is missing or stale.
+class AssetPack {
+  public:
+    // The build writes the pack under this name next to the game executable.
+    static constexpr const char *kFileName = "assets.pack";
+    static constexpr std::uint32_t kVersion = 1;
+
+    enum class Kind : std::uint32_t { Image = 1, Sound = 2 };
+
+    // The shared pack, opened on first use from the path last given to
+    // setInstancePath, or kFileName in the working directory.
+    static const AssetPack &instance();
+    // Call before the first instance().
+    static void setInstancePath(const std::string &path);
+
+    AssetPack() = default;
+    ~AssetPack();
+
+    AssetPack(const AssetPack &) = delete;
+    AssetPack &operator=(const AssetPack &) = delete;
+
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const {
+        return data_ != nullptr;
+    }
+    std::size_t entryCount() const {
+        return entries_.size();
+    }
+
+    bool findImage(const std::string &name, ImageData &out) const;
+    bool findSound(const std::string &name, SoundData &out) const;
+
+  private:
+    struct Entry {
+        Kind kind = Kind::Image;
+        std::uint64_t offset = 0;
+        std::uint64_t size = 0;
+    };
+
+    const Entry *find(const std::string &name, Kind kind) const;
+
+    const std::uint8_t *data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<std::uint8_t> fallback_{};
+    std::unordered_map<std::string, Entry> entries_{};
+};
+
+// Builds an asset pack file; used by the asset_packer build step.
+class AssetPackWriter {
+  public:
+    void addImage(const std::string &name, const std::uint8_t *rgba, int width, int height,
+                  int tileW, int tileH);
+    void addSound(const std::string &name, const SoundData &sound);
+    bool write(const std::string &path, std::string &error) const;
+
+  private:
+    struct Pending {
+        std::string name;
+        AssetPack::Kind kind = AssetPack::Kind::Image;
+        std::vector<std::uint8_t> payload;
+    };
+
+    std::vector<Pending> pending_{};
+};
+
+} // namespace core
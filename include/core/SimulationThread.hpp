@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace core {
+
+// Runs a fixed-step simulation on its own thread, paced by the wall clock.
+// Every step runs with the simulation mutex held; other threads take lock()
+// to read or change simulation state between steps. A step delayed by a long
+// lock is made up afterwards, at most kMaxCatchUpSteps per wake, so the
+// simulation keeps real-time pace whatever the frame rate.
+class SimulationThread {
+  public:
+    // step is the zero-based index of the step being run.
+    using Step = std::function<void(std::uint64_t step)>;
+
+    static constexpr int kMaxCatchUpSteps = 8;
+
+    SimulationThread(float stepSeconds, Step step);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread &) = delete;
+    SimulationThread &operator=(const SimulationThread &) = delete;
+
+    void start();
+    // Waits for the running step, if any, and joins. Safe to call twice.
+    void stop();
+
+    std::unique_lock<std::mutex> lock();
+    float stepSeconds() const {
+        return stepSeconds_;
+    }
+    std::uint64_t stepCount() const {
+        return steps_.load(std::memory_order_acquire);
+    }
+    // Simulation time in steps: the steps due when the stepper last woke, plus
+    // its accumulator's fraction of the next, plus the wall time since. Runs
+    // past stepCount() + 1 while a held lock delays due steps.
+    double clockSteps() const;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    void run();
+
+    float stepSeconds_ = 0.0f;
+    Step step_{};
+    std::mutex simMutex_;
+    std::mutex controlMutex_;
+    std::condition_variable stopCv_;
+    bool stopping_ = false;
+    std::atomic<std::uint64_t> steps_{0};
+    mutable std::mutex clockMutex_;
+    double clockBaseSteps_ = 0.0;
+    Clock::time_point clockBaseAt_{};
+    std::thread thread_{};
+};
+
+} // namespace core
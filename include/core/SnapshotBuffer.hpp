@@ -0,0 +1,61 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+
+namespace core {
+
+// The last two states a fixed-step simulation published, double-buffered so
+// a renderer on another thread can draw between them. Each state is stamped
+// with the simulation time it holds at, in steps; read() turns the current
+// simulation time into the interpolation alpha. read() copies both under a
+// short lock; publish() overwrites the older slot.
+template <typename State> class SnapshotBuffer {
+  public:
+    struct View {
+        State previous{};
+        State current{};
+        // Simulation-time progress from current toward the next publish, in
+        // [0, 1].
+        float alpha = 1.0f;
+        std::uint64_t published = 0;
+    };
+
+    // Makes state both the previous and the current snapshot, so a teleport
+    // or respawn is not interpolated from the old position.
+    void reset(const State &state, double atStep) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slots_[0] = state;
+        slots_[1] = state;
+        currentAt_ = atStep;
+    }
+
+    void publish(const State &state, double atStep) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        current_ ^= 1;
+        slots_[current_] = state;
+        currentAt_ = atStep;
+        ++published_;
+    }
+
+    // nowSteps is the simulation clock, as SimulationThread::clockSteps().
+    View read(double nowSteps) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        View view;
+        view.previous = slots_[current_ ^ 1];
+        view.current = slots_[current_];
+        view.published = published_;
+        view.alpha = static_cast<float>(std::clamp(nowSteps - currentAt_, 0.0, 1.0));
+        return view;
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    State slots_[2]{};
+    int current_ = 0;
+    double currentAt_ = 0.0;
+    std::uint64_t published_ = 0;
+};
+
+} // namespace core
@@ -32,6 +32,12 @@ class TickCounter {
         return tickCount_;
     }
 
+    // How far the time not yet consumed reaches into the next tick, in [0, 1)
+    // unless maxTicksPerUpdate held ticks back.
+    float alpha() const {
+        return (tickIntervalSeconds_ > 0.0f) ? accumulatorSeconds_ / tickIntervalSeconds_ : 0.0f;
+    }
+
     void reset() {
         accumulatorSeconds_ = 0.0f;
         tickCount_ = 0;
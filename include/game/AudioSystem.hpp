@@ -3,6 +3,10 @@
 #include <string>
 #include <vector>
 
+namespace core {
+class AssetLoader;
+}
+
 namespace game {
 
 class AudioSystem {
@@ -34,6 +38,9 @@ class AudioSystem {
     bool loadSwimSounds(const std::vector<std::string> &paths);
     bool loadWaterBobSounds(const std::vector<std::string> &paths);
     bool loadDefaultAssets();
+    // Decodes the default sounds on the loader's workers; each pool fills as
+    // its uploads are pumped on this thread. The loader must not outlive this.
+    void loadDefaultAssetsAsync(core::AssetLoader &loader);
     void playPickup();
     void playBreak(SoundProfile profile);
     void playFootstep(SoundProfile profile);
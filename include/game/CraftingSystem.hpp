@@ -4,7 +4,10 @@
 #include "game/Recipe.hpp"
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace game {
@@ -42,8 +45,20 @@ class CraftingSystem {
         int minGridSize = kGridSizeInventory;
     };
 
+    // Recipe-menu craftability derived from per-item inventory totals. The
+    // flags are only recomputed when the totals or the grid size change.
+    struct Craftability {
+        std::vector<int> counts;
+        int gridSize = 0;
+        std::vector<unsigned char> flags;
+    };
+
     CraftingSystem();
 
+    // Registers a recipe and indexes it by its grid signature. Info must
+    // describe the same recipe for the recipe menu.
+    void addRecipe(Recipe recipe, RecipeInfo info);
+
     static int activeInputCount(int gridSize);
 
     void updateOutput(State &state, int gridSize) const;
@@ -59,11 +74,55 @@ class CraftingSystem {
         return recipeInfos_;
     }
 
-  private:
+    // Looks the grid up by signature and verifies the few candidates.
     const Recipe *findMatch(const State &state, int gridSize) const;
+    // Reference scan over every recipe in order.
+    const Recipe *findMatchLinear(const State &state, int gridSize) const;
+
+    // Item totals across the inventory, indexed by block id.
+    std::vector<int> countItems(const Inventory &inventory) const;
+    bool canCraftFrom(const std::vector<int> &counts, int recipeIndex, int gridSize) const;
+    // Returns true when the flags were recomputed.
+    bool refreshCraftability(Craftability &state, const Inventory &inventory,
+                             int gridSize) const;
+
+  private:
+    // Shaped recipes key on the grid trimmed to its occupied bounding box;
+    // shapeless ones on the sorted set of distinct ingredients (width 0).
+    // Wildcard ingredients key on their family's base id.
+    struct Signature {
+        std::array<voxel::BlockId, kInputCount> ids{};
+        std::uint8_t width = 0;
+        std::uint8_t height = 0;
+        bool operator==(const Signature &other) const = default;
+    };
+    struct SignatureHash {
+        std::size_t operator()(const Signature &sig) const noexcept;
+    };
+    // Aggregated inventory need of one recipe. Family requirements exclude
+    // the units reserved by exact requirements from the same family.
+    struct Requirement {
+        voxel::BlockId id = voxel::AIR;
+        bool anyWood = false;
+        bool anyPlanks = false;
+        int count = 0;
+        int reserved = 0;
+    };
+
+    static voxel::BlockId signatureId(voxel::BlockId id, bool anyWood, bool anyPlanks);
+    static Signature gridSignature(const State &state, int gridSize, bool shaped, bool anyWood,
+                                   bool anyPlanks);
+    void indexRecipe(int index);
+    void buildRequirements(int index);
 
     std::vector<Recipe> recipes_{};
     std::vector<RecipeInfo> recipeInfos_{};
+    std::vector<std::vector<Requirement>> requirements_{};
+    std::unordered_map<Signature, std::vector<int>, SignatureHash> index_{};
+    // Recipes mixing a wildcard with an exact id of the same family have no
+    // single signature and are always verified.
+    std::vector<int> unindexed_{};
+    std::size_t countSize_ = 0;
 };
 
 } // namespace game
@@ -22,6 +22,8 @@ class Inventory {
     Inventory();
 
     bool add(voxel::BlockId id, int count);
+    // Adds as much of count as fits and returns how many were stored.
+    int addUpTo(voxel::BlockId id, int count);
     bool consumeHotbar(int hotbarIndex, int count);
 
     const Slot &hotbarSlot(int index) const {
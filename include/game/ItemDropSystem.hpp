@@ -3,10 +3,13 @@
 #include "gfx/TextureAtlas.hpp"
 #include "voxel/Block.hpp"
 
-#include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -16,6 +19,11 @@ class World;
 
 namespace game {
 
+// Dropped item stacks, stored structure-of-arrays. Stacks that come to rest
+// fall asleep and skip physics until blocks change in a chunk around them;
+// nearby identical stacks merge, and pickup/merge queries go through a sorted
+// cell hash rebuilt once per tick. Rendering is two instanced draws (cubes and
+// crossed sprites) over one shared static mesh.
 class ItemDropSystem {
   public:
     struct Pickup {
@@ -24,6 +32,23 @@ class ItemDropSystem {
         glm::vec3 pos{0.0f};
     };
 
+    // Block queries used by the physics step. World-backed by default; tests
+    // and tools can supply their own.
+    struct Environment {
+        std::function<bool(int, int, int)> isSolid;
+        std::function<glm::vec3(const glm::vec3 &)> fluidCurrent;
+        // Content revision of chunk (cx, cz), 0 when not loaded. A sleeping
+        // stack wakes when a chunk it touches reports a newer revision.
+        std::function<std::uint64_t(int, int)> chunkRevision;
+    };
+
+    struct Stats {
+        std::size_t stacks = 0;
+        std::size_t sleeping = 0;
+        std::size_t blockQueries = 0;
+        std::size_t merges = 0;
+    };
+
     ItemDropSystem() = default;
     ~ItemDropSystem();
 
@@ -32,42 +57,81 @@ class ItemDropSystem {
 
     void spawn(voxel::BlockId id, const glm::vec3 &worldPos, int count = 1);
     void update(const world::World &world, const glm::vec3 &playerPos, float dt);
+    void update(const Environment &env, const glm::vec3 &playerPos, float dt);
     std::vector<Pickup> consumePickups();
-    void render(const glm::mat4 &proj, const glm::mat4 &view, const gfx::TextureAtlas &atlas,
-                const voxel::BlockRegistry &registry);
+    // Camera matrices come from the shared SceneBlock uniform buffer.
+    void render(const gfx::TextureAtlas &atlas, const voxel::BlockRegistry &registry);
 
     std::size_t activeCount() const {
-        return items_.size();
+        return ids_.size();
+    }
+    int totalItemCount() const;
+    const Stats &stats() const {
+        return stats_;
     }
 
   private:
-    struct Item {
-        voxel::BlockId id = voxel::AIR;
-        glm::vec3 pos{0.0f};
-        glm::vec3 vel{0.0f};
-        float age = 0.0f;
-        float pickupDelay = 0.0f;
-    };
-
-    struct Vertex {
+    // Per-instance attributes: world position plus spawn time (for spin and
+    // bob), then the face UV rectangles.
+    struct Instance {
         float x;
         float y;
         float z;
-        float u;
-        float v;
-        float light;
+        float birth;
+        glm::vec4 uvSide;
+        glm::vec4 uvTop;
+        glm::vec4 uvBottom;
+        glm::vec4 uvFront;
     };
 
     void initGl();
-    bool collidesSolid(const world::World &world, const glm::vec3 &pos) const;
+    bool collidesSolid(const Environment &env, const glm::vec3 &pos);
+    bool solidAt(const Environment &env, int x, int y, int z);
+    glm::vec3 flowAt(const Environment &env, const glm::vec3 &pos);
+    std::uint64_t revisionAround(const Environment &env, const glm::vec3 &pos);
+    void removeAt(std::size_t index);
+    void rebuildCellIndex();
+    void mergeNearby(std::size_t index);
+    template <typename Visit>
+    void forEachInCells(const glm::ivec3 &minCell, const glm::ivec3 &maxCell, Visit &&visit) const;
+
+    // Stack state (structure of arrays, one entry per stack).
+    std::vector<voxel::BlockId> ids_;
+    std::vector<int> counts_;
+    std::vector<glm::vec3> positions_;
+    std::vector<glm::vec3> velocities_;
+    std::vector<float> births_;
+    std::vector<float> pickupDelays_;
+    std::vector<std::uint8_t> restTicks_;
+    std::vector<std::uint8_t> asleep_;
+    std::vector<std::uint64_t> sleepRevisions_;
+
+    float simTime_ = 0.0f;
+    bool instancesDirty_ = true;
+    Stats stats_;
+
+    // Per-tick caches: block solidity and fluid current keyed by packed block
+    // coordinate, chunk revisions keyed by packed chunk coordinate, and
+    // (cell key, stack index) pairs sorted by key.
+    std::unordered_map<std::uint64_t, bool> solidCache_;
+    std::unordered_map<std::uint64_t, glm::vec3> flowCache_;
+    std::unordered_map<std::uint64_t, std::uint64_t> chunkRevisionCache_;
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> cellIndex_;
+    std::vector<std::uint32_t> awakeScratch_;
 
     unsigned int shader_ = 0;
     unsigned int vao_ = 0;
-    unsigned int vbo_ = 0;
+    unsigned int meshVbo_ = 0;
+    unsigned int instanceVbo_ = 0;
+    int uAtlas_ = -1;
+    int uTime_ = -1;
+    int cubeVertexCount_ = 0;
+    int spriteVertexCount_ = 0;
+    int cubeInstances_ = 0;
+    int spriteInstances_ = 0;
+    std::size_t instanceCapacity_ = 0;
     bool ready_ = false;
-
-    std::vector<Vertex> verts_;
-    std::vector<Item> items_;
+    std::vector<Instance> instances_;
     std::vector<Pickup> pendingPickups_;
 };
 
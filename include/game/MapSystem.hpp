@@ -3,15 +3,21 @@
 #include "voxel/Block.hpp"
 #include "world/ChunkCoord.hpp"
 
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <filesystem>
+#include <iosfwd>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace world {
@@ -43,27 +49,84 @@ class MapSystem {
     bool sample(int wx, int wz, voxel::BlockId &outId) const;
     bool sampleHeight(int wx, int wz, int &outY) const;
     bool sampleWaterCover(int wx, int wz, bool &outCovered) const;
+    // Bumped each time scanned or loaded columns change.
+    std::uint64_t revision() const {
+        return revision_;
+    }
+    // Appends chunks whose columns changed after sinceRevision. Returns false
+    // when the change log no longer reaches back that far; the caller should
+    // then rebuild from knownChunks().
+    bool changedChunksSince(std::uint64_t sinceRevision,
+                            std::vector<world::ChunkCoord> &out) const;
+    // Chunks with explored columns in the resident pages.
+    std::vector<world::ChunkCoord> knownChunks() const;
+    // Makes the saved pages overlapping the region resident, nearest first and
+    // a few per call, and drops clean pages outside it once over the cap.
+    void requestRegion(int minWX, int minWZ, int maxWX, int maxWZ);
+    std::size_t residentPageCount() const {
+        return pages_.size();
+    }
+    std::size_t dirtyPageCount() const {
+        return dirtyPages_.size();
+    }
     const std::vector<Waypoint> &waypoints() const;
     std::vector<Waypoint> &waypoints();
 
     bool load(const std::filesystem::path &worldDir);
-    bool save(const std::filesystem::path &worldDir) const;
+    // Appends dirty pages to the page file and rewrites the small map.dat
+    // index. Once most of the page file is stale it is compacted into a new
+    // generation, and the old one is deleted after the index names the new.
+    bool save(const std::filesystem::path &worldDir);
 
   private:
-    static std::uint64_t keyFor(int x, int z);
+    // One explored column packed into 4 bytes; id == AIR means unexplored.
+    struct MapColumn {
+        voxel::BlockId id = voxel::AIR;
+        std::uint8_t height = 0;
+        std::uint8_t water = 0;
+    };
+    static_assert(sizeof(MapColumn) == 4);
+
+    static constexpr int kPageSize = 64;
+    // Pages are immutable once published: the scanner fills copies and the
+    // main thread swaps them into the directory.
+    struct Page {
+        std::array<MapColumn, kPageSize * kPageSize> columns{};
+    };
+    using PageMap = std::unordered_map<std::uint64_t, std::shared_ptr<const Page>>;
+    // Where a page's run-length encoded blob lives in the page file.
+    struct PageLocation {
+        std::uint64_t offset = 0;
+        std::uint32_t size = 0;
+    };
+
+    static std::uint64_t pageKeyFor(int px, int pz);
+    static void appendKnownChunks(std::uint64_t key, const Page &page,
+                                  std::vector<world::ChunkCoord> &out);
+    bool loadLegacy(std::istream &in, bool hasWaypoints, bool hasVisibility);
+    bool loadIndex(std::istream &in);
+    // True when the page file the index names exists and carries its generation.
+    bool pageFileMatches() const;
+    std::shared_ptr<const Page> readPage(std::istream &pagesIn, std::uint64_t key) const;
+    void loadPage(std::uint64_t key);
+    const MapColumn *findColumn(int wx, int wz) const;
     void workerLoop();
     void enqueueScan(const world::World &world, std::vector<world::ChunkCoord> chunks);
     void consumeWorkerResult();
 
-    std::unordered_map<std::uint64_t, voxel::BlockId> tiles_;
-    std::unordered_map<std::uint64_t, voxel::BlockId> liveTiles_;
-    std::unordered_map<std::uint64_t, std::uint8_t> heights_;
-    std::unordered_map<std::uint64_t, std::uint8_t> liveHeights_;
-    std::unordered_map<std::uint64_t, std::uint8_t> waterCover_;
-    std::unordered_map<std::uint64_t, std::uint8_t> liveWaterCover_;
-    std::unordered_set<world::ChunkCoord, world::ChunkCoordHash> knownLoadedChunks_;
+    PageMap pages_;
+    // Saved pages, resident or not, and the resident pages changed since.
+    std::unordered_map<std::uint64_t, PageLocation> diskPages_;
+    std::unordered_set<std::uint64_t> dirtyPages_;
+    std::filesystem::path storageDir_;
+    // map_pages.<generation>.dat holds the blobs diskPages_ points into.
+    std::uint32_t pageFileGeneration_ = 0;
+    // Chunk revision each loaded chunk had when it was last scanned.
+    std::unordered_map<world::ChunkCoord, std::uint64_t, world::ChunkCoordHash> scannedRevisions_;
     std::vector<Waypoint> waypoints_;
-    std::size_t refreshCursor_ = 0;
+    std::uint64_t revision_ = 0;
+    std::uint64_t changeLogFloor_ = 0;
+    std::deque<std::pair<std::uint64_t, world::ChunkCoord>> changeLog_;
 
     std::thread worker_;
     std::mutex workerMutex_;
@@ -73,12 +136,17 @@ class MapSystem {
     bool workerBusy_ = false;
     const world::World *requestWorld_ = nullptr;
     std::vector<world::ChunkCoord> requestChunks_;
+    // Current versions of the pages the requested chunks fall in.
+    PageMap requestPages_;
+    std::uint64_t requestGeneration_ = 0;
 
     std::mutex resultMutex_;
     bool hasResult_ = false;
-    std::unordered_map<std::uint64_t, voxel::BlockId> resultLiveTiles_;
-    std::unordered_map<std::uint64_t, std::uint8_t> resultLiveHeights_;
-    std::unordered_map<std::uint64_t, std::uint8_t> resultLiveWaterCover_;
+    PageMap resultPages_;
+    std::vector<std::pair<world::ChunkCoord, std::uint64_t>> resultChunks_;
+    std::uint64_t resultGeneration_ = 0;
+    // Bumped by load() so scans started against old contents are dropped.
+    std::uint64_t generation_ = 0;
 
     std::chrono::steady_clock::time_point lastScanEnqueue_{};
 };
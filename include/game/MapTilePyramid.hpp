@@ -0,0 +1,91 @@
+#pragma once
+
+#include "voxel/Block.hpp"
+#include "world/ChunkCoord.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace game {
+
+class MapSystem;
+
+// Shaded RGBA raster of the explored map, kept as fixed-size tiles with a mip
+// pyramid for zoomed-out views. Chunks reported changed by MapSystem are
+// re-rasterised a few per update and their footprint is propagated up the
+// levels, so drawing the map costs a handful of textured quads at any zoom.
+class MapTilePyramid {
+  public:
+    static constexpr int kTileSize = 256;
+    // Level 2 texels span 4 columns, one pixel at the map's furthest zoom;
+    // a coarser level would never be drawn.
+    static constexpr int kLevels = 3;
+
+    struct Tile {
+        int level = 0;
+        int tx = 0;
+        int tz = 0;
+        // kTileSize * kTileSize RGBA8 texels, row-major in +Z; alpha 0 marks
+        // unexplored columns.
+        std::vector<std::uint8_t> rgba;
+        // Bumped on every change so renderers know when to re-upload.
+        std::uint64_t version = 0;
+    };
+
+    using ColorFn = std::function<glm::vec3(voxel::BlockId)>;
+
+    // Pulls changes from the map and re-rasterises at most maxChunks dirty
+    // chunks. Returns the number of chunks rasterised.
+    int update(const MapSystem &map, const ColorFn &colorOf, int maxChunks);
+    void invalidateAll();
+
+    const Tile *find(int level, int tx, int tz) const;
+    // Slope-, altitude- and water-shaded colour of one column; false when the
+    // column is unexplored. Shared with the minimap raster.
+    static bool shadeColumn(const MapSystem &map, const ColorFn &colorOf, int wx, int wz,
+                            glm::vec3 &out);
+    std::size_t tileCount() const {
+        return tiles_.size();
+    }
+    std::size_t pendingChunks() const {
+        return dirtyQueue_.size();
+    }
+    // Bumped each time every tile is dropped and rasterised again.
+    std::uint64_t rebuildCount() const {
+        return rebuildCount_;
+    }
+
+    // World columns covered by one texel / one tile at the given level.
+    static constexpr int texelSpan(int level) {
+        return 1 << level;
+    }
+    static constexpr int tileSpan(int level) {
+        return kTileSize << level;
+    }
+
+  private:
+    static std::uint64_t keyFor(int level, int tx, int tz);
+    const std::uint8_t *peek(int level, int gx, int gz) const;
+    // Write access; bumps the owning tile's version.
+    std::uint8_t *texel(int level, int gx, int gz, bool create);
+    void enqueue(const world::ChunkCoord &cc);
+    void rasterChunk(const MapSystem &map, const ColorFn &colorOf, const world::ChunkCoord &cc);
+    void downsample(int level, int wx0, int wz0, int wx1, int wz1);
+
+    std::unordered_map<std::uint64_t, Tile> tiles_;
+    std::deque<world::ChunkCoord> dirtyQueue_;
+    std::unordered_set<world::ChunkCoord, world::ChunkCoordHash> queued_;
+    std::uint64_t seenRevision_ = 0;
+    std::uint64_t versionCounter_ = 0;
+    std::uint64_t rebuildCount_ = 0;
+    bool needsFullRebuild_ = true;
+};
+
+} // namespace game
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "game/MapTilePyramid.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace game {
+
+class MapSystem;
+
+// Toroidal RGBA raster of the explored map around the player. World column
+// (wx, wz) always lives at texel (wx mod kSize, wz mod kSize), so moving only
+// repaints the strips that scroll into view and a changed chunk only its own
+// footprint; the renderer samples it with wrapping and rotates or zooms in
+// the draw.
+class MiniMapRaster {
+  public:
+    static constexpr int kSize = 256;
+
+    // Texel rectangle in ring coordinates; never wraps.
+    struct Rect {
+        int x = 0;
+        int z = 0;
+        int w = 0;
+        int h = 0;
+    };
+
+    MiniMapRaster();
+
+    // Re-centres the window on the column and repaints newly exposed strips
+    // plus chunks the map reports changed. Returns the number of texels
+    // painted.
+    int update(const MapSystem &map, const MapTilePyramid::ColorFn &colorOf, int centerWX,
+               int centerWZ);
+    void invalidateAll();
+
+    // kSize * kSize RGBA8 texels, row-major in +Z; alpha 0 marks unexplored.
+    const std::vector<std::uint8_t> &rgba() const {
+        return rgba_;
+    }
+    // Regions painted since the last call.
+    std::vector<Rect> consumeDirtyRects();
+
+    static int ringIndex(int w) {
+        return w & (kSize - 1);
+    }
+
+  private:
+    // Paints the inclusive world box, clipped to the current window.
+    int paint(const MapSystem &map, const MapTilePyramid::ColorFn &colorOf, int wx0, int wz0,
+              int wx1, int wz1);
+    void markDirty(int wx0, int wz0, int wx1, int wz1);
+
+    std::vector<std::uint8_t> rgba_;
+    std::vector<Rect> dirty_;
+    // World column at the window's minimum corner.
+    int originX_ = 0;
+    int originZ_ = 0;
+    bool valid_ = false;
+    std::uint64_t seenRevision_ = 0;
+};
+
+} // namespace game
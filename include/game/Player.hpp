@@ -2,13 +2,6 @@
 
 #include "game/PlayerController.hpp"
 
-struct GLFWwindow;
-
-namespace game {
-
-class Camera;
-}
-
 namespace world {
 class World;
 }
@@ -19,8 +12,7 @@ class Player {
   public:
     void setFromCamera(const glm::vec3 &cameraPos, const world::World &world,
                        bool resolveIntersections = true);
-    void update(GLFWwindow *window, const world::World &world, const Camera &camera, float dt,
-                bool inputEnabled);
+    void update(const world::World &world, const PlayerInput &input, float dt);
 
     glm::vec3 cameraPosition() const;
     bool grounded() const;
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "world/VoxelWindow.hpp"
+
 #include <glm/vec3.hpp>
 
+#include <functional>
+
 struct GLFWwindow;
 
 namespace game {
@@ -15,12 +19,38 @@ class World;
 
 namespace game {
 
+// Movement keys and view for one update, sampled on the thread that owns the
+// window so the controller itself can step on any thread.
+struct PlayerInput {
+    glm::vec3 viewPos{0.0f};
+    glm::vec3 forward{0.0f, 0.0f, -1.0f};
+    bool forwardKey = false;
+    bool backKey = false;
+    bool leftKey = false;
+    bool rightKey = false;
+    bool jump = false;
+    bool sprint = false;
+    bool crouch = false;
+
+    // With inputEnabled false only the view is taken; every key reads as up.
+    static PlayerInput sample(GLFWwindow *window, const Camera &camera, bool inputEnabled);
+};
+
 class PlayerController {
   public:
+    // Copies [minCell, maxCell] into out, as World::gatherVoxelWindow does.
+    // Lets the controller step against a fixed grid without a World.
+    using CellSource = std::function<void(const glm::ivec3 &minCell, const glm::ivec3 &maxCell,
+                                          world::VoxelWindow &out)>;
+
     void setFromCamera(const glm::vec3 &cameraPos, const world::World &world,
                        bool resolveIntersections = true);
-    void update(GLFWwindow *window, const world::World &world, const Camera &camera, float dt,
-                bool inputEnabled, bool allowSprint = true);
+    void setFromCamera(const glm::vec3 &cameraPos, const CellSource &cells,
+                       bool resolveIntersections = true);
+    void update(const world::World &world, const PlayerInput &input, float dt,
+                bool allowSprint = true);
+    void update(const CellSource &cells, const PlayerInput &input, float dt,
+                bool allowSprint = true);
 
     glm::vec3 cameraPosition() const;
     bool grounded() const {
@@ -42,15 +72,20 @@ class PlayerController {
     }
 
   private:
-    bool intersectsSolid(const world::World &world, const glm::vec3 &feet) const;
-    bool hasGroundSupport(const world::World &world, const glm::vec3 &feet) const;
-    bool isWaterAt(const world::World &world, const glm::vec3 &pos) const;
-    bool isLavaAt(const world::World &world, const glm::vec3 &pos) const;
-    bool isOnIce(const world::World &world, const glm::vec3 &feet) const;
-    void moveAxis(const world::World &world, int axis, float amount);
+    // Copies the cells this update can touch: the player box grown by reach.
+    void gatherWindow(const CellSource &cells, const glm::vec3 &reach);
+    // Regathers when [boxMin, boxMax] leaves the current window.
+    void ensureWindow(const CellSource &cells, const glm::vec3 &boxMin, const glm::vec3 &boxMax);
+    bool intersectsSolid(const glm::vec3 &feet) const;
+    bool hasGroundSupport(const glm::vec3 &feet) const;
+    bool isWaterAt(const glm::vec3 &pos) const;
+    bool isLavaAt(const glm::vec3 &pos) const;
+    bool isOnIce(const glm::vec3 &feet) const;
+    void moveAxis(const CellSource &cells, int axis, float amount);
 
     glm::vec3 feetPos_{0.0f, 80.0f, 0.0f};
     glm::vec3 velocity_{0.0f};
+    world::VoxelWindow window_{};
 
     bool initialized_ = false;
     bool grounded_ = false;
@@ -35,6 +35,18 @@ class Recipe {
     const Inventory::Slot &output() const {
         return output_;
     }
+    bool shaped() const {
+        return shaped_;
+    }
+    int minGridSize() const {
+        return minGridSize_;
+    }
+    const std::vector<Ingredient> &ingredients() const {
+        return ingredients_;
+    }
+    const std::vector<ShapedCell> &shapedCells() const {
+        return shapedCells_;
+    }
 
   private:
     static bool ingredientMatches(Ingredient ingredient, voxel::BlockId id);
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace game {
+
+// Case-insensitive substring search over a fixed set of entries, each
+// searchable by several texts (names, ingredient names, aliases). Texts are
+// lower-cased once when added and every 1-, 2- and 3-character gram is
+// indexed: short queries are a single posting list, longer ones verify the
+// rarest trigram's postings. Results are cached per query, and a query that
+// extends a cached one only re-checks the cached results, so typing into a
+// search box touches a handful of entries per keystroke.
+class SearchIndex {
+  public:
+    static std::string toLower(std::string text);
+
+    void clear();
+    // Returns the entry index; entries are numbered in insertion order.
+    int add(const std::vector<std::string> &texts);
+    std::size_t size() const {
+        return texts_.size();
+    }
+
+    // Ascending indices of entries with a text containing the query. An empty
+    // query matches everything. The reference stays valid until the next
+    // add(), clear() or find().
+    const std::vector<int> &find(const std::string &query);
+    bool matches(int entry, const std::string &loweredQuery) const;
+
+  private:
+    static constexpr std::size_t kMaxCachedQueries = 256;
+
+    static std::uint32_t gramKey(const char *chars, std::size_t length);
+    std::vector<int> search(const std::string &query) const;
+
+    // Lower-cased texts of each entry joined by '\n', which no gram spans.
+    std::vector<std::string> texts_{};
+    std::vector<int> all_{};
+    std::unordered_map<std::uint32_t, std::vector<int>> grams_{};
+    std::unordered_map<std::string, std::vector<int>> cache_{};
+};
+
+} // namespace game
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace gfx {
+
+// Offset allocator for one large GPU buffer. Works in abstract units (vertices,
+// indices, bytes) and never touches GL, so it can be exercised headless.
+class BufferSubAllocator {
+  public:
+    struct Allocation {
+        std::uint32_t offset = 0;
+        std::uint32_t size = 0;
+    };
+
+    struct Move {
+        std::uint32_t from = 0;
+        std::uint32_t to = 0;
+        std::uint32_t size = 0;
+    };
+
+    static constexpr int kSizeClassCount = 32;
+
+    explicit BufferSubAllocator(std::uint32_t capacity = 0, std::uint32_t granularity = 64);
+
+    std::optional<Allocation> allocate(std::uint32_t size);
+    void release(const Allocation &allocation);
+    void grow(std::uint32_t newCapacity);
+    // Packs live allocations toward offset 0 in ascending order and returns the
+    // relocations the caller must mirror on the GPU copy of the buffer.
+    std::vector<Move> compact();
+
+    std::uint32_t capacity() const {
+        return capacity_;
+    }
+    std::uint32_t usedUnits() const {
+        return used_;
+    }
+    std::uint32_t freeUnits() const {
+        return capacity_ - used_;
+    }
+    std::uint32_t largestFreeBlock() const;
+    std::size_t liveCount() const {
+        return live_.size();
+    }
+    std::size_t freeBlockCount() const {
+        return freeByOffset_.size();
+    }
+
+  private:
+    std::uint32_t roundUp(std::uint32_t size) const;
+    static int sizeClass(std::uint32_t size);
+    void insertFree(std::uint32_t offset, std::uint32_t size);
+    void eraseFree(std::uint32_t offset, std::uint32_t size);
+
+    std::uint32_t capacity_ = 0;
+    std::uint32_t granularity_ = 1;
+    std::uint32_t used_ = 0;
+    std::map<std::uint32_t, std::uint32_t> freeByOffset_;
+    std::array<std::set<std::uint32_t>, kSizeClassCount> freeByClass_{};
+    std::unordered_map<std::uint32_t, std::uint32_t> live_;
+};
+
+} // namespace gfx
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "gfx/BufferSubAllocator.hpp"
+#include "gfx/StagingRing.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace gfx {
+
+struct CpuMesh;
+
+// Per-frame list of sub-draws issued with a single glMultiDrawElementsBaseVertex.
+struct ChunkDrawBatch {
+    std::vector<int> counts;
+    std::vector<const void *> indexOffsets;
+    std::vector<int> baseVertices;
+
+    void clear() {
+        counts.clear();
+        indexOffsets.clear();
+        baseVertices.clear();
+    }
+    bool empty() const {
+        return counts.empty();
+    }
+};
+
+// Staging memory the GL thread reserved ahead of time. A meshing worker may
+// write into memory until the slab goes back through the arena.
+struct StagingSlab {
+    StagingRing::Region region{};
+    unsigned char *memory = nullptr;
+};
+
+// A mesh written into a slab: vertices first, then indices at indexOffset.
+struct StagedMesh {
+    StagingSlab slab{};
+    std::uint32_t vertexCount = 0;
+    std::uint32_t indexCount = 0;
+    std::uint32_t indexOffset = 0;
+};
+
+// All chunk geometry lives in one vertex buffer and one index buffer bound to a
+// single shared VAO. Meshes refer to their ranges through stable slot handles so
+// the arena can compact or grow the buffers without touching the owners.
+class ChunkGeometryArena {
+  public:
+    using SlotHandle = std::uint32_t;
+    static constexpr SlotHandle kInvalidSlot = 0xFFFFFFFFu;
+
+    struct Stats {
+        std::uint32_t vertexCapacity = 0;
+        std::uint32_t vertexUsed = 0;
+        std::uint32_t indexCapacity = 0;
+        std::uint32_t indexUsed = 0;
+        std::uint32_t slots = 0;
+        std::uint32_t compactions = 0;
+        std::uint64_t stagedBytes = 0;
+        std::uint64_t directBytes = 0;
+    };
+
+    ChunkGeometryArena() = default;
+    ~ChunkGeometryArena();
+
+    ChunkGeometryArena(const ChunkGeometryArena &) = delete;
+    ChunkGeometryArena &operator=(const ChunkGeometryArena &) = delete;
+
+    SlotHandle createSlot();
+    void destroySlot(SlotHandle handle);
+    // Streams the mesh through the staging ring; uploads directly with
+    // glBufferSubData when the ring is unmapped or has no room this frame.
+    void upload(SlotHandle handle, const CpuMesh &mesh);
+    // Copies a mesh a worker staged into the slot and releases its slab.
+    void uploadStaged(SlotHandle handle, const StagedMesh &staged);
+    // Reserves a slab for a worker to stage a mesh in; nullopt without
+    // persistent mapping or when the ring has no room.
+    std::optional<StagingSlab> reserveSlab(std::uint32_t bytes);
+    // Returns a slab that was never uploaded from.
+    void releaseSlab(const StagingSlab &slab);
+    // Writes mesh into slab; safe off the GL thread. False when it does not fit.
+    static bool stageMesh(const StagingSlab &slab, const CpuMesh &mesh, StagedMesh &out);
+    // Fences this frame's staging writes. Call once after the frame's uploads.
+    void endFrame();
+    int indexCount(SlotHandle handle) const;
+    void appendDraw(SlotHandle handle, ChunkDrawBatch &batch) const;
+    void draw(const ChunkDrawBatch &batch) const;
+    Stats stats() const;
+
+  private:
+    struct Slot {
+        BufferSubAllocator::Allocation vertices{};
+        BufferSubAllocator::Allocation indices{};
+        int indexCount = 0;
+        bool live = false;
+    };
+
+    void init();
+    // Gives the slot fresh ranges for the counts; nullptr when it ends up empty.
+    Slot *allocateRanges(SlotHandle handle, std::uint32_t vertexCount, std::uint32_t indexCount);
+    void releaseRanges(Slot &slot);
+    void relocate(bool vertexBuffer, std::uint32_t newCapacity);
+    void bindVertexLayout() const;
+
+    unsigned int vao_ = 0;
+    unsigned int vbo_ = 0;
+    unsigned int ebo_ = 0;
+    bool ready_ = false;
+    BufferSubAllocator vertexAlloc_;
+    BufferSubAllocator indexAlloc_;
+    std::vector<Slot> slots_;
+    std::vector<SlotHandle> freeSlots_;
+    std::uint32_t compactions_ = 0;
+    std::uint64_t stagedBytes_ = 0;
+    std::uint64_t directBytes_ = 0;
+    StagingRing staging_;
+};
+
+} // namespace gfx
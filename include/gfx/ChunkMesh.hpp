@@ -1,5 +1,10 @@
 #pragma once
 
+#include "gfx/ChunkGeometryArena.hpp"
+#include "voxel/SectionVisibility.hpp"
+
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <vector>
 
@@ -19,27 +24,49 @@ struct Vertex {
     float fluidLevel;
 };
 
+struct MeshYBounds {
+    float minY = 0.0f;
+    float maxY = -1.0f;
+
+    bool empty() const {
+        return maxY < minY;
+    }
+    void include(float lo, float hi) {
+        if (empty()) {
+            minY = lo;
+            maxY = hi;
+            return;
+        }
+        minY = std::min(minY, lo);
+        maxY = std::max(maxY, hi);
+    }
+};
+
 struct CpuMesh {
     std::vector<Vertex> vertices;
     std::vector<std::uint32_t> indices;
+    // Vertical extent of the geometry. Each section holds the quads whose lowest
+    // corner falls in its 16-block slice of the column.
+    MeshYBounds bounds;
+    std::array<MeshYBounds, voxel::kSectionsPerChunk> sectionBounds{};
 };
 
 class ChunkMesh {
   public:
-    ChunkMesh() = default;
+    explicit ChunkMesh(ChunkGeometryArena &arena);
     ~ChunkMesh();
 
     ChunkMesh(const ChunkMesh &) = delete;
     ChunkMesh &operator=(const ChunkMesh &) = delete;
 
     void upload(const CpuMesh &mesh);
-    void draw() const;
+    void uploadStaged(const StagedMesh &staged);
+    void appendTo(ChunkDrawBatch &batch) const;
+    int indexCount() const;
 
   private:
-    unsigned int vao_ = 0;
-    unsigned int vbo_ = 0;
-    unsigned int ebo_ = 0;
-    int indexCount_ = 0;
+    ChunkGeometryArena &arena_;
+    ChunkGeometryArena::SlotHandle slot_ = ChunkGeometryArena::kInvalidSlot;
 };
 
 } // namespace gfx
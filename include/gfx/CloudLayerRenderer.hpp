@@ -0,0 +1,58 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <vector>
+
+namespace gfx {
+
+// Draws the cloud layer as one instanced quad batch. Cell coverage is hashed on
+// the CPU only when the drift-relative camera cell changes; drift itself is a
+// uniform applied in the vertex shader.
+class CloudLayerRenderer {
+  public:
+    struct Settings {
+        int range = 11;
+        float cellSize = 16.0f;
+        float quadRadius = 0.5f;
+        glm::vec2 driftSpeed{0.35f, 0.12f};
+    };
+
+    CloudLayerRenderer() = default;
+    explicit CloudLayerRenderer(const Settings &settings) : settings_(settings) {}
+    ~CloudLayerRenderer();
+
+    CloudLayerRenderer(const CloudLayerRenderer &) = delete;
+    CloudLayerRenderer &operator=(const CloudLayerRenderer &) = delete;
+
+    // Camera matrices come from the shared SceneBlock uniform buffer.
+    void draw(const glm::vec3 &cameraPos, float timeSeconds, float layerY,
+              const glm::vec3 &color);
+
+    int instanceCount() const {
+        return static_cast<int>(instances_.size());
+    }
+
+  private:
+    void init();
+    void rebuild(int centerGX, int centerGZ);
+
+    Settings settings_;
+    bool ready_ = false;
+    unsigned int program_ = 0;
+    unsigned int vao_ = 0;
+    unsigned int quadVbo_ = 0;
+    unsigned int instanceVbo_ = 0;
+    int uDrift_ = -1;
+    int uLayerY_ = -1;
+    int uCellSize_ = -1;
+    int uRadius_ = -1;
+    int uColor_ = -1;
+    bool built_ = false;
+    int builtGX_ = 0;
+    int builtGZ_ = 0;
+    std::vector<glm::vec2> instances_;
+};
+
+} // namespace gfx
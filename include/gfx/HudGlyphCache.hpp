@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace gfx {
+
+// Caches stb_easy_font layouts keyed by string. Glyph quads are stored relative
+// to the text origin, so callers translate and colour them instead of
+// re-running the font rasteriser for every label every frame.
+class HudGlyphCache {
+  public:
+    struct Quad {
+        float x0 = 0.0f;
+        float y0 = 0.0f;
+        float x1 = 0.0f;
+        float y1 = 0.0f;
+    };
+
+    struct Layout {
+        std::vector<Quad> quads;
+        float width = 0.0f;
+    };
+
+    // Once the cache holds maxEntries strings it is dropped wholesale; HUD text
+    // is a small working set, so a rare full reset beats per-entry bookkeeping.
+    explicit HudGlyphCache(std::size_t maxEntries = 2048);
+
+    // The reference stays valid until the next call to layout().
+    const Layout &layout(std::string_view text);
+    float width(std::string_view text) {
+        return layout(text).width;
+    }
+
+    std::size_t size() const {
+        return layouts_.size();
+    }
+    std::uint64_t hits() const {
+        return hits_;
+    }
+    std::uint64_t misses() const {
+        return misses_;
+    }
+
+  private:
+    struct NameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view text) const {
+            return std::hash<std::string_view>{}(text);
+        }
+    };
+
+    std::size_t maxEntries_;
+    std::unordered_map<std::string, Layout, NameHash, std::equal_to<>> layouts_;
+    std::vector<char> scratch_;
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+};
+
+} // namespace gfx
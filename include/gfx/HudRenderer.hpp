@@ -4,6 +4,7 @@
 #include "game/Inventory.hpp"
 #include "game/MapSystem.hpp"
 #include "game/SmeltingSystem.hpp"
+#include "gfx/HudGlyphCache.hpp"
 #include "gfx/TextureAtlas.hpp"
 #include "voxel/Block.hpp"
 
@@ -68,28 +69,70 @@ class HudRenderer {
                               const std::function<bool(int, int)> &isChunkLoadedAt);
 
   private:
-    struct IconClipBatch {
-        std::size_t start = 0;
-        std::size_t count = 0;
-        float x = 0.0f;
-        float y = 0.0f;
-        float w = 0.0f;
-        float h = 0.0f;
+    // Retained 2D HUD. Each panel keeps the vertices it produced last time and
+    // is rebuilt only when the hash of its inputs changes; everything is drawn
+    // from one persistent vertex buffer in layer order.
+    enum Panel { kPanelHotbar, kPanelInventory, kPanelOverlay, kPanelInfo, kPanelCount };
+    enum Layer {
+        kLayerRects,
+        kLayerIcons,
+        kLayerRecipeLabels,
+        kLayerSlotLabels,
+        kLayerTooltip,
+        kLayerDragRects,
+        kLayerDragIcons,
+        kLayerCount
     };
 
+    // Solid vertices carry u < 0; textured ones sample the atlas and tint by rgba.
     struct UiVertex {
         float x;
         float y;
+        float u;
+        float v;
         float r;
         float g;
         float b;
         float a;
     };
 
+    // Scissored sub-range of a panel's icon layer (indices into that layer).
+    struct IconClipBatch {
+        std::size_t start = 0;
+        std::size_t count = 0;
+        float x = 0.0f;
+        float y = 0.0f;
+        float w = 0.0f;
+        float h = 0.0f;
+    };
+
+    // A slot a panel drew, kept so the overlay can outline and describe the
+    // hovered one without rebuilding that panel.
+    struct HoverSlot {
+        int index = -1;
+        float x = 0.0f;
+        float y = 0.0f;
+        float size = 0.0f;
+        voxel::BlockId id = voxel::AIR;
+        int count = 0;
+    };
+
+    struct PanelCache {
+        std::uint64_t key = 0;
+        bool valid = false;
+        std::array<std::vector<UiVertex>, kLayerCount> layers;
+        std::vector<IconClipBatch> iconClips;
+        std::vector<HoverSlot> hoverSlots;
+    };
+
     void init2D();
-    void initIcons();
     void initLine();
     void initCrack();
+    // Returns true (and clears the panel) when `key` differs from the cached one.
+    bool beginPanel(Panel panel, std::uint64_t key);
+    std::vector<UiVertex> &layer(Layer which) {
+        return panels_[activePanel_].layers[which];
+    }
     void drawRect(float x, float y, float w, float h, float r, float g, float b, float a);
     void drawText(float x, float y, const std::string &text, unsigned char r, unsigned char g,
                   unsigned char b, unsigned char a);
@@ -99,15 +142,17 @@ class HudRenderer {
                        const std::string &modeText, const std::string &compassText,
                        const std::string &biomeText,
                        const std::string &coordText);
-    void flushIconPass(int width, int height, const TextureAtlas &atlas,
-                       const std::vector<IconClipBatch> &iconClipBatches);
-    void drawLabelOverlay(int width, int height, float uiScale,
-                          const std::vector<app::menus::RecipeNameLabel> &recipeNameLabels,
-                          const std::vector<app::menus::SlotLabel> &slotLabels,
-                          const app::menus::TooltipState &tooltip, bool suppressTooltip);
+    void appendLabels(const std::vector<app::menus::RecipeNameLabel> &recipeNameLabels,
+                      const std::vector<app::menus::SlotLabel> &slotLabels);
+    void uploadPanels();
+    void drawPanels(int width, int height, const TextureAtlas &atlas);
+
     unsigned int uiShader_ = 0;
     unsigned int uiVao_ = 0;
     unsigned int uiVbo_ = 0;
+    int uiScreenLoc_ = -1;
+    int uiAtlasLoc_ = -1;
+    std::size_t uiCapacity_ = 0;
     bool uiReady_ = false;
 
     unsigned int lineShader_ = 0;
@@ -120,22 +165,15 @@ class HudRenderer {
     unsigned int crackVbo_ = 0;
     bool crackReady_ = false;
 
-    unsigned int iconShader_ = 0;
-    unsigned int iconVao_ = 0;
-    unsigned int iconVbo_ = 0;
-    bool iconReady_ = false;
-
-    struct IconVertex {
-        float x;
-        float y;
-        float u;
-        float v;
-        float light;
-    };
-
-    std::vector<IconVertex> iconVerts_;
-
-    std::vector<UiVertex> verts_;
+    std::array<PanelCache, kPanelCount> panels_{};
+    Panel activePanel_ = kPanelHotbar;
+    Layer activeLayer_ = kLayerRects;
+    // First panel whose vertices must be re-uploaded; kPanelCount when clean.
+    int firstDirtyPanel_ = 0;
+    std::vector<UiVertex> staging_;
+    std::vector<int> drawFirsts_;
+    std::vector<int> drawCounts_;
+    HudGlyphCache glyphs_;
 };
 
 } // namespace gfx
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+
+namespace gfx {
+
+constexpr unsigned int kSceneUniformBinding = 0;
+
+// CPU mirror of the std140 `SceneBlock` uniform block. Each vec3 is paired with
+// a trailing float so the layout matches std140 without explicit padding.
+struct SceneUniforms {
+    glm::mat4 proj{1.0f};
+    glm::mat4 view{1.0f};
+    glm::vec3 skyTint{1.0f};
+    float daylight = 1.0f;
+    glm::vec3 celestialDir{0.0f, 1.0f, 0.0f};
+    float celestialStrength = 0.0f;
+    glm::vec3 fogColor{1.0f};
+    float fogNear = 1000000.0f;
+    glm::vec3 playerPos{0.0f};
+    float fogFar = 1000001.0f;
+    float cloudShadowEnabled = 0.0f;
+    float cloudShadowTime = 0.0f;
+    float cloudShadowStrength = 0.0f;
+    float cloudShadowDay = 0.0f;
+    float cloudLayerY = 0.0f;
+    float cloudShadowRange = 0.0f;
+    float time = 0.0f;
+    float padding = 0.0f;
+};
+static_assert(offsetof(SceneUniforms, skyTint) == 128);
+static_assert(offsetof(SceneUniforms, cloudShadowEnabled) == 192);
+static_assert(sizeof(SceneUniforms) == 224);
+
+// GLSL declaration of SceneBlock for inline shaders. shaders/chunk.* carry the
+// same block verbatim.
+inline constexpr const char *kSceneUniformBlockGlsl = R"(
+layout(std140) uniform SceneBlock {
+  mat4 uProj;
+  mat4 uView;
+  vec3 uSkyTint;
+  float uDaylight;
+  vec3 uCelestialDir;
+  float uCelestialStrength;
+  vec3 uFogColor;
+  float uFogNear;
+  vec3 uPlayerPos;
+  float uFogFar;
+  float uCloudShadowEnabled;
+  float uCloudShadowTime;
+  float uCloudShadowStrength;
+  float uCloudShadowDay;
+  float uCloudLayerY;
+  float uCloudShadowRange;
+  float uSceneTime;
+  float uScenePadding;
+};
+)";
+
+// Points a program's SceneBlock (if it declares one) at kSceneUniformBinding.
+void bindSceneUniformBlock(unsigned int program);
+
+// One uniform buffer holding SceneUniforms, written once per frame and bound to
+// kSceneUniformBinding for every program that declares SceneBlock.
+class SceneUniformBuffer {
+  public:
+    SceneUniformBuffer() = default;
+    ~SceneUniformBuffer();
+
+    SceneUniformBuffer(const SceneUniformBuffer &) = delete;
+    SceneUniformBuffer &operator=(const SceneUniformBuffer &) = delete;
+
+    void update(const SceneUniforms &values);
+
+  private:
+    unsigned int ubo_ = 0;
+};
+
+} // namespace gfx
@@ -2,7 +2,10 @@
 
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace gfx {
 
@@ -15,13 +18,33 @@ class Shader {
     Shader &operator=(const Shader &) = delete;
 
     void use() const;
+
+    // Locations are resolved once at link time; -1 for names the program does
+    // not use (GL ignores sets to -1).
+    int uniformLocation(std::string_view name) const;
+
+    void setInt(int location, int value) const;
+    void setFloat(int location, float value) const;
+    void setVec3(int location, const glm::vec3 &v) const;
+    void setMat4(int location, const glm::mat4 &m) const;
+
     void setInt(const char *name, int value) const;
     void setFloat(const char *name, float value) const;
     void setVec3(const char *name, const glm::vec3 &v) const;
     void setMat4(const char *name, const glm::mat4 &m) const;
 
   private:
+    struct NameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    void cacheUniformLocations();
+
     unsigned int program_ = 0;
+    std::unordered_map<std::string, int, NameHash, std::equal_to<>> locations_;
 };
 
 } // namespace gfx
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
 
 namespace gfx {
@@ -11,9 +10,10 @@ class SkyBodyRenderer {
 
     ~SkyBodyRenderer();
 
-    void draw(const glm::mat4 &proj, const glm::mat4 &view, const glm::vec3 &center,
-              const glm::vec3 &camRight, const glm::vec3 &camUp, float radius,
-              const glm::vec3 &color, float glow, BodyType type, float phase01 = 0.0f);
+    // Camera matrices come from the shared SceneBlock uniform buffer.
+    void draw(const glm::vec3 &center, const glm::vec3 &camRight, const glm::vec3 &camUp,
+              float radius, const glm::vec3 &color, float glow, BodyType type,
+              float phase01 = 0.0f);
 
   private:
     void init();
@@ -22,6 +22,14 @@ class SkyBodyRenderer {
     unsigned int program_ = 0;
     unsigned int vao_ = 0;
     unsigned int vbo_ = 0;
+    int uCenter_ = -1;
+    int uRight_ = -1;
+    int uUp_ = -1;
+    int uRadius_ = -1;
+    int uColor_ = -1;
+    int uGlow_ = -1;
+    int uBodyType_ = -1;
+    int uPhase01_ = -1;
 };
 
 } // namespace gfx
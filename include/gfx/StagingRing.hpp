@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+namespace gfx {
+
+// Upload ring for streaming geometry into device-local buffers, backed by a
+// persistently mapped buffer when GL_ARB_buffer_storage is available. Without
+// it the ring stays empty and callers upload directly. Regions are reserved in
+// ring order and reclaimed in that order once the fence of the frame that
+// released them signals, so the ring never overwrites bytes a pending copy
+// still reads.
+class StagingRing {
+  public:
+    struct Region {
+        std::uint32_t offset = 0;
+        std::uint32_t size = 0;
+    };
+
+    explicit StagingRing(std::uint32_t capacityBytes = 16u << 20);
+    ~StagingRing();
+
+    StagingRing(const StagingRing &) = delete;
+    StagingRing &operator=(const StagingRing &) = delete;
+
+    // Reserves space for a later write, which any thread may make through
+    // data() until the region is released. nullopt without persistent mapping
+    // or when the request does not fit until older frames retire.
+    std::optional<Region> reserve(std::uint32_t bytes);
+    // Hands a reserved region back once the copies that read it are issued.
+    void release(const Region &region);
+    // Reserves, fills and releases a region in one step.
+    std::optional<Region> write(const void *data, std::uint32_t bytes);
+    // Fences everything released since the previous call. Call once per frame
+    // after the copies that read this frame's regions have been issued.
+    void endFrame();
+
+    unsigned char *data(const Region &region) const {
+        return mapped_ + region.offset;
+    }
+
+    unsigned int buffer() const {
+        return buffer_;
+    }
+    std::uint32_t capacity() const {
+        return capacity_;
+    }
+    bool persistent() const {
+        return mapped_ != nullptr;
+    }
+
+  private:
+    struct Span {
+        std::uint32_t offset = 0;
+        std::uint32_t bytes = 0;
+        // Frame whose fence covers the last read; 0 until released.
+        std::uint64_t frame = 0;
+        bool released = false;
+    };
+    struct FrameFence {
+        std::uint64_t frame = 0;
+        void *sync = nullptr;
+    };
+
+    void init();
+    void retire();
+
+    unsigned int buffer_ = 0;
+    bool ready_ = false;
+    unsigned char *mapped_ = nullptr;
+    std::uint32_t capacity_ = 0;
+    std::uint32_t head_ = 0;
+    std::uint32_t used_ = 0;
+    std::uint64_t frame_ = 1;
+    std::uint64_t completedFrame_ = 0;
+    bool releasedThisFrame_ = false;
+    std::deque<Span> spans_;
+    std::deque<FrameFence> fences_;
+};
+
+} // namespace gfx
@@ -37,13 +37,14 @@ class Chunk {
         return blocks_;
     }
 
-    bool dirty = true;
-
-  private:
+    // Position of a cell in data().
     static int index(int x, int y, int z) {
         return x + SX * (z + SZ * y);
     }
 
+    bool dirty = true;
+
+  private:
     std::vector<BlockId> blocks_;
 };
 
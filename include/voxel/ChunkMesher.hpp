@@ -4,8 +4,10 @@
 #include "gfx/TextureAtlas.hpp"
 #include "voxel/Block.hpp"
 #include "voxel/Chunk.hpp"
+#include "voxel/SectionVisibility.hpp"
 
 #include <glm/vec2.hpp>
+#include <array>
 #include <cstddef>
 #include <functional>
 
@@ -40,6 +42,11 @@ class ChunkMesher {
                                             &fluidLevelLookup = {},
                                         std::size_t reserveVertices = 0,
                                         std::size_t reserveIndices = 0);
+
+    // Flood-fills the non-opaque voxels of every section and records which
+    // faces each connected region touches.
+    static std::array<SectionVisibility, kSectionsPerChunk>
+    buildSectionVisibility(const Chunk &chunk, const BlockRegistry &registry);
 };
 
 } // namespace voxel
@@ -1,9 +1,18 @@
 #pragma once
 
+#include "voxel/Block.hpp"
+#include "voxel/Chunk.hpp"
+
+#include <glm/geometric.hpp>
 #include <glm/vec3.hpp>
 
+#include <cmath>
 #include <functional>
+#include <limits>
+#include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace world {
 class World;
@@ -17,13 +26,166 @@ struct RayHit {
     float t = 0.0f;
 };
 
+struct Ray {
+    glm::vec3 origin{0.0f};
+    glm::vec3 dir{0.0f, 0.0f, 1.0f};
+    float maxDist = 0.0f;
+};
+
+// Reads blocks through the chunk the previous read fell in. The source is
+// asked for a chunk (shared_ptr<const Chunk>, null when not loaded) only when
+// a read crosses into another column, so a ray or a batch of nearby rays
+// costs one lookup per column instead of one per cell.
+template <typename ChunkSource> class ChunkCursor {
+  public:
+    explicit ChunkCursor(ChunkSource source) : source_(std::move(source)) {}
+
+    BlockId get(int x, int y, int z) {
+        if (y < 0 || y >= Chunk::SY) {
+            return AIR;
+        }
+        const int cx = floorDiv(x, Chunk::SX);
+        const int cz = floorDiv(z, Chunk::SZ);
+        if (!resolved_ || cx != cx_ || cz != cz_) {
+            chunk_ = source_(cx, cz);
+            cx_ = cx;
+            cz_ = cz;
+            resolved_ = true;
+            ++lookups_;
+        }
+        if (!chunk_) {
+            return AIR;
+        }
+        return chunk_->getUnchecked(x - cx * Chunk::SX, y, z - cz * Chunk::SZ);
+    }
+
+    int lookups() const {
+        return lookups_;
+    }
+
+  private:
+    static int floorDiv(int v, int d) {
+        return (v >= 0) ? (v / d) : ((v - d + 1) / d);
+    }
+
+    ChunkSource source_;
+    std::shared_ptr<const Chunk> chunk_{};
+    int cx_ = 0;
+    int cz_ = 0;
+    bool resolved_ = false;
+    int lookups_ = 0;
+};
+
+// Chunk source backed by World::chunkAt.
+struct WorldChunkSource {
+    const world::World *world = nullptr;
+    std::shared_ptr<const Chunk> operator()(int cx, int cz) const;
+};
+
 class Raycaster {
   public:
+    // Amanatides-Woo voxel traversal. isSolid(x, y, z) is called for each
+    // cell in ray order and is inlined, unlike the std::function overload.
+    template <typename IsSolid>
+    static std::optional<RayHit> traverse(const glm::vec3 &origin, const glm::vec3 &dir,
+                                          float maxDist, IsSolid &&isSolid);
+
     static std::optional<RayHit> cast(const glm::vec3 &origin, const glm::vec3 &dir, float maxDist,
                                       const std::function<bool(int, int, int)> &isSolid);
 
+    // Hits the first block World::isTargetBlockId accepts.
     static std::optional<RayHit> cast(const world::World &world, const glm::vec3 &origin,
                                       const glm::vec3 &dir, float maxDist);
+
+    // Hits the first block id isSolidId accepts, reading through the cursor.
+    template <typename ChunkSource, typename IsSolidId>
+    static std::optional<RayHit> cast(ChunkCursor<ChunkSource> &cursor, const glm::vec3 &origin,
+                                      const glm::vec3 &dir, float maxDist, IsSolidId &&isSolidId) {
+        return traverse(origin, dir, maxDist,
+                        [&](int x, int y, int z) { return isSolidId(cursor.get(x, y, z)); });
+    }
+
+    // Casts a batch through one cursor; rays starting near each other share
+    // chunk lookups. Results are in ray order.
+    template <typename ChunkSource, typename IsSolidId>
+    static std::vector<std::optional<RayHit>> castMany(ChunkCursor<ChunkSource> &cursor,
+                                                       const std::vector<Ray> &rays,
+                                                       IsSolidId &&isSolidId) {
+        std::vector<std::optional<RayHit>> hits;
+        hits.reserve(rays.size());
+        for (const Ray &ray : rays) {
+            hits.push_back(cast(cursor, ray.origin, ray.dir, ray.maxDist, isSolidId));
+        }
+        return hits;
+    }
+
+    static std::vector<std::optional<RayHit>> castMany(const world::World &world,
+                                                       const std::vector<Ray> &rays);
 };
 
+template <typename IsSolid>
+std::optional<RayHit> Raycaster::traverse(const glm::vec3 &origin, const glm::vec3 &dir,
+                                          float maxDist, IsSolid &&isSolid) {
+    const glm::vec3 d = glm::normalize(dir);
+
+    int x = static_cast<int>(std::floor(origin.x));
+    int y = static_cast<int>(std::floor(origin.y));
+    int z = static_cast<int>(std::floor(origin.z));
+
+    const int stepX = (d.x > 0.0f) ? 1 : (d.x < 0.0f ? -1 : 0);
+    const int stepY = (d.y > 0.0f) ? 1 : (d.y < 0.0f ? -1 : 0);
+    const int stepZ = (d.z > 0.0f) ? 1 : (d.z < 0.0f ? -1 : 0);
+
+    auto tDelta = [](float v) {
+        if (v == 0.0f) {
+            return std::numeric_limits<float>::infinity();
+        }
+        return std::abs(1.0f / v);
+    };
+
+    const float tDeltaX = tDelta(d.x);
+    const float tDeltaY = tDelta(d.y);
+    const float tDeltaZ = tDelta(d.z);
+
+    auto tMaxAxis = [](float o, float v, int voxel, int step) {
+        if (step == 0) {
+            return std::numeric_limits<float>::infinity();
+        }
+        const float nextBoundary = static_cast<float>(voxel + (step > 0 ? 1 : 0));
+        return (nextBoundary - o) / v;
+    };
+
+    float tMaxX = tMaxAxis(origin.x, d.x, x, stepX);
+    float tMaxY = tMaxAxis(origin.y, d.y, y, stepY);
+    float tMaxZ = tMaxAxis(origin.z, d.z, z, stepZ);
+
+    glm::ivec3 lastNormal(0);
+    float t = 0.0f;
+
+    while (t <= maxDist) {
+        if (isSolid(x, y, z)) {
+            return RayHit{glm::ivec3(x, y, z), lastNormal, t};
+        }
+
+        if (tMaxX < tMaxY && tMaxX < tMaxZ) {
+            x += stepX;
+            t = tMaxX;
+            tMaxX += tDeltaX;
+            lastNormal = glm::ivec3(-stepX, 0, 0);
+        } else if (tMaxY < tMaxZ) {
+            y += stepY;
+            t = tMaxY;
+            tMaxY += tDeltaY;
+            lastNormal = glm::ivec3(0, -stepY, 0);
+        } else {
+            z += stepZ;
+            t = tMaxZ;
+            tMaxZ += tDeltaZ;
+            lastNormal = glm::ivec3(0, 0, -stepZ);
+        }
+    }
+
+    return std::nullopt;
+}
+
 } // namespace voxel
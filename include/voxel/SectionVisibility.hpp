@@ -0,0 +1,60 @@
+#pragma once
+
+#include "voxel/Chunk.hpp"
+
+#include <cstdint>
+
+namespace voxel {
+
+constexpr int kSectionSize = 16;
+constexpr int kSectionsPerChunk = Chunk::SY / kSectionSize;
+
+// Faces of a 16^3 section, ordered so that the opposite face is `face ^ 1`.
+enum SectionFace : int {
+    FACE_NEG_X = 0,
+    FACE_POS_X = 1,
+    FACE_NEG_Y = 2,
+    FACE_POS_Y = 3,
+    FACE_NEG_Z = 4,
+    FACE_POS_Z = 5,
+    SECTION_FACE_COUNT = 6,
+};
+
+constexpr int oppositeFace(int face) {
+    return face ^ 1;
+}
+
+// Which pairs of section faces can see each other through non-opaque voxels.
+// Defaults to fully connected so unknown sections never hide anything.
+class SectionVisibility {
+  public:
+    SectionVisibility() {
+        connectAll();
+    }
+
+    static SectionVisibility none() {
+        SectionVisibility v;
+        v.bits_ = 0;
+        return v;
+    }
+
+    bool connected(int a, int b) const {
+        return (bits_ >> bit(a, b)) & 1u;
+    }
+    void connect(int a, int b) {
+        bits_ |= (1ull << bit(a, b)) | (1ull << bit(b, a));
+    }
+    void connectAll() {
+        bits_ = (1ull << (SECTION_FACE_COUNT * SECTION_FACE_COUNT)) - 1ull;
+    }
+    bool operator==(const SectionVisibility &) const = default;
+
+  private:
+    static int bit(int a, int b) {
+        return a * SECTION_FACE_COUNT + b;
+    }
+
+    std::uint64_t bits_ = 0;
+};
+
+} // namespace voxel
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "world/ChunkCoord.hpp"
+#include "world/Frustum.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+
+namespace world {
+
+// Sparse quadtree over chunk columns. Level 0 nodes are single columns; each
+// level above covers a 2x2 block of the level below. Nodes carry the union of
+// their children's vertical bounds so whole regions can be rejected at once.
+class ChunkColumnTree {
+  public:
+    static constexpr int kLevels = 5;
+
+    struct QueryStats {
+        int visited = 0;
+        int culled = 0;
+    };
+
+    void insert(ChunkCoord cc, float minY, float maxY);
+    void erase(ChunkCoord cc);
+    void clear();
+    std::size_t size() const {
+        return levels_[0].size();
+    }
+
+    // Visits every column whose box intersects the frustum and whose centre is
+    // within maxDist (XZ) of the camera. Cost scales with the visible set.
+    void query(const FrustumPlanes &frustum, const glm::vec3 &cameraPos, float maxDist,
+               const std::function<void(ChunkCoord, float, float)> &visit,
+               QueryStats &stats) const;
+
+  private:
+    struct Node {
+        int count = 0;
+        float minY = 0.0f;
+        float maxY = 0.0f;
+    };
+    using Level = std::unordered_map<ChunkCoord, Node, ChunkCoordHash>;
+
+    void refreshParents(ChunkCoord leaf);
+    void queryNode(int level, ChunkCoord key, const Node &node, const FrustumPlanes &frustum,
+                   const glm::vec3 &cameraPos, float maxDist,
+                   const std::function<void(ChunkCoord, float, float)> &visit,
+                   QueryStats &stats) const;
+
+    std::array<Level, kLevels> levels_;
+};
+
+} // namespace world
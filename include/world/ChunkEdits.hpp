@@ -0,0 +1,27 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace world {
+
+// Cells of a chunk that may differ from generated terrain, as ascending
+// indices into voxel::Chunk::data(). Tracked from load time so a delta save
+// writes them directly instead of regenerating the terrain to diff.
+struct ChunkEdits {
+    std::vector<std::uint16_t> cells;
+    // False when the blocks came from a full-format file and were never
+    // diffed against generated terrain; such chunks are saved in full.
+    bool overGenerated = true;
+
+    void add(int index) {
+        const auto cell = static_cast<std::uint16_t>(index);
+        const auto it = std::lower_bound(cells.begin(), cells.end(), cell);
+        if (it == cells.end() || *it != cell) {
+            cells.insert(it, cell);
+        }
+    }
+};
+
+} // namespace world
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <array>
+
+namespace world {
+
+struct FrustumPlane {
+    glm::vec3 n{0.0f};
+    float d = 0.0f;
+};
+
+struct FrustumPlanes {
+    std::array<FrustumPlane, 6> p{};
+};
+
+FrustumPlanes extractFrustumPlanes(const glm::mat4 &viewProj);
+bool sphereInFrustum(const FrustumPlanes &frustum, const glm::vec3 &center, float radius);
+// Conservative box test: rejects only when the box is fully behind one plane.
+bool aabbInFrustum(const FrustumPlanes &frustum, const glm::vec3 &minCorner,
+                   const glm::vec3 &maxCorner);
+
+} // namespace world
@@ -9,6 +9,7 @@ namespace world {
 struct FurnaceSlotState {
     voxel::BlockId id = voxel::AIR;
     int count = 0;
+    bool operator==(const FurnaceSlotState &) const = default;
 };
 
 struct FurnaceState {
@@ -18,6 +19,7 @@ struct FurnaceState {
     float progressSeconds = 0.0f;
     float burnSecondsRemaining = 0.0f;
     float burnSecondsCapacity = 0.0f;
+    bool operator==(const FurnaceState &) const = default;
 };
 
 struct FurnaceRecordLocal {
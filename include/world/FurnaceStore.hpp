@@ -0,0 +1,86 @@
+#pragma once
+
+#include "world/ChunkCoord.hpp"
+#include "world/FurnaceState.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace world {
+
+// Furnace states keyed by block position, stored densely so ticking walks a
+// flat array. Slots [0, awakeCount()) are awake; the rest sleep until put()
+// changes their state. Furnaces are also indexed by chunk so unloading a
+// chunk drops exactly its own. Not thread-safe: World guards it with its
+// chunk lock.
+class FurnaceStore {
+  public:
+    struct Key {
+        int x = 0;
+        int y = 0;
+        int z = 0;
+        bool operator==(const Key &other) const {
+            return x == other.x && y == other.y && z == other.z;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key &k) const {
+            std::size_t h = static_cast<std::size_t>(static_cast<std::uint32_t>(k.x));
+            h = (h * 1315423911u) ^ static_cast<std::size_t>(static_cast<std::uint32_t>(k.y));
+            h = (h * 2654435761u) ^ static_cast<std::size_t>(static_cast<std::uint32_t>(k.z));
+            return h;
+        }
+    };
+
+    struct Record {
+        Key key{};
+        FurnaceState state{};
+    };
+
+    const FurnaceState *find(const Key &key) const;
+    // Adds an awake furnace, or updates one and wakes it. An unchanged state
+    // cannot make progress, so a sleeping furnace keeps sleeping.
+    void put(const Key &key, const FurnaceState &state);
+    // Returns false when there was no furnace at key.
+    bool erase(const Key &key);
+    // Drops every furnace in the chunk.
+    void eraseChunk(ChunkCoord cc);
+    // Positions of the furnaces in the chunk, or null when it has none.
+    const std::unordered_set<Key, KeyHash> *chunkKeys(ChunkCoord cc) const;
+
+    // Slot access for ticking. sleep() moves the slot's record to the end of
+    // the awake range, so the caller must not advance past it.
+    Record &at(std::size_t slot) {
+        return records_[slot];
+    }
+    const Record &at(std::size_t slot) const {
+        return records_[slot];
+    }
+    void wake(std::size_t slot);
+    void sleep(std::size_t slot);
+
+    std::size_t size() const {
+        return records_.size();
+    }
+    std::size_t awakeCount() const {
+        return awake_;
+    }
+    // Slot currently holding key, or size() when absent.
+    std::size_t slotOf(const Key &key) const;
+
+    static ChunkCoord chunkOf(const Key &key);
+
+  private:
+    void swapSlots(std::size_t a, std::size_t b);
+
+    std::vector<Record> records_;
+    std::size_t awake_ = 0;
+    std::unordered_map<Key, std::size_t, KeyHash> slots_;
+    std::unordered_map<ChunkCoord, std::unordered_set<Key, KeyHash>, ChunkCoordHash> byChunk_;
+};
+
+} // namespace world
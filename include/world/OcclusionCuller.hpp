@@ -0,0 +1,55 @@
+#pragma once
+
+#include "voxel/SectionVisibility.hpp"
+#include "world/ChunkCoord.hpp"
+#include "world/Frustum.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+namespace world {
+
+// Breadth-first walk over 16^3 sections starting at the camera. A section is
+// only entered through a face its neighbour can see out of, never by turning
+// back toward the camera, and only while it stays inside the frustum and draw
+// distance. Columns reached by the walk are the potentially visible set.
+class OcclusionCuller {
+  public:
+    // Returns nullptr for sections whose connectivity is unknown; those are
+    // treated as fully open.
+    using Lookup = std::function<const voxel::SectionVisibility *(ChunkCoord, int section)>;
+
+    // False when the camera is outside the column's vertical range, in which
+    // case the caller should skip occlusion culling for this frame.
+    bool compute(const glm::vec3 &cameraPos, const FrustumPlanes &frustum, float maxDist,
+                 const Lookup &lookup);
+
+    bool isColumnVisible(ChunkCoord cc) const {
+        return visibleColumns_.count(cc) > 0;
+    }
+    const std::unordered_set<ChunkCoord, ChunkCoordHash> &visibleColumns() const {
+        return visibleColumns_;
+    }
+    int visitedSections() const {
+        return visitedSections_;
+    }
+
+  private:
+    struct Step {
+        ChunkCoord cc;
+        int section = 0;
+        int enteredFrom = -1;
+        unsigned int directions = 0;
+    };
+
+    std::unordered_set<ChunkCoord, ChunkCoordHash> visibleColumns_;
+    std::unordered_set<std::uint64_t> visited_;
+    std::vector<Step> queue_;
+    int visitedSections_ = 0;
+};
+
+} // namespace world
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "voxel/Block.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace world {
+
+inline constexpr int kWaterMaxFlowLevel = 7;
+inline constexpr int kLavaMaxFlowLevel = 4;
+
+// A box of cells copied out of the world under one lock: block ids, whether
+// each blocks movement, and fluid levels. Movement and fluid queries then run
+// against the copy; cells outside the box read as unloaded air.
+class VoxelWindow {
+  public:
+    // Covers [minCell, maxCell] inclusive, every cell air.
+    void reset(const glm::ivec3 &minCell, const glm::ivec3 &maxCell);
+    bool contains(const glm::ivec3 &minCell, const glm::ivec3 &maxCell) const;
+    const glm::ivec3 &minCell() const {
+        return min_;
+    }
+    const glm::ivec3 &maxCell() const {
+        return max_;
+    }
+
+    // fluidLevel is the cell's flow level (0 = source), or -1 for non-fluid.
+    void set(int x, int y, int z, voxel::BlockId id, bool solid, int fluidLevel);
+    voxel::BlockId block(int x, int y, int z) const;
+    bool solid(int x, int y, int z) const;
+    int fluidLevel(int x, int y, int z) const;
+
+    // Whether the box [aabbMin, aabbMax) overlaps a solid cell.
+    bool intersectsSolid(const glm::vec3 &aabbMin, const glm::vec3 &aabbMax) const;
+    // How far the box can move along axis (0..2) toward amount before touching
+    // a solid cell; the box must not already overlap one. Checks every cell
+    // column the sweep enters, so fast moves cannot tunnel.
+    float sweep(const glm::vec3 &aabbMin, const glm::vec3 &aabbMax, int axis, float amount) const;
+    // Push a flowing fluid applies at pos, as World::fluidCurrentAt.
+    glm::vec3 fluidCurrentAt(const glm::vec3 &pos) const;
+
+  private:
+    static constexpr std::uint8_t kSolidFlag = 1;
+
+    int index(int x, int y, int z) const;
+
+    glm::ivec3 min_{0};
+    glm::ivec3 max_{-1};
+    glm::ivec3 size_{0};
+    std::vector<voxel::BlockId> blocks_{};
+    std::vector<std::uint8_t> flags_{};
+    std::vector<std::int8_t> fluidLevels_{};
+};
+
+} // namespace world
@@ -2,29 +2,40 @@
 
 #include "core/ThreadQueue.hpp"
 #include "core/TickCounter.hpp"
+#include "gfx/ChunkGeometryArena.hpp"
 #include "gfx/ChunkMesh.hpp"
 #include "gfx/TextureAtlas.hpp"
 #include "voxel/Block.hpp"
 #include "voxel/Chunk.hpp"
+#include "voxel/SectionVisibility.hpp"
+#include "world/ChunkColumnTree.hpp"
 #include "world/ChunkCoord.hpp"
+#include "world/ChunkEdits.hpp"
+#include "world/OcclusionCuller.hpp"
+#include "world/VoxelWindow.hpp"
 #include "world/FurnaceState.hpp"
+#include "world/FurnaceStore.hpp"
 #include "world/WorldGen.hpp"
 
 #include <glm/vec3.hpp>
 #include <glm/mat4x4.hpp>
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <limits>
+#include <optional>
 #include <thread>
 #include <deque>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace world {
@@ -35,6 +46,13 @@ struct WorldDebugStats {
     int pendingLoad = 0;
     int pendingRemesh = 0;
     int totalTriangles = 0;
+    int drawnChunks = 0;
+    int culledChunks = 0;
+    int occludedChunks = 0;
+    // Wall time from opening the world to the end of preloadSpawnArea, or 0
+    // before a preload has finished.
+    float timeToFirstPlayableMs = 0.0f;
+    int preloadedChunks = 0;
 };
 
 class World {
@@ -44,23 +62,8 @@ class World {
         int count = 0;
         glm::vec3 pos{0.0f};
     };
-    struct FurnaceCoordKey {
-        int x = 0;
-        int y = 0;
-        int z = 0;
-        bool operator==(const FurnaceCoordKey &other) const {
-            return x == other.x && y == other.y && z == other.z;
-        }
-    };
-
-    struct FurnaceCoordKeyHash {
-        std::size_t operator()(const FurnaceCoordKey &k) const {
-            std::size_t h = static_cast<std::size_t>(static_cast<std::uint32_t>(k.x));
-            h = (h * 1315423911u) ^ static_cast<std::size_t>(static_cast<std::uint32_t>(k.y));
-            h = (h * 2654435761u) ^ static_cast<std::size_t>(static_cast<std::uint32_t>(k.z));
-            return h;
-        }
-    };
+    using FurnaceCoordKey = FurnaceStore::Key;
+    using FurnaceCoordKeyHash = FurnaceStore::KeyHash;
 
     World(const gfx::TextureAtlas &atlas, std::filesystem::path saveRoot,
           std::uint32_t seed = 1337u);
@@ -69,33 +72,85 @@ class World {
     World(const World &) = delete;
     World &operator=(const World &) = delete;
 
+    // Called on the preloading thread about once a frame, with the chunks
+    // loaded and meshed so far and the number expected.
+    using PreloadProgress = std::function<void(int done, int total)>;
+
+    // Loads or generates every chunk within radius chunks of pos, plus the
+    // ring their edges need, on as many threads as the worker pool; meshes
+    // each inner chunk once with all neighbours present; uploads the meshes
+    // in one batch. Run it on the GL thread before streaming starts. With
+    // onProgress the calling thread only waits on the pool, reporting
+    // progress so the caller can pump events and draw a loading frame;
+    // without, it blocks and helps. Returns the number of chunks meshed.
+    int preloadSpawnArea(const glm::vec3 &pos, int radius,
+                         const PreloadProgress &onProgress = {});
     void updateStream(const glm::vec3 &playerPos, const glm::vec3 &cameraForward);
     void updateFluidSimulation(float dt);
     void uploadReadyMeshes();
-    void draw(const glm::vec3 &cameraPos, float maxDrawDistance, const glm::mat4 &viewProj) const;
-    void drawTransparent(const glm::vec3 &cameraPos, const glm::vec3 &cameraForward,
-                         float maxDrawDistance, const glm::mat4 &viewProj) const;
+    // Culls and orders chunks once per frame; call after uploadReadyMeshes and
+    // before any draw pass. Every pass then reuses the same lists.
+    void prepareDrawLists(const glm::vec3 &cameraPos, const glm::vec3 &cameraForward,
+                          float maxDrawDistance, const glm::mat4 &viewProj) const;
+    void draw() const;
+    void drawTransparent() const;
 
     bool isSolidBlock(int wx, int wy, int wz) const;
+    bool isSolidBlockId(voxel::BlockId id) const;
     bool isTargetBlock(int wx, int wy, int wz) const;
+    bool isTargetBlockId(voxel::BlockId id) const;
     bool isChunkLoadedAt(int wx, int wz) const;
     glm::vec3 fluidCurrentAt(const glm::vec3 &pos) const;
+    // Copies blocks, solidity and fluid levels of [minCell, maxCell] under a
+    // single lock, resolving each chunk once per column.
+    void gatherVoxelWindow(const glm::ivec3 &minCell, const glm::ivec3 &maxCell,
+                           VoxelWindow &out) const;
     std::string biomeLabelAt(int wx, int wz) const;
     voxel::BlockId getBlock(int wx, int wy, int wz) const;
     bool setBlock(int wx, int wy, int wz, voxel::BlockId id);
     bool getFurnaceState(int wx, int wy, int wz, FurnaceState &out) const;
     void setFurnaceState(int wx, int wy, int wz, const FurnaceState &state);
     void clearFurnaceState(int wx, int wy, int wz);
-    std::vector<glm::ivec3> loadedFurnacePositions() const;
+    // Advances every awake furnace in loaded chunks by one tick, in a single
+    // pass under the world lock. A furnace that step leaves unchanged cannot
+    // make progress and sleeps until setFurnaceState changes it; an emptied
+    // one is dropped. Lit and unlit blocks are swapped after the pass.
+    // Returns the number of furnaces stepped.
+    int tickFurnaces(const std::function<void(FurnaceState &)> &step);
+    std::size_t furnaceCount() const;
+    std::size_t awakeFurnaceCount() const;
 
     void setStreamingRadii(int loadRadius, int unloadRadius);
     void setSmoothLighting(bool enabled);
+    // Delta saves store only the blocks changed since a chunk was generated,
+    // and chunks with none take no file; otherwise (the default) every block.
+    // Chunks already saved in full stay full unless migration is also on, in
+    // which case each is diffed once as it loads and rewritten as a delta.
+    // VOXEL_DELTA_CHUNK_SAVES and VOXEL_MIGRATE_FULL_CHUNKS set both at startup.
+    void setDeltaChunkSaves(bool enabled);
+    void setMigrateFullChunks(bool enabled);
     std::vector<FluidDrop> consumeFluidDrops();
     WorldDebugStats debugStats() const;
+    // Bumped whenever loaded chunk contents change.
+    std::uint64_t revision() const {
+        return worldRevision_.load(std::memory_order_relaxed);
+    }
     std::vector<ChunkCoord> loadedChunkCoords() const;
+    // Loaded chunks with the world revision of their last block change.
+    std::vector<std::pair<ChunkCoord, std::uint64_t>> loadedChunkRevisions() const;
+    // World revision of a loaded chunk's last block change, or 0 when unloaded.
+    std::uint64_t chunkRevision(ChunkCoord cc) const;
+    // Copies a loaded chunk's blocks so callers can read them without holding
+    // the world lock. Returns false when the chunk is not loaded.
+    bool copyChunk(ChunkCoord cc, voxel::Chunk &out, std::uint64_t &outRevision) const;
+    // Shares a loaded chunk, or null. Blocks are edited in place by the frame
+    // loop and by fluid and furnace ticks on the simulation thread, both under
+    // simLock, so callers may read it without the world lock only while they
+    // hold simLock too (raycasts do).
+    std::shared_ptr<const voxel::Chunk> chunkAt(ChunkCoord cc) const;
 
   private:
-    enum class JobType { LoadOrGenerate, Remesh };
+    enum class JobType { LoadOrGenerate, Remesh, Save };
     struct FluidCoord {
         int x = 0;
         int y = 0;
@@ -138,12 +193,33 @@ class World {
         std::shared_ptr<voxel::Chunk> chunk;
         std::unique_ptr<gfx::CpuMesh> mesh;
         bool replaceChunk = false;
+        // Set when the worker also wrote mesh into a staging slab.
+        std::optional<gfx::StagedMesh> staged{};
+        std::array<voxel::SectionVisibility, voxel::kSectionsPerChunk> visibility{};
+        ChunkEdits edits{};
+    };
+
+    // An unloaded chunk waiting for a worker to write it.
+    struct PendingSave {
+        std::shared_ptr<const voxel::Chunk> chunk;
+        std::vector<world::FurnaceRecordLocal> furnaces;
+        ChunkEdits edits;
+        bool writing = false;
     };
 
     struct ChunkEntry {
         std::shared_ptr<voxel::Chunk> chunk;
         std::unique_ptr<gfx::ChunkMesh> mesh;
         int triangleCount = 0;
+        std::array<gfx::MeshYBounds, voxel::kSectionsPerChunk> sectionBounds{};
+        std::array<voxel::SectionVisibility, voxel::kSectionsPerChunk> visibility{};
+        // worldRevision_ value at the last change to this chunk's blocks.
+        std::uint64_t contentRevision = 0;
+        // contentRevision when the blocks last matched the save file or, with
+        // no file, generated terrain.
+        std::uint64_t savedRevision = 0;
+        // Cells changed since the chunk was generated, kept for delta saves.
+        ChunkEdits edits;
     };
     struct TransparentDrawItem {
         const gfx::ChunkMesh *mesh = nullptr;
@@ -151,15 +227,34 @@ class World {
         float depth = 0.0f;
         float dist2 = 0.0f;
     };
+    struct TransparentSortKey {
+        int cellX = 0;
+        int cellY = 0;
+        int cellZ = 0;
+        int yaw = 0;
+        int pitch = 0;
+        bool operator==(const TransparentSortKey &) const = default;
+    };
     struct FluidState {
         std::uint8_t level = 0;
         bool source = false;
     };
 
+    void markChunkChangedLocked(ChunkEntry &entry);
+    // Marks the chunk changed after a write to the block at local (lx, y, lz).
+    void markBlockChangedLocked(ChunkEntry &entry, int lx, int y, int lz);
     void enqueueLoadIfNeeded(ChunkCoord cc);
     void enqueueRemesh(ChunkCoord cc, bool force, bool urgent = false);
+    WorkerJob makeRemeshJobLocked(ChunkCoord cc, std::shared_ptr<voxel::Chunk> chunk,
+                                  bool urgent) const;
     void scheduleWorkerJob(WorkerJob job);
     void workerLoop();
+    // Reads the saved chunk (registering its furnaces) or generates it.
+    std::shared_ptr<voxel::Chunk> loadOrGenerateChunk(ChunkCoord cc, ChunkEdits &edits);
+    WorkerResult buildMesh(const WorkerJob &job);
+    // Uploads result's mesh into entry, consuming its staging slab; returns
+    // the bytes uploaded.
+    std::size_t installMeshLocked(ChunkEntry &entry, WorkerResult &result);
     voxel::BlockId getBlockLoadedLocked(int wx, int wy, int wz) const;
     void enqueueFluidCellLocked(int wx, int wy, int wz);
     void activateFluidCellLocked(int wx, int wy, int wz);
@@ -176,11 +271,31 @@ class World {
                                     std::unordered_set<ChunkCoord, ChunkCoordHash> &remeshChunks);
     std::unique_ptr<gfx::CpuMesh> acquireMeshBuffer();
     void recycleMeshBuffer(std::unique_ptr<gfx::CpuMesh> mesh);
+    // GL thread: tops up the slabs workers stage finished meshes in.
+    void refillStagingSlabs();
+    std::optional<gfx::StagingSlab> takeStagingSlab();
+    // GL thread: releases the result's slab, if any, and recycles its mesh.
+    void recycleResult(WorkerResult &result);
+    template <typename Visit>
+    void forEachVisibleMeshLocked(const glm::vec3 &cameraPos, float maxDist,
+                                  const glm::mat4 &viewProj, Visit visit, int &drawn,
+                                  int &culled, int &occluded) const;
+    void updateTransparentOrderLocked(const glm::vec3 &cameraPos, const glm::vec3 &fwd) const;
+    std::vector<world::FurnaceRecordLocal> localFurnacesLocked(ChunkCoord cc,
+                                                              const voxel::Chunk &chunk) const;
+    // Queues an unloading chunk for writing if it changed since it loaded or
+    // holds furnaces. A worker writes it, off the world lock.
+    void saveChunkLocked(ChunkCoord cc, const ChunkEntry &entry);
+    // Writes pendingSaves_[cc], again if it is replaced meanwhile, then drops it.
+    void writePendingSave(ChunkCoord cc);
 
     static int floorDiv(int a, int b);
     static int floorMod(int a, int b);
     static ChunkCoord worldToChunk(int wx, int wz);
 
+    std::chrono::steady_clock::time_point openedAt_ = std::chrono::steady_clock::now();
+    float timeToFirstPlayableMs_ = 0.0f;
+    int preloadedChunks_ = 0;
     int loadRadius_ = 8;
     int unloadRadius_ = 10;
     std::atomic<std::int64_t> playerChunkPacked_{0};
@@ -193,7 +308,11 @@ class World {
     world::WorldGen gen_;
     std::filesystem::path saveRoot_;
 
+    // Declared before chunks_ so every ChunkMesh releases its slot first.
+    gfx::ChunkGeometryArena geometryArena_;
     std::unordered_map<ChunkCoord, ChunkEntry, ChunkCoordHash> chunks_;
+    // Meshed columns with non-empty geometry; kept in step with chunks_.
+    ChunkColumnTree columnTree_;
     mutable std::mutex chunksMutex_;
 
     core::ThreadQueue<WorkerJob> workerJobs_;
@@ -202,13 +321,21 @@ class World {
     std::unordered_set<ChunkCoord, ChunkCoordHash> pendingLoad_;
     std::unordered_set<ChunkCoord, ChunkCoordHash> pendingRemesh_;
     std::unordered_set<ChunkCoord, ChunkCoordHash> pendingRemeshDirty_;
-    std::unordered_map<FurnaceCoordKey, FurnaceState, FurnaceCoordKeyHash> furnaceStates_;
+    // Loads take these before the file, which may not be written yet.
+    std::unordered_map<ChunkCoord, PendingSave, ChunkCoordHash> pendingSaves_;
+    // Every furnace in loaded chunks, guarded by chunksMutex_.
+    FurnaceStore furnaces_;
+    std::vector<std::pair<FurnaceCoordKey, voxel::BlockId>> furnaceBlockSwaps_;
 
     std::vector<std::thread> workers_;
     std::mutex meshBufferPoolMutex_;
     std::vector<std::unique_ptr<gfx::CpuMesh>> meshBufferPool_;
+    std::mutex stagingSlabsMutex_;
+    std::vector<gfx::StagingSlab> stagingSlabs_;
     std::atomic<bool> running_ = true;
     std::atomic<bool> smoothLighting_{false};
+    std::atomic<bool> deltaChunkSaves_{false};
+    std::atomic<bool> migrateFullChunks_{false};
     std::deque<FluidCoord> waterFrontier_;
     std::deque<FluidCoord> lavaFrontier_;
     std::unordered_set<FluidCoord, FluidCoordHash> waterQueued_;
@@ -219,19 +346,22 @@ class World {
         waterStateByChunk_;
     std::unordered_map<ChunkCoord, std::unordered_set<FluidCoord, FluidCoordHash>, ChunkCoordHash>
         lavaStateByChunk_;
-    std::unordered_map<ChunkCoord, std::unordered_set<FurnaceCoordKey, FurnaceCoordKeyHash>,
-                       ChunkCoordHash>
-        furnaceStateByChunk_;
     std::vector<FluidDrop> pendingFluidDrops_;
     std::atomic<std::uint64_t> worldRevision_{1};
     std::atomic<std::uint32_t> meshReserveVertices_{8192};
     std::atomic<std::uint32_t> meshReserveIndices_{12288};
+    mutable gfx::ChunkDrawBatch opaqueBatch_;
+    mutable gfx::ChunkDrawBatch transparentBatch_;
+    mutable std::unordered_map<ChunkCoord, const gfx::ChunkMesh *, ChunkCoordHash> visibleMeshes_;
+    mutable int lastDrawnChunks_ = 0;
+    mutable int lastCulledChunks_ = 0;
+    mutable int lastOccludedChunks_ = 0;
+    mutable OcclusionCuller occlusion_;
+    mutable bool occlusionActive_ = false;
+    bool occlusionCullingEnabled_ = true;
     mutable std::vector<TransparentDrawItem> transparentDrawCache_;
-    mutable glm::vec3 transparentCachePos_{0.0f};
-    mutable glm::vec3 transparentCacheForward_{0.0f, 0.0f, -1.0f};
-    mutable float transparentCacheMaxDist_ = -1.0f;
-    mutable std::uint64_t transparentCacheRevision_ = 0;
-    mutable bool transparentCacheValid_ = false;
+    mutable TransparentSortKey transparentSortKey_{};
+    mutable bool transparentSortValid_ = false;
     core::TickCounter fluidTicks_{1.0f / 20.0f, 0};
 };
 
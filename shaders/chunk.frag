@@ -9,22 +9,31 @@ in float vFluidLevel;
 uniform sampler2D uAtlas;
 uniform int uRenderMode; // 0 = textured, 1 = flat
 uniform int uAlphaPass;  // 0 = opaque, 1 = transparent, 2 = all
-uniform vec3 uSkyTint;
-uniform vec3 uCelestialDir;
-uniform float uCelestialStrength;
-uniform vec3 uPlayerPos;
 uniform float uHeldTorchStrength;
-uniform vec3 uFogColor;
-uniform float uFogNear;
-uniform float uFogFar;
-uniform float uCloudShadowEnabled;
-uniform float uCloudShadowTime;
-uniform float uCloudShadowStrength;
-uniform float uCloudShadowDay;
-uniform float uCloudLayerY;
-uniform float uCloudShadowRange;
 uniform float uWaterLevelDebug;
 
+// Per-frame scene constants; must match gfx::SceneUniforms.
+layout(std140) uniform SceneBlock {
+    mat4 uProj;
+    mat4 uView;
+    vec3 uSkyTint;
+    float uDaylight;
+    vec3 uCelestialDir;
+    float uCelestialStrength;
+    vec3 uFogColor;
+    float uFogNear;
+    vec3 uPlayerPos;
+    float uFogFar;
+    float uCloudShadowEnabled;
+    float uCloudShadowTime;
+    float uCloudShadowStrength;
+    float uCloudShadowDay;
+    float uCloudLayerY;
+    float uCloudShadowRange;
+    float uSceneTime;
+    float uScenePadding;
+};
+
 out vec4 FragColor;
 
 vec3 waterDebugColor(float level01) {
@@ -6,9 +6,27 @@ layout(location = 3) in float aSkyLight;
 layout(location = 4) in float aBlockLight;
 layout(location = 5) in float aFluidLevel;
 
-uniform mat4 uProj;
-uniform mat4 uView;
-uniform float uDaylight;
+// Per-frame scene constants; must match gfx::SceneUniforms.
+layout(std140) uniform SceneBlock {
+    mat4 uProj;
+    mat4 uView;
+    vec3 uSkyTint;
+    float uDaylight;
+    vec3 uCelestialDir;
+    float uCelestialStrength;
+    vec3 uFogColor;
+    float uFogNear;
+    vec3 uPlayerPos;
+    float uFogFar;
+    float uCloudShadowEnabled;
+    float uCloudShadowTime;
+    float uCloudShadowStrength;
+    float uCloudShadowDay;
+    float uCloudLayerY;
+    float uCloudShadowRange;
+    float uSceneTime;
+    float uScenePadding;
+};
 
 out vec2 vUV;
 out float vSky;
@@ -1,14 +1,17 @@
 #include "app/GameSession.hpp"
 #include "app/SaveManager.hpp"
+#include "app/WorldCatalog.hpp"
 
 #include "app/menus/CreativeMenu.hpp"
 #include "app/menus/CraftingMenu.hpp"
 #include "app/menus/FurnaceMenu.hpp"
+#include "app/menus/LoadingScreen.hpp"
 #include "app/menus/MiniMapMenu.hpp"
 #include "app/menus/WorldMapMenu.hpp"
 #include "app/menus/PauseMenu.hpp"
 #include "app/menus/RecipeMenu.hpp"
 #include "app/menus/TextInputMenu.hpp"
+#include "core/AssetLoader.hpp"
 #include "core/Logger.hpp"
 #include "game/AudioSystem.hpp"
 #include "game/Camera.hpp"
@@ -22,6 +25,8 @@
 #include "game/SmeltingSystem.hpp"
 #include "gfx/HudRenderer.hpp"
 #include "gfx/ChunkBorderRenderer.hpp"
+#include "gfx/CloudLayerRenderer.hpp"
+#include "gfx/SceneUniforms.hpp"
 #include "gfx/Shader.hpp"
 #include "gfx/SkyBodyRenderer.hpp"
 #include "gfx/TextureAtlas.hpp"
@@ -50,10 +55,39 @@
 #include <vector>
 
 #include "app/Util.hpp"
-#include "core/TickCounter.hpp"
+#include "core/SimulationThread.hpp"
+#include "core/SnapshotBuffer.hpp"
 
 namespace {
 
+// Saved map pages kept resident around the player for the minimap.
+constexpr int kMapResidentRadius = 192;
+// Chunks around the spawn loaded and meshed before the first frame; the rest
+// of the load radius streams in as usual.
+constexpr int kSpawnPreloadRadius = 4;
+
+// Player state the simulation thread publishes after every step; the frame
+// loop draws the camera between the last two.
+struct SimSnapshot {
+    glm::vec3 cameraPos{0.0f};
+    bool inWater = false;
+    bool sprinting = false;
+    bool crouching = false;
+    float health01 = 1.0f;
+    float sprintStamina01 = 1.0f;
+};
+
+SimSnapshot snapshotOf(const game::Player &player) {
+    SimSnapshot snapshot;
+    snapshot.cameraPos = player.cameraPosition();
+    snapshot.inWater = player.inWater();
+    snapshot.sprinting = player.sprinting();
+    snapshot.crouching = player.crouching();
+    snapshot.health01 = player.health01();
+    snapshot.sprintStamina01 = player.sprintStamina01();
+    return snapshot;
+}
+
 void updateFrameTiming(float now, float &lastTime, float &fpsAccumSeconds, int &fpsAccumFrames,
                        float &fpsAvgDisplay, float &fpsOut, float &dtOut) {
     dtOut = now - lastTime;
@@ -157,6 +191,14 @@ void renderOverlayMenus(GLFWwindow *window, gfx::HudRenderer &hud, int winW, int
         const glm::vec3 pos = camera.position();
         const int mapWX = static_cast<int>(std::floor(pos.x));
         const int mapWZ = static_cast<int>(std::floor(pos.z));
+        const app::menus::MapOverlayLayout mapLayout =
+            worldMapMenu.computeLayout(winW, winH, mapZoom);
+        const int halfW = static_cast<int>(std::ceil(mapLayout.gridW * 0.5f / mapLayout.cell)) + 1;
+        const int halfH = static_cast<int>(std::ceil(mapLayout.gridH * 0.5f / mapLayout.cell)) + 1;
+        const int centerWX = static_cast<int>(std::round(mapCenterWX));
+        const int centerWZ = static_cast<int>(std::round(mapCenterWZ));
+        mapSystem.requestRegion(centerWX - halfW, centerWZ - halfH, centerWX + halfW,
+                                centerWZ + halfH);
         double mapCursorX = 0.0;
         double mapCursorY = 0.0;
         glfwGetCursorPos(window, &mapCursorX, &mapCursorY);
@@ -176,8 +218,7 @@ void renderOverlayMenus(GLFWwindow *window, gfx::HudRenderer &hud, int winW, int
             waypointIcon = static_cast<int>(wp.icon);
             waypointVisible = wp.visible;
         }
-        worldMapMenu.render(hud, winW, winH, mapSystem, static_cast<int>(std::round(mapCenterWX)),
-                            static_cast<int>(std::round(mapCenterWZ)), mapWX, mapWZ, mapZoom,
+        worldMapMenu.render(hud, winW, winH, mapSystem, centerWX, centerWZ, mapWX, mapWZ, mapZoom,
                             static_cast<float>(mapCursorX), static_cast<float>(mapCursorY),
                             selectedWaypointIndex, waypointName, waypointR, waypointG, waypointB,
                             waypointIcon, waypointVisible,
@@ -188,6 +229,8 @@ void renderOverlayMenus(GLFWwindow *window, gfx::HudRenderer &hud, int winW, int
         const glm::vec3 pos = camera.position();
         const int mapWX = static_cast<int>(std::floor(pos.x));
         const int mapWZ = static_cast<int>(std::floor(pos.z));
+        mapSystem.requestRegion(mapWX - kMapResidentRadius, mapWZ - kMapResidentRadius,
+                                mapWX + kMapResidentRadius, mapWZ + kMapResidentRadius);
         const glm::vec3 fwd = camera.forward();
         const float miniMapHeadingRad = std::atan2(fwd.x, -fwd.z);
         miniMapMenu.render(hud, winW, winH, mapSystem, mapWX, mapWZ, miniMapZoom,
@@ -205,14 +248,16 @@ namespace app {
 GameSession::GameSession(GLFWwindow *window, GLFWcursor *arrowCursor,
                          const menus::WorldSelection &worldSelection, gfx::Shader &shader,
                          gfx::TextureAtlas &atlas, gfx::HudRenderer &hud,
+                         game::AudioSystem &audio, core::AssetLoader &assetLoader,
                          menus::PauseMenu &pauseMenu, menus::CraftingMenu &craftingMenu,
                          menus::FurnaceMenu &furnaceMenu, menus::RecipeMenu &recipeMenu,
                          menus::CreativeMenu &creativeMenu, menus::WorldMapMenu &worldMapMenu,
-                         menus::MiniMapMenu &miniMapMenu)
+                         menus::MiniMapMenu &miniMapMenu, menus::LoadingScreen &loadingScreen)
     : window_(window), arrowCursor_(arrowCursor), worldSelection_(worldSelection), shader_(shader),
-      atlas_(atlas), hud_(hud), pauseMenu_(pauseMenu), craftingMenu_(craftingMenu),
+      atlas_(atlas), hud_(hud), audio_(audio), assetLoader_(assetLoader), pauseMenu_(pauseMenu),
+      craftingMenu_(craftingMenu),
       furnaceMenu_(furnaceMenu), recipeMenu_(recipeMenu), creativeMenu_(creativeMenu),
-      worldMapMenu_(worldMapMenu), miniMapMenu_(miniMapMenu) {}
+      worldMapMenu_(worldMapMenu), miniMapMenu_(miniMapMenu), loadingScreen_(loadingScreen) {}
 
 bool GameSession::run() {
     GLFWwindow *window = window_;
@@ -221,6 +266,8 @@ bool GameSession::run() {
     auto &shader = shader_;
     auto &atlas = atlas_;
     auto &hud = hud_;
+    auto &audio = audio_;
+    auto &assetLoader = assetLoader_;
     auto &pauseMenu = pauseMenu_;
     auto &craftingMenu = craftingMenu_;
     auto &furnaceMenu = furnaceMenu_;
@@ -228,14 +275,21 @@ bool GameSession::run() {
     auto &creativeMenu = creativeMenu_;
     auto &worldMapMenu = worldMapMenu_;
     auto &miniMapMenu = miniMapMenu_;
+    auto &loadingScreen = loadingScreen_;
+    // Declared before the world so it runs after the world's destructor has
+    // written the last changed chunks, folding those writes into the catalog.
+    struct CatalogFlush {
+        const std::filesystem::path &worldDir;
+        ~CatalogFlush() {
+            WorldCatalog::flushChunkWrites(worldDir);
+        }
+    } catalogFlush{worldSelection.path};
     world::World world(atlas, worldSelection.path, worldSelection.seed);
     game::Camera camera(glm::vec3(8.0f, 80.0f, 8.0f));
     game::DebugMenu debugMenu;
     game::ItemDropSystem itemDrops;
     game::MapSystem mapSystem;
-    game::AudioSystem audio;
     voxel::BlockRegistry hudRegistry;
-    audio.loadDefaultAssets();
 
     game::DebugConfig debugCfg;
     debugCfg.moveSpeed = camera.moveSpeed();
@@ -292,6 +346,7 @@ bool GameSession::run() {
     std::string creativeSearchText;
     std::optional<voxel::BlockId> recipeIngredientFilter;
     bool recipeCraftableOnly = false;
+    game::CraftingSystem::Craftability recipeCraftability;
     int craftingGridSize = game::CraftingSystem::kGridSizeInventory;
     bool usingCraftingTable = false;
     bool usingFurnace = false;
@@ -308,6 +363,28 @@ bool GameSession::run() {
         }
     }
     mapSystem.load(worldSelection.path);
+    {
+        // The preload runs on worker-count threads while this thread keeps the
+        // window responsive and shows how far it has got.
+        const int preloaded = world.preloadSpawnArea(
+            camera.position(), std::min(kSpawnPreloadRadius, debugCfg.loadRadius),
+            [&](int done, int total) {
+                glfwPollEvents();
+                assetLoader.pump(core::AssetLoader::kFrameBudgetSeconds);
+                int winW = 1;
+                int winH = 1;
+                glfwGetWindowSize(window, &winW, &winH);
+                glClearColor(0.12f, 0.18f, 0.24f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                loadingScreen.render(winW, winH, "Loading " + worldSelection.name, done, total);
+                glfwSwapBuffers(window);
+            });
+        std::ostringstream msg;
+        msg << "Spawn area ready: " << preloaded << " chunks meshed, first playable after "
+            << std::fixed << std::setprecision(0) << world.debugStats().timeToFirstPlayableMs
+            << " ms";
+        core::Logger::instance().info(msg.str());
+    }
     mapCenterWX = camera.position().x;
     mapCenterWZ = camera.position().z;
     auto persistActiveFurnaceState = [&]() {
@@ -321,6 +398,11 @@ bool GameSession::run() {
         mapSystem.save(worldSelection.path);
         SaveManager::savePlayerData(worldSelection.path, camera.position(), selectedBlockIndex,
                                     ghostMode, inventory, smelting);
+        const glm::vec3 pos = camera.position();
+        WorldCatalog::update(
+            worldSelection.path, worldSelection.name, worldSelection.seed, mapSystem,
+            static_cast<int>(std::floor(pos.x)), static_cast<int>(std::floor(pos.z)),
+            [&](voxel::BlockId id) { return atlas.tileAverageColor(hudRegistry.get(id).topTile); });
     };
     camera.resetMouseLook(window);
     bool prevInventoryLeft = false;
@@ -361,8 +443,26 @@ bool GameSession::run() {
     float dayClockSeconds = 120.0f;
     constexpr float kDayLengthSeconds = 900.0f;
     constexpr float kSimTickDt = 1.0f / 20.0f;
-    core::TickCounter simTicks(kSimTickDt, 0);
+    // Player movement steps at 60 Hz; every third step is also a world tick.
+    constexpr int kPlayerStepsPerTick = 3;
+    constexpr float kPlayerStepDt = kSimTickDt / static_cast<float>(kPlayerStepsPerTick);
+    gfx::SceneUniformBuffer sceneUniforms;
+    // Scene-wide values go through the UBO; only the chunk pass's own knobs
+    // are set per frame, through locations resolved once here.
+    struct {
+        int atlas;
+        int renderMode;
+        int alphaPass;
+        int heldTorchStrength;
+        int waterLevelDebug;
+    } const chunkUniforms{shader.uniformLocation("uAtlas"), shader.uniformLocation("uRenderMode"),
+                          shader.uniformLocation("uAlphaPass"),
+                          shader.uniformLocation("uHeldTorchStrength"),
+                          shader.uniformLocation("uWaterLevelDebug")};
     gfx::SkyBodyRenderer skyBodyRenderer;
+    gfx::CloudLayerRenderer cloudRenderer(gfx::CloudLayerRenderer::Settings{
+        kCloudRenderRange, kCloudCellSize, kCloudQuadRadius,
+        glm::vec2(kCloudDriftXSpeed, kCloudDriftZSpeed)});
     gfx::ChunkBorderRenderer chunkBorderRenderer;
     world::WorldDebugStats stats{};
     bool wasMenuOpen = false;
@@ -470,9 +570,11 @@ bool GameSession::run() {
         if (!blockInput && right && !prevRight) {
             std::optional<voxel::RayHit> placeHit = currentHit;
             if (!placeHit.has_value()) {
+                voxel::ChunkCursor<voxel::WorldChunkSource> cursor(
+                    voxel::WorldChunkSource{&world});
                 placeHit = voxel::Raycaster::cast(
-                    camera.position(), camera.forward(), debugCfg.raycastDistance,
-                    [&](int x, int y, int z) { return world.getBlock(x, y, z) != voxel::AIR; });
+                    cursor, camera.position(), camera.forward(), debugCfg.raycastDistance,
+                    [](voxel::BlockId id) { return id != voxel::AIR; });
             }
             if (placeHit.has_value()) {
                 glm::ivec3 place = placeHit->block + placeHit->normal;
@@ -1697,6 +1799,40 @@ bool GameSession::run() {
             prevInventoryRight = false;
         }
     };
+    // Player movement, fluids, item drops, furnaces and the day clock advance
+    // on the simulation thread. The frame loop holds simLock only while it
+    // reads or edits that state (the player, drops and pickups, the open
+    // furnace, the day clock); streaming, mesh upload, menus and rendering run
+    // without it, drawing the player from the published snapshots.
+    game::PlayerInput simInput;
+    bool simulatePlayer = false;
+    bool freezeDayClock = false;
+    core::SnapshotBuffer<SimSnapshot> simSnapshots;
+    simSnapshots.reset(snapshotOf(player), 0.0);
+    core::SimulationThread sim(kPlayerStepDt, [&](std::uint64_t step) {
+        if (simulatePlayer) {
+            player.update(world, simInput, kPlayerStepDt);
+        }
+        if ((step + 1) % kPlayerStepsPerTick == 0) {
+            const glm::vec3 viewer = simulatePlayer ? player.cameraPosition() : simInput.viewPos;
+            world.updateFluidSimulation(kSimTickDt);
+            mineCooldown = std::max(0.0f, mineCooldown - kSimTickDt);
+            itemDrops.update(world, viewer, kSimTickDt);
+            world.tickFurnaces([&](world::FurnaceState &wstate) {
+                game::SmeltingSystem::State gstate = SaveManager::fromWorldFurnaceState(wstate);
+                smeltingSystem.update(gstate, kSimTickDt);
+                wstate = SaveManager::toWorldFurnaceState(gstate);
+            });
+            for (const auto &drop : world.consumeFluidDrops()) {
+                itemDrops.spawn(drop.id, drop.pos, drop.count);
+            }
+            if (!freezeDayClock) {
+                dayClockSeconds = std::fmod(dayClockSeconds + kSimTickDt, kDayLengthSeconds);
+            }
+        }
+        simSnapshots.publish(snapshotOf(player), static_cast<double>(step + 1));
+    });
+    sim.start();
     while (!glfwWindowShouldClose(window)) {
         const float now = static_cast<float>(glfwGetTime());
         float dt = 0.0f;
@@ -1704,6 +1840,7 @@ bool GameSession::run() {
         updateFrameTiming(now, lastTime, fpsAccumSeconds, fpsAccumFrames, fpsAvgDisplay, fps, dt);
 
         glfwPollEvents();
+        assetLoader.pump(core::AssetLoader::kFrameBudgetSeconds);
         debugMenu.update(window, debugCfg, stats, fps, dt * 1000.0f);
         const bool menuOpen = debugMenu.isOpen();
         const bool pauseToggleDown = glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS;
@@ -1728,92 +1865,52 @@ bool GameSession::run() {
                           recaptureMouseAfterInventoryClose);
         const int currentCursorMode = glfwGetInputMode(window, GLFW_CURSOR);
 
+        std::unique_lock<std::mutex> simLock = sim.lock();
         if (pendingSpawnResolve) {
             const int swx = static_cast<int>(std::floor(loadedCameraPos.x));
             const int swz = static_cast<int>(std::floor(loadedCameraPos.z));
             if (world.isChunkLoadedAt(swx, swz)) {
                 // Restore exact saved position on reload (no collision adjustment).
                 player.setFromCamera(loadedCameraPos, world, false);
+                simSnapshots.reset(snapshotOf(player), static_cast<double>(sim.stepCount()));
                 camera.setPosition(player.cameraPosition());
                 loadedCameraPos = camera.position();
                 pendingSpawnResolve = false;
             }
         }
 
+        const auto simView = simSnapshots.read(sim.clockSteps());
         if (ghostMode) {
             if (!blockInput) {
                 camera.handleKeyboard(window, dt);
             }
-        } else {
-            if (!pendingSpawnResolve) {
-                player.update(window, world, camera, dt, !blockInput);
-                camera.setPosition(player.cameraPosition());
-            }
+        } else if (!pendingSpawnResolve) {
+            camera.setPosition(
+                glm::mix(simView.previous.cameraPos, simView.current.cameraPos, simView.alpha));
         }
-
-        world.updateStream(camera.position(), camera.forward());
-        const int simTickCount = simTicks.consume(dt);
+        simInput = game::PlayerInput::sample(window, camera, !blockInput);
+        simulatePlayer = !ghostMode && !pendingSpawnResolve;
+        freezeDayClock = debugCfg.overrideTime;
         if (debugCfg.overrideTime) {
             dayClockSeconds = std::clamp(debugCfg.timeOfDay01, 0.0f, 1.0f) * kDayLengthSeconds;
-        } else if (simTickCount > 0) {
-            dayClockSeconds += static_cast<float>(simTickCount) * kSimTickDt;
-            if (dayClockSeconds >= kDayLengthSeconds) {
-                dayClockSeconds = std::fmod(dayClockSeconds, kDayLengthSeconds);
-            }
+        } else {
             debugCfg.timeOfDay01 = dayClockSeconds / kDayLengthSeconds;
         }
-
-        persistActiveFurnaceState();
-        for (int tick = 0; tick < simTickCount; ++tick) {
-            world.updateFluidSimulation(kSimTickDt);
-            mineCooldown = std::max(0.0f, mineCooldown - kSimTickDt);
-            itemDrops.update(world, camera.position(), kSimTickDt);
-            const auto loadedFurnaces = world.loadedFurnacePositions();
-            for (const glm::ivec3 &fpos : loadedFurnaces) {
-                world::FurnaceState wstate{};
-                if (!world.getFurnaceState(fpos.x, fpos.y, fpos.z, wstate)) {
-                    continue;
-                }
-                const voxel::BlockId furnaceBlockId = world.getBlock(fpos.x, fpos.y, fpos.z);
-                game::SmeltingSystem::State gstate = SaveManager::fromWorldFurnaceState(wstate);
-                smeltingSystem.update(gstate, kSimTickDt);
-                const bool furnaceActive = gstate.burnSecondsRemaining > 0.0f;
-                if (voxel::isFurnace(furnaceBlockId)) {
-                    const voxel::BlockId desiredId = furnaceActive
-                                                         ? voxel::toLitFurnace(furnaceBlockId)
-                                                         : voxel::toUnlitFurnace(furnaceBlockId);
-                    if (desiredId != furnaceBlockId) {
-                        world.setBlock(fpos.x, fpos.y, fpos.z, desiredId);
-                    }
-                }
-                const bool hasItems = (gstate.input.id != voxel::AIR && gstate.input.count > 0) ||
-                                      (gstate.fuel.id != voxel::AIR && gstate.fuel.count > 0) ||
-                                      (gstate.output.id != voxel::AIR && gstate.output.count > 0);
-                const bool hasWork = gstate.progressSeconds > 0.0f ||
-                                     gstate.burnSecondsRemaining > 0.0f ||
-                                     gstate.burnSecondsCapacity > 0.0f;
-                if (!hasItems && !hasWork) {
-                    world.clearFurnaceState(fpos.x, fpos.y, fpos.z);
-                } else {
-                    world.setFurnaceState(fpos.x, fpos.y, fpos.z,
-                                          SaveManager::toWorldFurnaceState(gstate));
-                }
+        for (const auto &pickup : itemDrops.consumePickups()) {
+            const int added = inventory.addUpTo(pickup.id, pickup.count);
+            if (added > 0) {
+                audio.playPickup();
+            }
+            if (added < pickup.count) {
+                itemDrops.spawn(pickup.id, pickup.pos, pickup.count - added);
             }
         }
-        for (const auto &drop : world.consumeFluidDrops()) {
-            itemDrops.spawn(drop.id, drop.pos, drop.count);
-        }
+        simLock.unlock();
+
+        world.updateStream(camera.position(), camera.forward());
         world.uploadReadyMeshes();
         stats = world.debugStats();
         mapSystem.observeLoadedChunks(world);
-        loadActiveFurnaceState();
-        for (const auto &pickup : itemDrops.consumePickups()) {
-            if (inventory.add(pickup.id, pickup.count)) {
-                audio.playPickup();
-            } else {
-                itemDrops.spawn(pickup.id, pickup.pos, pickup.count);
-            }
-        }
 
         const bool hudToggleDown = glfwGetKey(window, GLFW_KEY_F2) == GLFW_PRESS;
         if (hudToggleDown && !prevHudToggle && !menuOpen) {
@@ -1854,18 +1951,18 @@ bool GameSession::run() {
         const bool mapZoomInDown = (glfwGetKey(window, GLFW_KEY_EQUAL) == GLFW_PRESS) ||
                                    (glfwGetKey(window, GLFW_KEY_KP_ADD) == GLFW_PRESS);
         if (mapZoomInDown && !prevMapZoomInToggle && mapOpen) {
-            mapZoom = std::clamp(mapZoom * 1.15f, 0.5f, 3.0f);
+            mapZoom = std::clamp(mapZoom * 1.15f, 0.0625f, 3.0f);
         }
         prevMapZoomInToggle = mapZoomInDown;
         const bool mapZoomOutDown = (glfwGetKey(window, GLFW_KEY_MINUS) == GLFW_PRESS) ||
                                     (glfwGetKey(window, GLFW_KEY_KP_SUBTRACT) == GLFW_PRESS);
         if (mapZoomOutDown && !prevMapZoomOutToggle && mapOpen) {
-            mapZoom = std::clamp(mapZoom / 1.15f, 0.5f, 3.0f);
+            mapZoom = std::clamp(mapZoom / 1.15f, 0.0625f, 3.0f);
         }
         prevMapZoomOutToggle = mapZoomOutDown;
         if (mapOpen && std::abs(gRecipeMenuScrollDelta) > 0.01f) {
             const float factor = 1.0f + gRecipeMenuScrollDelta * 0.08f;
-            mapZoom = std::clamp(mapZoom * std::max(0.5f, factor), 0.5f, 3.0f);
+            mapZoom = std::clamp(mapZoom * std::max(0.5f, factor), 0.0625f, 3.0f);
             gRecipeMenuScrollDelta = 0.0f;
         }
 
@@ -1880,12 +1977,17 @@ bool GameSession::run() {
         }
         prevTextureReloadToggle = textureReloadDown;
 
+        // The mode and inventory toggles move the player, spawn drops and
+        // persist the open furnace, so they run between simulation steps.
+        simLock.lock();
+        loadActiveFurnaceState();
         const bool modeToggleDown = glfwGetKey(window, GLFW_KEY_F4) == GLFW_PRESS;
         if (modeToggleDown && !prevModeToggle && !menuOpen && !inventoryVisible && !pauseMenuOpen &&
             !mapOpen) {
             ghostMode = !ghostMode;
             if (!ghostMode) {
                 player.setFromCamera(camera.position(), world);
+                simSnapshots.reset(snapshotOf(player), static_cast<double>(sim.stepCount()));
             } else {
                 camera.setPosition(player.cameraPosition());
             }
@@ -1995,6 +2097,7 @@ bool GameSession::run() {
             }
         }
         prevInventoryToggle = invToggleDown;
+        simLock.unlock();
 
         const bool recipeToggleDown = glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS;
         if (recipeToggleDown && !prevRecipeMenuToggle && inventoryVisible && !menuOpen &&
@@ -2078,46 +2181,26 @@ bool GameSession::run() {
 
         std::vector<int> filteredRecipeIndices;
         std::vector<int> filteredSmeltingIndices;
-        std::vector<unsigned char> recipeCraftableCache;
-        std::vector<unsigned char> recipeCraftableComputed;
-        const int recipeFilterActiveInputs =
-            game::CraftingSystem::activeInputCount(craftingGridSize);
         auto isRecipeCraftableNow = [&](int index) {
-            if (index < 0 || index >= static_cast<int>(craftingSystem.recipeInfos().size())) {
-                return false;
-            }
-            if (recipeCraftableComputed[index] != 0) {
-                return recipeCraftableCache[index] != 0;
-            }
-            recipeCraftableComputed[index] = 1;
-            const auto &recipe = craftingSystem.recipeInfos()[index];
-            if (craftingGridSize < recipe.minGridSize) {
-                recipeCraftableCache[index] = 0;
-                return false;
-            }
-            game::Inventory invSim = inventory;
-            game::CraftingSystem::State craftSim{};
-            const bool craftable =
-                craftingSystem.tryAddRecipeSet(recipe, invSim, craftSim, recipeFilterActiveInputs);
-            recipeCraftableCache[index] = craftable ? 1 : 0;
-            return craftable;
+            return index >= 0 && index < static_cast<int>(recipeCraftability.flags.size()) &&
+                   recipeCraftability.flags[index] != 0;
         };
 
         if (recipeMenuVisible && !usingFurnace) {
             filteredRecipeIndices.reserve(craftingSystem.recipeInfos().size());
-            recipeCraftableCache.assign(craftingSystem.recipeInfos().size(), 0);
-            recipeCraftableComputed.assign(craftingSystem.recipeInfos().size(), 0);
+            craftingSystem.refreshCraftability(recipeCraftability, inventory, craftingGridSize);
             std::vector<int> filteredPlankRecipeIndices;
             filteredPlankRecipeIndices.reserve(3);
             int plankInsertPos = -1;
-            for (int i = 0; i < static_cast<int>(craftingSystem.recipeInfos().size()); ++i) {
+            const auto &searchMatches =
+                recipeMenu.matchingRecipes(craftingSystem.recipeInfos(), recipeSearchText);
+            for (int i : searchMatches) {
                 const auto &recipe = craftingSystem.recipeInfos()[i];
-                const bool matchesSearch = recipeMenu.matchesSearch(recipe, recipeSearchText);
                 const bool matchesIngredient =
                     !recipeIngredientFilter.has_value() ||
                     recipeMenu.usesIngredient(recipe, recipeIngredientFilter.value());
                 const bool matchesCraftable = !recipeCraftableOnly || isRecipeCraftableNow(i);
-                if (matchesSearch && matchesIngredient && matchesCraftable) {
+                if (matchesIngredient && matchesCraftable) {
                     const bool isPlanksFamily = (recipe.outputId == voxel::OAK_PLANKS ||
                                                  recipe.outputId == voxel::SPRUCE_PLANKS ||
                                                  recipe.outputId == voxel::BIRCH_PLANKS);
@@ -2156,10 +2239,8 @@ bool GameSession::run() {
                 }
             }
 
-            for (int i = 0; i < static_cast<int>(smeltRecipes.size()); ++i) {
+            for (int i : recipeMenu.matchingSmeltingRecipes(smeltRecipes, recipeSearchText)) {
                 const auto &recipe = smeltRecipes[i];
-                const bool matchesSearch =
-                    recipeMenu.smeltingMatchesSearch(recipe, recipeSearchText);
                 const bool matchesIngredient = !recipeIngredientFilter.has_value() ||
                                                recipe.input == recipeIngredientFilter.value();
                 int inputCount = 0;
@@ -2171,7 +2252,7 @@ bool GameSession::run() {
                 }
                 const bool matchesCraftable =
                     !recipeCraftableOnly || (inputCount > 0 && fuelCount > 0);
-                if (matchesSearch && matchesIngredient && matchesCraftable) {
+                if (matchesIngredient && matchesCraftable) {
                     filteredSmeltingIndices.push_back(i);
                 }
             }
@@ -2179,12 +2260,7 @@ bool GameSession::run() {
 
         std::vector<voxel::BlockId> filteredCreativeItems;
         if (creativeMenuVisible) {
-            filteredCreativeItems.reserve(creativeMenu.catalog().size());
-            for (voxel::BlockId id : creativeMenu.catalog()) {
-                if (creativeMenu.itemMatchesSearch(id, creativeSearchText)) {
-                    filteredCreativeItems.push_back(id);
-                }
-            }
+            filteredCreativeItems = creativeMenu.matchingItems(creativeSearchText);
         }
 
         if (recipeMenuVisible && inventoryVisible && !menuOpen && !pauseMenuOpen) {
@@ -2517,7 +2593,9 @@ bool GameSession::run() {
             if (handSlot.id != voxel::AIR && handSlot.count > 0) {
                 glm::vec3 dropPos =
                     camera.position() + camera.forward() * 2.10f + glm::vec3(0.0f, -0.30f, 0.0f);
+                simLock.lock();
                 itemDrops.spawn(handSlot.id, dropPos, 1);
+                simLock.unlock();
                 handSlot.count -= 1;
                 if (handSlot.count <= 0) {
                     handSlot = {};
@@ -2537,6 +2615,10 @@ bool GameSession::run() {
 
         handleMapAndWaypoints(left, right, currentCursorMode);
 
+        // The furnace is reloaded under the lock so the steps since the last
+        // load are not overwritten when the UI persists it.
+        simLock.lock();
+        loadActiveFurnaceState();
         if (handlePauseMenuInput(window, pauseMenu, left, prevLeft, pauseMenuOpen, returnToTitle,
                                  saveCurrentPlayer)) {
             break;
@@ -2547,13 +2629,16 @@ bool GameSession::run() {
                                      clearCraftInputs);
 
         handleWorldInteractionAndMovement(dt, blockInput, currentHit, left, right);
+        persistActiveFurnaceState();
+        const float frameDayClockSeconds = dayClockSeconds;
+        simLock.unlock();
 
         // Stance feedback: slightly tighten FOV while crouched and widen while sprinting.
         float targetFov = debugCfg.fov;
         if (!ghostMode) {
-            if (player.sprinting()) {
+            if (simView.current.sprinting) {
                 targetFov += 7.0f;
-            } else if (player.crouching()) {
+            } else if (simView.current.crouching) {
                 targetFov -= 6.0f;
             }
         }
@@ -2569,7 +2654,7 @@ bool GameSession::run() {
         const glm::mat4 view = camera.view();
         const glm::mat4 viewProj = proj * view;
 
-        const float dayPhase = dayClockSeconds / kDayLengthSeconds;
+        const float dayPhase = frameDayClockSeconds / kDayLengthSeconds;
         const float sunAngle = dayPhase * (glm::pi<float>() * 2.0f);
         const float sunHeight = std::sin(sunAngle);
         const float daylight = glm::smoothstep(-0.10f, 0.20f, sunHeight);
@@ -2626,6 +2711,30 @@ bool GameSession::run() {
         const float starVis = glm::clamp((1.0f - daylight) * (0.65f + 0.35f * moonVis), 0.0f, 1.0f);
         const float cloudVis = glm::clamp(0.20f + 0.60f * daylight + 0.25f * twilight, 0.0f, 0.95f);
         const float cloudLayerY = kCloudLayerY;
+        const float renderEdge = static_cast<float>(debugCfg.loadRadius * voxel::Chunk::SX);
+        const float fogFar = std::max(28.0f, renderEdge - 16.0f);
+        const float fogNear = std::max(8.0f, fogFar - std::max(52.0f, renderEdge * 0.72f));
+        const glm::vec3 fogColor = glm::mix(skyColor, glm::vec3(0.80f, 0.86f, 0.95f), 0.22f);
+
+        gfx::SceneUniforms scene;
+        scene.proj = proj;
+        scene.view = view;
+        scene.skyTint = skyTint;
+        scene.daylight = daylight;
+        scene.celestialDir = celestialDir;
+        scene.celestialStrength = celestialStrength;
+        scene.fogColor = fogColor;
+        scene.fogNear = debugCfg.showFog ? fogNear : 1000000.0f;
+        scene.playerPos = camera.position();
+        scene.fogFar = debugCfg.showFog ? fogFar : 1000001.0f;
+        scene.cloudShadowEnabled = debugCfg.showClouds ? 1.0f : 0.0f;
+        scene.cloudShadowTime = now;
+        scene.cloudShadowStrength = 0.32f;
+        scene.cloudShadowDay = sunVis;
+        scene.cloudLayerY = cloudLayerY;
+        scene.cloudShadowRange = kCloudShadowRange;
+        scene.time = now;
+        sceneUniforms.update(scene);
 
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -2651,7 +2760,7 @@ bool GameSession::run() {
                 const glm::vec3 starColor =
                     glm::mix(glm::vec3(0.72f, 0.80f, 1.00f), glm::vec3(1.0f), hash01(i, 43));
                 const auto axes = skyBillboardAxes(center);
-                skyBodyRenderer.draw(proj, view, center, axes.first, axes.second, radius,
+                skyBodyRenderer.draw(center, axes.first, axes.second, radius,
                                      starColor * (0.35f + 0.75f * starVis), 0.10f * twinkle,
                                      gfx::SkyBodyRenderer::BodyType::Star, 0.0f);
             }
@@ -2659,13 +2768,13 @@ bool GameSession::run() {
 
         if (sunCenter.y + 16.0f > camera.position().y) {
             const auto axes = skyBillboardAxes(sunCenter);
-            skyBodyRenderer.draw(proj, view, sunCenter, axes.first, axes.second, 16.0f, sunColor,
+            skyBodyRenderer.draw(sunCenter, axes.first, axes.second, 16.0f, sunColor,
                                 0.07f + 0.15f * sunVis, gfx::SkyBodyRenderer::BodyType::Sun,
                                 0.0f);
         }
         if (moonCenter.y + 14.0f > camera.position().y) {
             const auto axes = skyBillboardAxes(moonCenter);
-            skyBodyRenderer.draw(proj, view, moonCenter, axes.first, axes.second, 14.0f, moonColor,
+            skyBodyRenderer.draw(moonCenter, axes.first, axes.second, 14.0f, moonColor,
                                 0.03f + 0.05f * moonVis, gfx::SkyBodyRenderer::BodyType::Moon,
                                 moonPhase01);
         }
@@ -2678,99 +2787,60 @@ bool GameSession::run() {
         glPolygonMode(GL_FRONT_AND_BACK, wireframe ? GL_LINE : GL_FILL);
 
         shader.use();
-        shader.setMat4("uProj", proj);
-        shader.setMat4("uView", view);
-        shader.setFloat("uDaylight", daylight);
-        shader.setVec3("uSkyTint", skyTint);
-        shader.setVec3("uCelestialDir", celestialDir);
-        shader.setFloat("uCelestialStrength", celestialStrength);
-        shader.setVec3("uPlayerPos", camera.position());
-        const float renderEdge = static_cast<float>(debugCfg.loadRadius * voxel::Chunk::SX);
-        const float fogFar = std::max(28.0f, renderEdge - 16.0f);
-        const float fogNear = std::max(8.0f, fogFar - std::max(52.0f, renderEdge * 0.72f));
-        const glm::vec3 fogColor = glm::mix(skyColor, glm::vec3(0.80f, 0.86f, 0.95f), 0.22f);
-        shader.setVec3("uFogColor", fogColor);
-        shader.setFloat("uFogNear", debugCfg.showFog ? fogNear : 1000000.0f);
-        shader.setFloat("uFogFar", debugCfg.showFog ? fogFar : 1000001.0f);
-        shader.setFloat("uCloudShadowEnabled", debugCfg.showClouds ? 1.0f : 0.0f);
-        shader.setFloat("uCloudShadowTime", now);
-        shader.setFloat("uCloudShadowStrength", 0.32f);
-        shader.setFloat("uCloudShadowDay", sunVis);
-        shader.setFloat("uCloudLayerY", cloudLayerY);
-        shader.setFloat("uCloudShadowRange", kCloudShadowRange);
-        shader.setFloat("uWaterLevelDebug", debugCfg.showWaterLevelDebug ? 1.0f : 0.0f);
+        shader.setFloat(chunkUniforms.waterLevelDebug, debugCfg.showWaterLevelDebug ? 1.0f : 0.0f);
         const voxel::BlockId heldId = inventory.hotbarSlot(selectedBlockIndex).id;
         const float heldTorchStrength = voxel::isTorch(heldId) ? 0.90f : 0.0f;
-        shader.setFloat("uHeldTorchStrength", heldTorchStrength);
+        shader.setFloat(chunkUniforms.heldTorchStrength, heldTorchStrength);
         atlas.bind(0);
-        shader.setInt("uAtlas", 0);
-        shader.setInt("uRenderMode", debugCfg.renderMode == game::RenderMode::Textured ? 0 : 1);
+        shader.setInt(chunkUniforms.atlas, 0);
+        shader.setInt(chunkUniforms.renderMode,
+                      debugCfg.renderMode == game::RenderMode::Textured ? 0 : 1);
+        world.prepareDrawLists(camera.position(), camera.forward(), renderEdge, viewProj);
         if (debugCfg.renderMode == game::RenderMode::Textured) {
             // Pass 1: opaque geometry writes depth.
             glDisable(GL_BLEND);
             glDepthMask(GL_TRUE);
-            shader.setInt("uAlphaPass", 0);
-            world.draw(camera.position(), renderEdge, viewProj);
+            shader.setInt(chunkUniforms.alphaPass, 0);
+            world.draw();
             // Draw item entities before transparent surfaces so they remain
             // visible through water/glass passes.
-            itemDrops.render(proj, view, atlas, hudRegistry);
+            simLock.lock();
+            itemDrops.render(atlas, hudRegistry);
+            simLock.unlock();
             // Item rendering uses its own shader; restore chunk shader state
             // before transparent world passes.
             shader.use();
             atlas.bind(0);
-            shader.setInt("uAtlas", 0);
+            shader.setInt(chunkUniforms.atlas, 0);
 
             // Pass 2a: transparent depth prepass (no color), so only nearest
             // transparent surface per pixel survives.
             glDisable(GL_BLEND);
             glDepthMask(GL_TRUE);
             glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
-            shader.setInt("uAlphaPass", 1);
-            world.drawTransparent(camera.position(), camera.forward(), renderEdge, viewProj);
+            shader.setInt(chunkUniforms.alphaPass, 1);
+            world.drawTransparent();
 
             // Pass 2b: transparent color pass, reading depth from prepass.
             glEnable(GL_BLEND);
             glDepthMask(GL_FALSE);
             glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
             glDepthFunc(GL_LEQUAL);
-            shader.setInt("uAlphaPass", 1);
-            world.drawTransparent(camera.position(), camera.forward(), renderEdge, viewProj);
+            shader.setInt(chunkUniforms.alphaPass, 1);
+            world.drawTransparent();
             glDepthFunc(GL_LESS);
             glDepthMask(GL_TRUE);
         } else {
             glDisable(GL_BLEND);
             glDepthMask(GL_TRUE);
-            shader.setInt("uAlphaPass", 2);
-            world.draw(camera.position(), renderEdge, viewProj);
-            itemDrops.render(proj, view, atlas, hudRegistry);
+            shader.setInt(chunkUniforms.alphaPass, 2);
+            world.draw();
+            simLock.lock();
+            itemDrops.render(atlas, hudRegistry);
+            simLock.unlock();
         }
 
         if (debugCfg.showClouds && cloudVis > 0.01f) {
-            constexpr int kRange = kCloudRenderRange;
-            const float cell = kCloudCellSize;
-            const float cloudY = cloudLayerY;
-            const float driftX = now * kCloudDriftXSpeed;
-            const float driftZ = now * kCloudDriftZSpeed;
-            auto cloudHashU32 = [](std::uint32_t x) {
-                x ^= x >> 16u;
-                x *= 0x7feb352du;
-                x ^= x >> 15u;
-                x *= 0x846ca68bu;
-                x ^= x >> 16u;
-                return x;
-            };
-            auto cloudHash = [cloudHashU32](int x, int z, int salt) {
-                const auto u32 = [](int v) { return static_cast<std::uint32_t>(v); };
-                const std::uint32_t h = cloudHashU32(
-                    u32(x) ^ (cloudHashU32(u32(z) + 0x9e3779b9u) + u32(salt) * 0x85ebca6bu));
-                return static_cast<float>(h & 0x00ffffffu) * (1.0f / 16777215.0f);
-            };
-            const int centerGX =
-                static_cast<int>(std::floor((camera.position().x - driftX) / cell));
-            const int centerGZ =
-                static_cast<int>(std::floor((camera.position().z - driftZ) / cell));
-            const glm::vec3 cloudRight(1.0f, 0.0f, 0.0f);
-            const glm::vec3 cloudUp(0.0f, 0.0f, 1.0f);
             const glm::vec3 cloudColor =
                 glm::mix(glm::vec3(0.80f, 0.86f, 0.92f), glm::vec3(1.00f, 1.00f, 1.00f),
                          0.42f + 0.45f * daylight);
@@ -2780,33 +2850,8 @@ bool GameSession::run() {
             glEnable(GL_DEPTH_TEST);
             glDepthFunc(GL_LEQUAL);
             glDepthMask(GL_FALSE);
-            for (int gz = -kRange; gz <= kRange; ++gz) {
-                for (int gx = -kRange; gx <= kRange; ++gx) {
-                    const int gxi = centerGX + gx;
-                    const int gzi = centerGZ + gz;
-                    const int fx = static_cast<int>(std::floor(static_cast<float>(gxi) * 0.5f));
-                    const int fz = static_cast<int>(std::floor(static_cast<float>(gzi) * 0.5f));
-
-                    const float base = cloudHash(fx, fz, 503);
-                    const float nE = cloudHash(fx + 1, fz, 503);
-                    const float nW = cloudHash(fx - 1, fz, 503);
-                    const float nN = cloudHash(fx, fz + 1, 503);
-                    const float nS = cloudHash(fx, fz - 1, 503);
-                    const bool core = base > 0.77f;
-                    const bool fringe =
-                        (base > 0.69f) && (std::max(std::max(nE, nW), std::max(nN, nS)) > 0.78f);
-                    if (!(core || fringe)) {
-                        continue;
-                    }
-
-                    const glm::vec3 center((static_cast<float>(gxi) * cell) + driftX, cloudY,
-                                           (static_cast<float>(gzi) * cell) + driftZ);
-                    skyBodyRenderer.draw(proj, view, center, cloudRight, cloudUp,
-                                         cell * kCloudQuadRadius,
-                                         cloudColor * (0.48f + 0.52f * cloudVis), 0.0f,
-                                        gfx::SkyBodyRenderer::BodyType::Cloud, 0.0f);
-                }
-            }
+            cloudRenderer.draw(camera.position(), now, cloudLayerY,
+                               cloudColor * (0.48f + 0.52f * cloudVis));
             glDepthMask(GL_TRUE);
             glDepthFunc(GL_LESS);
             glDisable(GL_BLEND);
@@ -2938,11 +2983,11 @@ bool GameSession::run() {
             std::string modeText = "Walking";
             if (ghostMode) {
                 modeText = "Mode: Ghost";
-            } else if (player.inWater()) {
+            } else if (simView.current.inWater) {
                 modeText = "Swimming";
-            } else if (player.sprinting()) {
+            } else if (simView.current.sprinting) {
                 modeText = "Sprinting";
-            } else if (player.crouching()) {
+            } else if (simView.current.crouching) {
                 modeText = "Crouching";
             }
             const std::string compassText = compassTextFromForward(camera.forward());
@@ -2971,8 +3016,8 @@ bool GameSession::run() {
                     : game::blockName(carriedSlot.id),
                 (selectedPlaceBlock == voxel::AIR) ? "Empty Slot"
                                                    : game::blockName(selectedPlaceBlock),
-                lookedAt, modeText, player.health01(), player.sprintStamina01(), fpsAvgDisplay,
-                compassText, biomeText, coord.str(), hudRegistry, atlas);
+                lookedAt, modeText, simView.current.health01, simView.current.sprintStamina01,
+                fpsAvgDisplay, compassText, biomeText, coord.str(), hudRegistry, atlas);
         }
         renderOverlayMenus(window, hud, winW, winH, pauseMenu, pauseMenuOpen, worldMapMenu,
                            miniMapMenu, mapOpen, hudVisible, mapSystem, camera, mapCenterWX,
@@ -2983,6 +3028,7 @@ bool GameSession::run() {
         maybeUpdateWindowTitle(window, debugMenu, debugCfg, stats, fps, dt, titleAccum);
     }
 
+    sim.stop();
     app::menus::TextInputMenu::unbind(window);
     saveCurrentPlayer();
 
@@ -4,8 +4,10 @@
 #include "voxel/Block.hpp"
 #include "voxel/Chunk.hpp"
 #include "world/ChunkCoord.hpp"
+#include "world/ChunkEdits.hpp"
 #include "world/FurnaceState.hpp"
 #include "world/World.hpp"
+#include "world/WorldGen.hpp"
 
 #include <algorithm>
 #include <array>
@@ -13,13 +15,29 @@
 #include <fstream>
 #include <iomanip>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace app {
 
 namespace {
 
+constexpr std::uint32_t kFullChunkMagic = 0x31584C56u;      // VXL1
+constexpr std::uint32_t kDeltaChunkMagic = 0x31445856u;     // VXD1
 constexpr std::uint32_t kFurnaceSectionMagic = 0x31465246u; // FRF1
+constexpr std::size_t kChunkVolume =
+    static_cast<std::size_t>(voxel::Chunk::SX) * voxel::Chunk::SY * voxel::Chunk::SZ;
+static_assert(kChunkVolume <= 0x10000u, "delta block indices are stored as 16 bits");
+
+// One block that differs from generated terrain, by index into Chunk::data().
+struct BlockEdit {
+    std::uint16_t index = 0;
+    voxel::BlockId id = voxel::AIR;
+};
 
 std::filesystem::path chunkPath(const std::filesystem::path &root, world::ChunkCoord cc) {
     return root / ("chunk_" + std::to_string(cc.x) + "_" + std::to_string(cc.z) + ".bin");
@@ -49,6 +67,170 @@ bool readSlot(std::ifstream &in, world::FurnaceSlotState &slot) {
     return true;
 }
 
+void writeChunkHeader(std::ofstream &out, std::uint32_t magic, std::uint32_t version) {
+    const std::uint16_t sx = voxel::Chunk::SX;
+    const std::uint16_t sy = voxel::Chunk::SY;
+    const std::uint16_t sz = voxel::Chunk::SZ;
+    out.write(reinterpret_cast<const char *>(&magic), sizeof(magic));
+    out.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    out.write(reinterpret_cast<const char *>(&sx), sizeof(sx));
+    out.write(reinterpret_cast<const char *>(&sy), sizeof(sy));
+    out.write(reinterpret_cast<const char *>(&sz), sizeof(sz));
+}
+
+void writeFullBlocks(std::ofstream &out, const std::vector<voxel::BlockId> &blocks) {
+    std::size_t i = 0;
+    while (i < blocks.size()) {
+        const voxel::BlockId id = blocks[i];
+        std::uint16_t run = 1;
+        while (i + run < blocks.size() && blocks[i + run] == id && run < 0xFFFFu) {
+            ++run;
+        }
+        out.write(reinterpret_cast<const char *>(&id), sizeof(id));
+        out.write(reinterpret_cast<const char *>(&run), sizeof(run));
+        i += run;
+    }
+}
+
+bool readFullBlocks(std::ifstream &in, std::vector<voxel::BlockId> &blocks) {
+    blocks.assign(kChunkVolume, voxel::AIR);
+    std::size_t writePos = 0;
+    while (in && writePos < blocks.size()) {
+        voxel::BlockId id = voxel::AIR;
+        std::uint16_t run = 0;
+        in.read(reinterpret_cast<char *>(&id), sizeof(id));
+        in.read(reinterpret_cast<char *>(&run), sizeof(run));
+        if (!in) {
+            break;
+        }
+        for (std::uint16_t ri = 0; ri < run && writePos < blocks.size(); ++ri) {
+            blocks[writePos++] = id;
+        }
+    }
+    return writePos == blocks.size();
+}
+
+std::vector<std::uint16_t> diffBlocks(const std::vector<voxel::BlockId> &base,
+                                      const std::vector<voxel::BlockId> &blocks) {
+    std::vector<std::uint16_t> cells;
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        if (blocks[i] != base[i]) {
+            cells.push_back(static_cast<std::uint16_t>(i));
+        }
+    }
+    return cells;
+}
+
+void writeDeltaBlocks(std::ofstream &out, const std::vector<voxel::BlockId> &blocks,
+                      const std::vector<std::uint16_t> &cells) {
+    const std::uint32_t count = static_cast<std::uint32_t>(cells.size());
+    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for (const std::uint16_t index : cells) {
+        const voxel::BlockId id = blocks[index];
+        out.write(reinterpret_cast<const char *>(&index), sizeof(index));
+        out.write(reinterpret_cast<const char *>(&id), sizeof(id));
+    }
+}
+
+// Applies edits over blocks, which already hold the regenerated base, and
+// records their cells.
+bool readDeltaBlocks(std::ifstream &in, std::vector<voxel::BlockId> &blocks,
+                     world::ChunkEdits &edits) {
+    std::uint32_t count = 0;
+    in.read(reinterpret_cast<char *>(&count), sizeof(count));
+    if (!in || count > blocks.size()) {
+        return false;
+    }
+    for (std::uint32_t i = 0; i < count; ++i) {
+        BlockEdit edit{};
+        in.read(reinterpret_cast<char *>(&edit.index), sizeof(edit.index));
+        in.read(reinterpret_cast<char *>(&edit.id), sizeof(edit.id));
+        if (!in || edit.index >= blocks.size()) {
+            return false;
+        }
+        blocks[edit.index] = edit.id;
+        edits.add(edit.index);
+    }
+    return true;
+}
+
+void writeFurnaceSection(std::ofstream &out,
+                         const std::vector<world::FurnaceRecordLocal> *furnaces) {
+    const std::uint32_t sectionMagic = kFurnaceSectionMagic;
+    const std::uint16_t furnaceCount = static_cast<std::uint16_t>(
+        std::min<std::size_t>(furnaces ? furnaces->size() : 0, 0xFFFFu));
+    out.write(reinterpret_cast<const char *>(&sectionMagic), sizeof(sectionMagic));
+    out.write(reinterpret_cast<const char *>(&furnaceCount), sizeof(furnaceCount));
+    if (furnaces == nullptr) {
+        return;
+    }
+    for (std::size_t fi = 0; fi < furnaceCount; ++fi) {
+        const auto &r = (*furnaces)[fi];
+        out.write(reinterpret_cast<const char *>(&r.x), sizeof(r.x));
+        out.write(reinterpret_cast<const char *>(&r.y), sizeof(r.y));
+        out.write(reinterpret_cast<const char *>(&r.z), sizeof(r.z));
+        writeSlot(out, r.state.input);
+        writeSlot(out, r.state.fuel);
+        writeSlot(out, r.state.output);
+        out.write(reinterpret_cast<const char *>(&r.state.progressSeconds),
+                  sizeof(r.state.progressSeconds));
+        out.write(reinterpret_cast<const char *>(&r.state.burnSecondsRemaining),
+                  sizeof(r.state.burnSecondsRemaining));
+        out.write(reinterpret_cast<const char *>(&r.state.burnSecondsCapacity),
+                  sizeof(r.state.burnSecondsCapacity));
+    }
+}
+
+bool readFurnaceSection(std::ifstream &in, std::vector<world::FurnaceRecordLocal> &furnaces) {
+    furnaces.clear();
+    std::uint32_t sectionMagic = 0;
+    in.read(reinterpret_cast<char *>(&sectionMagic), sizeof(sectionMagic));
+    if (!in) {
+        return true; // older chunk format without furnace section
+    }
+    if (sectionMagic != kFurnaceSectionMagic) {
+        return true;
+    }
+    std::uint16_t furnaceCount = 0;
+    in.read(reinterpret_cast<char *>(&furnaceCount), sizeof(furnaceCount));
+    if (!in) {
+        return false;
+    }
+    for (std::uint16_t fi = 0; fi < furnaceCount; ++fi) {
+        world::FurnaceRecordLocal rec{};
+        in.read(reinterpret_cast<char *>(&rec.x), sizeof(rec.x));
+        in.read(reinterpret_cast<char *>(&rec.y), sizeof(rec.y));
+        in.read(reinterpret_cast<char *>(&rec.z), sizeof(rec.z));
+        if (!in || !readSlot(in, rec.state.input) || !readSlot(in, rec.state.fuel) ||
+            !readSlot(in, rec.state.output)) {
+            return false;
+        }
+        in.read(reinterpret_cast<char *>(&rec.state.progressSeconds),
+                sizeof(rec.state.progressSeconds));
+        in.read(reinterpret_cast<char *>(&rec.state.burnSecondsRemaining),
+                sizeof(rec.state.burnSecondsRemaining));
+        in.read(reinterpret_cast<char *>(&rec.state.burnSecondsCapacity),
+                sizeof(rec.state.burnSecondsCapacity));
+        if (!in) {
+            return false;
+        }
+        furnaces.push_back(rec);
+    }
+    return true;
+}
+
+// One log per world folder, created on first write and kept for the process.
+ChunkWriteLog &chunkWriteLog(const std::filesystem::path &worldDir) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::unique_ptr<ChunkWriteLog>> logs;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<ChunkWriteLog> &log = logs[worldDir.lexically_normal().generic_string()];
+    if (!log) {
+        log = std::make_unique<ChunkWriteLog>();
+    }
+    return *log;
+}
+
 } // namespace
 
 world::FurnaceState SaveManager::toWorldFurnaceState(const game::SmeltingSystem::State &src) {
@@ -248,151 +430,125 @@ void SaveManager::loadFurnaceState(world::World &world,
 
 bool SaveManager::saveChunk(const std::filesystem::path &worldDir, std::uint32_t generatorVersion,
                             const voxel::Chunk &chunk, world::ChunkCoord cc,
-                            const std::vector<world::FurnaceRecordLocal> *furnaces) {
+                            const std::vector<world::FurnaceRecordLocal> *furnaces,
+                            const world::ChunkEdits *edits) {
+    const std::filesystem::path path = chunkPath(worldDir, cc);
+    std::error_code sizeEc;
+    const std::uintmax_t oldBytes = std::filesystem::file_size(path, sizeEc);
+    const bool existed = !sizeEc;
+
+    if (edits != nullptr) {
+        if (edits->cells.empty() && (furnaces == nullptr || furnaces->empty())) {
+            // Regenerating reproduces this chunk exactly, so it needs no file.
+            if (!existed) {
+                return true;
+            }
+            std::error_code removeEc;
+            if (!std::filesystem::remove(path, removeEc)) {
+                return false;
+            }
+            chunkWriteLog(worldDir).recordRemoval(oldBytes);
+            return true;
+        }
+    }
+
     std::filesystem::create_directories(worldDir);
-    std::ofstream out(chunkPath(worldDir, cc), std::ios::binary);
+    std::ofstream out(path, std::ios::binary);
     if (!out) {
         return false;
     }
-
-    const std::uint32_t magic = 0x31584C56u; // VXL1
-    const std::uint32_t version = generatorVersion;
-    const std::uint16_t sx = voxel::Chunk::SX;
-    const std::uint16_t sy = voxel::Chunk::SY;
-    const std::uint16_t sz = voxel::Chunk::SZ;
-
-    out.write(reinterpret_cast<const char *>(&magic), sizeof(magic));
-    out.write(reinterpret_cast<const char *>(&version), sizeof(version));
-    out.write(reinterpret_cast<const char *>(&sx), sizeof(sx));
-    out.write(reinterpret_cast<const char *>(&sy), sizeof(sy));
-    out.write(reinterpret_cast<const char *>(&sz), sizeof(sz));
-
-    const auto &blocks = chunk.data();
-    std::size_t i = 0;
-    while (i < blocks.size()) {
-        const voxel::BlockId id = blocks[i];
-        std::uint16_t run = 1;
-        while (i + run < blocks.size() && blocks[i + run] == id && run < 0xFFFFu) {
-            ++run;
-        }
-        out.write(reinterpret_cast<const char *>(&id), sizeof(id));
-        out.write(reinterpret_cast<const char *>(&run), sizeof(run));
-        i += run;
+    if (edits != nullptr) {
+        writeChunkHeader(out, kDeltaChunkMagic, generatorVersion);
+        writeDeltaBlocks(out, chunk.data(), edits->cells);
+    } else {
+        writeChunkHeader(out, kFullChunkMagic, generatorVersion);
+        writeFullBlocks(out, chunk.data());
     }
+    writeFurnaceSection(out, furnaces);
 
-    const std::uint32_t sectionMagic = kFurnaceSectionMagic;
-    const std::uint16_t furnaceCount = static_cast<std::uint16_t>(
-        std::min<std::size_t>(furnaces ? furnaces->size() : 0, 0xFFFFu));
-    out.write(reinterpret_cast<const char *>(&sectionMagic), sizeof(sectionMagic));
-    out.write(reinterpret_cast<const char *>(&furnaceCount), sizeof(furnaceCount));
-    if (furnaces != nullptr) {
-        for (std::size_t fi = 0; fi < furnaceCount; ++fi) {
-            const auto &r = (*furnaces)[fi];
-            out.write(reinterpret_cast<const char *>(&r.x), sizeof(r.x));
-            out.write(reinterpret_cast<const char *>(&r.y), sizeof(r.y));
-            out.write(reinterpret_cast<const char *>(&r.z), sizeof(r.z));
-            writeSlot(out, r.state.input);
-            writeSlot(out, r.state.fuel);
-            writeSlot(out, r.state.output);
-            out.write(reinterpret_cast<const char *>(&r.state.progressSeconds),
-                      sizeof(r.state.progressSeconds));
-            out.write(reinterpret_cast<const char *>(&r.state.burnSecondsRemaining),
-                      sizeof(r.state.burnSecondsRemaining));
-            out.write(reinterpret_cast<const char *>(&r.state.burnSecondsCapacity),
-                      sizeof(r.state.burnSecondsCapacity));
-        }
+    if (!out) {
+        return false;
     }
-
-    return static_cast<bool>(out);
+    const std::streamoff newBytes = std::max<std::streamoff>(0, out.tellp());
+    chunkWriteLog(worldDir).recordWrite(existed, existed ? oldBytes : 0u,
+                                        static_cast<std::uint64_t>(newBytes));
+    return true;
 }
 
 bool SaveManager::loadChunk(const std::filesystem::path &worldDir, std::uint32_t generatorVersion,
                             voxel::Chunk &chunk, world::ChunkCoord cc,
-                            std::vector<world::FurnaceRecordLocal> *furnacesOut) {
-    std::ifstream in(chunkPath(worldDir, cc), std::ios::binary);
-    if (!in) {
-        return false;
-    }
-
-    std::uint32_t magic = 0;
-    std::uint32_t version = 0;
-    std::uint16_t sx = 0;
-    std::uint16_t sy = 0;
-    std::uint16_t sz = 0;
-
-    in.read(reinterpret_cast<char *>(&magic), sizeof(magic));
-    in.read(reinterpret_cast<char *>(&version), sizeof(version));
-    in.read(reinterpret_cast<char *>(&sx), sizeof(sx));
-    in.read(reinterpret_cast<char *>(&sy), sizeof(sy));
-    in.read(reinterpret_cast<char *>(&sz), sizeof(sz));
-
-    if (!in || magic != 0x31584C56u || version != generatorVersion || sx != voxel::Chunk::SX ||
-        sy != voxel::Chunk::SY || sz != voxel::Chunk::SZ) {
-        return false;
-    }
-
-    auto &blocks = chunk.data();
-    blocks.assign(voxel::Chunk::SX * voxel::Chunk::SY * voxel::Chunk::SZ, voxel::AIR);
-
-    std::size_t writePos = 0;
-    while (in && writePos < blocks.size()) {
-        voxel::BlockId id = voxel::AIR;
-        std::uint16_t run = 0;
-        in.read(reinterpret_cast<char *>(&id), sizeof(id));
-        in.read(reinterpret_cast<char *>(&run), sizeof(run));
+                            std::vector<world::FurnaceRecordLocal> *furnacesOut,
+                            const world::WorldGen *baseGen, world::ChunkEdits *editsOut,
+                            bool migrateFull) {
+    std::vector<world::FurnaceRecordLocal> furnaces;
+    world::ChunkEdits edits;
+    bool fullFormat = false;
+    {
+        std::ifstream in(chunkPath(worldDir, cc), std::ios::binary);
         if (!in) {
-            break;
-        }
-        for (std::uint16_t ri = 0; ri < run && writePos < blocks.size(); ++ri) {
-            blocks[writePos++] = id;
+            return false;
         }
-    }
 
-    if (writePos != blocks.size()) {
-        return false;
-    }
+        std::uint32_t magic = 0;
+        std::uint32_t version = 0;
+        std::uint16_t sx = 0;
+        std::uint16_t sy = 0;
+        std::uint16_t sz = 0;
 
-    if (furnacesOut != nullptr) {
-        furnacesOut->clear();
-    }
+        in.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+        in.read(reinterpret_cast<char *>(&version), sizeof(version));
+        in.read(reinterpret_cast<char *>(&sx), sizeof(sx));
+        in.read(reinterpret_cast<char *>(&sy), sizeof(sy));
+        in.read(reinterpret_cast<char *>(&sz), sizeof(sz));
 
-    std::uint32_t sectionMagic = 0;
-    in.read(reinterpret_cast<char *>(&sectionMagic), sizeof(sectionMagic));
-    if (!in) {
-        return true; // older chunk format without furnace section
-    }
-    if (sectionMagic != kFurnaceSectionMagic) {
-        return true;
-    }
-    std::uint16_t furnaceCount = 0;
-    in.read(reinterpret_cast<char *>(&furnaceCount), sizeof(furnaceCount));
-    if (!in) {
-        return false;
-    }
-    for (std::uint16_t fi = 0; fi < furnaceCount; ++fi) {
-        world::FurnaceRecordLocal rec{};
-        in.read(reinterpret_cast<char *>(&rec.x), sizeof(rec.x));
-        in.read(reinterpret_cast<char *>(&rec.y), sizeof(rec.y));
-        in.read(reinterpret_cast<char *>(&rec.z), sizeof(rec.z));
-        if (!in || !readSlot(in, rec.state.input) || !readSlot(in, rec.state.fuel) ||
-            !readSlot(in, rec.state.output)) {
+        if (!in || sx != voxel::Chunk::SX || sy != voxel::Chunk::SY || sz != voxel::Chunk::SZ) {
             return false;
         }
-        in.read(reinterpret_cast<char *>(&rec.state.progressSeconds),
-                sizeof(rec.state.progressSeconds));
-        in.read(reinterpret_cast<char *>(&rec.state.burnSecondsRemaining),
-                sizeof(rec.state.burnSecondsRemaining));
-        in.read(reinterpret_cast<char *>(&rec.state.burnSecondsCapacity),
-                sizeof(rec.state.burnSecondsCapacity));
-        if (!in) {
+
+        auto &blocks = chunk.data();
+        if (magic == kFullChunkMagic) {
+            if (version != generatorVersion || !readFullBlocks(in, blocks)) {
+                return false;
+            }
+            fullFormat = true;
+        } else if (magic == kDeltaChunkMagic && baseGen != nullptr) {
+            // Edits replay over the current generator whatever version wrote
+            // them, so a generator bump keeps player changes.
+            blocks.assign(kChunkVolume, voxel::AIR);
+            baseGen->fillChunk(chunk, cc);
+            if (!readDeltaBlocks(in, blocks, edits)) {
+                return false;
+            }
+        } else {
             return false;
         }
-        if (furnacesOut != nullptr) {
-            furnacesOut->push_back(rec);
+
+        if (!readFurnaceSection(in, furnaces)) {
+            return false;
         }
     }
 
+    if (fullFormat && migrateFull && baseGen != nullptr) {
+        // Migrates full chunks to deltas the first time they load, the only
+        // time their terrain is regenerated to diff.
+        voxel::Chunk base;
+        baseGen->fillChunk(base, cc);
+        edits.cells = diffBlocks(base.data(), chunk.data());
+        (void)saveChunk(worldDir, generatorVersion, chunk, cc, &furnaces, &edits);
+    } else if (fullFormat) {
+        edits.overGenerated = false;
+    }
+    if (furnacesOut != nullptr) {
+        *furnacesOut = std::move(furnaces);
+    }
+    if (editsOut != nullptr) {
+        *editsOut = std::move(edits);
+    }
     return true;
 }
 
+ChunkWriteLog::Totals SaveManager::takeChunkWrites(const std::filesystem::path &worldDir) {
+    return chunkWriteLog(worldDir).take();
+}
+
 } // namespace app
@@ -0,0 +1,385 @@
+#include "app/WorldCatalog.hpp"
+
+#include "app/SaveManager.hpp"
+#include "game/MapSystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <unordered_map>
+#include <utility>
+
+namespace app {
+namespace {
+
+constexpr char kCatalogMagic[4] = {'V', 'X', 'C', '1'};
+constexpr char kIndexMagic[4] = {'V', 'X', 'I', '1'};
+constexpr const char *kCatalogFileName = "catalog.dat";
+constexpr const char *kIndexFileName = "index.dat";
+
+template <typename T> void writeRaw(std::ostream &out, const T &value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T> bool readRaw(std::istream &in, T &value) {
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+void writeString(std::ostream &out, const std::string &text) {
+    const std::uint16_t length =
+        static_cast<std::uint16_t>(std::min<std::size_t>(text.size(), 0xFFFFu));
+    writeRaw(out, length);
+    out.write(text.data(), length);
+}
+
+bool readString(std::istream &in, std::string &text) {
+    std::uint16_t length = 0;
+    if (!readRaw(in, length)) {
+        return false;
+    }
+    text.resize(length);
+    in.read(text.data(), length);
+    return static_cast<bool>(in);
+}
+
+void writeSummary(std::ostream &out, const WorldCatalogEntry &entry) {
+    writeString(out, entry.name);
+    writeRaw(out, entry.seed);
+    writeRaw(out, entry.lastPlayed);
+    writeRaw(out, entry.chunkCount);
+    writeRaw(out, entry.sizeBytes);
+    const std::uint16_t thumbSize =
+        entry.thumbnail.size() == static_cast<std::size_t>(WorldCatalog::kThumbnailSize) *
+                                      WorldCatalog::kThumbnailSize * 4u
+            ? static_cast<std::uint16_t>(WorldCatalog::kThumbnailSize)
+            : 0u;
+    writeRaw(out, thumbSize);
+    if (thumbSize != 0) {
+        out.write(reinterpret_cast<const char *>(entry.thumbnail.data()),
+                  static_cast<std::streamsize>(entry.thumbnail.size()));
+    }
+}
+
+bool readSummary(std::istream &in, WorldCatalogEntry &entry) {
+    std::uint16_t thumbSize = 0;
+    if (!readString(in, entry.name) || !readRaw(in, entry.seed) ||
+        !readRaw(in, entry.lastPlayed) || !readRaw(in, entry.chunkCount) ||
+        !readRaw(in, entry.sizeBytes) || !readRaw(in, thumbSize)) {
+        return false;
+    }
+    entry.thumbnail.clear();
+    if (thumbSize == 0) {
+        return true;
+    }
+    if (thumbSize != WorldCatalog::kThumbnailSize) {
+        return false;
+    }
+    entry.thumbnail.resize(static_cast<std::size_t>(thumbSize) * thumbSize * 4u);
+    in.read(reinterpret_cast<char *>(entry.thumbnail.data()),
+            static_cast<std::streamsize>(entry.thumbnail.size()));
+    return static_cast<bool>(in);
+}
+
+// Writes next to the target and renames, so a reader on another thread never
+// sees a partial file.
+template <typename WriteFn>
+bool replaceFile(const std::filesystem::path &target, const char (&magic)[4], WriteFn &&write) {
+    const std::filesystem::path tmp = target.string() + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out.write(magic, sizeof(magic));
+        write(out);
+        if (!out) {
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, target, ec);
+    return !ec;
+}
+
+bool checkMagic(std::istream &in, const char (&magic)[4]) {
+    char found[4] = {};
+    in.read(found, sizeof(found));
+    return in && std::equal(std::begin(found), std::end(found), std::begin(magic));
+}
+
+std::int64_t catalogStamp(const std::filesystem::path &worldDir) {
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(worldDir / kCatalogFileName, ec);
+    return ec ? 0 : static_cast<std::int64_t>(time.time_since_epoch().count());
+}
+
+std::int64_t unixSeconds(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+bool isChunkFile(const std::filesystem::path &path) {
+    return path.filename().string().rfind("chunk_", 0) == 0 && path.extension() == ".bin";
+}
+
+std::uint8_t toByte(float v) {
+    return static_cast<std::uint8_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f));
+}
+
+std::vector<std::uint8_t> makeThumbnail(const game::MapSystem &map, int centerWX, int centerWZ,
+                                        const game::MapTilePyramid::ColorFn &colorOf) {
+    constexpr int kSize = WorldCatalog::kThumbnailSize;
+    constexpr int kStride = WorldCatalog::kThumbnailStride;
+    std::vector<std::uint8_t> rgba(static_cast<std::size_t>(kSize) * kSize * 4u, 0u);
+    bool any = false;
+    const int x0 = centerWX - kSize * kStride / 2 + kStride / 2;
+    const int z0 = centerWZ - kSize * kStride / 2 + kStride / 2;
+    for (int ty = 0; ty < kSize; ++ty) {
+        for (int tx = 0; tx < kSize; ++tx) {
+            glm::vec3 c(0.0f);
+            if (!game::MapTilePyramid::shadeColumn(map, colorOf, x0 + tx * kStride,
+                                                   z0 + ty * kStride, c)) {
+                continue;
+            }
+            std::uint8_t *out = rgba.data() + (static_cast<std::size_t>(ty) * kSize + tx) * 4u;
+            out[0] = toByte(c.r);
+            out[1] = toByte(c.g);
+            out[2] = toByte(c.b);
+            out[3] = 255u;
+            any = true;
+        }
+    }
+    if (!any) {
+        rgba.clear();
+    }
+    return rgba;
+}
+
+} // namespace
+
+void WorldCatalog::flushChunkWrites(const std::filesystem::path &worldDir) {
+    const ChunkWriteLog::Totals pending = SaveManager::takeChunkWrites(worldDir);
+    if (pending.chunks == 0 && pending.bytes == 0) {
+        return;
+    }
+    WorldCatalogEntry entry;
+    // Without a catalog the next update() scans the folder anyway.
+    if (!loadCatalog(worldDir, entry)) {
+        return;
+    }
+    entry.chunkCount = static_cast<std::uint32_t>(
+        std::max<std::int64_t>(0, static_cast<std::int64_t>(entry.chunkCount) + pending.chunks));
+    entry.sizeBytes = static_cast<std::uint64_t>(
+        std::max<std::int64_t>(0, static_cast<std::int64_t>(entry.sizeBytes) + pending.bytes));
+    (void)saveCatalog(worldDir, entry);
+}
+
+bool WorldCatalog::update(const std::filesystem::path &worldDir, const std::string &name,
+                          std::uint32_t seed, const game::MapSystem &map, int centerWX,
+                          int centerWZ, const game::MapTilePyramid::ColorFn &colorOf) {
+    WorldCatalogEntry entry;
+    if (loadCatalog(worldDir, entry)) {
+        const ChunkWriteLog::Totals pending = SaveManager::takeChunkWrites(worldDir);
+        entry.chunkCount = static_cast<std::uint32_t>(std::max<std::int64_t>(
+            0, static_cast<std::int64_t>(entry.chunkCount) + pending.chunks));
+        entry.sizeBytes = static_cast<std::uint64_t>(std::max<std::int64_t>(
+            0, static_cast<std::int64_t>(entry.sizeBytes) + pending.bytes));
+    } else {
+        // The scan already sees every chunk written so far.
+        (void)SaveManager::takeChunkWrites(worldDir);
+        entry = scanWorld(worldDir, name, seed);
+    }
+    entry.name = name;
+    entry.seed = seed;
+    entry.lastPlayed = unixSeconds(std::chrono::system_clock::now());
+    std::vector<std::uint8_t> thumbnail = makeThumbnail(map, centerWX, centerWZ, colorOf);
+    if (!thumbnail.empty()) {
+        entry.thumbnail = std::move(thumbnail);
+    }
+    return saveCatalog(worldDir, entry);
+}
+
+bool WorldCatalog::loadCatalog(const std::filesystem::path &worldDir, WorldCatalogEntry &out) {
+    std::ifstream in(worldDir / kCatalogFileName, std::ios::binary);
+    if (!in || !checkMagic(in, kCatalogMagic)) {
+        return false;
+    }
+    WorldCatalogEntry entry;
+    if (!readSummary(in, entry)) {
+        return false;
+    }
+    entry.path = worldDir;
+    entry.catalogStamp = catalogStamp(worldDir);
+    out = std::move(entry);
+    return true;
+}
+
+bool WorldCatalog::saveCatalog(const std::filesystem::path &worldDir,
+                               const WorldCatalogEntry &entry) {
+    std::error_code ec;
+    std::filesystem::create_directories(worldDir, ec);
+    return replaceFile(worldDir / kCatalogFileName, kCatalogMagic,
+                       [&](std::ostream &out) { writeSummary(out, entry); });
+}
+
+WorldCatalogEntry WorldCatalog::scanWorld(const std::filesystem::path &worldDir,
+                                          const std::string &name, std::uint32_t seed) {
+    WorldCatalogEntry entry;
+    entry.path = worldDir;
+    entry.name = name;
+    entry.seed = seed;
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(worldDir, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        std::error_code fileEc;
+        if (!it->is_regular_file(fileEc)) {
+            continue;
+        }
+        const std::uintmax_t bytes = it->file_size(fileEc);
+        if (fileEc) {
+            continue;
+        }
+        entry.sizeBytes += bytes;
+        if (isChunkFile(it->path())) {
+            ++entry.chunkCount;
+        }
+    }
+    const auto played = std::filesystem::last_write_time(worldDir / "player.dat", ec);
+    if (!ec) {
+        entry.lastPlayed = unixSeconds(std::chrono::file_clock::to_sys(played));
+    }
+    return entry;
+}
+
+bool WorldCatalog::readWorldMeta(const std::filesystem::path &worldDir, std::string &outName,
+                                 std::uint32_t &outSeed) {
+    std::ifstream in(worldDir / "world.meta");
+    if (!in) {
+        return false;
+    }
+    std::string line;
+    bool hasName = false;
+    bool hasSeed = false;
+    while (std::getline(in, line)) {
+        const std::size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            continue;
+        }
+        const std::string key = line.substr(0, eq);
+        const std::string value = line.substr(eq + 1);
+        if (key == "name") {
+            outName = value;
+            hasName = true;
+        } else if (key == "seed") {
+            try {
+                outSeed = static_cast<std::uint32_t>(std::stoll(value));
+                hasSeed = true;
+            } catch (...) {
+                hasSeed = false;
+            }
+        }
+    }
+    return hasName && hasSeed;
+}
+
+std::vector<WorldCatalogEntry> WorldCatalog::readIndex(const std::filesystem::path &root) {
+    std::vector<WorldCatalogEntry> entries;
+    std::ifstream in(root / kIndexFileName, std::ios::binary);
+    std::uint32_t count = 0;
+    if (!in || !checkMagic(in, kIndexMagic) || !readRaw(in, count)) {
+        return entries;
+    }
+    entries.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        WorldCatalogEntry entry;
+        std::string path;
+        if (!readString(in, path) || !readRaw(in, entry.catalogStamp) ||
+            !readSummary(in, entry)) {
+            entries.clear();
+            return entries;
+        }
+        entry.path = std::filesystem::path(path);
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+bool WorldCatalog::writeIndex(const std::filesystem::path &root,
+                              const std::vector<WorldCatalogEntry> &entries) {
+    std::error_code ec;
+    std::filesystem::create_directories(root, ec);
+    return replaceFile(root / kIndexFileName, kIndexMagic, [&](std::ostream &out) {
+        writeRaw(out, static_cast<std::uint32_t>(entries.size()));
+        for (const WorldCatalogEntry &entry : entries) {
+            writeString(out, entry.path.generic_string());
+            writeRaw(out, entry.catalogStamp);
+            writeSummary(out, entry);
+        }
+    });
+}
+
+std::vector<WorldCatalogEntry> WorldCatalog::refresh(const std::filesystem::path &root,
+                                                     const std::filesystem::path &legacyDir,
+                                                     const std::atomic<bool> *cancel) {
+    std::unordered_map<std::string, WorldCatalogEntry> previous;
+    for (WorldCatalogEntry &entry : readIndex(root)) {
+        std::string key = entry.path.generic_string();
+        previous.emplace(std::move(key), std::move(entry));
+    }
+
+    std::vector<std::pair<std::filesystem::path, std::string>> folders;
+    std::error_code ec;
+    std::filesystem::create_directories(root, ec);
+    for (std::filesystem::directory_iterator it(root, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        std::error_code dirEc;
+        if (it->is_directory(dirEc)) {
+            folders.emplace_back(it->path(), it->path().filename().string());
+        }
+    }
+    if (std::filesystem::is_directory(legacyDir, ec)) {
+        folders.emplace_back(legacyDir, "Legacy World");
+    }
+
+    std::vector<WorldCatalogEntry> entries;
+    for (const auto &[path, defaultName] : folders) {
+        if (cancel != nullptr && cancel->load(std::memory_order_relaxed)) {
+            return {};
+        }
+        const std::int64_t stamp = catalogStamp(path);
+        if (stamp != 0) {
+            const auto it = previous.find(path.generic_string());
+            if (it != previous.end() && it->second.catalogStamp == stamp) {
+                entries.push_back(std::move(it->second));
+                continue;
+            }
+            WorldCatalogEntry entry;
+            if (loadCatalog(path, entry)) {
+                entries.push_back(std::move(entry));
+                continue;
+            }
+        }
+        // No usable catalog yet: scan once and write one so the next refresh
+        // is cheap.
+        std::string name = defaultName;
+        std::uint32_t seed = 1337u;
+        const bool hasMeta = readWorldMeta(path, name, seed);
+        WorldCatalogEntry entry = scanWorld(path, name, seed);
+        if (!hasMeta && entry.chunkCount == 0) {
+            continue;
+        }
+        if (saveCatalog(path, entry)) {
+            entry.catalogStamp = catalogStamp(path);
+        }
+        entries.push_back(std::move(entry));
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const WorldCatalogEntry &a, const WorldCatalogEntry &b) {
+                  return a.name < b.name;
+              });
+    (void)writeIndex(root, entries);
+    return entries;
+}
+
+} // namespace app
@@ -122,12 +122,10 @@ int CraftingMenu::inventorySlotAtCursor(double mx, double my, int width, int hei
 }
 
 void CraftingMenu::renderPanel(
-    int width, int height, float uiScale, bool usingCraftingTable, int hoveredSlotIndex,
-    int craftingGridSize,
+    int width, int height, float uiScale, bool usingCraftingTable, int craftingGridSize,
     const std::array<game::Inventory::Slot, game::CraftingSystem::kInputCount> &craftInput,
     const game::Inventory::Slot &craftOutput, const voxel::BlockRegistry &registry,
-    const HudDrawContext &draw, std::vector<SlotLabel> &slotLabels,
-    const std::function<void(voxel::BlockId, int)> &setHoverTip) const {
+    const HudDrawContext &draw, std::vector<SlotLabel> &slotLabels) const {
     const float cx = width * 0.5f;
     const float y0 = height - 90.0f * uiScale;
     const int cols = game::Inventory::kColumns;
@@ -200,10 +198,7 @@ void CraftingMenu::renderPanel(
                 slotLabels.push_back(
                     SlotLabel{sx + 5.0f, sy + craftSlot - 13.0f, std::to_string(slotData.count)});
             }
-            if (hoveredSlotIndex == uiIdx) {
-                draw.drawHoverOutline(sx, sy, craftSlot);
-                setHoverTip(slotData.id, slotData.count);
-            }
+            draw.markSlot(uiIdx, sx, sy, craftSlot, slotData.id, slotData.count);
         }
     }
 
@@ -226,10 +221,8 @@ void CraftingMenu::renderPanel(
         slotLabels.push_back(
             SlotLabel{craftOutX + 5.0f, craftOutY + craftSlot - 13.0f, std::to_string(craftOutput.count)});
     }
-    if (hoveredSlotIndex == craftOutputIndex) {
-        draw.drawHoverOutline(craftOutX, craftOutY, craftSlot);
-        setHoverTip(craftOutput.id, craftOutput.count);
-    }
+    draw.markSlot(craftOutputIndex, craftOutX, craftOutY, craftSlot, craftOutput.id,
+                  craftOutput.count);
 
     const float trashX = craftX - 10.0f * uiScale;
     const float invBorderBottomY = invY + invH + 10.0f * uiScale;
@@ -247,9 +240,7 @@ void CraftingMenu::renderPanel(
                   12.0f * uiScale, 0.92f, 0.82f, 0.82f, 0.85f);
     draw.drawRect(trashX + 28.0f * uiScale, trashY + 18.0f * uiScale, 2.0f * uiScale,
                   12.0f * uiScale, 0.92f, 0.82f, 0.82f, 0.85f);
-    if (hoveredSlotIndex == trashIndex) {
-        draw.drawHoverOutline(trashX, trashY, craftSlot);
-    }
+    draw.markSlot(trashIndex, trashX, trashY, craftSlot, voxel::AIR, 0);
 }
 
 bool CraftingMenu::isLookingAtCraftingTable(world::World &world, const game::Camera &camera,
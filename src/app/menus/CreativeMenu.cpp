@@ -5,19 +5,8 @@
 #include "game/Inventory.hpp"
 
 #include <algorithm>
-#include <cctype>
 
 namespace app::menus {
-namespace {
-
-std::string toLowerAscii(std::string s) {
-    for (char &c : s) {
-        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-    }
-    return s;
-}
-
-} // namespace
 
 const std::vector<voxel::BlockId> &CreativeMenu::catalog() const {
     static const std::vector<voxel::BlockId> kItems = {
@@ -75,12 +64,24 @@ const std::vector<voxel::BlockId> &CreativeMenu::catalog() const {
     return kItems;
 }
 
-bool CreativeMenu::itemMatchesSearch(voxel::BlockId id, const std::string &search) const {
-    const std::string needle = toLowerAscii(search);
-    if (needle.empty()) {
-        return true;
+const std::vector<voxel::BlockId> &CreativeMenu::matchingItems(const std::string &search) {
+    const auto &items = catalog();
+    if (searchIndex_.size() != items.size()) {
+        searchIndex_.clear();
+        for (voxel::BlockId id : items) {
+            searchIndex_.add({game::blockName(id)});
+        }
+        matchingQuery_.clear();
+        matchingItems_ = items;
+    }
+    if (search != matchingQuery_) {
+        matchingQuery_ = search;
+        matchingItems_.clear();
+        for (int index : searchIndex_.find(search)) {
+            matchingItems_.push_back(items[index]);
+        }
     }
-    return toLowerAscii(game::blockName(id)).find(needle) != std::string::npos;
+    return matchingItems_;
 }
 
 CreativeMenuLayout CreativeMenu::computeLayout(int width, int height, float hudScale,
@@ -181,12 +182,11 @@ int CreativeMenu::itemAtCursor(double mx, double my, const CreativeMenuLayout &l
 }
 
 void CreativeMenu::renderOverlay(int width, int height, float uiScale, int craftingGridSize,
-                                 bool usingFurnace, float cursorX, float cursorY,
-                                 float creativeScroll, float uiTimeSeconds,
+                                 bool usingFurnace, float creativeScroll,
                                  const std::string &creativeSearch,
                                  const std::vector<voxel::BlockId> &creativeItems,
                                  const voxel::BlockRegistry &registry,
-                                 const HudDrawContext &draw, TooltipState &tooltip) const {
+                                 const HudDrawContext &draw) const {
     const CreativeMenuLayout layout =
         computeLayout(width, height, uiScale, craftingGridSize, usingFurnace, creativeItems.size());
     draw.drawRect(layout.panelX, layout.panelY, layout.panelW, layout.panelH, 0.03f, 0.04f, 0.05f,
@@ -199,11 +199,10 @@ void CreativeMenu::renderOverlay(int width, int height, float uiScale, int craft
                   0.95f);
     draw.drawRect(layout.searchX + 1.0f, layout.searchY + 1.0f, layout.searchW - 2.0f,
                   layout.searchH - 2.0f, 0.12f, 0.14f, 0.18f, 0.95f);
-    const bool blinkOn = (static_cast<int>(std::floor(uiTimeSeconds * 2.0f)) % 2) == 0;
     const std::string searchText = creativeSearch.empty() ? "Search items..." : creativeSearch;
-    draw.drawText(layout.searchX + 6.0f * uiScale, layout.searchY + 7.0f * uiScale,
-                  searchText + (blinkOn ? "_" : ""), creativeSearch.empty() ? 168 : 232,
-                  creativeSearch.empty() ? 176 : 238, creativeSearch.empty() ? 190 : 248, 255);
+    draw.drawText(layout.searchX + 6.0f * uiScale, layout.searchY + 7.0f * uiScale, searchText,
+                  creativeSearch.empty() ? 168 : 232, creativeSearch.empty() ? 176 : 238,
+                  creativeSearch.empty() ? 190 : 248, 255);
 
     const std::size_t iconClipBatch = draw.beginIconClipBatch(
         layout.contentX, layout.contentY, layout.contentW, layout.contentH);
@@ -242,12 +241,6 @@ void CreativeMenu::renderOverlay(int width, int height, float uiScale, int craft
             draw.appendCubeIcon(sx + cubeInset, sy + cubeInset, layout.cell - 2.0f * cubeInset,
                                 layout.cell - 2.0f * cubeInset, def);
         }
-        if (cursorX >= sx && cursorX <= (sx + layout.cell) && cursorY >= sy &&
-            cursorY <= (sy + layout.cell)) {
-            tooltip.text = game::blockName(id);
-            tooltip.x = cursorX + 12.0f * uiScale;
-            tooltip.y = cursorY - 8.0f * uiScale;
-        }
     }
     draw.endIconClipBatch(iconClipBatch);
 
@@ -265,4 +258,30 @@ void CreativeMenu::renderOverlay(int width, int height, float uiScale, int craft
     }
 }
 
+void CreativeMenu::renderHover(int width, int height, float uiScale, int craftingGridSize,
+                               bool usingFurnace, float cursorX, float cursorY,
+                               float creativeScroll, float uiTimeSeconds,
+                               const std::string &creativeSearch,
+                               const std::vector<voxel::BlockId> &creativeItems,
+                               const HudDrawContext &draw, TooltipState &tooltip) const {
+    const CreativeMenuLayout layout =
+        computeLayout(width, height, uiScale, craftingGridSize, usingFurnace, creativeItems.size());
+    const bool blinkOn =
+        (static_cast<int>(std::floor(uiTimeSeconds * kMenuBlinkStepsPerSecond)) % 2) == 0;
+    if (blinkOn) {
+        const std::string searchText = creativeSearch.empty() ? "Search items..." : creativeSearch;
+        draw.drawText(layout.searchX + 6.0f * uiScale + draw.textWidthPx(searchText),
+                      layout.searchY + 7.0f * uiScale, "_", creativeSearch.empty() ? 168 : 232,
+                      creativeSearch.empty() ? 176 : 238, creativeSearch.empty() ? 190 : 248, 255);
+    }
+
+    const float scroll = std::clamp(creativeScroll, 0.0f, layout.maxScroll);
+    const int hovered = itemAtCursor(cursorX, cursorY, layout, scroll, creativeItems.size());
+    if (hovered >= 0) {
+        tooltip.text = game::blockName(creativeItems[static_cast<std::size_t>(hovered)]);
+        tooltip.x = cursorX + 12.0f * uiScale;
+        tooltip.y = cursorY - 8.0f * uiScale;
+    }
+}
+
 } // namespace app::menus
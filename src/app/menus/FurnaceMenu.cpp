@@ -29,13 +29,13 @@ bool FurnaceMenu::isLookingAtFurnace(world::World &world, const game::Camera &ca
     return lookedAtCell(world, camera, raycastDistance).has_value();
 }
 
-void FurnaceMenu::renderPanel(
-    int width, int height, float uiScale, int hoveredSlotIndex, int craftingGridSize,
-    const game::Inventory::Slot &smeltInput, const game::Inventory::Slot &smeltFuel,
-    const game::Inventory::Slot &smeltOutput, float smeltProgress01, float smeltFuel01,
-    const voxel::BlockRegistry &registry, const HudDrawContext &draw,
-    std::vector<SlotLabel> &slotLabels,
-    const std::function<void(voxel::BlockId, int)> &setHoverTip) const {
+void FurnaceMenu::renderPanel(int width, int height, float uiScale, int craftingGridSize,
+                              const game::Inventory::Slot &smeltInput,
+                              const game::Inventory::Slot &smeltFuel,
+                              const game::Inventory::Slot &smeltOutput, float smeltProgress01,
+                              float smeltFuel01, const voxel::BlockRegistry &registry,
+                              const HudDrawContext &draw,
+                              std::vector<SlotLabel> &slotLabels) const {
     const float cx = width * 0.5f;
     const float y0 = height - 90.0f * uiScale;
     const int cols = game::Inventory::kColumns;
@@ -112,18 +112,12 @@ void FurnaceMenu::renderPanel(
     const int furnaceFuelIndex = game::Inventory::kSlotCount + 1;
     const int craftOutputIndex = game::Inventory::kSlotCount + game::CraftingSystem::kInputCount;
     const int trashIndex = craftOutputIndex + 1;
-    if (hoveredSlotIndex == furnaceInputIndex) {
-        draw.drawHoverOutline(furnaceInX, furnaceInY, craftSlot);
-        setHoverTip(smeltInput.id, smeltInput.count);
-    }
-    if (hoveredSlotIndex == furnaceFuelIndex) {
-        draw.drawHoverOutline(furnaceFuelX, furnaceFuelY, craftSlot);
-        setHoverTip(smeltFuel.id, smeltFuel.count);
-    }
-    if (hoveredSlotIndex == craftOutputIndex) {
-        draw.drawHoverOutline(furnaceOutX, craftOutY, craftSlot);
-        setHoverTip(smeltOutput.id, smeltOutput.count);
-    }
+    draw.markSlot(furnaceInputIndex, furnaceInX, furnaceInY, craftSlot, smeltInput.id,
+                  smeltInput.count);
+    draw.markSlot(furnaceFuelIndex, furnaceFuelX, furnaceFuelY, craftSlot, smeltFuel.id,
+                  smeltFuel.count);
+    draw.markSlot(craftOutputIndex, furnaceOutX, craftOutY, craftSlot, smeltOutput.id,
+                  smeltOutput.count);
 
     const float inputCenterX = furnaceInX + craftSlot * 0.5f;
     const float outputCenterX = furnaceOutX + craftSlot * 0.5f;
@@ -164,9 +158,7 @@ void FurnaceMenu::renderPanel(
                   12.0f * uiScale, 0.92f, 0.82f, 0.82f, 0.85f);
     draw.drawRect(trashX + 28.0f * uiScale, trashY + 18.0f * uiScale, 2.0f * uiScale,
                   12.0f * uiScale, 0.92f, 0.82f, 0.82f, 0.85f);
-    if (hoveredSlotIndex == trashIndex) {
-        draw.drawHoverOutline(trashX, trashY, craftSlot);
-    }
+    draw.markSlot(trashIndex, trashX, trashY, craftSlot, voxel::AIR, 0);
 }
 
 } // namespace app::menus
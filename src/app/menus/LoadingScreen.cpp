@@ -0,0 +1,38 @@
+#include "app/menus/LoadingScreen.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace app::menus {
+
+void LoadingScreen::render(int width, int height, const std::string &title, int done,
+                           int total) const {
+    ui_.begin(width, height);
+
+    const float w = static_cast<float>(width);
+    const float h = static_cast<float>(height);
+    const float cx = w * 0.5f;
+    const float cy = h * 0.5f;
+    const float progress =
+        total > 0 ? std::clamp(static_cast<float>(done) / static_cast<float>(total), 0.0f, 1.0f)
+                  : 0.0f;
+
+    ui_.drawRect(0.0f, 0.0f, w, h, 0.05f, 0.06f, 0.08f, 1.0f);
+    ui_.drawText(cx - UiMenuRenderer::textWidthPx(title) * 0.5f, cy - 40.0f, title, 246, 248,
+                 252, 255);
+
+    const float barW = 320.0f;
+    const float barH = 14.0f;
+    const float barX = cx - barW * 0.5f;
+    ui_.drawRect(barX - 2.0f, cy - 2.0f, barW + 4.0f, barH + 4.0f, 0.08f, 0.08f, 0.11f, 0.96f);
+    ui_.drawRect(barX, cy, barW, barH, 0.16f, 0.17f, 0.21f, 0.96f);
+    ui_.drawRect(barX, cy, barW * progress, barH, 0.36f, 0.62f, 0.32f, 0.98f);
+
+    const std::string count =
+        std::to_string(std::min(done, total)) + " / " + std::to_string(total) + " chunks";
+    ui_.drawText(cx - UiMenuRenderer::textWidthPx(count) * 0.5f, cy + 28.0f, count, 208, 216,
+                 232, 255);
+    ui_.end();
+}
+
+} // namespace app::menus
@@ -5,8 +5,13 @@
 #include "voxel/Block.hpp"
 #include "voxel/Chunk.hpp"
 
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <vector>
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
@@ -49,6 +54,44 @@ glm::vec3 mapColorForBlock(voxel::BlockId id, const voxel::BlockRegistry &regist
 
 } // namespace
 
+MiniMapMenu::~MiniMapMenu() {
+    if (glfwGetCurrentContext() == nullptr || rasterTexture_ == 0) {
+        return;
+    }
+    glDeleteTextures(1, &rasterTexture_);
+}
+
+unsigned int MiniMapMenu::rasterTexture() const {
+    const std::vector<std::uint8_t> &rgba = raster_.rgba();
+    if (rasterTexture_ == 0) {
+        glGenTextures(1, &rasterTexture_);
+        glBindTexture(GL_TEXTURE_2D, rasterTexture_);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, game::MiniMapRaster::kSize,
+                     game::MiniMapRaster::kSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+        (void)raster_.consumeDirtyRects();
+        return rasterTexture_;
+    }
+    const std::vector<game::MiniMapRaster::Rect> dirty = raster_.consumeDirtyRects();
+    if (dirty.empty()) {
+        return rasterTexture_;
+    }
+    glBindTexture(GL_TEXTURE_2D, rasterTexture_);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, game::MiniMapRaster::kSize);
+    for (const game::MiniMapRaster::Rect &rect : dirty) {
+        const std::size_t offset =
+            (static_cast<std::size_t>(rect.z) * game::MiniMapRaster::kSize +
+             static_cast<std::size_t>(rect.x)) * 4u;
+        glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.z, rect.w, rect.h, GL_RGBA,
+                        GL_UNSIGNED_BYTE, rgba.data() + offset);
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    return rasterTexture_;
+}
+
 MiniMapLayout MiniMapMenu::computeLayout(int width) const {
     const float w = static_cast<float>(width);
     const float panelW = 190.0f;
@@ -147,62 +190,39 @@ void MiniMapMenu::render(gfx::HudRenderer &hud, int width, int height, const gam
     ui_.drawRect(gridX, gridY, gridW, gridH, 0.08f, 0.10f, 0.12f, 0.92f);
     ui_.drawText(panelX + 10.0f, panelY + 8.0f, "Mini Map", 228, 234, 246, 255);
 
-    for (int iz = 0; iz < drawRows; ++iz) {
-        for (int ix = 0; ix < drawCols; ++ix) {
-            const int dx = static_cast<int>(std::floor(static_cast<float>(ix) - centerIx));
-            const int dz = static_cast<int>(std::floor(static_cast<float>(iz) - centerIz));
-            int sdx = dx;
-            int sdz = dz;
+    const float pCenterX = gridX + centerIx * cell;
+    const float pCenterY = gridY + centerIz * cell;
+    raster_.update(
+        map, [&](voxel::BlockId id) { return mapColorForBlock(id, registry, atlas); }, playerWX,
+        playerWZ);
+    {
+        // Screen points map to world columns through zoom and, unless north
+        // is locked, the heading; the texture repeats, so ring coordinates
+        // (kept positive) address the raster directly.
+        const float c = std::cos(headingRad);
+        const float s = std::sin(headingRad);
+        const float size = static_cast<float>(game::MiniMapRaster::kSize);
+        const float ringX = static_cast<float>(game::MiniMapRaster::ringIndex(playerWX)) + 0.5f;
+        const float ringZ = static_cast<float>(game::MiniMapRaster::ringIndex(playerWZ)) + 0.5f;
+        auto uvAt = [&](float sx, float sy, float *out) {
+            float dx = (sx - (pCenterX + 0.5f)) / cell;
+            float dz = (sy - (pCenterY + 0.5f)) / cell;
             if (!northLocked) {
-                const float c = std::cos(headingRad);
-                const float s = std::sin(headingRad);
-                const float rx = static_cast<float>(dx) * c - static_cast<float>(dz) * s;
-                const float rz = static_cast<float>(dx) * s + static_cast<float>(dz) * c;
-                sdx = static_cast<int>(std::round(rx));
-                sdz = static_cast<int>(std::round(rz));
-            }
-            voxel::BlockId id = voxel::AIR;
-            if (!map.sample(playerWX + sdx, playerWZ + sdz, id)) {
-                continue;
-            }
-            glm::vec3 c = mapColorForBlock(id, registry, atlas);
-            int y = voxel::Chunk::SY / 2;
-            if (map.sampleHeight(playerWX + sdx, playerWZ + sdz, y)) {
-                int yX1 = y;
-                int yX0 = y;
-                int yZ1 = y;
-                int yZ0 = y;
-                (void)map.sampleHeight(playerWX + sdx + 1, playerWZ + sdz, yX1);
-                (void)map.sampleHeight(playerWX + sdx - 1, playerWZ + sdz, yX0);
-                (void)map.sampleHeight(playerWX + sdx, playerWZ + sdz + 1, yZ1);
-                (void)map.sampleHeight(playerWX + sdx, playerWZ + sdz - 1, yZ0);
-                const float slope = static_cast<float>((yX1 - yX0) - (yZ1 - yZ0));
-                const float shade = std::clamp(0.86f + slope * 0.026f, 0.68f, 1.18f);
-                const float altitude =
-                    std::clamp(0.90f + (static_cast<float>(y) / 127.0f) * 0.22f, 0.88f, 1.16f);
-                c *= shade * altitude;
-            }
-            bool waterCovered = false;
-            if (map.sampleWaterCover(playerWX + sdx, playerWZ + sdz, waterCovered) && waterCovered) {
-                const glm::vec3 waterTint(0.22f, 0.46f, 0.86f);
-                const float tintMix = voxel::isWaterloggedPlant(id) ? 0.10f
-                                     : (voxel::isPlant(id) ? 0.22f : 0.44f);
-                c = glm::mix(c, waterTint, tintMix);
-            }
-            c = glm::clamp(c, glm::vec3(0.0f), glm::vec3(1.0f));
-            const float px = gridX + static_cast<float>(ix) * cell;
-            const float py = gridY + static_cast<float>(iz) * cell;
-            const float pw = std::min(cell, (gridX + gridW) - px);
-            const float ph = std::min(cell, (gridY + gridH) - py);
-            if (pw <= 0.0f || ph <= 0.0f) {
-                continue;
+                const float rx = dx * c - dz * s;
+                const float rz = dx * s + dz * c;
+                dx = rx;
+                dz = rz;
             }
-            ui_.drawRect(px, py, pw, ph, c.r, c.g, c.b, 0.96f);
-        }
+            out[0] = (ringX + dx) / size + 1.0f;
+            out[1] = (ringZ + dz) / size + 1.0f;
+        };
+        float uv[8];
+        uvAt(gridX, gridY, uv);
+        uvAt(gridX + gridW, gridY, uv + 2);
+        uvAt(gridX + gridW, gridY + gridH, uv + 4);
+        uvAt(gridX, gridY + gridH, uv + 6);
+        ui_.drawImageCorners(rasterTexture(), gridX, gridY, gridW, gridH, uv, 1.0f);
     }
-
-    const float pCenterX = gridX + centerIx * cell;
-    const float pCenterY = gridY + centerIz * cell;
     auto drawFilledTri = [&](glm::vec2 a, glm::vec2 b, glm::vec2 c, float rr, float rg, float rb,
                              float ra) {
         const float minX = std::floor(std::min({a.x, b.x, c.x}));
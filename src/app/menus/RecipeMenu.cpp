@@ -4,16 +4,37 @@
 #include "game/Inventory.hpp"
 
 #include <algorithm>
-#include <cctype>
+#include <array>
+#include <cmath>
+#include <string>
 
 namespace app::menus {
 namespace {
 
-std::string toLowerAscii(std::string s) {
-    for (char &c : s) {
-        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+const std::array<voxel::BlockId, 3> kWoodCycle = {voxel::WOOD, voxel::SPRUCE_WOOD,
+                                                  voxel::BIRCH_WOOD};
+const std::array<voxel::BlockId, 3> kPlankCycle = {voxel::OAK_PLANKS, voxel::SPRUCE_PLANKS,
+                                                   voxel::BIRCH_PLANKS};
+
+std::string searchPlaceholderOr(const std::string &search, bool usingFurnace) {
+    if (!search.empty()) {
+        return search;
+    }
+    return usingFurnace ? "Search smelting..." : "Search recipes...";
+}
+
+void appendIngredientIcon(const HudDrawContext &draw, const voxel::BlockRegistry &registry,
+                          voxel::BlockId id, float iconX, float iconY, float iconS, float uiScale) {
+    const float drawX = iconX + 4.0f * uiScale;
+    const float drawY = iconY + 4.0f * uiScale;
+    const float drawS = iconS - 8.0f * uiScale;
+    if (draw.isFlatItemId(id)) {
+        draw.appendItemIcon(drawX, drawY, drawX + drawS, drawY + drawS, id, 1.0f);
+    } else {
+        const float cubeInset = 2.0f * uiScale;
+        draw.appendCubeIcon(iconX + cubeInset, iconY + cubeInset, iconS - 2.0f * cubeInset,
+                            iconS - 2.0f * cubeInset, registry.get(id));
     }
-    return s;
 }
 
 } // namespace
@@ -155,36 +176,28 @@ int RecipeMenu::rowAtCursor(double mx, double my, const RecipeMenuLayout &layout
     return -1;
 }
 
-bool RecipeMenu::matchesSearch(const game::CraftingSystem::RecipeInfo &recipe,
-                               const std::string &search) const {
-    const std::string needle = toLowerAscii(search);
-    if (needle.empty()) {
-        return true;
-    }
-    if (toLowerAscii(recipe.label).find(needle) != std::string::npos) {
-        return true;
-    }
-    if (toLowerAscii(game::blockName(recipe.outputId)).find(needle) != std::string::npos) {
-        return true;
-    }
-    for (const auto &ingredient : recipe.ingredients) {
-        if (ingredient.allowAnyWood) {
-            if (std::string("wood").find(needle) != std::string::npos ||
-                std::string("log").find(needle) != std::string::npos) {
-                return true;
-            }
-        }
-        if (ingredient.allowAnyPlanks) {
-            if (std::string("plank").find(needle) != std::string::npos ||
-                std::string("wood").find(needle) != std::string::npos) {
-                return true;
+const std::vector<int> &
+RecipeMenu::matchingRecipes(const std::vector<game::CraftingSystem::RecipeInfo> &recipes,
+                            const std::string &search) {
+    if (recipeIndex_.size() != recipes.size()) {
+        recipeIndex_.clear();
+        for (const auto &recipe : recipes) {
+            std::vector<std::string> texts{recipe.label, game::blockName(recipe.outputId)};
+            for (const auto &ingredient : recipe.ingredients) {
+                if (ingredient.allowAnyWood) {
+                    texts.emplace_back("wood");
+                    texts.emplace_back("log");
+                }
+                if (ingredient.allowAnyPlanks) {
+                    texts.emplace_back("plank");
+                    texts.emplace_back("wood");
+                }
+                texts.emplace_back(game::blockName(ingredient.id));
             }
-        }
-        if (toLowerAscii(game::blockName(ingredient.id)).find(needle) != std::string::npos) {
-            return true;
+            recipeIndex_.add(texts);
         }
     }
-    return false;
+    return recipeIndex_.find(search);
 }
 
 bool RecipeMenu::usesIngredient(const game::CraftingSystem::RecipeInfo &recipe,
@@ -219,33 +232,28 @@ bool RecipeMenu::usesIngredient(const game::CraftingSystem::RecipeInfo &recipe,
     return false;
 }
 
-bool RecipeMenu::smeltingMatchesSearch(const game::SmeltingSystem::Recipe &recipe,
-                                       const std::string &search) const {
-    const std::string needle = toLowerAscii(search);
-    if (needle.empty()) {
-        return true;
-    }
-    if (toLowerAscii(game::blockName(recipe.input)).find(needle) != std::string::npos) {
-        return true;
-    }
-    if (toLowerAscii(game::blockName(recipe.output)).find(needle) != std::string::npos) {
-        return true;
+const std::vector<int> &
+RecipeMenu::matchingSmeltingRecipes(const std::vector<game::SmeltingSystem::Recipe> &recipes,
+                                    const std::string &search) {
+    if (smeltingIndex_.size() != recipes.size()) {
+        smeltingIndex_.clear();
+        for (const auto &recipe : recipes) {
+            smeltingIndex_.add({game::blockName(recipe.input), game::blockName(recipe.output)});
+        }
     }
-    return false;
+    return smeltingIndex_.find(search);
 }
 
 void RecipeMenu::renderOverlay(int width, int height, float uiScale, int craftingGridSize,
-                               bool usingFurnace, float cursorX, float cursorY, float recipeScroll,
-                               float uiTimeSeconds, const std::string &recipeSearch,
-                               bool recipeCraftableOnly,
+                               bool usingFurnace, float recipeScroll,
+                               const std::string &recipeSearch, bool recipeCraftableOnly,
                                const std::optional<voxel::BlockId> &recipeIngredientFilter,
                                const std::vector<game::CraftingSystem::RecipeInfo> &recipes,
                                const std::vector<game::SmeltingSystem::Recipe> &smeltingRecipes,
                                const std::vector<bool> &recipeCraftable,
                                const voxel::BlockRegistry &registry,
                                const HudDrawContext &draw,
-                               std::vector<RecipeNameLabel> &recipeNameLabels,
-                               TooltipState &tooltip) const {
+                               std::vector<RecipeNameLabel> &recipeNameLabels) const {
     const std::size_t rowCount = usingFurnace ? smeltingRecipes.size() : recipes.size();
     const RecipeMenuLayout layout =
         computeLayout(width, height, uiScale, craftingGridSize, usingFurnace, rowCount);
@@ -261,12 +269,8 @@ void RecipeMenu::renderOverlay(int width, int height, float uiScale, int craftin
                   0.95f);
     draw.drawRect(layout.searchX + 1.0f, layout.searchY + 1.0f, layout.searchW - 2.0f,
                   layout.searchH - 2.0f, 0.12f, 0.14f, 0.18f, 0.95f);
-    const std::string searchText = recipeSearch.empty()
-                                       ? (usingFurnace ? "Search smelting..." : "Search recipes...")
-                                       : recipeSearch;
-    const bool blinkOn = (static_cast<int>(std::floor(uiTimeSeconds * 2.0f)) % 2) == 0;
     draw.drawText(layout.searchX + 6.0f * uiScale, layout.searchY + 7.0f * uiScale,
-                  searchText + (blinkOn ? "_" : ""), recipeSearch.empty() ? 168 : 232,
+                  searchPlaceholderOr(recipeSearch, usingFurnace), recipeSearch.empty() ? 168 : 232,
                   recipeSearch.empty() ? 176 : 238, recipeSearch.empty() ? 190 : 248, 255);
     draw.drawRect(layout.craftableFilterX, layout.craftableFilterY, layout.craftableFilterSize,
                   layout.craftableFilterSize, 0.09f, 0.10f, 0.12f, 0.95f);
@@ -314,7 +318,6 @@ void RecipeMenu::renderOverlay(int width, int height, float uiScale, int craftin
                   0.70f);
     const std::size_t recipeIconClipBatch =
         draw.beginIconClipBatch(layout.contentX, layout.contentY, layout.contentW, layout.contentH);
-    std::string hoveredIngredientName;
 
     if (usingFurnace) {
         const float cellH = 74.0f * uiScale;
@@ -335,16 +338,13 @@ void RecipeMenu::renderOverlay(int width, int height, float uiScale, int craftin
             if (ry + cellH < layout.contentY || ry > (layout.contentY + layout.contentH)) {
                 continue;
             }
-            const bool hovered =
-                (cursorX >= rx && cursorX <= (rx + layout.cellW) && cursorY >= ry && cursorY <= (ry + cellH));
             const bool craftable = i < recipeCraftable.size() && recipeCraftable[i];
             const float baseR = craftable ? 0.12f : 0.10f;
             const float baseG = craftable ? 0.20f : 0.12f;
             const float baseB = craftable ? 0.13f : 0.15f;
-            const float glow = hovered ? 0.08f : 0.0f;
             draw.drawRectClipped(rx, ry, layout.cellW, cellH, layout.contentX, layout.contentY,
                                  layout.contentX + layout.contentW, layout.contentY + layout.contentH,
-                                 baseR + glow, baseG + glow, baseB + glow, craftable ? 0.92f : 0.86f);
+                                 baseR, baseG, baseB, craftable ? 0.92f : 0.86f);
             draw.drawRectClipped(rx + 2.0f * uiScale, ry + 2.0f * uiScale, layout.cellW - 4.0f * uiScale,
                                  cellH - 4.0f * uiScale, layout.contentX, layout.contentY,
                                  layout.contentX + layout.contentW, layout.contentY + layout.contentH,
@@ -365,10 +365,6 @@ void RecipeMenu::renderOverlay(int width, int height, float uiScale, int craftin
                 draw.appendCubeIcon(iconX + inset, iconY + inset, iconS - 2.0f * inset,
                                     iconS - 2.0f * inset, registry.get(recipe.input));
             }
-            if (cursorX >= iconX && cursorX <= (iconX + iconS) && cursorY >= iconY &&
-                cursorY <= (iconY + iconS)) {
-                hoveredIngredientName = game::blockName(recipe.input);
-            }
             iconX += 46.0f * uiScale;
             draw.drawTextClipped(iconX, ry + 21.0f * uiScale, "->", layout.contentX, layout.contentY,
                                  layout.contentX + layout.contentW, layout.contentY + layout.contentH, 230,
@@ -386,10 +382,6 @@ void RecipeMenu::renderOverlay(int width, int height, float uiScale, int craftin
                 draw.appendCubeIcon(iconX + inset, iconY + inset, iconS - 2.0f * inset,
                                     iconS - 2.0f * inset, registry.get(recipe.output));
             }
-            if (cursorX >= iconX && cursorX <= (iconX + iconS) && cursorY >= iconY &&
-                cursorY <= (iconY + iconS)) {
-                hoveredIngredientName = game::blockName(recipe.output);
-            }
             draw.drawTextClipped(iconX + 2.0f * uiScale, iconY + iconS - 10.0f * uiScale,
                                  std::to_string(std::max(1, recipe.outputCount)), layout.contentX,
                                  layout.contentY, layout.contentX + layout.contentW,
@@ -420,11 +412,6 @@ void RecipeMenu::renderOverlay(int width, int height, float uiScale, int craftin
         }
     } else {
         const float scroll = std::clamp(recipeScroll, 0.0f, layout.maxScroll);
-        const std::array<voxel::BlockId, 3> woodCycle = {voxel::WOOD, voxel::SPRUCE_WOOD, voxel::BIRCH_WOOD};
-        const std::array<voxel::BlockId, 3> plankCycle = {voxel::OAK_PLANKS, voxel::SPRUCE_PLANKS,
-                                                          voxel::BIRCH_PLANKS};
-        const int cycleIndex =
-            static_cast<int>(std::floor(std::max(0.0f, uiTimeSeconds) * 0.6f)) % static_cast<int>(woodCycle.size());
         for (std::size_t i = 0; i < recipes.size(); ++i) {
             const auto &recipe = recipes[i];
             const int row = static_cast<int>(i) / layout.columns;
@@ -435,67 +422,32 @@ void RecipeMenu::renderOverlay(int width, int height, float uiScale, int craftin
             if (ry + layout.cellH < layout.contentY || ry > (layout.contentY + layout.contentH)) {
                 continue;
             }
-            const bool hovered = (cursorX >= rx && cursorX <= (rx + layout.cellW) && cursorY >= ry &&
-                                  cursorY <= (ry + layout.cellH));
             const bool craftable = i < recipeCraftable.size() && recipeCraftable[i];
             const float baseR = craftable ? 0.12f : 0.10f;
             const float baseG = craftable ? 0.20f : 0.12f;
             const float baseB = craftable ? 0.13f : 0.15f;
-            const float glow = hovered ? 0.08f : 0.0f;
             draw.drawRectClipped(rx, ry, layout.cellW, layout.cellH, layout.contentX, layout.contentY,
                                  layout.contentX + layout.contentW, layout.contentY + layout.contentH,
-                                 baseR + glow, baseG + glow, baseB + glow, craftable ? 0.92f : 0.86f);
+                                 baseR, baseG, baseB, craftable ? 0.92f : 0.86f);
             draw.drawRectClipped(rx + 2.0f * uiScale, ry + 2.0f * uiScale, layout.cellW - 4.0f * uiScale,
                                  layout.cellH - 4.0f * uiScale, layout.contentX, layout.contentY,
                                  layout.contentX + layout.contentW, layout.contentY + layout.contentH,
                                  craftable ? 0.18f : 0.14f, craftable ? 0.22f : 0.16f,
                                  craftable ? 0.18f : 0.20f, 0.82f);
-            if (hovered) {
-                draw.drawRectClipped(rx - 1.0f, ry - 1.0f, layout.cellW + 2.0f, 2.0f, layout.contentX,
-                                     layout.contentY, layout.contentX + layout.contentW,
-                                     layout.contentY + layout.contentH, 0.38f, 0.80f, 1.0f, 0.95f);
-                draw.drawRectClipped(rx - 1.0f, ry + layout.cellH - 1.0f, layout.cellW + 2.0f, 2.0f,
-                                     layout.contentX, layout.contentY, layout.contentX + layout.contentW,
-                                     layout.contentY + layout.contentH, 0.38f, 0.80f, 1.0f, 0.95f);
-                draw.drawRectClipped(rx - 1.0f, ry, 2.0f, layout.cellH, layout.contentX, layout.contentY,
-                                     layout.contentX + layout.contentW, layout.contentY + layout.contentH,
-                                     0.38f, 0.80f, 1.0f, 0.95f);
-                draw.drawRectClipped(rx + layout.cellW - 1.0f, ry, 2.0f, layout.cellH, layout.contentX,
-                                     layout.contentY, layout.contentX + layout.contentW,
-                                     layout.contentY + layout.contentH, 0.38f, 0.80f, 1.0f, 0.95f);
-            }
             float iconX = rx + 8.0f * uiScale;
             const float iconY = ry + 7.0f * uiScale;
             const float iconS = 36.0f * uiScale;
             for (const auto &in : recipe.ingredients) {
-                voxel::BlockId renderId = in.id;
-                if (in.allowAnyWood) {
-                    renderId = woodCycle[cycleIndex];
-                } else if (in.allowAnyPlanks) {
-                    renderId = plankCycle[cycleIndex];
-                }
                 draw.drawRectClipped(iconX, iconY, iconS, iconS, layout.contentX, layout.contentY,
                                      layout.contentX + layout.contentW, layout.contentY + layout.contentH,
                                      0.08f, 0.10f, 0.12f, 0.95f);
-                const float drawX = iconX + 4.0f * uiScale;
-                const float drawY = iconY + 4.0f * uiScale;
-                const float drawS = iconS - 8.0f * uiScale;
-                if (draw.isFlatItemId(renderId)) {
-                    draw.appendItemIcon(drawX, drawY, drawX + drawS, drawY + drawS, renderId, 1.0f);
-                } else {
-                    const float cubeInset = 2.0f * uiScale;
-                    draw.appendCubeIcon(iconX + cubeInset, iconY + cubeInset, iconS - 2.0f * cubeInset,
-                                        iconS - 2.0f * cubeInset, registry.get(renderId));
+                if (!in.allowAnyWood && !in.allowAnyPlanks) {
+                    appendIngredientIcon(draw, registry, in.id, iconX, iconY, iconS, uiScale);
                 }
                 draw.drawTextClipped(iconX + 2.0f * uiScale, iconY + iconS - 10.0f * uiScale,
                                      std::to_string(in.count), layout.contentX, layout.contentY,
                                      layout.contentX + layout.contentW, layout.contentY + layout.contentH,
                                      232, 236, 246, 255);
-                if (cursorX >= iconX && cursorX <= (iconX + iconS) && cursorY >= iconY &&
-                    cursorY <= (iconY + iconS)) {
-                    hoveredIngredientName = (in.allowAnyWood || in.allowAnyPlanks) ? game::blockName(renderId)
-                                                                                    : game::blockName(in.id);
-                }
                 iconX += 48.0f * uiScale;
             }
             draw.drawTextClipped(iconX, ry + 19.0f * uiScale, "->", layout.contentX, layout.contentY,
@@ -515,10 +467,6 @@ void RecipeMenu::renderOverlay(int width, int height, float uiScale, int craftin
                                     iconS - 2.0f * outCubeInset, iconS - 2.0f * outCubeInset,
                                     registry.get(recipe.outputId));
             }
-            if (cursorX >= iconX && cursorX <= (iconX + iconS) && cursorY >= iconY &&
-                cursorY <= (iconY + iconS)) {
-                hoveredIngredientName = game::blockName(recipe.outputId);
-            }
             draw.drawTextClipped(iconX + 2.0f * uiScale, iconY + iconS - 10.0f * uiScale,
                                  std::to_string(recipe.outputCount), layout.contentX, layout.contentY,
                                  layout.contentX + layout.contentW, layout.contentY + layout.contentH, 232,
@@ -551,6 +499,127 @@ void RecipeMenu::renderOverlay(int width, int height, float uiScale, int craftin
     }
 
     draw.endIconClipBatch(recipeIconClipBatch);
+}
+
+void RecipeMenu::renderHover(int width, int height, float uiScale, int craftingGridSize,
+                             bool usingFurnace, float cursorX, float cursorY, float recipeScroll,
+                             float uiTimeSeconds, const std::string &recipeSearch,
+                             const std::vector<game::CraftingSystem::RecipeInfo> &recipes,
+                             const std::vector<game::SmeltingSystem::Recipe> &smeltingRecipes,
+                             const voxel::BlockRegistry &registry, const HudDrawContext &draw,
+                             TooltipState &tooltip) const {
+    const std::size_t rowCount = usingFurnace ? smeltingRecipes.size() : recipes.size();
+    const RecipeMenuLayout layout =
+        computeLayout(width, height, uiScale, craftingGridSize, usingFurnace, rowCount);
+
+    const bool blinkOn =
+        (static_cast<int>(std::floor(uiTimeSeconds * kMenuBlinkStepsPerSecond)) % 2) == 0;
+    if (blinkOn) {
+        const std::string searchText = searchPlaceholderOr(recipeSearch, usingFurnace);
+        draw.drawText(layout.searchX + 6.0f * uiScale + draw.textWidthPx(searchText),
+                      layout.searchY + 7.0f * uiScale, "_", recipeSearch.empty() ? 168 : 232,
+                      recipeSearch.empty() ? 176 : 238, recipeSearch.empty() ? 190 : 248, 255);
+    }
+
+    const float clipX1 = layout.contentX + layout.contentW;
+    const float clipY1 = layout.contentY + layout.contentH;
+    const auto overCell = [&](float x, float y, float w, float h) {
+        return cursorX >= x && cursorX <= (x + w) && cursorY >= y && cursorY <= (y + h);
+    };
+    const auto glowCell = [&](float rx, float ry, float cellH) {
+        draw.drawRectClipped(rx, ry, layout.cellW, cellH, layout.contentX, layout.contentY, clipX1,
+                             clipY1, 1.0f, 1.0f, 1.0f, 0.06f);
+    };
+    const float iconS = 36.0f * uiScale;
+    std::string hoveredIngredientName;
+    const std::size_t iconClipBatch =
+        draw.beginIconClipBatch(layout.contentX, layout.contentY, layout.contentW, layout.contentH);
+
+    if (usingFurnace) {
+        const float cellH = 74.0f * uiScale;
+        const float rowStride = cellH + layout.cellGapY;
+        const int rowsCount =
+            (static_cast<int>(smeltingRecipes.size()) + layout.columns - 1) / layout.columns;
+        const float totalContentH =
+            static_cast<float>(rowsCount) * cellH +
+            static_cast<float>(std::max(0, rowsCount - 1)) * layout.cellGapY;
+        const float maxScroll = std::max(0.0f, totalContentH - layout.contentH);
+        const float scroll = std::clamp(recipeScroll, 0.0f, maxScroll);
+        for (std::size_t i = 0; i < smeltingRecipes.size(); ++i) {
+            const int row = static_cast<int>(i) / layout.columns;
+            const int col = static_cast<int>(i) % layout.columns;
+            const float rx = layout.contentX + layout.gridInsetLeft +
+                             static_cast<float>(col) * (layout.cellW + layout.cellGapX);
+            const float ry = layout.contentY + static_cast<float>(row) * rowStride - scroll;
+            if (ry + cellH < layout.contentY || ry > clipY1 ||
+                !overCell(rx, ry, layout.cellW, cellH)) {
+                continue;
+            }
+            glowCell(rx, ry, cellH);
+            const float iconY = ry + 8.0f * uiScale;
+            const float inputX = rx + 10.0f * uiScale;
+            const float outputX = inputX + 64.0f * uiScale;
+            if (overCell(inputX, iconY, iconS, iconS)) {
+                hoveredIngredientName = game::blockName(smeltingRecipes[i].input);
+            } else if (overCell(outputX, iconY, iconS, iconS)) {
+                hoveredIngredientName = game::blockName(smeltingRecipes[i].output);
+            }
+        }
+    } else {
+        const float scroll = std::clamp(recipeScroll, 0.0f, layout.maxScroll);
+        const int cycleIndex =
+            static_cast<int>(std::floor(std::max(0.0f, uiTimeSeconds) * kMenuCycleStepsPerSecond)) %
+            static_cast<int>(kWoodCycle.size());
+        for (std::size_t i = 0; i < recipes.size(); ++i) {
+            const auto &recipe = recipes[i];
+            const int row = static_cast<int>(i) / layout.columns;
+            const int col = static_cast<int>(i) % layout.columns;
+            const float rx = layout.contentX + layout.gridInsetLeft +
+                             static_cast<float>(col) * (layout.cellW + layout.cellGapX);
+            const float ry = layout.contentY + static_cast<float>(row) * layout.rowStride - scroll;
+            if (ry + layout.cellH < layout.contentY || ry > clipY1) {
+                continue;
+            }
+            const bool hovered = overCell(rx, ry, layout.cellW, layout.cellH);
+            if (hovered) {
+                glowCell(rx, ry, layout.cellH);
+                draw.drawRectClipped(rx - 1.0f, ry - 1.0f, layout.cellW + 2.0f, 2.0f,
+                                     layout.contentX, layout.contentY, clipX1, clipY1, 0.38f,
+                                     0.80f, 1.0f, 0.95f);
+                draw.drawRectClipped(rx - 1.0f, ry + layout.cellH - 1.0f, layout.cellW + 2.0f, 2.0f,
+                                     layout.contentX, layout.contentY, clipX1, clipY1, 0.38f, 0.80f,
+                                     1.0f, 0.95f);
+                draw.drawRectClipped(rx - 1.0f, ry, 2.0f, layout.cellH, layout.contentX,
+                                     layout.contentY, clipX1, clipY1, 0.38f, 0.80f, 1.0f, 0.95f);
+                draw.drawRectClipped(rx + layout.cellW - 1.0f, ry, 2.0f, layout.cellH,
+                                     layout.contentX, layout.contentY, clipX1, clipY1, 0.38f, 0.80f,
+                                     1.0f, 0.95f);
+            }
+            float iconX = rx + 8.0f * uiScale;
+            const float iconY = ry + 7.0f * uiScale;
+            for (const auto &in : recipe.ingredients) {
+                voxel::BlockId renderId = in.id;
+                if (in.allowAnyWood) {
+                    renderId = kWoodCycle[cycleIndex];
+                } else if (in.allowAnyPlanks) {
+                    renderId = kPlankCycle[cycleIndex];
+                }
+                if (in.allowAnyWood || in.allowAnyPlanks) {
+                    appendIngredientIcon(draw, registry, renderId, iconX, iconY, iconS, uiScale);
+                }
+                if (hovered && overCell(iconX, iconY, iconS, iconS)) {
+                    hoveredIngredientName = game::blockName(renderId);
+                }
+                iconX += 48.0f * uiScale;
+            }
+            iconX += 20.0f * uiScale;
+            if (hovered && overCell(iconX, iconY, iconS, iconS)) {
+                hoveredIngredientName = game::blockName(recipe.outputId);
+            }
+        }
+    }
+
+    draw.endIconClipBatch(iconClipBatch);
     if (!hoveredIngredientName.empty()) {
         tooltip.text = hoveredIngredientName;
         tooltip.x = cursorX + 12.0f * uiScale;
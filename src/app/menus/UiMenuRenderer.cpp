@@ -21,26 +21,35 @@ void UiMenuRenderer::init() {
     const char *vs = R"(
 #version 330 core
 layout(location=0) in vec2 aPos;
-layout(location=1) in vec4 aColor;
+layout(location=1) in vec2 aUV;
+layout(location=2) in vec4 aColor;
 uniform vec2 uScreen;
+out vec2 vUV;
 out vec4 vColor;
 void main() {
   vec2 ndc = vec2((aPos.x / uScreen.x) * 2.0 - 1.0, 1.0 - (aPos.y / uScreen.y) * 2.0);
   gl_Position = vec4(ndc, 0.0, 1.0);
+  vUV = aUV;
   vColor = aColor;
 }
 )";
 
     const char *fs = R"(
 #version 330 core
+in vec2 vUV;
 in vec4 vColor;
+uniform sampler2D uImage;
 out vec4 FragColor;
-void main() { FragColor = vColor; }
+void main() {
+  FragColor = vUV.x < 0.0 ? vColor : texture(uImage, vUV) * vColor;
+}
 )";
 
     shader_ = app::util::linkInLineProgram(
         app::util::compileInlineShader(GL_VERTEX_SHADER, vs),
         app::util::compileInlineShader(GL_FRAGMENT_SHADER, fs));
+    uScreen_ = glGetUniformLocation(shader_, "uScreen");
+    uImage_ = glGetUniformLocation(shader_, "uImage");
 
     glGenVertexArrays(1, &vao_);
     glGenBuffers(1, &vbo_);
@@ -50,8 +59,11 @@ void main() { FragColor = vColor; }
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(UiVertex), reinterpret_cast<void *>(0));
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(UiVertex),
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(UiVertex),
                           reinterpret_cast<void *>(2 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(UiVertex),
+                          reinterpret_cast<void *>(4 * sizeof(float)));
 
     ready_ = true;
 }
@@ -61,20 +73,44 @@ void UiMenuRenderer::begin(int width, int height) {
     width_ = width;
     height_ = height;
     verts_.clear();
+    batches_.clear();
 }
 
-void UiMenuRenderer::drawRect(float x, float y, float w, float h, float r, float g, float b,
-                              float a) {
-    const UiVertex v0{x, y, r, g, b, a};
-    const UiVertex v1{x + w, y, r, g, b, a};
-    const UiVertex v2{x + w, y + h, r, g, b, a};
-    const UiVertex v3{x, y + h, r, g, b, a};
+void UiMenuRenderer::pushQuad(const UiVertex &v0, const UiVertex &v1, const UiVertex &v2,
+                              const UiVertex &v3, unsigned int texture) {
+    if (batches_.empty() || batches_.back().texture != texture) {
+        batches_.push_back(Batch{texture, verts_.size(), 0});
+    }
     verts_.push_back(v0);
     verts_.push_back(v1);
     verts_.push_back(v2);
     verts_.push_back(v0);
     verts_.push_back(v2);
     verts_.push_back(v3);
+    batches_.back().count += 6;
+}
+
+void UiMenuRenderer::drawRect(float x, float y, float w, float h, float r, float g, float b,
+                              float a) {
+    pushQuad(UiVertex{x, y, -1.0f, 0.0f, r, g, b, a}, UiVertex{x + w, y, -1.0f, 0.0f, r, g, b, a},
+             UiVertex{x + w, y + h, -1.0f, 0.0f, r, g, b, a},
+             UiVertex{x, y + h, -1.0f, 0.0f, r, g, b, a}, 0);
+}
+
+void UiMenuRenderer::drawImage(unsigned int texture, float x, float y, float w, float h, float u0,
+                               float v0, float u1, float v1, float a) {
+    pushQuad(UiVertex{x, y, u0, v0, 1.0f, 1.0f, 1.0f, a},
+             UiVertex{x + w, y, u1, v0, 1.0f, 1.0f, 1.0f, a},
+             UiVertex{x + w, y + h, u1, v1, 1.0f, 1.0f, 1.0f, a},
+             UiVertex{x, y + h, u0, v1, 1.0f, 1.0f, 1.0f, a}, texture);
+}
+
+void UiMenuRenderer::drawImageCorners(unsigned int texture, float x, float y, float w, float h,
+                                      const float (&uv)[8], float a) {
+    pushQuad(UiVertex{x, y, uv[0], uv[1], 1.0f, 1.0f, 1.0f, a},
+             UiVertex{x + w, y, uv[2], uv[3], 1.0f, 1.0f, 1.0f, a},
+             UiVertex{x + w, y + h, uv[4], uv[5], 1.0f, 1.0f, 1.0f, a},
+             UiVertex{x, y + h, uv[6], uv[7], 1.0f, 1.0f, 1.0f, a}, texture);
 }
 
 void UiMenuRenderer::drawText(float x, float y, const std::string &text, unsigned char r,
@@ -93,20 +129,12 @@ void UiMenuRenderer::drawText(float x, float y, const std::string &text, unsigne
 
     const StbVert *q = reinterpret_cast<const StbVert *>(buffer);
     for (int i = 0; i < quads; ++i) {
-        const StbVert &a0 = q[i * 4 + 0];
-        const StbVert &a1 = q[i * 4 + 1];
-        const StbVert &a2 = q[i * 4 + 2];
-        const StbVert &a3 = q[i * 4 + 3];
-        auto push = [&](const StbVert &v) {
-            verts_.push_back(UiVertex{v.x, v.y, v.c[0] / 255.0f, v.c[1] / 255.0f, v.c[2] / 255.0f,
-                                      v.c[3] / 255.0f});
+        auto vertex = [](const StbVert &v) {
+            return UiVertex{v.x, v.y, -1.0f, 0.0f, v.c[0] / 255.0f, v.c[1] / 255.0f,
+                            v.c[2] / 255.0f, v.c[3] / 255.0f};
         };
-        push(a0);
-        push(a1);
-        push(a2);
-        push(a0);
-        push(a2);
-        push(a3);
+        pushQuad(vertex(q[i * 4 + 0]), vertex(q[i * 4 + 1]), vertex(q[i * 4 + 2]),
+                 vertex(q[i * 4 + 3]), 0);
     }
 }
 
@@ -115,13 +143,20 @@ void UiMenuRenderer::end() {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glDisable(GL_DEPTH_TEST);
     glUseProgram(shader_);
-    glUniform2f(glGetUniformLocation(shader_, "uScreen"), static_cast<float>(width_),
-                static_cast<float>(height_));
+    glUniform2f(uScreen_, static_cast<float>(width_), static_cast<float>(height_));
+    glUniform1i(uImage_, 0);
     glBindVertexArray(vao_);
     glBindBuffer(GL_ARRAY_BUFFER, vbo_);
     glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(verts_.size() * sizeof(UiVertex)),
                  verts_.data(), GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(verts_.size()));
+    glActiveTexture(GL_TEXTURE0);
+    for (const Batch &batch : batches_) {
+        if (batch.texture != 0) {
+            glBindTexture(GL_TEXTURE_2D, batch.texture);
+        }
+        glDrawArrays(GL_TRIANGLES, static_cast<GLint>(batch.first),
+                     static_cast<GLsizei>(batch.count));
+    }
     glEnable(GL_DEPTH_TEST);
 }
 
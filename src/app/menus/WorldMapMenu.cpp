@@ -6,6 +6,9 @@
 #include "voxel/Block.hpp"
 #include "voxel/Chunk.hpp"
 
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
 #include <algorithm>
 #include <cmath>
 
@@ -15,6 +18,15 @@
 namespace app::menus {
 namespace {
 
+// Chunks re-rasterised into the map tiles per frame while the map is open.
+constexpr int kMapChunkRasterBudget = 48;
+// Screen pixels per world column at the furthest and closest zoom.
+constexpr float kMinMapCell = 0.25f;
+constexpr float kMaxMapCell = 14.0f;
+static_assert(kMinMapCell * game::MapTilePyramid::texelSpan(game::MapTilePyramid::kLevels - 1) <=
+                  1.0f,
+              "the coarsest map level must be reachable at the furthest zoom");
+
 glm::vec3 mapColorForBlock(voxel::BlockId id, const voxel::BlockRegistry &registry,
                            const gfx::TextureAtlas &atlas) {
     if (voxel::isWaterLike(id)) {
@@ -48,8 +60,75 @@ glm::vec3 mapColorForBlock(voxel::BlockId id, const voxel::BlockRegistry &regist
     return c;
 }
 
+int floorMod(int a, int b) {
+    const int m = a % b;
+    return (m < 0) ? (m + b) : m;
+}
+
+int floorDiv(int a, int b) {
+    int q = a / b;
+    const int r = a % b;
+    if (r != 0 && ((r > 0) != (b > 0))) {
+        --q;
+    }
+    return q;
+}
+
+std::uint64_t tileTextureKey(const game::MapTilePyramid::Tile &tile) {
+    const std::uint64_t ux = static_cast<std::uint32_t>(tile.tx) & 0xFFFFFFFu;
+    const std::uint64_t uz = static_cast<std::uint32_t>(tile.tz) & 0xFFFFFFFu;
+    return (static_cast<std::uint64_t>(tile.level) << 56u) | (ux << 28u) | uz;
+}
+
 } // namespace
 
+WorldMapMenu::~WorldMapMenu() {
+    if (glfwGetCurrentContext() == nullptr) {
+        return;
+    }
+    for (const auto &[key, entry] : tileTextures_) {
+        (void)key;
+        glDeleteTextures(1, &entry.texture);
+    }
+}
+
+unsigned int WorldMapMenu::tileTexture(const game::MapTilePyramid::Tile &tile) const {
+    TileTexture &entry = tileTextures_[tileTextureKey(tile)];
+    if (entry.texture == 0) {
+        glGenTextures(1, &entry.texture);
+        glBindTexture(GL_TEXTURE_2D, entry.texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, game::MapTilePyramid::kTileSize,
+                     game::MapTilePyramid::kTileSize, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                     tile.rgba.data());
+        entry.version = tile.version;
+        entry.level = tile.level;
+        entry.tx = tile.tx;
+        entry.tz = tile.tz;
+    } else if (entry.version != tile.version) {
+        glBindTexture(GL_TEXTURE_2D, entry.texture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, game::MapTilePyramid::kTileSize,
+                        game::MapTilePyramid::kTileSize, GL_RGBA, GL_UNSIGNED_BYTE,
+                        tile.rgba.data());
+        entry.version = tile.version;
+    }
+    return entry.texture;
+}
+
+void WorldMapMenu::evictStaleTileTextures() const {
+    for (auto it = tileTextures_.begin(); it != tileTextures_.end();) {
+        if (pyramid_.find(it->second.level, it->second.tx, it->second.tz) != nullptr) {
+            ++it;
+            continue;
+        }
+        glDeleteTextures(1, &it->second.texture);
+        it = tileTextures_.erase(it);
+    }
+}
+
 MapOverlayLayout WorldMapMenu::computeLayout(int width, int height, float zoom) const {
     const float w = static_cast<float>(width);
     const float h = static_cast<float>(height);
@@ -62,7 +141,7 @@ MapOverlayLayout WorldMapMenu::computeLayout(int width, int height, float zoom)
     const float gridY = panelY + innerPad + 18.0f;
     const float gridW = panelW - innerPad * 2.0f;
     const float gridH = panelH - innerPad * 2.0f - 24.0f;
-    const float cell = std::clamp(4.0f * zoom, 2.0f, 14.0f);
+    const float cell = std::clamp(4.0f * zoom, kMinMapCell, kMaxMapCell);
     const float chunkBtnW = 94.0f;
     const float chunkBtnH = 18.0f;
     const float chunkBtnX = panelX + panelW - 298.0f;
@@ -127,7 +206,7 @@ void WorldMapMenu::render(gfx::HudRenderer &hud, int width, int height, const ga
     const float gridY = panelY + innerPad + 18.0f;
     const float gridW = panelW - innerPad * 2.0f;
     const float gridH = panelH - innerPad * 2.0f - 24.0f;
-    const float cell = std::clamp(4.0f * zoom, 2.0f, 14.0f);
+    const float cell = std::clamp(4.0f * zoom, kMinMapCell, kMaxMapCell);
     const float chunkBtnW = 94.0f;
     const float chunkBtnH = 18.0f;
     const float chunkBtnX = panelX + panelW - 298.0f;
@@ -193,63 +272,51 @@ void WorldMapMenu::render(gfx::HudRenderer &hud, int width, int height, const ga
         drawWaypointShape(cx, cy, drawSize, icon, r, g, b, a);
     };
 
-    for (int iz = 0; iz < drawRows; ++iz) {
-        for (int ix = 0; ix < drawCols; ++ix) {
-            const int dx = static_cast<int>(std::floor(static_cast<float>(ix) - centerIx));
-            const int dz = static_cast<int>(std::floor(static_cast<float>(iz) - centerIz));
-            voxel::BlockId id = voxel::AIR;
-            if (!map.sample(mapCenterWX + dx, mapCenterWZ + dz, id)) {
+    pyramid_.update(
+        map, [&](voxel::BlockId id) { return mapColorForBlock(id, registry, atlas); },
+        kMapChunkRasterBudget);
+    // Tiles come back over several frames after a full rebuild; sweep once
+    // the queue has drained.
+    if (pyramid_.rebuildCount() != sweptRebuild_ && pyramid_.pendingChunks() == 0) {
+        evictStaleTileTextures();
+        sweptRebuild_ = pyramid_.rebuildCount();
+    }
+    // Pick the coarsest level whose texels still cover at least a pixel.
+    int level = 0;
+    while (level + 1 < game::MapTilePyramid::kLevels &&
+           cell * static_cast<float>(game::MapTilePyramid::texelSpan(level + 1)) <= 1.0f) {
+        ++level;
+    }
+    const float originIx = std::ceil(centerIx);
+    const float originIz = std::ceil(centerIz);
+    const int minWX = mapCenterWX - static_cast<int>(originIx);
+    const int minWZ = mapCenterWZ - static_cast<int>(originIz);
+    const int span = game::MapTilePyramid::tileSpan(level);
+    const int tx0 = floorDiv(minWX, span);
+    const int tz0 = floorDiv(minWZ, span);
+    const int tx1 = floorDiv(minWX + drawCols - 1, span);
+    const int tz1 = floorDiv(minWZ + drawRows - 1, span);
+    for (int tz = tz0; tz <= tz1; ++tz) {
+        for (int tx = tx0; tx <= tx1; ++tx) {
+            const game::MapTilePyramid::Tile *tile = pyramid_.find(level, tx, tz);
+            if (tile == nullptr) {
                 continue;
             }
-            glm::vec3 c = mapColorForBlock(id, registry, atlas);
-            int y = voxel::Chunk::SY / 2;
-            if (map.sampleHeight(mapCenterWX + dx, mapCenterWZ + dz, y)) {
-                int yX1 = y;
-                int yX0 = y;
-                int yZ1 = y;
-                int yZ0 = y;
-                (void)map.sampleHeight(mapCenterWX + dx + 1, mapCenterWZ + dz, yX1);
-                (void)map.sampleHeight(mapCenterWX + dx - 1, mapCenterWZ + dz, yX0);
-                (void)map.sampleHeight(mapCenterWX + dx, mapCenterWZ + dz + 1, yZ1);
-                (void)map.sampleHeight(mapCenterWX + dx, mapCenterWZ + dz - 1, yZ0);
-                const float slope = static_cast<float>((yX1 - yX0) - (yZ1 - yZ0));
-                const float shade = std::clamp(0.84f + slope * 0.025f, 0.68f, 1.16f);
-                const float altitude = std::clamp(0.90f + (static_cast<float>(y) / 127.0f) * 0.22f,
-                                                  0.88f, 1.16f);
-                c *= shade * altitude;
-            }
-            bool waterCovered = false;
-            if (map.sampleWaterCover(mapCenterWX + dx, mapCenterWZ + dz, waterCovered) &&
-                waterCovered) {
-                const glm::vec3 waterTint(0.22f, 0.46f, 0.86f);
-                const float tintMix = voxel::isWaterloggedPlant(id) ? 0.10f
-                                     : (voxel::isPlant(id) ? 0.22f : 0.44f);
-                c = glm::mix(c, waterTint, tintMix);
-            }
-            c = glm::clamp(c, glm::vec3(0.0f), glm::vec3(1.0f));
-            const float px = gridX + static_cast<float>(ix) * cell;
-            const float py = gridY + static_cast<float>(iz) * cell;
-            const float pw = std::min(cell, (gridX + gridW) - px);
-            const float ph = std::min(cell, (gridY + gridH) - py);
-            if (pw <= 0.0f || ph <= 0.0f) {
+            const float sx0 = gridX + static_cast<float>(tx * span - minWX) * cell;
+            const float sz0 = gridY + static_cast<float>(tz * span - minWZ) * cell;
+            const float size = static_cast<float>(span) * cell;
+            const float cx0 = std::max(sx0, gridX);
+            const float cz0 = std::max(sz0, gridY);
+            const float cx1 = std::min(sx0 + size, gridX + gridW);
+            const float cz1 = std::min(sz0 + size, gridY + gridH);
+            if (cx1 <= cx0 || cz1 <= cz0) {
                 continue;
             }
-            ui_.drawRect(px, py, pw, ph, c.r, c.g, c.b, 0.96f);
+            ui_.drawImage(tileTexture(*tile), cx0, cz0, cx1 - cx0, cz1 - cz0, (cx0 - sx0) / size,
+                          (cz0 - sz0) / size, (cx1 - sx0) / size, (cz1 - sz0) / size, 1.0f);
         }
     }
     // Chunk grid overlay and hovered chunk highlight.
-    auto floorMod = [](int a, int b) {
-        const int m = a % b;
-        return (m < 0) ? (m + b) : m;
-    };
-    auto floorDiv = [](int a, int b) {
-        int q = a / b;
-        const int r = a % b;
-        if (r != 0 && ((r > 0) != (b > 0))) {
-            --q;
-        }
-        return q;
-    };
     if (showChunkBorders && cell >= 2.0f) {
         for (int ix = 0; ix < drawCols; ++ix) {
             const int dx = static_cast<int>(std::floor(static_cast<float>(ix) - centerIx));
@@ -1,27 +1,26 @@
 #include "app/menus/WorldSelectionMenu.hpp"
 
+#include "app/WorldCatalog.hpp"
+#include "core/AssetLoader.hpp"
 #include "gfx/HudRenderer.hpp"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstdio>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace app::menus {
 namespace {
 
-struct WorldEntry {
-    std::string name;
-    std::filesystem::path path;
-    std::uint32_t seed = 1337u;
-};
-
 struct TitleTextInputState {
     bool active = false;
     bool editSeed = false;
@@ -65,53 +64,6 @@ std::filesystem::path worldsRootPath() {
     return "worlds";
 }
 
-bool hasChunkFiles(const std::filesystem::path &worldDir) {
-    if (!std::filesystem::exists(worldDir) || !std::filesystem::is_directory(worldDir)) {
-        return false;
-    }
-    for (const auto &entry : std::filesystem::directory_iterator(worldDir)) {
-        if (!entry.is_regular_file()) {
-            continue;
-        }
-        const std::string name = entry.path().filename().string();
-        if (name.rfind("chunk_", 0) == 0 && entry.path().extension() == ".bin") {
-            return true;
-        }
-    }
-    return false;
-}
-
-bool loadWorldMeta(const std::filesystem::path &worldDir, std::string &outName,
-                   std::uint32_t &outSeed) {
-    std::ifstream in(worldDir / "world.meta");
-    if (!in) {
-        return false;
-    }
-    std::string line;
-    bool hasName = false;
-    bool hasSeed = false;
-    while (std::getline(in, line)) {
-        const std::size_t eq = line.find('=');
-        if (eq == std::string::npos) {
-            continue;
-        }
-        const std::string key = line.substr(0, eq);
-        const std::string value = line.substr(eq + 1);
-        if (key == "name") {
-            outName = value;
-            hasName = true;
-        } else if (key == "seed") {
-            try {
-                outSeed = static_cast<std::uint32_t>(std::stoll(value));
-                hasSeed = true;
-            } catch (...) {
-                hasSeed = false;
-            }
-        }
-    }
-    return hasName && hasSeed;
-}
-
 void saveWorldMeta(const std::filesystem::path &worldDir, const std::string &name,
                    std::uint32_t seed) {
     std::filesystem::create_directories(worldDir);
@@ -157,37 +109,50 @@ std::uint32_t parseSeedString(const std::string &seedText) {
     }
 }
 
-std::vector<WorldEntry> discoverWorlds() {
-    std::vector<WorldEntry> worlds;
-    const std::filesystem::path root = worldsRootPath();
-    std::filesystem::create_directories(root);
+// GL textures for the catalog thumbnails, parallel to the world list.
+struct ThumbnailTextures {
+    std::vector<unsigned int> ids;
 
-    for (const auto &entry : std::filesystem::directory_iterator(root)) {
-        if (!entry.is_directory()) {
-            continue;
-        }
-        const std::filesystem::path path = entry.path();
-        std::string name = path.filename().string();
-        std::uint32_t seed = 1337u;
-        const bool hasMeta = loadWorldMeta(path, name, seed);
-        if (!hasMeta && !hasChunkFiles(path)) {
-            continue;
+    ~ThumbnailTextures() {
+        clear();
+    }
+
+    void clear() {
+        for (unsigned int id : ids) {
+            if (id != 0) {
+                glDeleteTextures(1, &id);
+            }
         }
-        worlds.push_back(WorldEntry{name, path, seed});
+        ids.clear();
     }
 
-    const std::filesystem::path legacy = "world";
-    if (std::filesystem::exists(legacy) && std::filesystem::is_directory(legacy) &&
-        hasChunkFiles(legacy)) {
-        std::string name = "Legacy World";
-        std::uint32_t seed = 1337u;
-        loadWorldMeta(legacy, name, seed);
-        worlds.push_back(WorldEntry{name, legacy, seed});
+    void rebuild(const std::vector<WorldCatalogEntry> &worlds) {
+        clear();
+        ids.reserve(worlds.size());
+        for (const WorldCatalogEntry &world : worlds) {
+            unsigned int id = 0;
+            if (!world.thumbnail.empty()) {
+                glGenTextures(1, &id);
+                glBindTexture(GL_TEXTURE_2D, id);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, WorldCatalog::kThumbnailSize,
+                             WorldCatalog::kThumbnailSize, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                             world.thumbnail.data());
+            }
+            ids.push_back(id);
+        }
     }
+};
 
-    std::sort(worlds.begin(), worlds.end(),
-              [](const WorldEntry &a, const WorldEntry &b) { return a.name < b.name; });
-    return worlds;
+std::string formatWorldLine(const WorldCatalogEntry &world) {
+    const double megabytes = static_cast<double>(world.sizeBytes) / (1024.0 * 1024.0);
+    char size[32];
+    std::snprintf(size, sizeof(size), "%.1f MB", megabytes);
+    return world.name + "  [seed " + std::to_string(world.seed) + "]  " +
+           std::to_string(world.chunkCount) + " chunks, " + size;
 }
 
 std::filesystem::path allocateWorldPath(const std::string &worldName) {
@@ -206,10 +171,12 @@ std::filesystem::path allocateWorldPath(const std::string &worldName) {
 } // namespace
 
 void WorldSelectionMenu::render(gfx::HudRenderer &hud, int width, int height,
-                                const std::vector<std::string> &worlds, int selectedWorld,
+                                const std::vector<std::string> &worlds,
+                                const std::vector<unsigned int> &thumbnails, int selectedWorld,
                                 bool createMode, bool editSeed,
                                 const std::string &createName, const std::string &createSeed,
-                                float cursorX, float cursorY) const {
+                                float cursorX, float cursorY,
+                                const std::string &statusText) const {
     (void)hud;
     ui_.begin(width, height);
 
@@ -285,6 +252,10 @@ void WorldSelectionMenu::render(gfx::HudRenderer &hud, int width, int height,
                 ui_.drawRect(rowX + 2.0f, y + 1.0f, rowW - 4.0f, rowH - 6.0f, 0.13f, 0.14f, 0.17f,
                              0.90f);
             }
+            if (idx < static_cast<int>(thumbnails.size()) && thumbnails[idx] != 0) {
+                ui_.drawImage(thumbnails[idx], rowX + 8.0f, y + 2.0f, rowH - 8.0f, rowH - 8.0f,
+                              0.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+            }
             ui_.drawText(rowX + rowW * 0.5f - UiMenuRenderer::textWidthPx(worlds[idx]) * 0.5f,
                          y + 9.0f, worlds[idx], 245, 246, 250, 255);
         }
@@ -400,11 +371,64 @@ void WorldSelectionMenu::render(gfx::HudRenderer &hud, int width, int height,
         "Flow: Select world -> Load. New World opens a modal with Create/Cancel.";
     ui_.drawText(panelX + panelW * 0.5f - UiMenuRenderer::textWidthPx(flowText) * 0.5f,
                  panelY + panelH - 14.0f, flowText, 198, 206, 222, 255);
+    if (!statusText.empty()) {
+        ui_.drawText(16.0f, h - 24.0f, statusText, 198, 206, 222, 255);
+    }
     ui_.end();
 }
 
-WorldSelection WorldSelectionMenu::run(GLFWwindow *window, gfx::HudRenderer &hud) {
-    auto worlds = discoverWorlds();
+// Result slot shared with the refresh thread; worlds is written before done.
+struct WorldSelectionMenu::CatalogRefresh {
+    std::atomic<bool> cancel{false};
+    std::atomic<bool> done{false};
+    std::vector<WorldCatalogEntry> worlds;
+};
+
+WorldSelectionMenu::WorldSelectionMenu() = default;
+
+WorldSelectionMenu::~WorldSelectionMenu() {
+    cancelCatalogRefresh();
+    joinCatalogRefresh();
+}
+
+void WorldSelectionMenu::startCatalogRefresh() {
+    joinCatalogRefresh();
+    refresh_ = std::make_unique<CatalogRefresh>();
+    refreshThread_ = std::thread([slot = refresh_.get()]() {
+        slot->worlds = WorldCatalog::refresh(worldsRootPath(), "world", &slot->cancel);
+        slot->done.store(true, std::memory_order_release);
+    });
+}
+
+void WorldSelectionMenu::cancelCatalogRefresh() {
+    if (refresh_) {
+        refresh_->cancel.store(true, std::memory_order_relaxed);
+    }
+}
+
+void WorldSelectionMenu::joinCatalogRefresh() {
+    if (refreshThread_.joinable()) {
+        refreshThread_.join();
+    }
+    refresh_.reset();
+}
+
+WorldSelection WorldSelectionMenu::run(GLFWwindow *window, gfx::HudRenderer &hud,
+                                       core::AssetLoader &assets) {
+    // Whichever way the menu is left, a refresh still in flight is abandoned.
+    struct RefreshCanceller {
+        WorldSelectionMenu &menu;
+        ~RefreshCanceller() {
+            menu.cancelCatalogRefresh();
+        }
+    } refreshCanceller{*this};
+
+    // The root index lists worlds immediately; a background refresh picks up
+    // folders and catalogs that changed since it was written.
+    std::vector<WorldCatalogEntry> worlds = WorldCatalog::readIndex(worldsRootPath());
+    startCatalogRefresh();
+    ThumbnailTextures thumbnails;
+    thumbnails.rebuild(worlds);
     int selectedWorld = worlds.empty() ? -1 : 0;
 
     std::string createName = "New World";
@@ -424,6 +448,22 @@ WorldSelection WorldSelectionMenu::run(GLFWwindow *window, gfx::HudRenderer &hud
 
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
+        assets.pump(core::AssetLoader::kFrameBudgetSeconds);
+
+        if (refresh_ && refresh_->done.load(std::memory_order_acquire)) {
+            std::filesystem::path selectedPath;
+            if (selectedWorld >= 0 && selectedWorld < static_cast<int>(worlds.size())) {
+                selectedPath = worlds[selectedWorld].path;
+            }
+            worlds = std::move(refresh_->worlds);
+            joinCatalogRefresh();
+            thumbnails.rebuild(worlds);
+            const auto it = std::find_if(
+                worlds.begin(), worlds.end(),
+                [&](const WorldCatalogEntry &world) { return world.path == selectedPath; });
+            selectedWorld = it != worlds.end() ? static_cast<int>(it - worlds.begin())
+                                               : (worlds.empty() ? -1 : 0);
+        }
 
         inputState.active = createMode;
         inputState.editSeed = editSeed;
@@ -511,11 +551,8 @@ WorldSelection WorldSelectionMenu::run(GLFWwindow *window, gfx::HudRenderer &hud
                 editSeed = false;
             } else if (!createMode && mx >= (rowX + 2.0f * (btnW + 4.0f)) &&
                        mx <= (rowX + 3.0f * btnW + 8.0f) && my >= btnY && my <= (btnY + btnH)) {
-                worlds = discoverWorlds();
-                if (worlds.empty()) {
-                    selectedWorld = -1;
-                } else if (selectedWorld < 0 || selectedWorld >= static_cast<int>(worlds.size())) {
-                    selectedWorld = 0;
+                if (!refresh_) {
+                    startCatalogRefresh();
                 }
             } else if (!createMode && mx >= (rowX + 3.0f * (btnW + 4.0f)) &&
                        mx <= (rowX + 4.0f * btnW + 12.0f) && my >= btnY && my <= (btnY + btnH)) {
@@ -556,14 +593,19 @@ WorldSelection WorldSelectionMenu::run(GLFWwindow *window, gfx::HudRenderer &hud
 
         std::vector<std::string> worldLines;
         worldLines.reserve(worlds.size());
-        for (const auto &world : worlds) {
-            worldLines.push_back(world.name + "  [seed " + std::to_string(world.seed) + "]");
+        for (const WorldCatalogEntry &world : worlds) {
+            worldLines.push_back(formatWorldLine(world));
         }
 
         glClearColor(0.12f, 0.18f, 0.24f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        render(hud, winW, winH, worldLines, selectedWorld, createMode, editSeed, createName,
-               createSeed, static_cast<float>(mx), static_cast<float>(my));
+        std::string statusText;
+        if (!assets.done()) {
+            statusText = "Loading assets " + std::to_string(assets.completedCount()) + "/" +
+                         std::to_string(assets.submittedCount());
+        }
+        render(hud, winW, winH, worldLines, thumbnails.ids, selectedWorld, createMode, editSeed,
+               createName, createSeed, static_cast<float>(mx), static_cast<float>(my), statusText);
         glfwSwapBuffers(window);
         prevLeftMouse = leftMouse;
     }
@@ -0,0 +1,134 @@
+#include "core/AssetLoader.hpp"
+
+#include "core/Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <string>
+
+namespace core {
+
+AssetLoader::AssetLoader(unsigned int workerCount) {
+    if (workerCount == 0) {
+        const unsigned int hardwareThreads = std::max(2u, std::thread::hardware_concurrency());
+        workerCount = std::min(4u, hardwareThreads - 1);
+    }
+    workers_.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        workers_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        jobs_.clear();
+    }
+    jobCv_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+void AssetLoader::submit(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(std::move(job));
+        ++submitted_;
+    }
+    jobCv_.notify_one();
+}
+
+void AssetLoader::workerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobCv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        Upload upload;
+        try {
+            upload = job();
+        } catch (const std::exception &e) {
+            Logger::instance().warn(std::string("Asset decode failed: ") + e.what());
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // A failed or empty decode still counts towards progress.
+            uploads_.push_back(upload ? std::move(upload) : Upload([] {}));
+        }
+        uploadCv_.notify_all();
+    }
+}
+
+std::size_t AssetLoader::pump(double budgetSeconds) {
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t ran = 0;
+    for (;;) {
+        Upload upload;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (uploads_.empty()) {
+                break;
+            }
+            upload = std::move(uploads_.front());
+            uploads_.pop_front();
+        }
+        upload();
+        ++ran;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++completed_;
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= budgetSeconds) {
+            break;
+        }
+    }
+    return ran;
+}
+
+void AssetLoader::finish() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (completed_ == submitted_) {
+                return;
+            }
+            uploadCv_.wait(lock, [this] { return !uploads_.empty() || completed_ == submitted_; });
+        }
+        pump(1.0e9);
+    }
+}
+
+std::size_t AssetLoader::submittedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return submitted_;
+}
+
+std::size_t AssetLoader::completedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completed_;
+}
+
+bool AssetLoader::done() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completed_ == submitted_;
+}
+
+float AssetLoader::progress() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (submitted_ == 0) {
+        return 1.0f;
+    }
+    return static_cast<float>(completed_) / static_cast<float>(submitted_);
+}
+
+} // namespace core
@@ -0,0 +1,389 @@
+#include "core/AssetPack.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core {
+
+namespace {
+
+constexpr char kMagic[4] = {'V', 'X', 'P', 'K'};
+constexpr std::size_t kHeaderBytes = 16;
+constexpr std::size_t kDirectoryEntryBytes = 24;
+constexpr std::size_t kImageHeaderBytes = 24;
+constexpr std::size_t kSoundHeaderBytes = 16;
+constexpr std::uint64_t kPayloadAlign = 16;
+
+template <typename T> T readAt(const std::uint8_t *p) {
+    T value{};
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+template <typename T> void append(std::vector<std::uint8_t> &out, T value) {
+    const auto *p = reinterpret_cast<const std::uint8_t *>(&value);
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+std::uint32_t readLe32(const std::uint8_t *p) {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+std::uint16_t readLe16(const std::uint8_t *p) {
+    return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+std::size_t levelBytes(int width, int height, int level) {
+    const int w = std::max(1, width >> level);
+    const int h = std::max(1, height >> level);
+    return static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * 4;
+}
+
+} // namespace
+
+bool parseWav(const std::uint8_t *bytes, std::size_t size, SoundData &out, std::string &error) {
+    if (size < 12 || std::memcmp(bytes, "RIFF", 4) != 0) {
+        error = "Invalid WAV header";
+        return false;
+    }
+    if (std::memcmp(bytes + 8, "WAVE", 4) != 0) {
+        error = "Invalid WAV format";
+        return false;
+    }
+
+    bool foundFmt = false;
+    bool foundData = false;
+    std::uint16_t audioFormat = 0;
+    std::size_t pos = 12;
+    while (pos + 8 <= size && (!foundFmt || !foundData)) {
+        const std::uint8_t *chunk = bytes + pos;
+        const std::uint32_t chunkSize = readLe32(chunk + 4);
+        const std::size_t body = pos + 8;
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            if (chunkSize < 16 || body + 16 > size) {
+                break;
+            }
+            audioFormat = readLe16(bytes + body);
+            out.channels = readLe16(bytes + body + 2);
+            out.sampleRate = readLe32(bytes + body + 4);
+            out.bitsPerSample = readLe16(bytes + body + 14);
+            foundFmt = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (body + chunkSize > size) {
+                break;
+            }
+            out.samples = bytes + body;
+            out.sampleBytes = chunkSize;
+            foundData = true;
+        }
+        pos = body + chunkSize + (chunkSize % 2);
+    }
+
+    if (!foundFmt || !foundData) {
+        error = "Incomplete WAV file";
+        return false;
+    }
+    if (audioFormat != 1) {
+        error = "Only PCM WAV is supported";
+        return false;
+    }
+    return true;
+}
+
+std::vector<float> computeTileAverageColors(const std::uint8_t *rgba, int width, int height,
+                                            int tileW, int tileH) {
+    std::vector<float> out;
+    if (rgba == nullptr || width <= 0 || height <= 0 || tileW <= 0 || tileH <= 0) {
+        return out;
+    }
+    const int cols = width / tileW;
+    const int rows = height / tileH;
+    const int count = cols * rows;
+    out.assign(static_cast<std::size_t>(count) * 3, 0.5f);
+    for (int t = 0; t < count; ++t) {
+        const int x0 = (t % cols) * tileW;
+        const int y0 = (t / cols) * tileH;
+        std::uint64_t sumR = 0;
+        std::uint64_t sumG = 0;
+        std::uint64_t sumB = 0;
+        std::uint64_t sumA = 0;
+        for (int y = y0; y < y0 + tileH; ++y) {
+            const std::uint8_t *row = rgba + (static_cast<std::size_t>(y) * width + x0) * 4;
+            for (int x = 0; x < tileW; ++x) {
+                const std::uint32_t a = row[x * 4 + 3];
+                sumR += static_cast<std::uint64_t>(row[x * 4 + 0]) * a;
+                sumG += static_cast<std::uint64_t>(row[x * 4 + 1]) * a;
+                sumB += static_cast<std::uint64_t>(row[x * 4 + 2]) * a;
+                sumA += a;
+            }
+        }
+        if (sumA > 0) {
+            float *rgb = out.data() + static_cast<std::size_t>(t) * 3;
+            rgb[0] = static_cast<float>(sumR) / static_cast<float>(sumA) / 255.0f;
+            rgb[1] = static_cast<float>(sumG) / static_cast<float>(sumA) / 255.0f;
+            rgb[2] = static_cast<float>(sumB) / static_cast<float>(sumA) / 255.0f;
+        }
+    }
+    return out;
+}
+
+namespace {
+
+std::string &instancePath() {
+    static std::string path = AssetPack::kFileName;
+    return path;
+}
+
+} // namespace
+
+const AssetPack &AssetPack::instance() {
+    static AssetPack pack;
+    static const bool opened = pack.open(instancePath());
+    (void)opened;
+    return pack;
+}
+
+void AssetPack::setInstancePath(const std::string &path) {
+    instancePath() = path;
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const std::string &path) {
+    close();
+#if !defined(_WIN32)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void *mapped = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE,
+                          fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    data_ = static_cast<const std::uint8_t *>(mapped);
+    size_ = static_cast<std::size_t>(st.st_size);
+    mapped_ = true;
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return false;
+    }
+    fallback_.resize(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(reinterpret_cast<char *>(fallback_.data()),
+            static_cast<std::streamsize>(fallback_.size()));
+    if (!in || fallback_.empty()) {
+        fallback_.clear();
+        return false;
+    }
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+#endif
+
+    if (size_ < kHeaderBytes || std::memcmp(data_, kMagic, 4) != 0 ||
+        readAt<std::uint32_t>(data_ + 4) != kVersion) {
+        close();
+        return false;
+    }
+    const std::uint32_t count = readAt<std::uint32_t>(data_ + 8);
+    std::size_t pos = kHeaderBytes;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (pos + kDirectoryEntryBytes > size_) {
+            close();
+            return false;
+        }
+        Entry entry{};
+        entry.kind = static_cast<Kind>(readAt<std::uint32_t>(data_ + pos));
+        const std::uint32_t nameLength = readAt<std::uint32_t>(data_ + pos + 4);
+        entry.offset = readAt<std::uint64_t>(data_ + pos + 8);
+        entry.size = readAt<std::uint64_t>(data_ + pos + 16);
+        pos += kDirectoryEntryBytes;
+        if (pos + nameLength > size_ || entry.offset > size_ || entry.size > size_ - entry.offset) {
+            close();
+            return false;
+        }
+        entries_.emplace(std::string(reinterpret_cast<const char *>(data_ + pos), nameLength),
+                         entry);
+        pos += nameLength;
+    }
+    return true;
+}
+
+void AssetPack::close() {
+#if !defined(_WIN32)
+    if (mapped_ && data_ != nullptr) {
+        ::munmap(const_cast<std::uint8_t *>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    fallback_.clear();
+    entries_.clear();
+}
+
+const AssetPack::Entry *AssetPack::find(const std::string &name, Kind kind) const {
+    const auto it = entries_.find(name);
+    if (it == entries_.end() || it->second.kind != kind) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+bool AssetPack::findImage(const std::string &name, ImageData &out) const {
+    const Entry *entry = find(name, Kind::Image);
+    if (entry == nullptr || entry->size < kImageHeaderBytes) {
+        return false;
+    }
+    const std::uint8_t *p = data_ + entry->offset;
+    ImageData image{};
+    image.width = static_cast<int>(readAt<std::uint32_t>(p));
+    image.height = static_cast<int>(readAt<std::uint32_t>(p + 4));
+    const int levels = static_cast<int>(readAt<std::uint32_t>(p + 8));
+    image.tileW = static_cast<int>(readAt<std::uint32_t>(p + 12));
+    image.tileH = static_cast<int>(readAt<std::uint32_t>(p + 16));
+    image.tileCount = static_cast<int>(readAt<std::uint32_t>(p + 20));
+    if (image.width <= 0 || image.height <= 0 || levels <= 0 || levels > 16) {
+        return false;
+    }
+
+    std::size_t need = kImageHeaderBytes;
+    for (int level = 0; level < levels; ++level) {
+        need += levelBytes(image.width, image.height, level);
+    }
+    need += static_cast<std::size_t>(image.tileCount) * 3 * sizeof(float);
+    if (need > entry->size) {
+        return false;
+    }
+    std::size_t pos = kImageHeaderBytes;
+    for (int level = 0; level < levels; ++level) {
+        image.levels.push_back(p + pos);
+        pos += levelBytes(image.width, image.height, level);
+    }
+    image.tileColors = reinterpret_cast<const float *>(p + pos);
+    out = std::move(image);
+    return true;
+}
+
+bool AssetPack::findSound(const std::string &name, SoundData &out) const {
+    const Entry *entry = find(name, Kind::Sound);
+    if (entry == nullptr || entry->size < kSoundHeaderBytes) {
+        return false;
+    }
+    const std::uint8_t *p = data_ + entry->offset;
+    SoundData sound{};
+    sound.channels = readAt<std::uint16_t>(p);
+    sound.bitsPerSample = readAt<std::uint16_t>(p + 2);
+    sound.sampleRate = readAt<std::uint32_t>(p + 4);
+    sound.sampleBytes = static_cast<std::size_t>(readAt<std::uint64_t>(p + 8));
+    if (sound.sampleBytes > entry->size - kSoundHeaderBytes) {
+        return false;
+    }
+    sound.samples = p + kSoundHeaderBytes;
+    out = sound;
+    return true;
+}
+
+void AssetPackWriter::addImage(const std::string &name, const std::uint8_t *rgba, int width,
+                               int height, int tileW, int tileH) {
+    // The atlas samples without mipmaps so tiles never bleed into their
+    // neighbours; only level 0 is stored, but the format carries a level count.
+    const std::vector<float> colors = computeTileAverageColors(rgba, width, height, tileW, tileH);
+    Pending entry{name, AssetPack::Kind::Image, {}};
+    auto &out = entry.payload;
+    append<std::uint32_t>(out, static_cast<std::uint32_t>(width));
+    append<std::uint32_t>(out, static_cast<std::uint32_t>(height));
+    append<std::uint32_t>(out, 1);
+    append<std::uint32_t>(out, static_cast<std::uint32_t>(tileW));
+    append<std::uint32_t>(out, static_cast<std::uint32_t>(tileH));
+    append<std::uint32_t>(out, static_cast<std::uint32_t>(colors.size() / 3));
+    out.insert(out.end(), rgba, rgba + levelBytes(width, height, 0));
+    const auto *colorBytes = reinterpret_cast<const std::uint8_t *>(colors.data());
+    out.insert(out.end(), colorBytes, colorBytes + colors.size() * sizeof(float));
+    pending_.push_back(std::move(entry));
+}
+
+void AssetPackWriter::addSound(const std::string &name, const SoundData &sound) {
+    Pending entry{name, AssetPack::Kind::Sound, {}};
+    auto &out = entry.payload;
+    append<std::uint16_t>(out, sound.channels);
+    append<std::uint16_t>(out, sound.bitsPerSample);
+    append<std::uint32_t>(out, sound.sampleRate);
+    append<std::uint64_t>(out, static_cast<std::uint64_t>(sound.sampleBytes));
+    out.insert(out.end(), sound.samples, sound.samples + sound.sampleBytes);
+    pending_.push_back(std::move(entry));
+}
+
+bool AssetPackWriter::write(const std::string &path, std::string &error) const {
+    std::vector<std::uint8_t> header;
+    header.insert(header.end(), kMagic, kMagic + 4);
+    append<std::uint32_t>(header, AssetPack::kVersion);
+    append<std::uint32_t>(header, static_cast<std::uint32_t>(pending_.size()));
+    append<std::uint32_t>(header, 0);
+
+    std::uint64_t offset = kHeaderBytes;
+    for (const auto &entry : pending_) {
+        offset += kDirectoryEntryBytes + entry.name.size();
+    }
+    for (const auto &entry : pending_) {
+        offset = (offset + kPayloadAlign - 1) / kPayloadAlign * kPayloadAlign;
+        append<std::uint32_t>(header, static_cast<std::uint32_t>(entry.kind));
+        append<std::uint32_t>(header, static_cast<std::uint32_t>(entry.name.size()));
+        append<std::uint64_t>(header, offset);
+        append<std::uint64_t>(header, static_cast<std::uint64_t>(entry.payload.size()));
+        header.insert(header.end(), entry.name.begin(), entry.name.end());
+        offset += entry.payload.size();
+    }
+
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            error = "Cannot open " + tmpPath;
+            return false;
+        }
+        out.write(reinterpret_cast<const char *>(header.data()),
+                  static_cast<std::streamsize>(header.size()));
+        std::uint64_t written = header.size();
+        const char padding[kPayloadAlign] = {};
+        for (const auto &entry : pending_) {
+            const std::uint64_t aligned =
+                (written + kPayloadAlign - 1) / kPayloadAlign * kPayloadAlign;
+            out.write(padding, static_cast<std::streamsize>(aligned - written));
+            out.write(reinterpret_cast<const char *>(entry.payload.data()),
+                      static_cast<std::streamsize>(entry.payload.size()));
+            written = aligned + entry.payload.size();
+        }
+        if (!out) {
+            error = "Failed writing " + tmpPath;
+            return false;
+        }
+    }
+    std::remove(path.c_str());
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        error = "Cannot replace " + path;
+        return false;
+    }
+    return true;
+}
+
+} // namespace core
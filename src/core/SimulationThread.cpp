@@ -0,0 +1,93 @@
+#include "core/SimulationThread.hpp"
+
+#include "core/TickCounter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace core {
+
+SimulationThread::SimulationThread(float stepSeconds, Step step)
+    : stepSeconds_(stepSeconds), step_(std::move(step)) {}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start() {
+    if (thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(controlMutex_);
+        stopping_ = false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(clockMutex_);
+        clockBaseSteps_ = static_cast<double>(steps_.load(std::memory_order_relaxed));
+        clockBaseAt_ = Clock::now();
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+void SimulationThread::stop() {
+    {
+        std::lock_guard<std::mutex> lock(controlMutex_);
+        stopping_ = true;
+    }
+    stopCv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::unique_lock<std::mutex> SimulationThread::lock() {
+    return std::unique_lock<std::mutex>(simMutex_);
+}
+
+double SimulationThread::clockSteps() const {
+    std::lock_guard<std::mutex> lock(clockMutex_);
+    if (clockBaseAt_ == Clock::time_point{} || stepSeconds_ <= 0.0f) {
+        return static_cast<double>(stepCount());
+    }
+    const double since = std::chrono::duration<double>(Clock::now() - clockBaseAt_).count();
+    return clockBaseSteps_ + since / static_cast<double>(stepSeconds_);
+}
+
+void SimulationThread::run() {
+    TickCounter ticks(stepSeconds_, kMaxCatchUpSteps);
+    Clock::time_point last;
+    {
+        std::lock_guard<std::mutex> lock(clockMutex_);
+        last = clockBaseAt_;
+    }
+    const std::uint64_t firstStep = steps_.load(std::memory_order_relaxed);
+    for (;;) {
+        const Clock::time_point now = Clock::now();
+        const int due = ticks.consume(std::chrono::duration<float>(now - last).count());
+        last = now;
+        {
+            // The steps consumed so far count from where start() set the clock.
+            std::lock_guard<std::mutex> lock(clockMutex_);
+            clockBaseSteps_ = static_cast<double>(firstStep + ticks.tickCount()) + ticks.alpha();
+            clockBaseAt_ = now;
+        }
+        for (int i = 0; i < due; ++i) {
+            std::lock_guard<std::mutex> lock(simMutex_);
+            step_(steps_.load(std::memory_order_relaxed));
+            steps_.fetch_add(1, std::memory_order_release);
+        }
+
+        // Sleep until the next step is due; a backlog left by the catch-up
+        // cap runs on the next pass without waiting.
+        const float untilNext = (1.0f - std::min(ticks.alpha(), 1.0f)) * stepSeconds_;
+        std::unique_lock<std::mutex> lock(controlMutex_);
+        if (stopCv_.wait_for(lock, std::chrono::duration<float>(untilNext),
+                             [this] { return stopping_; })) {
+            return;
+        }
+    }
+}
+
+} // namespace core
@@ -1,5 +1,7 @@
 #include "game/AudioSystem.hpp"
 
+#include "core/AssetLoader.hpp"
+#include "core/AssetPack.hpp"
 #include "core/Logger.hpp"
 
 #include <algorithm>
@@ -7,6 +9,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -29,130 +32,67 @@ namespace {
 
 constexpr std::size_t kProfileCount = static_cast<std::size_t>(AudioSystem::SoundProfile::Count);
 
-bool readU16(std::istream &in, std::uint16_t &out) {
-    char b[2];
-    in.read(b, sizeof(b));
-    if (!in) {
-        return false;
-    }
-    out = static_cast<std::uint16_t>(static_cast<unsigned char>(b[0])) |
-          (static_cast<std::uint16_t>(static_cast<unsigned char>(b[1])) << 8);
-    return true;
-}
+struct DecodedWav {
+    core::SoundData sound;
+    // Owns the samples when they came from a loose file rather than the pack.
+    std::vector<std::uint8_t> fileBytes;
+};
 
-bool readU32(std::istream &in, std::uint32_t &out) {
-    char b[4];
-    in.read(b, sizeof(b));
-    if (!in) {
-        return false;
+// Safe to call from asset loader workers: touches no OpenAL state.
+bool decodeWav(const std::string &path, DecodedWav &out) {
+    // Packed sounds are PCM already sitting in the mapped pack; otherwise the
+    // loose file is read whole and parsed in memory.
+    if (core::AssetPack::instance().findSound(path, out.sound)) {
+        return true;
     }
-    out = static_cast<std::uint32_t>(static_cast<unsigned char>(b[0])) |
-          (static_cast<std::uint32_t>(static_cast<unsigned char>(b[1])) << 8) |
-          (static_cast<std::uint32_t>(static_cast<unsigned char>(b[2])) << 16) |
-          (static_cast<std::uint32_t>(static_cast<unsigned char>(b[3])) << 24);
-    return true;
-}
-
-bool loadWav(const std::string &path, ALuint buffer) {
-    std::ifstream in(path, std::ios::binary);
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
     if (!in) {
         core::Logger::instance().warn("Audio file missing: " + path);
         return false;
     }
-
-    char riff[4];
-    in.read(riff, 4);
-    if (std::string(riff, 4) != "RIFF") {
-        core::Logger::instance().warn("Invalid WAV header: " + path);
-        return false;
-    }
-
-    std::uint32_t riffSize = 0;
-    (void)readU32(in, riffSize);
-
-    char wave[4];
-    in.read(wave, 4);
-    if (std::string(wave, 4) != "WAVE") {
-        core::Logger::instance().warn("Invalid WAV format: " + path);
-        return false;
-    }
-
-    bool foundFmt = false;
-    bool foundData = false;
-    std::uint16_t audioFormat = 0;
-    std::uint16_t channels = 0;
-    std::uint32_t sampleRate = 0;
-    std::uint16_t bitsPerSample = 0;
-    std::vector<char> pcmData;
-
-    while (in && (!foundFmt || !foundData)) {
-        char chunkId[4];
-        in.read(chunkId, 4);
-        if (!in) {
-            break;
-        }
-        std::uint32_t chunkSize = 0;
-        if (!readU32(in, chunkSize)) {
-            break;
-        }
-        const std::string id(chunkId, 4);
-        if (id == "fmt ") {
-            std::uint16_t blockAlign = 0;
-            std::uint32_t byteRate = 0;
-            if (!readU16(in, audioFormat) || !readU16(in, channels) || !readU32(in, sampleRate) ||
-                !readU32(in, byteRate) || !readU16(in, blockAlign) || !readU16(in, bitsPerSample)) {
-                return false;
-            }
-            if (chunkSize > 16) {
-                in.seekg(static_cast<std::streamoff>(chunkSize - 16), std::ios::cur);
-            }
-            foundFmt = true;
-        } else if (id == "data") {
-            pcmData.resize(chunkSize);
-            in.read(pcmData.data(), static_cast<std::streamsize>(chunkSize));
-            if (!in) {
-                return false;
-            }
-            foundData = true;
-        } else {
-            in.seekg(static_cast<std::streamoff>(chunkSize), std::ios::cur);
-        }
-
-        if ((chunkSize % 2) != 0) {
-            in.seekg(1, std::ios::cur);
-        }
-    }
-
-    if (!foundFmt || !foundData) {
-        core::Logger::instance().warn("Incomplete WAV file: " + path);
-        return false;
-    }
-    if (audioFormat != 1) {
-        core::Logger::instance().warn("Only PCM WAV is supported: " + path);
+    out.fileBytes.resize(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(reinterpret_cast<char *>(out.fileBytes.data()),
+            static_cast<std::streamsize>(out.fileBytes.size()));
+    std::string error;
+    if (!in || !core::parseWav(out.fileBytes.data(), out.fileBytes.size(), out.sound, error)) {
+        core::Logger::instance().warn((error.empty() ? "Failed to read WAV" : error) + ": " +
+                                      path);
         return false;
     }
+    return true;
+}
 
+// Returns 0 when the buffer could not be created.
+ALuint uploadWav(const std::string &path, const core::SoundData &sound) {
     ALenum format = 0;
-    if (channels == 1 && bitsPerSample == 8) {
+    if (sound.channels == 1 && sound.bitsPerSample == 8) {
         format = AL_FORMAT_MONO8;
-    } else if (channels == 1 && bitsPerSample == 16) {
+    } else if (sound.channels == 1 && sound.bitsPerSample == 16) {
         format = AL_FORMAT_MONO16;
-    } else if (channels == 2 && bitsPerSample == 8) {
+    } else if (sound.channels == 2 && sound.bitsPerSample == 8) {
         format = AL_FORMAT_STEREO8;
-    } else if (channels == 2 && bitsPerSample == 16) {
+    } else if (sound.channels == 2 && sound.bitsPerSample == 16) {
         format = AL_FORMAT_STEREO16;
     } else {
         core::Logger::instance().warn("Unsupported WAV channel/bit depth: " + path);
-        return false;
+        return 0;
     }
 
-    alBufferData(buffer, format, pcmData.data(), static_cast<ALsizei>(pcmData.size()),
-                 static_cast<ALsizei>(sampleRate));
+    ALuint buffer = 0;
+    alGenBuffers(1, &buffer);
+    if (alGetError() != AL_NO_ERROR || buffer == 0) {
+        core::Logger::instance().warn("Failed to allocate audio buffer: " + path);
+        return 0;
+    }
+    alBufferData(buffer, format, sound.samples, static_cast<ALsizei>(sound.sampleBytes),
+                 static_cast<ALsizei>(sound.sampleRate));
     if (alGetError() != AL_NO_ERROR) {
         core::Logger::instance().warn("Failed to upload audio buffer: " + path);
-        return false;
+        alDeleteBuffers(1, &buffer);
+        return 0;
     }
-    return true;
+    return buffer;
 }
 
 void releaseBuffers(std::vector<ALuint> &buffers) {
@@ -213,17 +153,14 @@ bool loadBufferPool(const std::vector<std::string> &paths, std::vector<ALuint> &
     releaseBuffers(pool);
     pool.reserve(paths.size());
     for (const std::string &path : paths) {
-        ALuint buffer = 0;
-        alGenBuffers(1, &buffer);
-        if (alGetError() != AL_NO_ERROR || buffer == 0) {
-            core::Logger::instance().warn("Failed to allocate audio buffer: " + path);
+        DecodedWav wav;
+        if (!decodeWav(path, wav)) {
             continue;
         }
-        if (!loadWav(path, buffer)) {
-            alDeleteBuffers(1, &buffer);
-            continue;
+        const ALuint buffer = uploadWav(path, wav.sound);
+        if (buffer != 0) {
+            pool.push_back(buffer);
         }
-        pool.push_back(buffer);
     }
     if (pool.empty()) {
         core::Logger::instance().warn(std::string("No ") + emptyWarnLabel + " sounds loaded");
@@ -232,6 +169,201 @@ bool loadBufferPool(const std::vector<std::string> &paths, std::vector<ALuint> &
     return true;
 }
 
+enum class SoundPool { Pickup, Break, Footstep, Place, Swim, WaterBob };
+
+struct SoundSet {
+    SoundPool pool;
+    AudioSystem::SoundProfile profile;
+    std::vector<std::string> paths;
+};
+
+const std::vector<SoundSet> &defaultSoundSets() {
+    static const std::vector<SoundSet> sets = {
+    {SoundPool::Pickup,
+     AudioSystem::SoundProfile::Default,
+     {
+         "assets/audio/pickup/pickup.wav",
+     }},
+    {SoundPool::Break,
+     AudioSystem::SoundProfile::Default,
+     {
+         "assets/audio/break/break_1.wav",
+         "assets/audio/break/break_2.wav",
+         "assets/audio/break/break_3.wav",
+     }},
+    {SoundPool::Break,
+     AudioSystem::SoundProfile::Stone,
+     {
+         "assets/audio/break/break_stone_1.wav",
+         "assets/audio/break/break_stone_2.wav",
+         "assets/audio/break/break_stone_3.wav",
+     }},
+    {SoundPool::Break,
+     AudioSystem::SoundProfile::Dirt,
+     {
+         "assets/audio/break/break_dirt_1.wav",
+         "assets/audio/break/break_dirt_2.wav",
+         "assets/audio/break/break_dirt_3.wav",
+     }},
+    {SoundPool::Break,
+     AudioSystem::SoundProfile::Wood,
+     {
+         "assets/audio/break/break_wood_1.wav",
+         "assets/audio/break/break_wood_2.wav",
+         "assets/audio/break/break_wood_3.wav",
+     }},
+    {SoundPool::Break,
+     AudioSystem::SoundProfile::Foliage,
+     {
+         "assets/audio/break/break_foliage_1.wav",
+         "assets/audio/break/break_foliage_2.wav",
+         "assets/audio/break/break_foliage_3.wav",
+     }},
+    {SoundPool::Break,
+     AudioSystem::SoundProfile::Sand,
+     {
+         "assets/audio/break/break_sand_1.wav",
+         "assets/audio/break/break_sand_2.wav",
+         "assets/audio/break/break_sand_3.wav",
+     }},
+    {SoundPool::Break,
+     AudioSystem::SoundProfile::Snow,
+     {
+         "assets/audio/break/break_snow_1.wav",
+         "assets/audio/break/break_snow_2.wav",
+     }},
+    {SoundPool::Break,
+     AudioSystem::SoundProfile::Ice,
+     {
+         "assets/audio/break/break_ice_1.wav",
+         "assets/audio/break/break_ice_2.wav",
+     }},
+    {SoundPool::Footstep,
+     AudioSystem::SoundProfile::Default,
+     {
+         "assets/audio/step/step_default_1.wav",
+         "assets/audio/step/step_default_2.wav",
+     }},
+    {SoundPool::Footstep,
+     AudioSystem::SoundProfile::Stone,
+     {
+         "assets/audio/step/step_stone_1.wav",
+         "assets/audio/step/step_stone_2.wav",
+         "assets/audio/step/step_stone_3.wav",
+     }},
+    {SoundPool::Footstep,
+     AudioSystem::SoundProfile::Dirt,
+     {
+         "assets/audio/step/step_dirt_1.wav",
+         "assets/audio/step/step_dirt_2.wav",
+         "assets/audio/step/step_dirt_3.wav",
+     }},
+    {SoundPool::Footstep,
+     AudioSystem::SoundProfile::Grass,
+     {
+         "assets/audio/step/step_grass_1.wav",
+         "assets/audio/step/step_grass_2.wav",
+         "assets/audio/step/step_grass_3.wav",
+     }},
+    {SoundPool::Footstep,
+     AudioSystem::SoundProfile::Wood,
+     {
+         "assets/audio/step/step_wood_1.wav",
+         "assets/audio/step/step_wood_2.wav",
+         "assets/audio/step/step_wood_3.wav",
+     }},
+    {SoundPool::Footstep,
+     AudioSystem::SoundProfile::Foliage,
+     {
+         "assets/audio/step/step_foliage_1.wav",
+         "assets/audio/step/step_foliage_2.wav",
+         "assets/audio/step/step_foliage_3.wav",
+     }},
+    {SoundPool::Footstep,
+     AudioSystem::SoundProfile::Sand,
+     {
+         "assets/audio/step/step_sand_1.wav",
+         "assets/audio/step/step_sand_2.wav",
+         "assets/audio/step/step_sand_3.wav",
+     }},
+    {SoundPool::Footstep,
+     AudioSystem::SoundProfile::Snow,
+     {
+         "assets/audio/step/step_snow_1.wav",
+         "assets/audio/step/step_snow_2.wav",
+     }},
+    {SoundPool::Footstep,
+     AudioSystem::SoundProfile::Ice,
+     {
+         "assets/audio/step/step_ice_1.wav",
+         "assets/audio/step/step_ice_2.wav",
+     }},
+    {SoundPool::Place,
+     AudioSystem::SoundProfile::Default,
+     {
+         "assets/audio/place/place_default_1.wav",
+         "assets/audio/place/place_default_2.wav",
+     }},
+    {SoundPool::Place,
+     AudioSystem::SoundProfile::Stone,
+     {
+         "assets/audio/place/place_stone_1.wav",
+         "assets/audio/place/place_stone_2.wav",
+     }},
+    {SoundPool::Place,
+     AudioSystem::SoundProfile::Dirt,
+     {
+         "assets/audio/place/place_dirt_1.wav",
+         "assets/audio/place/place_dirt_2.wav",
+     }},
+    {SoundPool::Place,
+     AudioSystem::SoundProfile::Wood,
+     {
+         "assets/audio/place/place_wood_1.wav",
+         "assets/audio/place/place_wood_2.wav",
+     }},
+    {SoundPool::Place,
+     AudioSystem::SoundProfile::Foliage,
+     {
+         "assets/audio/place/place_foliage_1.wav",
+         "assets/audio/place/place_foliage_2.wav",
+     }},
+    {SoundPool::Place,
+     AudioSystem::SoundProfile::Sand,
+     {
+         "assets/audio/place/place_sand_1.wav",
+         "assets/audio/place/place_sand_2.wav",
+     }},
+    {SoundPool::Place,
+     AudioSystem::SoundProfile::Snow,
+     {
+         "assets/audio/place/place_snow_1.wav",
+         "assets/audio/place/place_snow_2.wav",
+     }},
+    {SoundPool::Place,
+     AudioSystem::SoundProfile::Ice,
+     {
+         "assets/audio/place/place_ice_1.wav",
+         "assets/audio/place/place_ice_2.wav",
+     }},
+    {SoundPool::Swim,
+     AudioSystem::SoundProfile::Default,
+     {
+         "assets/audio/swim/swim_1.wav",
+         "assets/audio/swim/swim_2.wav",
+         "assets/audio/swim/swim_3.wav",
+     }},
+    {SoundPool::WaterBob,
+     AudioSystem::SoundProfile::Default,
+     {
+         "assets/audio/bob/bob_1.wav",
+         "assets/audio/bob/bob_2.wav",
+         "assets/audio/bob/bob_3.wav",
+     }},
+    };
+    return sets;
+}
+
 } // namespace
 
 struct AudioSystem::Impl {
@@ -244,6 +376,24 @@ struct AudioSystem::Impl {
     std::array<std::vector<ALuint>, kProfileCount> footstepPools;
     std::array<std::vector<ALuint>, kProfileCount> placePools;
     std::vector<ALuint> activeSources;
+
+    std::vector<ALuint> &pool(SoundPool kind, SoundProfile profile) {
+        switch (kind) {
+        case SoundPool::Pickup:
+            return pickupBuffers;
+        case SoundPool::Break:
+            return breakPools[profileIndex(profile)];
+        case SoundPool::Footstep:
+            return footstepPools[profileIndex(profile)];
+        case SoundPool::Place:
+            return placePools[profileIndex(profile)];
+        case SoundPool::Swim:
+            return swimBuffers;
+        case SoundPool::WaterBob:
+            break;
+        }
+        return bobBuffers;
+    }
 };
 
 AudioSystem::~AudioSystem() {
@@ -384,187 +534,56 @@ bool AudioSystem::loadPlaceSounds(SoundProfile profile, const std::vector<std::s
 
 bool AudioSystem::loadDefaultAssets() {
     bool ok = true;
-    ok = loadPickupSounds({
-             "assets/audio/pickup/pickup.wav",
-         }) &&
-         ok;
-    ok = loadBreakSounds(SoundProfile::Default,
-                         {
-                             "assets/audio/break/break_1.wav",
-                             "assets/audio/break/break_2.wav",
-                             "assets/audio/break/break_3.wav",
-                         }) &&
-         ok;
-    ok = loadBreakSounds(SoundProfile::Stone,
-                         {
-                             "assets/audio/break/break_stone_1.wav",
-                             "assets/audio/break/break_stone_2.wav",
-                             "assets/audio/break/break_stone_3.wav",
-                         }) &&
-         ok;
-    ok = loadBreakSounds(SoundProfile::Dirt,
-                         {
-                             "assets/audio/break/break_dirt_1.wav",
-                             "assets/audio/break/break_dirt_2.wav",
-                             "assets/audio/break/break_dirt_3.wav",
-                         }) &&
-         ok;
-    ok = loadBreakSounds(SoundProfile::Wood,
-                         {
-                             "assets/audio/break/break_wood_1.wav",
-                             "assets/audio/break/break_wood_2.wav",
-                             "assets/audio/break/break_wood_3.wav",
-                         }) &&
-         ok;
-    ok = loadBreakSounds(SoundProfile::Foliage,
-                         {
-                             "assets/audio/break/break_foliage_1.wav",
-                             "assets/audio/break/break_foliage_2.wav",
-                             "assets/audio/break/break_foliage_3.wav",
-                         }) &&
-         ok;
-    ok = loadBreakSounds(SoundProfile::Sand,
-                         {
-                             "assets/audio/break/break_sand_1.wav",
-                             "assets/audio/break/break_sand_2.wav",
-                             "assets/audio/break/break_sand_3.wav",
-                         }) &&
-         ok;
-    ok = loadBreakSounds(SoundProfile::Snow,
-                         {
-                             "assets/audio/break/break_snow_1.wav",
-                             "assets/audio/break/break_snow_2.wav",
-                         }) &&
-         ok;
-    ok = loadBreakSounds(SoundProfile::Ice,
-                         {
-                             "assets/audio/break/break_ice_1.wav",
-                             "assets/audio/break/break_ice_2.wav",
-                         }) &&
-         ok;
-    ok = loadFootstepSounds(SoundProfile::Default,
-                            {
-                                "assets/audio/step/step_default_1.wav",
-                                "assets/audio/step/step_default_2.wav",
-                            }) &&
-         ok;
-    ok = loadFootstepSounds(SoundProfile::Stone,
-                            {
-                                "assets/audio/step/step_stone_1.wav",
-                                "assets/audio/step/step_stone_2.wav",
-                                "assets/audio/step/step_stone_3.wav",
-                            }) &&
-         ok;
-    ok = loadFootstepSounds(SoundProfile::Dirt,
-                            {
-                                "assets/audio/step/step_dirt_1.wav",
-                                "assets/audio/step/step_dirt_2.wav",
-                                "assets/audio/step/step_dirt_3.wav",
-                            }) &&
-         ok;
-    ok = loadFootstepSounds(SoundProfile::Grass,
-                            {
-                                "assets/audio/step/step_grass_1.wav",
-                                "assets/audio/step/step_grass_2.wav",
-                                "assets/audio/step/step_grass_3.wav",
-                            }) &&
-         ok;
-    ok = loadFootstepSounds(SoundProfile::Wood,
-                            {
-                                "assets/audio/step/step_wood_1.wav",
-                                "assets/audio/step/step_wood_2.wav",
-                                "assets/audio/step/step_wood_3.wav",
-                            }) &&
-         ok;
-    ok = loadFootstepSounds(SoundProfile::Foliage,
-                            {
-                                "assets/audio/step/step_foliage_1.wav",
-                                "assets/audio/step/step_foliage_2.wav",
-                                "assets/audio/step/step_foliage_3.wav",
-                            }) &&
-         ok;
-    ok = loadFootstepSounds(SoundProfile::Sand,
-                            {
-                                "assets/audio/step/step_sand_1.wav",
-                                "assets/audio/step/step_sand_2.wav",
-                                "assets/audio/step/step_sand_3.wav",
-                            }) &&
-         ok;
-    ok = loadFootstepSounds(SoundProfile::Snow,
-                            {
-                                "assets/audio/step/step_snow_1.wav",
-                                "assets/audio/step/step_snow_2.wav",
-                            }) &&
-         ok;
-    ok = loadFootstepSounds(SoundProfile::Ice,
-                            {
-                                "assets/audio/step/step_ice_1.wav",
-                                "assets/audio/step/step_ice_2.wav",
-                            }) &&
-         ok;
-    ok = loadPlaceSounds(SoundProfile::Default,
-                         {
-                             "assets/audio/place/place_default_1.wav",
-                             "assets/audio/place/place_default_2.wav",
-                         }) &&
-         ok;
-    ok = loadPlaceSounds(SoundProfile::Stone,
-                         {
-                             "assets/audio/place/place_stone_1.wav",
-                             "assets/audio/place/place_stone_2.wav",
-                         }) &&
-         ok;
-    ok = loadPlaceSounds(SoundProfile::Dirt,
-                         {
-                             "assets/audio/place/place_dirt_1.wav",
-                             "assets/audio/place/place_dirt_2.wav",
-                         }) &&
-         ok;
-    ok = loadPlaceSounds(SoundProfile::Wood,
-                         {
-                             "assets/audio/place/place_wood_1.wav",
-                             "assets/audio/place/place_wood_2.wav",
-                         }) &&
-         ok;
-    ok = loadPlaceSounds(SoundProfile::Foliage,
-                         {
-                             "assets/audio/place/place_foliage_1.wav",
-                             "assets/audio/place/place_foliage_2.wav",
-                         }) &&
-         ok;
-    ok = loadPlaceSounds(SoundProfile::Sand,
-                         {
-                             "assets/audio/place/place_sand_1.wav",
-                             "assets/audio/place/place_sand_2.wav",
-                         }) &&
-         ok;
-    ok = loadPlaceSounds(SoundProfile::Snow,
-                         {
-                             "assets/audio/place/place_snow_1.wav",
-                             "assets/audio/place/place_snow_2.wav",
-                         }) &&
-         ok;
-    ok = loadPlaceSounds(SoundProfile::Ice,
-                         {
-                             "assets/audio/place/place_ice_1.wav",
-                             "assets/audio/place/place_ice_2.wav",
-                         }) &&
-         ok;
-    ok = loadSwimSounds({
-             "assets/audio/swim/swim_1.wav",
-             "assets/audio/swim/swim_2.wav",
-             "assets/audio/swim/swim_3.wav",
-         }) &&
-         ok;
-    ok = loadWaterBobSounds({
-             "assets/audio/bob/bob_1.wav",
-             "assets/audio/bob/bob_2.wav",
-             "assets/audio/bob/bob_3.wav",
-         }) &&
-         ok;
+    for (const SoundSet &set : defaultSoundSets()) {
+        switch (set.pool) {
+        case SoundPool::Pickup:
+            ok = loadPickupSounds(set.paths) && ok;
+            break;
+        case SoundPool::Break:
+            ok = loadBreakSounds(set.profile, set.paths) && ok;
+            break;
+        case SoundPool::Footstep:
+            ok = loadFootstepSounds(set.profile, set.paths) && ok;
+            break;
+        case SoundPool::Place:
+            ok = loadPlaceSounds(set.profile, set.paths) && ok;
+            break;
+        case SoundPool::Swim:
+            ok = loadSwimSounds(set.paths) && ok;
+            break;
+        case SoundPool::WaterBob:
+            ok = loadWaterBobSounds(set.paths) && ok;
+            break;
+        }
+    }
     return ok;
 }
 
+void AudioSystem::loadDefaultAssetsAsync(core::AssetLoader &loader) {
+    if (!ready_ && !init()) {
+        return;
+    }
+    for (const SoundSet &set : defaultSoundSets()) {
+        std::vector<ALuint> &pool = impl_->pool(set.pool, set.profile);
+        releaseBuffers(pool);
+        for (const std::string &path : set.paths) {
+            loader.submit([path, &pool]() -> core::AssetLoader::Upload {
+                auto wav = std::make_shared<DecodedWav>();
+                if (!decodeWav(path, *wav)) {
+                    return {};
+                }
+                // Pools fill as uploads land; playing an empty pool is silent.
+                return [path, wav, &pool] {
+                    const ALuint buffer = uploadWav(path, wav->sound);
+                    if (buffer != 0) {
+                        pool.push_back(buffer);
+                    }
+                };
+            });
+        }
+    }
+}
+
 void AudioSystem::playPickup() {
     if (!ready_ || impl_ == nullptr) {
         return;
@@ -677,6 +696,8 @@ bool AudioSystem::loadDefaultAssets() {
     return false;
 }
 
+void AudioSystem::loadDefaultAssetsAsync(core::AssetLoader & /*loader*/) {}
+
 void AudioSystem::playBreak(SoundProfile /*profile*/) {}
 
 void AudioSystem::playFootstep(SoundProfile /*profile*/) {}
@@ -1,23 +1,43 @@
 #include "game/CraftingSystem.hpp"
 
 #include <algorithm>
+#include <climits>
 #include <cmath>
 
 namespace game {
+namespace {
+bool isWood(voxel::BlockId id) {
+    return id == voxel::WOOD || id == voxel::SPRUCE_WOOD || id == voxel::BIRCH_WOOD;
+}
+
+bool isPlanks(voxel::BlockId id) {
+    return id == voxel::OAK_PLANKS || id == voxel::SPRUCE_PLANKS || id == voxel::BIRCH_PLANKS;
+}
+
+voxel::BlockId ingredientKey(const Recipe::Ingredient &ingredient) {
+    if (ingredient.allowAnyWood) {
+        return voxel::WOOD;
+    }
+    if (ingredient.allowAnyPlanks) {
+        return voxel::OAK_PLANKS;
+    }
+    return ingredient.id;
+}
+} // namespace
 
 CraftingSystem::CraftingSystem() {
     auto addShapeless = [&](std::vector<Recipe::Ingredient> ingredients, voxel::BlockId outId,
                             int outCount, const std::string &label, int minGrid, int exactSlots,
                             std::vector<RecipeInfo::IngredientInfo> infoIn) {
-        recipes_.emplace_back(std::move(ingredients), Inventory::Slot{outId, outCount}, minGrid,
-                              exactSlots);
         RecipeInfo info{};
         info.ingredients = std::move(infoIn);
         info.outputId = outId;
         info.outputCount = outCount;
         info.label = label;
         info.minGridSize = minGrid;
-        recipeInfos_.push_back(std::move(info));
+        addRecipe(Recipe(std::move(ingredients), Inventory::Slot{outId, outCount}, minGrid,
+                         exactSlots),
+                  std::move(info));
     };
 
     auto addShaped = [&](std::vector<Recipe::ShapedCell> cells, voxel::BlockId outId, int outCount,
@@ -25,7 +45,6 @@ CraftingSystem::CraftingSystem() {
                          std::vector<RecipeInfo::IngredientInfo> infoIn,
                          std::vector<int> shapedSlots,
                          std::vector<RecipeInfo::ShapedCellInfo> shapedCells) {
-        recipes_.emplace_back(cells, Inventory::Slot{outId, outCount}, gridSize);
         RecipeInfo info{};
         info.ingredients = std::move(infoIn);
         info.shapedSlots = std::move(shapedSlots);
@@ -34,7 +53,8 @@ CraftingSystem::CraftingSystem() {
         info.outputCount = outCount;
         info.label = label;
         info.minGridSize = gridSize;
-        recipeInfos_.push_back(std::move(info));
+        addRecipe(Recipe(std::move(cells), Inventory::Slot{outId, outCount}, gridSize),
+                  std::move(info));
     };
 
     // Minecraft-like starter recipes.
@@ -99,7 +119,262 @@ int CraftingSystem::activeInputCount(int gridSize) {
     return clamped * clamped;
 }
 
+void CraftingSystem::addRecipe(Recipe recipe, RecipeInfo info) {
+    recipes_.push_back(std::move(recipe));
+    recipeInfos_.push_back(std::move(info));
+    const int index = static_cast<int>(recipes_.size()) - 1;
+    indexRecipe(index);
+    buildRequirements(index);
+}
+
+std::size_t CraftingSystem::SignatureHash::operator()(const Signature &sig) const noexcept {
+    std::uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&hash](std::uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+    mix(sig.width);
+    mix(sig.height);
+    for (voxel::BlockId id : sig.ids) {
+        mix(id);
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+voxel::BlockId CraftingSystem::signatureId(voxel::BlockId id, bool anyWood, bool anyPlanks) {
+    if (anyWood && isWood(id)) {
+        return voxel::WOOD;
+    }
+    if (anyPlanks && isPlanks(id)) {
+        return voxel::OAK_PLANKS;
+    }
+    return id;
+}
+
+CraftingSystem::Signature CraftingSystem::gridSignature(const State &state, int gridSize,
+                                                        bool shaped, bool anyWood,
+                                                        bool anyPlanks) {
+    const int inputCount = activeInputCount(gridSize);
+    Signature sig{};
+    if (!shaped) {
+        int distinct = 0;
+        for (int i = 0; i < inputCount; ++i) {
+            const auto &slot = state.input[i];
+            if (slot.id == voxel::AIR || slot.count <= 0) {
+                continue;
+            }
+            const voxel::BlockId id = signatureId(slot.id, anyWood, anyPlanks);
+            const auto end = sig.ids.begin() + distinct;
+            if (std::find(sig.ids.begin(), end, id) == end) {
+                sig.ids[distinct++] = id;
+            }
+        }
+        std::sort(sig.ids.begin(), sig.ids.begin() + distinct);
+        sig.height = static_cast<std::uint8_t>(distinct);
+        return sig;
+    }
+
+    int minRow = gridSize;
+    int minCol = gridSize;
+    int maxRow = -1;
+    int maxCol = -1;
+    for (int i = 0; i < inputCount; ++i) {
+        const auto &slot = state.input[i];
+        if (slot.id == voxel::AIR || slot.count <= 0) {
+            continue;
+        }
+        minRow = std::min(minRow, i / gridSize);
+        minCol = std::min(minCol, i % gridSize);
+        maxRow = std::max(maxRow, i / gridSize);
+        maxCol = std::max(maxCol, i % gridSize);
+    }
+    if (maxRow < 0) {
+        return sig;
+    }
+    const int width = maxCol - minCol + 1;
+    sig.width = static_cast<std::uint8_t>(width);
+    sig.height = static_cast<std::uint8_t>(maxRow - minRow + 1);
+    for (int row = minRow; row <= maxRow; ++row) {
+        for (int col = minCol; col <= maxCol; ++col) {
+            const auto &slot = state.input[row * gridSize + col];
+            if (slot.id == voxel::AIR || slot.count <= 0) {
+                continue;
+            }
+            sig.ids[(row - minRow) * width + (col - minCol)] =
+                signatureId(slot.id, anyWood, anyPlanks);
+        }
+    }
+    return sig;
+}
+
+void CraftingSystem::indexRecipe(int index) {
+    const Recipe &recipe = recipes_[index];
+    bool anyWood = false;
+    bool anyPlanks = false;
+    bool exactWood = false;
+    bool exactPlanks = false;
+    bool usable = true;
+    auto classify = [&](const Recipe::Ingredient &ingredient) {
+        if (ingredient.allowAnyWood) {
+            anyWood = true;
+        } else if (ingredient.allowAnyPlanks) {
+            anyPlanks = true;
+        } else {
+            exactWood = exactWood || isWood(ingredient.id);
+            exactPlanks = exactPlanks || isPlanks(ingredient.id);
+            usable = usable && ingredient.id != voxel::AIR;
+        }
+        usable = usable && ingredient.count > 0;
+    };
+
+    Signature sig{};
+    if (recipe.shaped()) {
+        const auto &cells = recipe.shapedCells();
+        const int base = recipe.minGridSize();
+        int minRow = base;
+        int minCol = base;
+        int maxRow = -1;
+        int maxCol = -1;
+        for (const auto &cell : cells) {
+            classify(cell.ingredient);
+            usable = usable && cell.slot >= 0 && cell.slot < base * base;
+            minRow = std::min(minRow, cell.slot / base);
+            minCol = std::min(minCol, cell.slot % base);
+            maxRow = std::max(maxRow, cell.slot / base);
+            maxCol = std::max(maxCol, cell.slot % base);
+        }
+        const int width = maxCol - minCol + 1;
+        const int height = maxRow - minRow + 1;
+        usable = usable && !cells.empty() && width <= kGridSizeTable && height <= kGridSizeTable;
+        if (usable) {
+            sig.width = static_cast<std::uint8_t>(width);
+            sig.height = static_cast<std::uint8_t>(height);
+            for (const auto &cell : cells) {
+                const int row = cell.slot / base - minRow;
+                const int col = cell.slot % base - minCol;
+                auto &id = sig.ids[row * width + col];
+                usable = usable && id == voxel::AIR;
+                id = ingredientKey(cell.ingredient);
+            }
+        }
+    } else {
+        std::vector<voxel::BlockId> keys;
+        for (const auto &ingredient : recipe.ingredients()) {
+            classify(ingredient);
+            keys.push_back(ingredientKey(ingredient));
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        usable = usable && !keys.empty() && keys.size() <= sig.ids.size();
+        if (usable) {
+            std::copy(keys.begin(), keys.end(), sig.ids.begin());
+            sig.height = static_cast<std::uint8_t>(keys.size());
+        }
+    }
+
+    if (!usable || (anyWood && exactWood) || (anyPlanks && exactPlanks)) {
+        unindexed_.push_back(index);
+        return;
+    }
+    index_[sig].push_back(index);
+}
+
+void CraftingSystem::buildRequirements(int index) {
+    const RecipeInfo &info = recipeInfos_[index];
+    std::vector<Requirement> requirements;
+    auto add = [&](const RecipeInfo::IngredientInfo &ingredient) {
+        Requirement req{};
+        req.anyWood = ingredient.allowAnyWood;
+        req.anyPlanks = !ingredient.allowAnyWood && ingredient.allowAnyPlanks;
+        req.id = req.anyWood ? voxel::WOOD : (req.anyPlanks ? voxel::OAK_PLANKS : ingredient.id);
+        req.count = ingredient.count;
+        for (auto &existing : requirements) {
+            if (existing.id == req.id && existing.anyWood == req.anyWood &&
+                existing.anyPlanks == req.anyPlanks) {
+                existing.count += req.count;
+                return;
+            }
+        }
+        requirements.push_back(req);
+    };
+    if (!info.shapedCells.empty()) {
+        for (const auto &cell : info.shapedCells) {
+            add(cell.ingredient);
+        }
+    } else {
+        for (const auto &ingredient : info.ingredients) {
+            add(ingredient);
+        }
+    }
+
+    for (auto &req : requirements) {
+        countSize_ = std::max(countSize_, static_cast<std::size_t>(req.id) + 1);
+        if (!req.anyWood && !req.anyPlanks) {
+            continue;
+        }
+        for (const auto &other : requirements) {
+            if (!other.anyWood && !other.anyPlanks &&
+                (req.anyWood ? isWood(other.id) : isPlanks(other.id))) {
+                req.reserved += other.count;
+            }
+        }
+        const voxel::BlockId last = req.anyWood ? voxel::BIRCH_WOOD : voxel::BIRCH_PLANKS;
+        countSize_ = std::max(countSize_, static_cast<std::size_t>(last) + 1);
+    }
+    requirements_.push_back(std::move(requirements));
+}
+
 const Recipe *CraftingSystem::findMatch(const State &state, int gridSize) const {
+    if (gridSize != kGridSizeInventory && gridSize != kGridSizeTable) {
+        return findMatchLinear(state, gridSize);
+    }
+    const int inputCount = activeInputCount(gridSize);
+    bool occupied = false;
+    bool hasWood = false;
+    bool hasPlanks = false;
+    for (int i = 0; i < inputCount; ++i) {
+        const auto &slot = state.input[i];
+        if (slot.id == voxel::AIR || slot.count <= 0) {
+            continue;
+        }
+        occupied = true;
+        hasWood = hasWood || isWood(slot.id);
+        hasPlanks = hasPlanks || isPlanks(slot.id);
+    }
+
+    // Earlier recipes win, as in the linear scan.
+    int best = INT_MAX;
+    for (int index : unindexed_) {
+        if (index < best && recipes_[index].matches(state.input, inputCount, gridSize)) {
+            best = index;
+        }
+    }
+    if (occupied) {
+        for (int wood = 0; wood <= (hasWood ? 1 : 0); ++wood) {
+            for (int planks = 0; planks <= (hasPlanks ? 1 : 0); ++planks) {
+                for (bool shaped : {true, false}) {
+                    const auto it =
+                        index_.find(gridSignature(state, gridSize, shaped, wood != 0, planks != 0));
+                    if (it == index_.end()) {
+                        continue;
+                    }
+                    for (int index : it->second) {
+                        if (index >= best) {
+                            break;
+                        }
+                        if (recipes_[index].matches(state.input, inputCount, gridSize)) {
+                            best = index;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return best == INT_MAX ? nullptr : &recipes_[best];
+}
+
+const Recipe *CraftingSystem::findMatchLinear(const State &state, int gridSize) const {
     const int inputCount = activeInputCount(gridSize);
     for (const auto &recipe : recipes_) {
         if (recipe.matches(state.input, inputCount, gridSize)) {
@@ -109,6 +384,61 @@ const Recipe *CraftingSystem::findMatch(const State &state, int gridSize) const
     return nullptr;
 }
 
+std::vector<int> CraftingSystem::countItems(const Inventory &inventory) const {
+    std::vector<int> counts(countSize_, 0);
+    for (int i = 0; i < Inventory::kSlotCount; ++i) {
+        const auto &slot = inventory.slot(i);
+        if (slot.id == voxel::AIR || slot.count <= 0 || slot.id >= countSize_) {
+            continue;
+        }
+        counts[slot.id] += slot.count;
+    }
+    return counts;
+}
+
+bool CraftingSystem::canCraftFrom(const std::vector<int> &counts, int recipeIndex,
+                                  int gridSize) const {
+    if (recipeIndex < 0 || recipeIndex >= static_cast<int>(recipeInfos_.size()) ||
+        gridSize < recipeInfos_[recipeIndex].minGridSize) {
+        return false;
+    }
+    auto countOf = [&counts](voxel::BlockId id) {
+        return id < counts.size() ? counts[id] : 0;
+    };
+    for (const auto &req : requirements_[recipeIndex]) {
+        int available = 0;
+        if (req.anyWood) {
+            available = countOf(voxel::WOOD) + countOf(voxel::SPRUCE_WOOD) +
+                        countOf(voxel::BIRCH_WOOD) - req.reserved;
+        } else if (req.anyPlanks) {
+            available = countOf(voxel::OAK_PLANKS) + countOf(voxel::SPRUCE_PLANKS) +
+                        countOf(voxel::BIRCH_PLANKS) - req.reserved;
+        } else {
+            available = countOf(req.id);
+        }
+        if (available < req.count) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CraftingSystem::refreshCraftability(Craftability &state, const Inventory &inventory,
+                                         int gridSize) const {
+    std::vector<int> counts = countItems(inventory);
+    if (counts == state.counts && gridSize == state.gridSize &&
+        state.flags.size() == recipes_.size()) {
+        return false;
+    }
+    state.counts = std::move(counts);
+    state.gridSize = gridSize;
+    state.flags.assign(recipes_.size(), 0);
+    for (int i = 0; i < static_cast<int>(recipes_.size()); ++i) {
+        state.flags[i] = canCraftFrom(state.counts, i, gridSize) ? 1 : 0;
+    }
+    return true;
+}
+
 void CraftingSystem::updateOutput(State &state, int gridSize) const {
     state.output = {};
     if (const Recipe *recipe = findMatch(state, gridSize)) {
@@ -390,7 +390,12 @@ void DebugMenu::update(GLFWwindow *window, DebugConfig &cfg, const world::WorldD
                   "Chunks Loaded: %d  Meshed: %d  Pending Load: %d  Pending Mesh: %d",
                   stats.loadedChunks, stats.meshedChunks, stats.pendingLoad, stats.pendingRemesh);
     infoLines_.push_back(line);
-    std::snprintf(line, sizeof(line), "Triangles: %d", stats.totalTriangles);
+    std::snprintf(line, sizeof(line), "Triangles: %d  Chunks Drawn: %d  Culled: %d  Occluded: %d",
+                  stats.totalTriangles, stats.drawnChunks, stats.culledChunks,
+                  stats.occludedChunks);
+    infoLines_.push_back(line);
+    std::snprintf(line, sizeof(line), "First playable: %.0f ms  Spawn chunks preloaded: %d",
+                  stats.timeToFirstPlayableMs, stats.preloadedChunks);
     infoLines_.push_back(line);
     infoLines_.push_back("Mouse: use tabs, click +/- and switches, drag Time/Moon sliders");
 
@@ -13,8 +13,12 @@ Inventory::Inventory() {
 }
 
 bool Inventory::add(voxel::BlockId id, int count) {
+    return addUpTo(id, count) > 0;
+}
+
+int Inventory::addUpTo(voxel::BlockId id, int count) {
     if (id == voxel::AIR || count <= 0) {
-        return false;
+        return 0;
     }
 
     int remaining = count;
@@ -28,7 +32,7 @@ bool Inventory::add(voxel::BlockId id, int count) {
         slot.count += take;
         remaining -= take;
         if (remaining == 0) {
-            return true;
+            return count;
         }
     }
 
@@ -41,11 +45,11 @@ bool Inventory::add(voxel::BlockId id, int count) {
         slot.count = take;
         remaining -= take;
         if (remaining == 0) {
-            return true;
+            return count;
         }
     }
 
-    return remaining != count;
+    return count - remaining;
 }
 
 bool Inventory::consumeHotbar(int hotbarIndex, int count) {
@@ -1,17 +1,20 @@
 #include "game/ItemDropSystem.hpp"
 
 #include "app/util/ShaderProgramUtils.hpp"
+#include "game/Inventory.hpp"
+#include "gfx/SceneUniforms.hpp"
+#include "voxel/Chunk.hpp"
 #include "world/World.hpp"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <glm/common.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
+#include <glm/geometric.hpp>
 
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <string>
 namespace game {
 namespace {
 
@@ -23,20 +26,107 @@ constexpr float kGroundDrag = 7.0f;
 constexpr float kAirDrag = 1.2f;
 constexpr float kPickupRadius = 1.20f;
 constexpr float kMaxLifetime = 180.0f;
+constexpr float kMergeRadius = 0.6f;
+// A stack counts as resting once it is supported and slower than this for a
+// few consecutive ticks; it then sleeps until a chunk around it changes.
+constexpr float kSleepSpeed = 0.02f;
+constexpr std::uint8_t kSleepAfterTicks = 3;
+constexpr float kSupportProbe = 0.05f;
+
+// Static mesh vertex: object-space position, UV corner (0..1), face slot
+// (0 front, 1 side, 2 top, 3 bottom) and flat face light.
+struct MeshVertex {
+    float x;
+    float y;
+    float z;
+    float cornerU;
+    float cornerV;
+    float face;
+    float light;
+};
 
 float frand(float minV, float maxV) {
     const float t = static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX);
     return minV + (maxV - minV) * t;
 }
 
+std::uint64_t packCoord(int x, int y, int z) {
+    constexpr std::uint64_t kMask = (1ull << 21) - 1;
+    constexpr int kBias = 1 << 20;
+    return ((static_cast<std::uint64_t>(x + kBias) & kMask) << 42) |
+           ((static_cast<std::uint64_t>(y + kBias) & kMask) << 21) |
+           (static_cast<std::uint64_t>(z + kBias) & kMask);
+}
+
+glm::ivec3 cellOf(const glm::vec3 &p) {
+    return glm::ivec3(static_cast<int>(std::floor(p.x)), static_cast<int>(std::floor(p.y)),
+                      static_cast<int>(std::floor(p.z)));
+}
+
+int floorDiv(int v, int d) {
+    return (v >= 0) ? (v / d) : ((v - d + 1) / d);
+}
+
+bool isFlatItem(voxel::BlockId id) {
+    return id == voxel::STICK || voxel::isPlant(id) || id == voxel::IRON_INGOT ||
+           id == voxel::COPPER_INGOT || id == voxel::GOLD_INGOT || voxel::isTorch(id);
+}
+
+void buildMesh(std::vector<MeshVertex> &out, int &cubeVertices, int &spriteVertices) {
+    auto appendQuad = [&](const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &p2,
+                          const glm::vec3 &p3, float face, float light) {
+        out.push_back(MeshVertex{p0.x, p0.y, p0.z, 0.0f, 0.0f, face, light});
+        out.push_back(MeshVertex{p1.x, p1.y, p1.z, 1.0f, 0.0f, face, light});
+        out.push_back(MeshVertex{p2.x, p2.y, p2.z, 1.0f, 1.0f, face, light});
+        out.push_back(MeshVertex{p0.x, p0.y, p0.z, 0.0f, 0.0f, face, light});
+        out.push_back(MeshVertex{p2.x, p2.y, p2.z, 1.0f, 1.0f, face, light});
+        out.push_back(MeshVertex{p3.x, p3.y, p3.z, 0.0f, 1.0f, face, light});
+    };
+
+    const float h = kItemRenderHalf;
+    const glm::vec3 p000(-h, -h, -h);
+    const glm::vec3 p001(-h, -h, h);
+    const glm::vec3 p010(-h, h, -h);
+    const glm::vec3 p011(-h, h, h);
+    const glm::vec3 p100(h, -h, -h);
+    const glm::vec3 p101(h, -h, h);
+    const glm::vec3 p110(h, h, -h);
+    const glm::vec3 p111(h, h, h);
+    appendQuad(p001, p101, p111, p011, 0.0f, 0.92f); // +Z (furnace front)
+    appendQuad(p100, p000, p010, p110, 1.0f, 0.75f); // -Z
+    appendQuad(p000, p001, p011, p010, 1.0f, 0.82f); // -X
+    appendQuad(p101, p100, p110, p111, 1.0f, 0.88f); // +X
+    appendQuad(p010, p011, p111, p110, 2.0f, 1.00f); // +Y
+    appendQuad(p000, p100, p101, p001, 3.0f, 0.65f); // -Y
+    cubeVertices = static_cast<int>(out.size());
+
+    const float s = 0.20f;
+    const float y0 = -0.20f;
+    const float y1 = 0.20f;
+    appendQuad({-s, y0, -s}, {s, y0, s}, {s, y1, s}, {-s, y1, -s}, 1.0f, 0.95f);
+    appendQuad({s, y0, -s}, {-s, y0, s}, {-s, y1, s}, {s, y1, -s}, 1.0f, 0.95f);
+    spriteVertices = static_cast<int>(out.size()) - cubeVertices;
+}
+
+void pointInstanceAttributes(std::size_t firstInstance, std::size_t stride) {
+    const std::size_t base = firstInstance * stride;
+    for (GLuint i = 0; i < 5; ++i) {
+        glVertexAttribPointer(4 + i, 4, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(stride),
+                              reinterpret_cast<void *>(base + i * 4 * sizeof(float)));
+    }
+}
+
 } // namespace
 
 ItemDropSystem::~ItemDropSystem() {
     if (glfwGetCurrentContext() == nullptr) {
         return;
     }
-    if (vbo_ != 0) {
-        glDeleteBuffers(1, &vbo_);
+    if (instanceVbo_ != 0) {
+        glDeleteBuffers(1, &instanceVbo_);
+    }
+    if (meshVbo_ != 0) {
+        glDeleteBuffers(1, &meshVbo_);
     }
     if (vao_ != 0) {
         glDeleteVertexArrays(1, &vao_);
@@ -51,19 +141,30 @@ void ItemDropSystem::initGl() {
         return;
     }
 
-    const char *vs = R"(
-#version 330 core
+    const std::string vs = std::string("#version 330 core\n") + gfx::kSceneUniformBlockGlsl + R"(
 layout(location = 0) in vec3 aPos;
-layout(location = 1) in vec2 aUV;
-layout(location = 2) in float aLight;
-uniform mat4 uProj;
-uniform mat4 uView;
+layout(location = 1) in vec2 aCorner;
+layout(location = 2) in float aFace;
+layout(location = 3) in float aLight;
+layout(location = 4) in vec4 iPosBirth;
+layout(location = 5) in vec4 iUvSide;
+layout(location = 6) in vec4 iUvTop;
+layout(location = 7) in vec4 iUvBottom;
+layout(location = 8) in vec4 iUvFront;
+uniform float uTime;
 out vec2 vUV;
 out float vLight;
 void main() {
-    vUV = aUV;
+    float age = uTime - iPosBirth.w;
+    float ang = age * 1.8;
+    float c = cos(ang);
+    float s = sin(ang);
+    vec3 local = vec3(c * aPos.x + s * aPos.z, aPos.y, -s * aPos.x + c * aPos.z);
+    vec3 center = iPosBirth.xyz + vec3(0.0, 0.23 + 0.08 * sin(age * 3.8), 0.0);
+    vec4 rect = aFace < 0.5 ? iUvFront : (aFace < 1.5 ? iUvSide : (aFace < 2.5 ? iUvTop : iUvBottom));
+    vUV = vec2(mix(rect.x, rect.z, aCorner.x), mix(rect.w, rect.y, aCorner.y));
     vLight = aLight;
-    gl_Position = uProj * uView * vec4(aPos, 1.0);
+    gl_Position = uProj * uView * vec4(center + local, 1.0);
 }
 )";
 
@@ -81,39 +182,107 @@ void main() {
 )";
 
     shader_ = app::util::linkInLineProgram(
-        app::util::compileInlineShader(GL_VERTEX_SHADER, vs),
+        app::util::compileInlineShader(GL_VERTEX_SHADER, vs.c_str()),
         app::util::compileInlineShader(GL_FRAGMENT_SHADER, fs));
+    gfx::bindSceneUniformBlock(shader_);
+    uAtlas_ = glGetUniformLocation(shader_, "uAtlas");
+    uTime_ = glGetUniformLocation(shader_, "uTime");
+
+    std::vector<MeshVertex> mesh;
+    buildMesh(mesh, cubeVertexCount_, spriteVertexCount_);
 
     glGenVertexArrays(1, &vao_);
-    glGenBuffers(1, &vbo_);
+    glGenBuffers(1, &meshVbo_);
+    glGenBuffers(1, &instanceVbo_);
     glBindVertexArray(vao_);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, meshVbo_);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(mesh.size() * sizeof(MeshVertex)),
+                 mesh.data(), GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(0));
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
+                          reinterpret_cast<void *>(0));
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
                           reinterpret_cast<void *>(3 * sizeof(float)));
     glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
                           reinterpret_cast<void *>(5 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
+                          reinterpret_cast<void *>(6 * sizeof(float)));
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo_);
+    for (GLuint i = 4; i <= 8; ++i) {
+        glEnableVertexAttribArray(i);
+        glVertexAttribDivisor(i, 1);
+    }
+    pointInstanceAttributes(0, sizeof(Instance));
 
     ready_ = true;
 }
 
-bool ItemDropSystem::collidesSolid(const world::World &world, const glm::vec3 &pos) const {
+bool ItemDropSystem::solidAt(const Environment &env, int x, int y, int z) {
+    const std::uint64_t key = packCoord(x, y, z);
+    if (const auto it = solidCache_.find(key); it != solidCache_.end()) {
+        return it->second;
+    }
+    ++stats_.blockQueries;
+    const bool solid = env.isSolid && env.isSolid(x, y, z);
+    solidCache_.emplace(key, solid);
+    return solid;
+}
+
+glm::vec3 ItemDropSystem::flowAt(const Environment &env, const glm::vec3 &pos) {
+    if (!env.fluidCurrent) {
+        return glm::vec3(0.0f);
+    }
+    // Fluid current only depends on the containing block.
+    const glm::ivec3 cell = cellOf(pos);
+    const std::uint64_t key = packCoord(cell.x, cell.y, cell.z);
+    if (const auto it = flowCache_.find(key); it != flowCache_.end()) {
+        return it->second;
+    }
+    ++stats_.blockQueries;
+    const glm::vec3 flow = env.fluidCurrent(pos);
+    flowCache_.emplace(key, flow);
+    return flow;
+}
+
+std::uint64_t ItemDropSystem::revisionAround(const Environment &env, const glm::vec3 &pos) {
+    if (!env.chunkRevision) {
+        return 0;
+    }
+    // Support reads the cells under the stack and fluid current reads their
+    // neighbours, so one block of margin covers every chunk that matters.
+    const glm::ivec3 minC = cellOf(pos - glm::vec3(1.0f));
+    const glm::ivec3 maxC = cellOf(pos + glm::vec3(1.0f));
+    const int cx0 = floorDiv(minC.x, voxel::Chunk::SX);
+    const int cx1 = floorDiv(maxC.x, voxel::Chunk::SX);
+    const int cz0 = floorDiv(minC.z, voxel::Chunk::SZ);
+    const int cz1 = floorDiv(maxC.z, voxel::Chunk::SZ);
+    std::uint64_t newest = 0;
+    for (int cz = cz0; cz <= cz1; ++cz) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            const std::uint64_t key = packCoord(cx, 0, cz);
+            auto it = chunkRevisionCache_.find(key);
+            if (it == chunkRevisionCache_.end()) {
+                it = chunkRevisionCache_.emplace(key, env.chunkRevision(cx, cz)).first;
+            }
+            newest = std::max(newest, it->second);
+        }
+    }
+    return newest;
+}
+
+bool ItemDropSystem::collidesSolid(const Environment &env, const glm::vec3 &pos) {
     const glm::vec3 minP = pos + glm::vec3(-kItemHalf, 0.0f, -kItemHalf);
     const glm::vec3 maxP = pos + glm::vec3(kItemHalf, kItemHeight, kItemHalf);
-    const int minX = static_cast<int>(std::floor(minP.x));
-    const int minY = static_cast<int>(std::floor(minP.y));
-    const int minZ = static_cast<int>(std::floor(minP.z));
-    const int maxX = static_cast<int>(std::floor(maxP.x));
-    const int maxY = static_cast<int>(std::floor(maxP.y));
-    const int maxZ = static_cast<int>(std::floor(maxP.z));
-    for (int y = minY; y <= maxY; ++y) {
-        for (int z = minZ; z <= maxZ; ++z) {
-            for (int x = minX; x <= maxX; ++x) {
-                if (world.isSolidBlock(x, y, z)) {
+    const glm::ivec3 minC = cellOf(minP);
+    const glm::ivec3 maxC = cellOf(maxP);
+    for (int y = minC.y; y <= maxC.y; ++y) {
+        for (int z = minC.z; z <= maxC.z; ++z) {
+            for (int x = minC.x; x <= maxC.x; ++x) {
+                if (solidAt(env, x, y, z)) {
                     return true;
                 }
             }
@@ -126,70 +295,225 @@ void ItemDropSystem::spawn(voxel::BlockId id, const glm::vec3 &worldPos, int cou
     if (id == voxel::AIR || count <= 0) {
         return;
     }
-    for (int i = 0; i < count; ++i) {
-        Item item;
-        item.id = id;
-        item.pos =
-            worldPos + glm::vec3(frand(-0.15f, 0.15f), frand(0.02f, 0.20f), frand(-0.15f, 0.15f));
-        item.vel = glm::vec3(frand(-1.2f, 1.2f), frand(1.8f, 3.5f), frand(-1.2f, 1.2f));
-        item.pickupDelay = 0.18f;
-        items_.push_back(item);
+    while (count > 0) {
+        const int take = std::min(count, Inventory::kMaxStack);
+        count -= take;
+        ids_.push_back(id);
+        counts_.push_back(take);
+        positions_.push_back(worldPos + glm::vec3(frand(-0.15f, 0.15f), frand(0.02f, 0.20f),
+                                                  frand(-0.15f, 0.15f)));
+        velocities_.push_back(
+            glm::vec3(frand(-1.2f, 1.2f), frand(1.8f, 3.5f), frand(-1.2f, 1.2f)));
+        births_.push_back(simTime_);
+        pickupDelays_.push_back(0.18f);
+        restTicks_.push_back(0);
+        asleep_.push_back(0);
+        sleepRevisions_.push_back(0);
+    }
+    instancesDirty_ = true;
+}
+
+void ItemDropSystem::removeAt(std::size_t index) {
+    const std::size_t last = ids_.size() - 1;
+    if (index != last) {
+        ids_[index] = ids_[last];
+        counts_[index] = counts_[last];
+        positions_[index] = positions_[last];
+        velocities_[index] = velocities_[last];
+        births_[index] = births_[last];
+        pickupDelays_[index] = pickupDelays_[last];
+        restTicks_[index] = restTicks_[last];
+        asleep_[index] = asleep_[last];
+        sleepRevisions_[index] = sleepRevisions_[last];
+    }
+    ids_.pop_back();
+    counts_.pop_back();
+    positions_.pop_back();
+    velocities_.pop_back();
+    births_.pop_back();
+    pickupDelays_.pop_back();
+    restTicks_.pop_back();
+    asleep_.pop_back();
+    sleepRevisions_.pop_back();
+    instancesDirty_ = true;
+}
+
+void ItemDropSystem::rebuildCellIndex() {
+    cellIndex_.clear();
+    cellIndex_.reserve(ids_.size());
+    for (std::size_t i = 0; i < ids_.size(); ++i) {
+        const glm::ivec3 c = cellOf(positions_[i]);
+        cellIndex_.emplace_back(packCoord(c.x, c.y, c.z), static_cast<std::uint32_t>(i));
+    }
+    std::sort(cellIndex_.begin(), cellIndex_.end());
+}
+
+template <typename Visit>
+void ItemDropSystem::forEachInCells(const glm::ivec3 &minCell, const glm::ivec3 &maxCell,
+                                    Visit &&visit) const {
+    for (int y = minCell.y; y <= maxCell.y; ++y) {
+        for (int z = minCell.z; z <= maxCell.z; ++z) {
+            for (int x = minCell.x; x <= maxCell.x; ++x) {
+                const std::uint64_t key = packCoord(x, y, z);
+                auto it = std::lower_bound(cellIndex_.begin(), cellIndex_.end(),
+                                           std::make_pair(key, std::uint32_t{0}));
+                for (; it != cellIndex_.end() && it->first == key; ++it) {
+                    if (!visit(static_cast<std::size_t>(it->second))) {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ItemDropSystem::mergeNearby(std::size_t index) {
+    if (counts_[index] <= 0 || counts_[index] >= Inventory::kMaxStack) {
+        return;
     }
+    const glm::vec3 radius(kMergeRadius);
+    forEachInCells(cellOf(positions_[index] - radius), cellOf(positions_[index] + radius),
+                   [&](std::size_t other) {
+                       if (other == index || counts_[other] <= 0 || ids_[other] != ids_[index] ||
+                           counts_[index] + counts_[other] > Inventory::kMaxStack) {
+                           return true;
+                       }
+                       const glm::vec3 d = positions_[other] - positions_[index];
+                       if (glm::dot(d, d) > kMergeRadius * kMergeRadius) {
+                           return true;
+                       }
+                       // Fold into a sleeping neighbour so resting piles stay asleep.
+                       const std::size_t keep = asleep_[other] != 0 ? other : index;
+                       const std::size_t drop = keep == index ? other : index;
+                       counts_[keep] += counts_[drop];
+                       counts_[drop] = 0;
+                       births_[keep] = std::max(births_[keep], births_[drop]);
+                       pickupDelays_[keep] = std::max(pickupDelays_[keep], pickupDelays_[drop]);
+                       ++stats_.merges;
+                       instancesDirty_ = true;
+                       return keep == index && counts_[index] < Inventory::kMaxStack;
+                   });
 }
 
 void ItemDropSystem::update(const world::World &world, const glm::vec3 &playerPos, float dt) {
-    for (std::size_t i = 0; i < items_.size();) {
-        Item &it = items_[i];
-        it.age += dt;
-        it.pickupDelay -= dt;
-        if (it.age >= kMaxLifetime) {
-            items_[i] = items_.back();
-            items_.pop_back();
+    Environment env;
+    env.isSolid = [&world](int x, int y, int z) { return world.isSolidBlock(x, y, z); };
+    env.fluidCurrent = [&world](const glm::vec3 &p) { return world.fluidCurrentAt(p); };
+    env.chunkRevision = [&world](int cx, int cz) { return world.chunkRevision({cx, cz}); };
+    update(env, playerPos, dt);
+}
+
+void ItemDropSystem::update(const Environment &env, const glm::vec3 &playerPos, float dt) {
+    simTime_ += dt;
+    solidCache_.clear();
+    flowCache_.clear();
+    chunkRevisionCache_.clear();
+    stats_.blockQueries = 0;
+    stats_.merges = 0;
+    const glm::vec3 probe(0.0f, kSupportProbe, 0.0f);
+
+    awakeScratch_.clear();
+    for (std::size_t i = 0; i < ids_.size();) {
+        if (simTime_ - births_[i] >= kMaxLifetime) {
+            removeAt(i);
             continue;
         }
+        pickupDelays_[i] -= dt;
+        glm::vec3 &pos = positions_[i];
+        glm::vec3 &vel = velocities_[i];
+
+        if (asleep_[i] != 0) {
+            // Sleepers only re-check when blocks changed nearby: stay down while
+            // still supported and outside any current. Unloading lowers the
+            // revision and leaves them be; a reload brings a newer one.
+            const std::uint64_t revision = revisionAround(env, pos);
+            if (revision <= sleepRevisions_[i]) {
+                ++i;
+                continue;
+            }
+            sleepRevisions_[i] = revision;
+            if (collidesSolid(env, pos - probe) && flowAt(env, pos + probe) == glm::vec3(0.0f)) {
+                ++i;
+                continue;
+            }
+            asleep_[i] = 0;
+            restTicks_[i] = 0;
+        }
 
-        it.vel.y -= kGravity * dt;
-        const glm::vec3 flowA = world.fluidCurrentAt(it.pos + glm::vec3(0.0f, 0.05f, 0.0f));
-        const glm::vec3 flowB = world.fluidCurrentAt(it.pos + glm::vec3(0.0f, 0.24f, 0.0f));
+        vel.y -= kGravity * dt;
+        const glm::vec3 flowA = flowAt(env, pos + probe);
+        const glm::vec3 flowB = flowAt(env, pos + glm::vec3(0.0f, 0.24f, 0.0f));
         const glm::vec3 flow = (flowA + flowB) * 0.5f;
-        it.vel.x += flow.x * dt;
-        it.vel.z += flow.z * dt;
-        it.vel.y += flow.y * dt * 0.65f;
+        vel.x += flow.x * dt;
+        vel.z += flow.z * dt;
+        vel.y += flow.y * dt * 0.65f;
         const float drag =
-            std::max(0.0f, 1.0f - (it.pos.y <= playerPos.y + 0.5f ? kGroundDrag : kAirDrag) * dt);
-        it.vel.x *= drag;
-        it.vel.z *= drag;
+            std::max(0.0f, 1.0f - (pos.y <= playerPos.y + 0.5f ? kGroundDrag : kAirDrag) * dt);
+        vel.x *= drag;
+        vel.z *= drag;
 
         for (int axis = 0; axis < 3; ++axis) {
-            glm::vec3 test = it.pos;
-            test[axis] += it.vel[axis] * dt;
-            if (collidesSolid(world, test)) {
-                if (axis == 1 && it.vel.y < 0.0f) {
-                    it.vel.y *= -0.15f;
-                    if (std::abs(it.vel.y) < 0.8f) {
-                        it.vel.y = 0.0f;
+            glm::vec3 test = pos;
+            test[axis] += vel[axis] * dt;
+            if (collidesSolid(env, test)) {
+                if (axis == 1 && vel.y < 0.0f) {
+                    vel.y *= -0.15f;
+                    if (std::abs(vel.y) < 0.8f) {
+                        vel.y = 0.0f;
                     }
                 } else {
-                    it.vel[axis] = 0.0f;
+                    vel[axis] = 0.0f;
                 }
             } else {
-                it.pos = test;
+                pos = test;
             }
         }
+        instancesDirty_ = true;
 
-        // Use a body-like pickup volume so items at feet are still collectible.
-        const glm::vec3 playerFeet = playerPos - glm::vec3(0.0f, 1.25f, 0.0f);
-        const glm::vec3 d = it.pos - playerFeet;
-        const float horiz2 = d.x * d.x + d.z * d.z;
-        if (it.pickupDelay <= 0.0f && horiz2 <= kPickupRadius * kPickupRadius &&
-            std::abs(d.y) <= 1.9f) {
-            pendingPickups_.push_back(Pickup{it.id, 1, it.pos});
-            items_[i] = items_.back();
-            items_.pop_back();
-            continue;
+        const bool resting = glm::dot(vel, vel) < kSleepSpeed * kSleepSpeed &&
+                             flow == glm::vec3(0.0f) && collidesSolid(env, pos - probe);
+        restTicks_[i] = resting ? static_cast<std::uint8_t>(std::min(255, restTicks_[i] + 1)) : 0;
+        if (restTicks_[i] >= kSleepAfterTicks) {
+            asleep_[i] = 1;
+            sleepRevisions_[i] = revisionAround(env, pos);
+            vel = glm::vec3(0.0f);
         }
+        awakeScratch_.push_back(static_cast<std::uint32_t>(i));
         ++i;
     }
+
+    rebuildCellIndex();
+    // Only stacks that moved this tick can have found a new neighbour.
+    for (const std::uint32_t index : awakeScratch_) {
+        mergeNearby(index);
+    }
+
+    // Use a body-like pickup volume so items at feet are still collectible.
+    const glm::vec3 playerFeet = playerPos - glm::vec3(0.0f, 1.25f, 0.0f);
+    const glm::vec3 reach(kPickupRadius, 1.9f, kPickupRadius);
+    forEachInCells(cellOf(playerFeet - reach), cellOf(playerFeet + reach), [&](std::size_t i) {
+        if (counts_[i] <= 0 || pickupDelays_[i] > 0.0f) {
+            return true;
+        }
+        const glm::vec3 d = positions_[i] - playerFeet;
+        const float horiz2 = d.x * d.x + d.z * d.z;
+        if (horiz2 <= kPickupRadius * kPickupRadius && std::abs(d.y) <= 1.9f) {
+            pendingPickups_.push_back(Pickup{ids_[i], counts_[i], positions_[i]});
+            counts_[i] = 0;
+        }
+        return true;
+    });
+
+    // Drop merged and collected stacks. Walking backwards keeps swap-removal
+    // from moving an unvisited entry into the current slot.
+    for (std::size_t i = ids_.size(); i-- > 0;) {
+        if (counts_[i] <= 0) {
+            removeAt(i);
+        }
+    }
+
+    stats_.stacks = ids_.size();
+    stats_.sleeping = static_cast<std::size_t>(std::count(asleep_.begin(), asleep_.end(), 1));
 }
 
 std::vector<ItemDropSystem::Pickup> ItemDropSystem::consumePickups() {
@@ -198,87 +522,54 @@ std::vector<ItemDropSystem::Pickup> ItemDropSystem::consumePickups() {
     return out;
 }
 
-void ItemDropSystem::render(const glm::mat4 &proj, const glm::mat4 &view,
-                            const gfx::TextureAtlas &atlas, const voxel::BlockRegistry &registry) {
-    if (items_.empty()) {
+int ItemDropSystem::totalItemCount() const {
+    int total = 0;
+    for (const int c : counts_) {
+        total += c;
+    }
+    return total;
+}
+
+void ItemDropSystem::render(const gfx::TextureAtlas &atlas, const voxel::BlockRegistry &registry) {
+    if (ids_.empty()) {
         return;
     }
     initGl();
-    verts_.clear();
-    verts_.reserve(items_.size() * 36);
-
-    auto appendQuad = [&](const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &p2,
-                          const glm::vec3 &p3, const glm::vec4 &uv, float light) {
-        verts_.push_back(Vertex{p0.x, p0.y, p0.z, uv.x, uv.w, light});
-        verts_.push_back(Vertex{p1.x, p1.y, p1.z, uv.z, uv.w, light});
-        verts_.push_back(Vertex{p2.x, p2.y, p2.z, uv.z, uv.y, light});
-        verts_.push_back(Vertex{p0.x, p0.y, p0.z, uv.x, uv.w, light});
-        verts_.push_back(Vertex{p2.x, p2.y, p2.z, uv.z, uv.y, light});
-        verts_.push_back(Vertex{p3.x, p3.y, p3.z, uv.x, uv.y, light});
-    };
-
-    auto appendPlantSprite = [&](const glm::mat4 &model, const glm::vec4 &uv) {
-        auto tp = [&](float x, float y, float z) {
-            return glm::vec3(model * glm::vec4(x, y, z, 1.0f));
-        };
-        const float h = 0.20f;
-        const float y0 = -0.20f;
-        const float y1 = 0.20f;
-        const glm::vec3 p0 = tp(-h, y0, -h);
-        const glm::vec3 p1 = tp(h, y0, h);
-        const glm::vec3 p2 = tp(h, y1, h);
-        const glm::vec3 p3 = tp(-h, y1, -h);
-        const glm::vec3 q0 = tp(h, y0, -h);
-        const glm::vec3 q1 = tp(-h, y0, h);
-        const glm::vec3 q2 = tp(-h, y1, h);
-        const glm::vec3 q3 = tp(h, y1, -h);
-        appendQuad(p0, p1, p2, p3, uv, 0.95f);
-        appendQuad(q0, q1, q2, q3, uv, 0.95f);
-    };
 
-    for (const Item &item : items_) {
-        const voxel::BlockDef &def = registry.get(item.id);
-        const glm::vec4 uvSide = atlas.uvRect(def.sideTile);
-        const glm::vec4 uvTop = atlas.uvRect(def.topTile);
-        const glm::vec4 uvBottom = atlas.uvRect(def.bottomTile);
-        const bool furnaceLike = voxel::isFurnace(item.id);
-        const glm::vec4 uvFront = furnaceLike ? atlas.uvRect(voxel::TILE_FURNACE_FRONT) : uvSide;
-        const float bob = 0.08f * std::sin(item.age * 3.8f);
-        const glm::vec3 center = item.pos + glm::vec3(0.0f, 0.23f + bob, 0.0f);
-        const float ang = item.age * 1.8f;
-        glm::mat4 model(1.0f);
-        model = glm::translate(model, center);
-        model = glm::rotate(model, ang, glm::vec3(0.0f, 1.0f, 0.0f));
-
-        const bool plantItem = (item.id == voxel::STICK || voxel::isPlant(item.id) ||
-                                item.id == voxel::IRON_INGOT ||
-                                item.id == voxel::COPPER_INGOT || item.id == voxel::GOLD_INGOT ||
-                                voxel::isTorch(item.id));
-        if (plantItem) {
-            appendPlantSprite(model, uvSide);
-            continue;
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo_);
+    if (instancesDirty_) {
+        // Cubes first, then flat sprites, so each shape is one contiguous range.
+        instances_.clear();
+        instances_.reserve(ids_.size());
+        for (int pass = 0; pass < 2; ++pass) {
+            for (std::size_t i = 0; i < ids_.size(); ++i) {
+                const voxel::BlockId id = ids_[i];
+                if (isFlatItem(id) != (pass == 1)) {
+                    continue;
+                }
+                const voxel::BlockDef &def = registry.get(id);
+                const glm::vec4 uvSide = atlas.uvRect(def.sideTile);
+                const glm::vec4 uvFront =
+                    voxel::isFurnace(id) ? atlas.uvRect(voxel::TILE_FURNACE_FRONT) : uvSide;
+                const glm::vec3 &p = positions_[i];
+                instances_.push_back(Instance{p.x, p.y, p.z, births_[i], uvSide,
+                                              atlas.uvRect(def.topTile),
+                                              atlas.uvRect(def.bottomTile), uvFront});
+            }
+            (pass == 0 ? cubeInstances_ : spriteInstances_) =
+                static_cast<int>(instances_.size()) - (pass == 0 ? 0 : cubeInstances_);
         }
 
-        auto tp = [&](float x, float y, float z) {
-            return glm::vec3(model * glm::vec4(x, y, z, 1.0f));
-        };
-
-        const float h = kItemRenderHalf;
-        const glm::vec3 p000 = tp(-h, -h, -h);
-        const glm::vec3 p001 = tp(-h, -h, h);
-        const glm::vec3 p010 = tp(-h, h, -h);
-        const glm::vec3 p011 = tp(-h, h, h);
-        const glm::vec3 p100 = tp(h, -h, -h);
-        const glm::vec3 p101 = tp(h, -h, h);
-        const glm::vec3 p110 = tp(h, h, -h);
-        const glm::vec3 p111 = tp(h, h, h);
-
-        appendQuad(p001, p101, p111, p011, uvFront, 0.92f);  // +Z (furnace front)
-        appendQuad(p100, p000, p010, p110, uvSide, 0.75f);   // -Z
-        appendQuad(p000, p001, p011, p010, uvSide, 0.82f);   // -X
-        appendQuad(p101, p100, p110, p111, uvSide, 0.88f);   // +X
-        appendQuad(p010, p011, p111, p110, uvTop, 1.00f);    // +Y
-        appendQuad(p000, p100, p101, p001, uvBottom, 0.65f); // -Y
+        const std::size_t bytes = instances_.size() * sizeof(Instance);
+        if (instances_.size() > instanceCapacity_) {
+            instanceCapacity_ = std::max(instances_.size(), instanceCapacity_ * 2);
+            glBufferData(GL_ARRAY_BUFFER,
+                         static_cast<GLsizeiptr>(instanceCapacity_ * sizeof(Instance)), nullptr,
+                         GL_DYNAMIC_DRAW);
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), instances_.data());
+        instancesDirty_ = false;
     }
 
     glEnable(GL_BLEND);
@@ -286,16 +577,20 @@ void ItemDropSystem::render(const glm::mat4 &proj, const glm::mat4 &view,
     // Keep depth writes enabled so spinning cube faces occlude correctly.
     glDepthMask(GL_TRUE);
     glUseProgram(shader_);
-    glUniformMatrix4fv(glGetUniformLocation(shader_, "uProj"), 1, GL_FALSE, glm::value_ptr(proj));
-    glUniformMatrix4fv(glGetUniformLocation(shader_, "uView"), 1, GL_FALSE, glm::value_ptr(view));
-    glUniform1i(glGetUniformLocation(shader_, "uAtlas"), 0);
+    glUniform1i(uAtlas_, 0);
+    glUniform1f(uTime_, simTime_);
     atlas.bind(0);
 
-    glBindVertexArray(vao_);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(verts_.size() * sizeof(Vertex)),
-                 verts_.data(), GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(verts_.size()));
+    if (cubeInstances_ > 0) {
+        pointInstanceAttributes(0, sizeof(Instance));
+        glDrawArraysInstanced(GL_TRIANGLES, 0, cubeVertexCount_, cubeInstances_);
+    }
+    if (spriteInstances_ > 0) {
+        // GL 3.3 has no base-instance draw, so offset the instance pointers.
+        pointInstanceAttributes(static_cast<std::size_t>(cubeInstances_), sizeof(Instance));
+        glDrawArraysInstanced(GL_TRIANGLES, cubeVertexCount_, spriteVertexCount_,
+                              spriteInstances_);
+    }
 }
 
 } // namespace game
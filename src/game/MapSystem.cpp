@@ -5,7 +5,12 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <functional>
+#include <istream>
+#include <ostream>
 #include <utility>
 
 namespace game {
@@ -14,9 +19,24 @@ namespace {
 constexpr char kMapMagicV1[4] = {'V', 'X', 'M', '1'};
 constexpr char kMapMagicV2[4] = {'V', 'X', 'M', '2'};
 constexpr char kMapMagicV3[4] = {'V', 'X', 'M', '3'};
+constexpr char kMapMagicV4[4] = {'V', 'X', 'M', '4'};
+// Page files start with this magic and the generation the index names them by.
+constexpr char kPageFileMagic[4] = {'V', 'X', 'P', '1'};
+constexpr std::uint64_t kPageFileHeaderBytes = sizeof(kPageFileMagic) + sizeof(std::uint32_t);
 constexpr auto kScanEnqueueInterval = std::chrono::milliseconds(180);
-constexpr int kNewChunkScanBudget = 96;
-constexpr int kRefreshChunkScanBudget = 20;
+constexpr int kScanChunkBudget = 96;
+constexpr std::size_t kChangeLogCapacity = 8192;
+constexpr int kPageLoadBudget = 8;
+constexpr std::size_t kMaxResidentPages = 1024;
+constexpr std::uint64_t kCompactMinGarbageBytes = 1u << 20u;
+
+int floorDiv(int a, int b) {
+    return (a >= 0) ? (a / b) : ((a - b + 1) / b);
+}
+
+std::filesystem::path pageFilePath(const std::filesystem::path &dir, std::uint32_t generation) {
+    return dir / ("map_pages." + std::to_string(generation) + ".dat");
+}
 
 bool isMapSurfaceCandidate(voxel::BlockId id) {
     if (id == voxel::AIR) {
@@ -29,6 +49,88 @@ bool isMapSurfaceCandidate(voxel::BlockId id) {
     return true;
 }
 
+template <typename T> void writeRaw(std::ostream &out, const T &value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T> void readRaw(std::istream &in, T &value) {
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+}
+
+// Page file generation named by the index in dir, or 0 without one.
+std::uint32_t indexedPageGeneration(const std::filesystem::path &dir) {
+    std::ifstream in(dir / "map.dat", std::ios::binary);
+    char magic[4] = {};
+    std::uint32_t generation = 0;
+    in.read(magic, sizeof(magic));
+    readRaw(in, generation);
+    if (!in || !std::equal(std::begin(magic), std::end(magic), std::begin(kMapMagicV4))) {
+        return 0;
+    }
+    return generation;
+}
+
+bool readWaypoints(std::istream &in, bool hasVisibility, std::vector<MapSystem::Waypoint> &out) {
+    std::uint32_t waypointCount = 0;
+    readRaw(in, waypointCount);
+    if (!in) {
+        return false;
+    }
+    out.reserve(waypointCount);
+    for (std::uint32_t i = 0; i < waypointCount; ++i) {
+        MapSystem::Waypoint wp{};
+        std::int32_t x = 0;
+        std::int32_t z = 0;
+        std::uint16_t nameLen = 0;
+        readRaw(in, x);
+        readRaw(in, z);
+        readRaw(in, wp.r);
+        readRaw(in, wp.g);
+        readRaw(in, wp.b);
+        readRaw(in, wp.icon);
+        if (hasVisibility) {
+            std::uint8_t visible = 1;
+            readRaw(in, visible);
+            wp.visible = (visible != 0);
+        }
+        readRaw(in, nameLen);
+        if (!in) {
+            return false;
+        }
+        wp.x = static_cast<int>(x);
+        wp.z = static_cast<int>(z);
+        wp.name.resize(nameLen);
+        if (nameLen > 0) {
+            in.read(wp.name.data(), nameLen);
+            if (!in) {
+                return false;
+            }
+        }
+        wp.icon = static_cast<std::uint8_t>(wp.icon % 5u);
+        out.push_back(std::move(wp));
+    }
+    return true;
+}
+
+void writeWaypoints(std::ostream &out, const std::vector<MapSystem::Waypoint> &waypoints) {
+    writeRaw(out, static_cast<std::uint32_t>(waypoints.size()));
+    for (const MapSystem::Waypoint &wp : waypoints) {
+        const std::uint16_t nameLen =
+            static_cast<std::uint16_t>(std::min<std::size_t>(wp.name.size(), 64));
+        writeRaw(out, static_cast<std::int32_t>(wp.x));
+        writeRaw(out, static_cast<std::int32_t>(wp.z));
+        writeRaw(out, wp.r);
+        writeRaw(out, wp.g);
+        writeRaw(out, wp.b);
+        writeRaw(out, static_cast<std::uint8_t>(wp.icon % 5u));
+        writeRaw(out, static_cast<std::uint8_t>(wp.visible ? 1u : 0u));
+        writeRaw(out, nameLen);
+        if (nameLen > 0) {
+            out.write(wp.name.data(), nameLen);
+        }
+    }
+}
+
 } // namespace
 
 MapSystem::MapSystem() {
@@ -47,16 +149,32 @@ MapSystem::~MapSystem() {
     }
 }
 
-std::uint64_t MapSystem::keyFor(int x, int z) {
-    const std::uint64_t ux = static_cast<std::uint64_t>(static_cast<std::uint32_t>(x));
-    const std::uint64_t uz = static_cast<std::uint64_t>(static_cast<std::uint32_t>(z));
+std::uint64_t MapSystem::pageKeyFor(int px, int pz) {
+    const std::uint64_t ux = static_cast<std::uint64_t>(static_cast<std::uint32_t>(px));
+    const std::uint64_t uz = static_cast<std::uint64_t>(static_cast<std::uint32_t>(pz));
     return (ux << 32u) | uz;
 }
 
+const MapSystem::MapColumn *MapSystem::findColumn(int wx, int wz) const {
+    const int px = floorDiv(wx, kPageSize);
+    const int pz = floorDiv(wz, kPageSize);
+    const auto it = pages_.find(pageKeyFor(px, pz));
+    if (it == pages_.end()) {
+        return nullptr;
+    }
+    const MapColumn &column =
+        it->second->columns[static_cast<std::size_t>((wz - pz * kPageSize) * kPageSize +
+                                                      (wx - px * kPageSize))];
+    return column.id == voxel::AIR ? nullptr : &column;
+}
+
 void MapSystem::workerLoop() {
+    voxel::Chunk snapshot;
     while (true) {
         const world::World *world = nullptr;
         std::vector<world::ChunkCoord> chunks;
+        PageMap basePages;
+        std::uint64_t generation = 0;
         {
             std::unique_lock<std::mutex> lock(workerMutex_);
             workerCv_.wait(lock, [&]() { return requestPending_ || !running_; });
@@ -65,19 +183,39 @@ void MapSystem::workerLoop() {
             }
             world = requestWorld_;
             chunks = std::move(requestChunks_);
+            basePages = std::move(requestPages_);
+            generation = requestGeneration_;
             requestChunks_.clear();
+            requestPages_.clear();
             requestPending_ = false;
             workerBusy_ = true;
         }
 
-        std::unordered_map<std::uint64_t, voxel::BlockId> localLiveTiles;
-        std::unordered_map<std::uint64_t, std::uint8_t> localLiveHeights;
-        std::unordered_map<std::uint64_t, std::uint8_t> localLiveWaterCover;
+        // Copy-on-write: each touched page is cloned once, filled, and handed
+        // back whole for the main thread to swap in.
+        std::unordered_map<std::uint64_t, std::shared_ptr<Page>> outPages;
+        auto pageFor = [&](int px, int pz) -> Page & {
+            const std::uint64_t key = pageKeyFor(px, pz);
+            auto it = outPages.find(key);
+            if (it == outPages.end()) {
+                const auto base = basePages.find(key);
+                auto page = base != basePages.end() ? std::make_shared<Page>(*base->second)
+                                                    : std::make_shared<Page>();
+                it = outPages.emplace(key, std::move(page)).first;
+            }
+            return *it->second;
+        };
+        std::vector<std::pair<world::ChunkCoord, std::uint64_t>> scanned;
         if (world != nullptr) {
-            localLiveTiles.reserve(chunks.size() * voxel::Chunk::SX * voxel::Chunk::SZ);
-            localLiveHeights.reserve(chunks.size() * voxel::Chunk::SX * voxel::Chunk::SZ);
-            localLiveWaterCover.reserve(chunks.size() * voxel::Chunk::SX * voxel::Chunk::SZ);
+            scanned.reserve(chunks.size());
             for (const auto &cc : chunks) {
+                // One locked copy per chunk; the column walk below is plain
+                // array access and never touches the world lock.
+                std::uint64_t chunkRevision = 0;
+                if (!world->copyChunk(cc, snapshot, chunkRevision)) {
+                    continue;
+                }
+                scanned.emplace_back(cc, chunkRevision);
                 const int baseX = cc.x * voxel::Chunk::SX;
                 const int baseZ = cc.z * voxel::Chunk::SZ;
                 for (int lz = 0; lz < voxel::Chunk::SZ; ++lz) {
@@ -88,7 +226,7 @@ void MapSystem::workerLoop() {
                         int surfaceY = 0;
                         bool sawWater = false;
                         for (int y = voxel::Chunk::SY - 1; y >= 0; --y) {
-                            const voxel::BlockId s = world->getBlock(wx, y, wz);
+                            const voxel::BlockId s = snapshot.getUnchecked(lx, y, lz);
                             if (!isMapSurfaceCandidate(s)) {
                                 continue;
                             }
@@ -113,11 +251,15 @@ void MapSystem::workerLoop() {
                             id = voxel::WATER;
                         }
                         if (id != voxel::AIR) {
-                            const std::uint64_t key = keyFor(wx, wz);
-                            localLiveTiles[key] = id;
-                            localLiveHeights[key] = static_cast<std::uint8_t>(
+                            const int px = floorDiv(wx, kPageSize);
+                            const int pz = floorDiv(wz, kPageSize);
+                            Page &page = pageFor(px, pz);
+                            MapColumn &column = page.columns[static_cast<std::size_t>(
+                                (wz - pz * kPageSize) * kPageSize + (wx - px * kPageSize))];
+                            column.id = id;
+                            column.height = static_cast<std::uint8_t>(
                                 std::clamp(surfaceY, 0, voxel::Chunk::SY - 1));
-                            localLiveWaterCover[key] = sawWater ? 1u : 0u;
+                            column.water = sawWater ? 1u : 0u;
                         }
                     }
                 }
@@ -126,9 +268,12 @@ void MapSystem::workerLoop() {
 
         {
             std::lock_guard<std::mutex> lock(resultMutex_);
-            resultLiveTiles_ = std::move(localLiveTiles);
-            resultLiveHeights_ = std::move(localLiveHeights);
-            resultLiveWaterCover_ = std::move(localLiveWaterCover);
+            resultPages_.clear();
+            for (auto &[key, page] : outPages) {
+                resultPages_.emplace(key, std::move(page));
+            }
+            resultChunks_ = std::move(scanned);
+            resultGeneration_ = generation;
             hasResult_ = true;
         }
         {
@@ -139,86 +284,141 @@ void MapSystem::workerLoop() {
 }
 
 void MapSystem::enqueueScan(const world::World &world, std::vector<world::ChunkCoord> chunks) {
+    PageMap pages;
+    for (const world::ChunkCoord &cc : chunks) {
+        const int px = floorDiv(cc.x * voxel::Chunk::SX, kPageSize);
+        const int pz = floorDiv(cc.z * voxel::Chunk::SZ, kPageSize);
+        const std::uint64_t key = pageKeyFor(px, pz);
+        // The scan result replaces the whole page, so saved columns have to
+        // be in the base copy.
+        if (pages_.find(key) == pages_.end()) {
+            loadPage(key);
+        }
+        if (const auto it = pages_.find(key); it != pages_.end()) {
+            pages.emplace(key, it->second);
+        }
+    }
     std::lock_guard<std::mutex> lock(workerMutex_);
     requestWorld_ = &world;
     requestChunks_ = std::move(chunks);
+    requestPages_ = std::move(pages);
+    requestGeneration_ = generation_;
     requestPending_ = true;
     workerCv_.notify_one();
 }
 
 void MapSystem::consumeWorkerResult() {
-    std::unordered_map<std::uint64_t, voxel::BlockId> local;
-    std::unordered_map<std::uint64_t, std::uint8_t> localHeights;
-    std::unordered_map<std::uint64_t, std::uint8_t> localWaterCover;
+    PageMap pages;
+    std::vector<std::pair<world::ChunkCoord, std::uint64_t>> scannedChunks;
     {
         std::lock_guard<std::mutex> lock(resultMutex_);
         if (!hasResult_) {
             return;
         }
-        local = std::move(resultLiveTiles_);
-        localHeights = std::move(resultLiveHeights_);
-        localWaterCover = std::move(resultLiveWaterCover_);
-        resultLiveTiles_.clear();
-        resultLiveHeights_.clear();
-        resultLiveWaterCover_.clear();
         hasResult_ = false;
+        if (resultGeneration_ != generation_) {
+            resultPages_.clear();
+            resultChunks_.clear();
+            return;
+        }
+        pages = std::move(resultPages_);
+        scannedChunks = std::move(resultChunks_);
+        resultPages_.clear();
+        resultChunks_.clear();
+    }
+    // Scans never overlap, so each returned page supersedes the directory's.
+    for (auto &[key, page] : pages) {
+        pages_[key] = std::move(page);
+        dirtyPages_.insert(key);
+    }
+
+    ++revision_;
+    for (const auto &[cc, chunkRevision] : scannedChunks) {
+        scannedRevisions_[cc] = chunkRevision;
+        changeLog_.emplace_back(revision_, cc);
     }
-    liveTiles_ = std::move(local);
-    liveHeights_ = std::move(localHeights);
-    liveWaterCover_ = std::move(localWaterCover);
-    for (const auto &[key, id] : liveTiles_) {
-        tiles_[key] = id;
+    while (changeLog_.size() > kChangeLogCapacity) {
+        changeLogFloor_ = changeLog_.front().first;
+        changeLog_.pop_front();
     }
-    for (const auto &[key, y] : liveHeights_) {
-        heights_[key] = y;
+}
+
+bool MapSystem::changedChunksSince(std::uint64_t sinceRevision,
+                                   std::vector<world::ChunkCoord> &out) const {
+    // Entries for changeLogFloor_ itself may have been partly dropped.
+    if (sinceRevision < changeLogFloor_) {
+        return false;
     }
-    for (const auto &[key, covered] : liveWaterCover_) {
-        waterCover_[key] = covered;
+    auto it = std::upper_bound(
+        changeLog_.begin(), changeLog_.end(), sinceRevision,
+        [](std::uint64_t rev, const std::pair<std::uint64_t, world::ChunkCoord> &entry) {
+            return rev < entry.first;
+        });
+    for (; it != changeLog_.end(); ++it) {
+        out.push_back(it->second);
     }
+    return true;
+}
+
+void MapSystem::appendKnownChunks(std::uint64_t key, const Page &page,
+                                  std::vector<world::ChunkCoord> &out) {
+    constexpr int kChunksPerPageX = kPageSize / voxel::Chunk::SX;
+    constexpr int kChunksPerPageZ = kPageSize / voxel::Chunk::SZ;
+    const int px = static_cast<std::int32_t>(key >> 32u);
+    const int pz = static_cast<std::int32_t>(key & 0xFFFFFFFFu);
+    for (int cz = 0; cz < kChunksPerPageZ; ++cz) {
+        for (int cx = 0; cx < kChunksPerPageX; ++cx) {
+            bool known = false;
+            for (int lz = 0; lz < voxel::Chunk::SZ && !known; ++lz) {
+                const std::size_t row = static_cast<std::size_t>(
+                    (cz * voxel::Chunk::SZ + lz) * kPageSize + cx * voxel::Chunk::SX);
+                for (int lx = 0; lx < voxel::Chunk::SX; ++lx) {
+                    if (page.columns[row + static_cast<std::size_t>(lx)].id != voxel::AIR) {
+                        known = true;
+                        break;
+                    }
+                }
+            }
+            if (known) {
+                out.push_back(
+                    world::ChunkCoord{px * kChunksPerPageX + cx, pz * kChunksPerPageZ + cz});
+            }
+        }
+    }
+}
+
+std::vector<world::ChunkCoord> MapSystem::knownChunks() const {
+    std::vector<world::ChunkCoord> out;
+    for (const auto &[key, page] : pages_) {
+        appendKnownChunks(key, *page, out);
+    }
+    return out;
 }
 
 bool MapSystem::sample(int wx, int wz, voxel::BlockId &outId) const {
-    const std::uint64_t key = keyFor(wx, wz);
-    const auto liveIt = liveTiles_.find(key);
-    if (liveIt != liveTiles_.end()) {
-        outId = liveIt->second;
-        return true;
-    }
-    const auto it = tiles_.find(key);
-    if (it == tiles_.end()) {
+    const MapColumn *column = findColumn(wx, wz);
+    if (column == nullptr) {
         return false;
     }
-    outId = it->second;
+    outId = column->id;
     return true;
 }
 
 bool MapSystem::sampleHeight(int wx, int wz, int &outY) const {
-    const std::uint64_t key = keyFor(wx, wz);
-    const auto liveIt = liveHeights_.find(key);
-    if (liveIt != liveHeights_.end()) {
-        outY = static_cast<int>(liveIt->second);
-        return true;
-    }
-    const auto it = heights_.find(key);
-    if (it == heights_.end()) {
+    const MapColumn *column = findColumn(wx, wz);
+    if (column == nullptr) {
         return false;
     }
-    outY = static_cast<int>(it->second);
+    outY = static_cast<int>(column->height);
     return true;
 }
 
 bool MapSystem::sampleWaterCover(int wx, int wz, bool &outCovered) const {
-    const std::uint64_t key = keyFor(wx, wz);
-    const auto liveIt = liveWaterCover_.find(key);
-    if (liveIt != liveWaterCover_.end()) {
-        outCovered = (liveIt->second != 0u);
-        return true;
-    }
-    const auto it = waterCover_.find(key);
-    if (it == waterCover_.end()) {
+    const MapColumn *column = findColumn(wx, wz);
+    if (column == nullptr) {
         return false;
     }
-    outCovered = (it->second != 0u);
+    outCovered = (column->water != 0u);
     return true;
 }
 
@@ -243,70 +443,184 @@ void MapSystem::observeLoadedChunks(const world::World &world) {
             return;
         }
     }
-    auto loaded = world.loadedChunkCoords();
+    auto loaded = world.loadedChunkRevisions();
     if (loaded.empty()) {
-        knownLoadedChunks_.clear();
-        refreshCursor_ = 0;
+        scannedRevisions_.clear();
         return;
     }
 
     std::unordered_set<world::ChunkCoord, world::ChunkCoordHash> loadedSet;
     loadedSet.reserve(loaded.size() * 2u + 1u);
-    for (const world::ChunkCoord &cc : loaded) {
+    for (const auto &[cc, chunkRevision] : loaded) {
+        (void)chunkRevision;
         loadedSet.insert(cc);
     }
-    for (auto it = knownLoadedChunks_.begin(); it != knownLoadedChunks_.end();) {
-        if (loadedSet.find(*it) == loadedSet.end()) {
-            it = knownLoadedChunks_.erase(it);
+    for (auto it = scannedRevisions_.begin(); it != scannedRevisions_.end();) {
+        if (loadedSet.find(it->first) == loadedSet.end()) {
+            it = scannedRevisions_.erase(it);
         } else {
             ++it;
         }
     }
 
+    // Rescan only chunks whose blocks changed since their last scan, never
+    // seen chunks first.
     std::vector<world::ChunkCoord> scanChunks;
-    scanChunks.reserve(static_cast<std::size_t>(kNewChunkScanBudget + kRefreshChunkScanBudget));
-
-    for (const world::ChunkCoord &cc : loaded) {
-        if (knownLoadedChunks_.find(cc) != knownLoadedChunks_.end()) {
-            continue;
+    std::vector<world::ChunkCoord> changedChunks;
+    scanChunks.reserve(static_cast<std::size_t>(kScanChunkBudget));
+    for (const auto &[cc, chunkRevision] : loaded) {
+        const auto it = scannedRevisions_.find(cc);
+        if (it == scannedRevisions_.end()) {
+            if (static_cast<int>(scanChunks.size()) < kScanChunkBudget) {
+                scanChunks.push_back(cc);
+            }
+        } else if (it->second != chunkRevision) {
+            changedChunks.push_back(cc);
         }
-        knownLoadedChunks_.insert(cc);
-        scanChunks.push_back(cc);
-        if (static_cast<int>(scanChunks.size()) >= kNewChunkScanBudget) {
+    }
+    for (const world::ChunkCoord &cc : changedChunks) {
+        if (static_cast<int>(scanChunks.size()) >= kScanChunkBudget) {
             break;
         }
+        scanChunks.push_back(cc);
     }
-
     if (scanChunks.empty()) {
-        const int loadedCount = static_cast<int>(loaded.size());
-        const int refreshCount = std::min(kRefreshChunkScanBudget, loadedCount);
-        if (loadedCount > 0) {
-            refreshCursor_ %= loaded.size();
-            for (int i = 0; i < refreshCount; ++i) {
-                const std::size_t idx = (refreshCursor_ + static_cast<std::size_t>(i)) % loaded.size();
-                scanChunks.push_back(loaded[idx]);
+        return;
+    }
+
+    lastScanEnqueue_ = now;
+    enqueueScan(world, std::move(scanChunks));
+}
+
+void MapSystem::requestRegion(int minWX, int minWZ, int maxWX, int maxWZ) {
+    const int px0 = floorDiv(minWX, kPageSize);
+    const int pz0 = floorDiv(minWZ, kPageSize);
+    const int px1 = floorDiv(maxWX, kPageSize);
+    const int pz1 = floorDiv(maxWZ, kPageSize);
+    const int centerPX = floorDiv(minWX + (maxWX - minWX) / 2, kPageSize);
+    const int centerPZ = floorDiv(minWZ + (maxWZ - minWZ) / 2, kPageSize);
+    auto distanceTo = [&](std::uint64_t key) {
+        const int px = static_cast<std::int32_t>(key >> 32u);
+        const int pz = static_cast<std::int32_t>(key & 0xFFFFFFFFu);
+        return std::max(std::abs(px - centerPX), std::abs(pz - centerPZ));
+    };
+
+    if (!diskPages_.empty()) {
+        std::vector<std::pair<int, std::uint64_t>> missing;
+        for (int pz = pz0; pz <= pz1; ++pz) {
+            for (int px = px0; px <= px1; ++px) {
+                const std::uint64_t key = pageKeyFor(px, pz);
+                if (pages_.find(key) == pages_.end() && diskPages_.find(key) != diskPages_.end()) {
+                    missing.emplace_back(distanceTo(key), key);
+                }
             }
-            refreshCursor_ = (refreshCursor_ + static_cast<std::size_t>(refreshCount)) % loaded.size();
+        }
+        std::sort(missing.begin(), missing.end());
+        const std::size_t loadCount =
+            std::min(missing.size(), static_cast<std::size_t>(kPageLoadBudget));
+        for (std::size_t i = 0; i < loadCount; ++i) {
+            loadPage(missing[i].second);
         }
     }
-    if (scanChunks.empty()) {
+
+    if (pages_.size() <= kMaxResidentPages) {
         return;
     }
+    // Only saved, unchanged pages can be dropped; they reload on demand.
+    std::vector<std::pair<int, std::uint64_t>> evictable;
+    for (const auto &[key, page] : pages_) {
+        (void)page;
+        const int px = static_cast<std::int32_t>(key >> 32u);
+        const int pz = static_cast<std::int32_t>(key & 0xFFFFFFFFu);
+        const bool inRegion = px >= px0 && px <= px1 && pz >= pz0 && pz <= pz1;
+        if (!inRegion && dirtyPages_.find(key) == dirtyPages_.end() &&
+            diskPages_.find(key) != diskPages_.end()) {
+            evictable.emplace_back(distanceTo(key), key);
+        }
+    }
+    std::sort(evictable.begin(), evictable.end(), std::greater<>());
+    for (const auto &[distance, key] : evictable) {
+        (void)distance;
+        if (pages_.size() <= kMaxResidentPages) {
+            break;
+        }
+        pages_.erase(key);
+    }
+}
 
-    lastScanEnqueue_ = now;
-    enqueueScan(world, std::move(scanChunks));
+std::shared_ptr<const MapSystem::Page> MapSystem::readPage(std::istream &pagesIn,
+                                                           std::uint64_t key) const {
+    const auto it = diskPages_.find(key);
+    if (it == diskPages_.end()) {
+        return nullptr;
+    }
+    // Blob layout: runs of (packed column u32, count u16) covering the page.
+    std::vector<char> blob(it->second.size);
+    pagesIn.clear();
+    pagesIn.seekg(static_cast<std::streamoff>(it->second.offset));
+    pagesIn.read(blob.data(), static_cast<std::streamsize>(blob.size()));
+    if (!pagesIn || blob.size() % 6u != 0u) {
+        return nullptr;
+    }
+    auto page = std::make_shared<Page>();
+    std::size_t filled = 0;
+    for (std::size_t pos = 0; pos < blob.size(); pos += 6u) {
+        std::uint32_t packed = 0;
+        std::uint16_t run = 0;
+        std::memcpy(&packed, blob.data() + pos, sizeof(packed));
+        std::memcpy(&run, blob.data() + pos + 4u, sizeof(run));
+        if (filled + run > page->columns.size()) {
+            return nullptr;
+        }
+        MapColumn column;
+        column.id = static_cast<voxel::BlockId>(packed & 0xFFFFu);
+        column.height = static_cast<std::uint8_t>((packed >> 16u) & 0xFFu);
+        column.water = static_cast<std::uint8_t>(packed >> 24u);
+        std::fill_n(page->columns.begin() + static_cast<std::ptrdiff_t>(filled), run, column);
+        filled += run;
+    }
+    if (filled != page->columns.size()) {
+        return nullptr;
+    }
+    return page;
+}
+
+void MapSystem::loadPage(std::uint64_t key) {
+    if (storageDir_.empty() || diskPages_.find(key) == diskPages_.end()) {
+        return;
+    }
+    std::ifstream in(pageFilePath(storageDir_, pageFileGeneration_), std::ios::binary);
+    std::shared_ptr<const Page> page = readPage(in, key);
+    if (!page) {
+        return;
+    }
+    std::vector<world::ChunkCoord> chunks;
+    appendKnownChunks(key, *page, chunks);
+    pages_[key] = std::move(page);
+    // Newly resident columns reach the tile pyramid like any other change.
+    ++revision_;
+    for (const world::ChunkCoord &cc : chunks) {
+        changeLog_.emplace_back(revision_, cc);
+    }
+    while (changeLog_.size() > kChangeLogCapacity) {
+        changeLogFloor_ = changeLog_.front().first;
+        changeLog_.pop_front();
+    }
 }
 
 bool MapSystem::load(const std::filesystem::path &worldDir) {
-    tiles_.clear();
-    liveTiles_.clear();
-    heights_.clear();
-    liveHeights_.clear();
-    waterCover_.clear();
-    liveWaterCover_.clear();
-    knownLoadedChunks_.clear();
+    pages_.clear();
+    diskPages_.clear();
+    dirtyPages_.clear();
+    storageDir_ = worldDir;
+    pageFileGeneration_ = 0;
+    ++generation_;
+    scannedRevisions_.clear();
     waypoints_.clear();
-    refreshCursor_ = 0;
+    // Everything derived from the old contents has to be rebuilt.
+    ++revision_;
+    changeLog_.clear();
+    changeLogFloor_ = revision_;
     std::ifstream in(worldDir / "map.dat", std::ios::binary);
     if (!in) {
         return false;
@@ -317,117 +631,259 @@ bool MapSystem::load(const std::filesystem::path &worldDir) {
     if (!in) {
         return false;
     }
-    const bool isV1 = std::equal(std::begin(magic), std::end(magic), std::begin(kMapMagicV1));
-    const bool isV2 = std::equal(std::begin(magic), std::end(magic), std::begin(kMapMagicV2));
-    const bool isV3 = std::equal(std::begin(magic), std::end(magic), std::begin(kMapMagicV3));
-    if (!isV1 && !isV2 && !isV3) {
+    auto isMagic = [&](const char (&expected)[4]) {
+        return std::equal(std::begin(magic), std::end(magic), std::begin(expected));
+    };
+    if (isMagic(kMapMagicV4)) {
+        return loadIndex(in);
+    }
+    if (isMagic(kMapMagicV1)) {
+        return loadLegacy(in, false, false);
+    }
+    if (isMagic(kMapMagicV2)) {
+        return loadLegacy(in, true, false);
+    }
+    if (isMagic(kMapMagicV3)) {
+        return loadLegacy(in, true, true);
+    }
+    return false;
+}
+
+bool MapSystem::loadIndex(std::istream &in) {
+    // Only the index and waypoints are read here; pages load on request.
+    std::uint32_t pageCount = 0;
+    readRaw(in, pageFileGeneration_);
+    readRaw(in, pageCount);
+    if (!in) {
+        return false;
+    }
+    diskPages_.reserve(pageCount);
+    for (std::uint32_t i = 0; i < pageCount; ++i) {
+        std::int32_t px = 0;
+        std::int32_t pz = 0;
+        PageLocation location;
+        readRaw(in, px);
+        readRaw(in, pz);
+        readRaw(in, location.offset);
+        readRaw(in, location.size);
+        if (!in) {
+            diskPages_.clear();
+            return false;
+        }
+        diskPages_[pageKeyFor(px, pz)] = location;
+    }
+    if (!diskPages_.empty() && !pageFileMatches()) {
+        // Offsets into any other page file would decode as garbage.
+        diskPages_.clear();
         return false;
     }
+    return readWaypoints(in, true, waypoints_);
+}
 
+bool MapSystem::pageFileMatches() const {
+    std::ifstream in(pageFilePath(storageDir_, pageFileGeneration_), std::ios::binary);
+    char magic[4] = {};
+    std::uint32_t generation = 0;
+    in.read(magic, sizeof(magic));
+    readRaw(in, generation);
+    return in && std::equal(std::begin(magic), std::end(magic), std::begin(kPageFileMagic)) &&
+           generation == pageFileGeneration_;
+}
+
+bool MapSystem::loadLegacy(std::istream &in, bool hasWaypoints, bool hasVisibility) {
     std::uint32_t count = 0;
-    in.read(reinterpret_cast<char *>(&count), sizeof(count));
+    readRaw(in, count);
     if (!in) {
         return false;
     }
 
+    std::unordered_map<std::uint64_t, std::shared_ptr<Page>> loadedPages;
     for (std::uint32_t i = 0; i < count; ++i) {
         std::int32_t x = 0;
         std::int32_t z = 0;
         std::uint16_t id = 0;
-        in.read(reinterpret_cast<char *>(&x), sizeof(x));
-        in.read(reinterpret_cast<char *>(&z), sizeof(z));
-        in.read(reinterpret_cast<char *>(&id), sizeof(id));
+        readRaw(in, x);
+        readRaw(in, z);
+        readRaw(in, id);
         if (!in) {
             return false;
         }
         if (id != voxel::AIR) {
-            tiles_[keyFor(static_cast<int>(x), static_cast<int>(z))] =
-                static_cast<voxel::BlockId>(id);
-            heights_[keyFor(static_cast<int>(x), static_cast<int>(z))] =
-                static_cast<std::uint8_t>(voxel::Chunk::SY / 2);
+            const int px = floorDiv(static_cast<int>(x), kPageSize);
+            const int pz = floorDiv(static_cast<int>(z), kPageSize);
+            std::shared_ptr<Page> &page = loadedPages[pageKeyFor(px, pz)];
+            if (!page) {
+                page = std::make_shared<Page>();
+            }
+            MapColumn &column = page->columns[static_cast<std::size_t>(
+                (static_cast<int>(z) - pz * kPageSize) * kPageSize +
+                (static_cast<int>(x) - px * kPageSize))];
+            column.id = static_cast<voxel::BlockId>(id);
+            column.height = static_cast<std::uint8_t>(voxel::Chunk::SY / 2);
         }
     }
-    if (isV2 || isV3) {
-        std::uint32_t waypointCount = 0;
-        in.read(reinterpret_cast<char *>(&waypointCount), sizeof(waypointCount));
-        if (!in) {
-            return false;
+    // Old flat files have no page file yet; the next save migrates them.
+    for (auto &[key, page] : loadedPages) {
+        dirtyPages_.insert(key);
+        pages_.emplace(key, std::move(page));
+    }
+    return !hasWaypoints || readWaypoints(in, hasVisibility, waypoints_);
+}
+
+bool MapSystem::save(const std::filesystem::path &worldDir) {
+    std::error_code ec;
+    std::filesystem::create_directories(worldDir, ec);
+
+    // Saving somewhere new: pull every saved page in so the copy is complete.
+    if (storageDir_.lexically_normal() != worldDir.lexically_normal()) {
+        std::vector<std::uint64_t> unloaded;
+        for (const auto &[key, location] : diskPages_) {
+            (void)location;
+            if (pages_.find(key) == pages_.end()) {
+                unloaded.push_back(key);
+            }
+        }
+        for (const std::uint64_t key : unloaded) {
+            loadPage(key);
         }
-        waypoints_.reserve(waypointCount);
-        for (std::uint32_t i = 0; i < waypointCount; ++i) {
-            Waypoint wp{};
-            std::uint16_t nameLen = 0;
-            in.read(reinterpret_cast<char *>(&wp.x), sizeof(std::int32_t));
-            in.read(reinterpret_cast<char *>(&wp.z), sizeof(std::int32_t));
-            in.read(reinterpret_cast<char *>(&wp.r), sizeof(std::uint8_t));
-            in.read(reinterpret_cast<char *>(&wp.g), sizeof(std::uint8_t));
-            in.read(reinterpret_cast<char *>(&wp.b), sizeof(std::uint8_t));
-            in.read(reinterpret_cast<char *>(&wp.icon), sizeof(std::uint8_t));
-            if (isV3) {
-                std::uint8_t visible = 1;
-                in.read(reinterpret_cast<char *>(&visible), sizeof(std::uint8_t));
-                wp.visible = (visible != 0);
-            } else {
-                wp.visible = true;
+        diskPages_.clear();
+        dirtyPages_.clear();
+        for (const auto &[key, page] : pages_) {
+            (void)page;
+            dirtyPages_.insert(key);
+        }
+        storageDir_ = worldDir;
+        // Whatever map is already there gets replaced, page file included.
+        pageFileGeneration_ = indexedPageGeneration(worldDir);
+    }
+
+    const std::filesystem::path pagesPath = pageFilePath(worldDir, pageFileGeneration_);
+    const std::uint64_t fileBytes = std::filesystem::file_size(pagesPath, ec);
+    if (ec && !diskPages_.empty()) {
+        // The page file went missing; only resident pages can be kept.
+        diskPages_.clear();
+        for (const auto &[key, page] : pages_) {
+            (void)page;
+            dirtyPages_.insert(key);
+        }
+    }
+    // Pages are appended; the file is rewritten only when it is new or mostly
+    // superseded blobs.
+    std::uint64_t liveBytes = 0;
+    for (const auto &[key, location] : diskPages_) {
+        if (dirtyPages_.find(key) == dirtyPages_.end()) {
+            liveBytes += location.size;
+        }
+    }
+    const std::uint64_t garbageBytes = fileBytes > liveBytes ? fileBytes - liveBytes : 0u;
+    const bool rewrite = diskPages_.empty() ||
+                         (garbageBytes > kCompactMinGarbageBytes && garbageBytes > liveBytes);
+    // A rewrite goes to a page file of a new generation that no index names
+    // yet; only the index is swapped, so a crash at any point leaves map.dat
+    // paired with the page file it was written against.
+    std::uint32_t generation = pageFileGeneration_;
+    if (rewrite) {
+        do {
+            ++generation;
+        } while (std::filesystem::exists(pageFilePath(worldDir, generation), ec));
+    }
+    const std::filesystem::path newPagesPath = pageFilePath(worldDir, generation);
+    std::ofstream pagesOut(newPagesPath,
+                           std::ios::binary | (rewrite ? std::ios::trunc : std::ios::app));
+    if (!pagesOut) {
+        return false;
+    }
+    if (rewrite) {
+        pagesOut.write(kPageFileMagic, sizeof(kPageFileMagic));
+        writeRaw(pagesOut, generation);
+    }
+    std::uint64_t offset = rewrite ? kPageFileHeaderBytes : fileBytes;
+    std::unordered_map<std::uint64_t, PageLocation> index;
+    std::vector<char> blob;
+    if (rewrite && !diskPages_.empty()) {
+        std::ifstream pagesIn(pagesPath, std::ios::binary);
+        for (const auto &[key, location] : diskPages_) {
+            if (dirtyPages_.find(key) != dirtyPages_.end()) {
+                continue;
             }
-            in.read(reinterpret_cast<char *>(&nameLen), sizeof(std::uint16_t));
-            if (!in) {
+            blob.resize(location.size);
+            pagesIn.seekg(static_cast<std::streamoff>(location.offset));
+            pagesIn.read(blob.data(), static_cast<std::streamsize>(blob.size()));
+            if (!pagesIn) {
                 return false;
             }
-            wp.name.resize(nameLen);
-            if (nameLen > 0) {
-                in.read(wp.name.data(), nameLen);
-                if (!in) {
-                    return false;
-                }
+            pagesOut.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+            index[key] = PageLocation{offset, location.size};
+            offset += location.size;
+        }
+    } else if (!rewrite) {
+        index = diskPages_;
+    }
+    for (const std::uint64_t key : dirtyPages_) {
+        const auto it = pages_.find(key);
+        if (it == pages_.end()) {
+            continue;
+        }
+        blob.clear();
+        const auto &columns = it->second->columns;
+        for (std::size_t i = 0; i < columns.size();) {
+            const MapColumn &column = columns[i];
+            std::size_t run = 1;
+            while (i + run < columns.size() && columns[i + run].id == column.id &&
+                   columns[i + run].height == column.height &&
+                   columns[i + run].water == column.water) {
+                ++run;
             }
-            wp.icon = static_cast<std::uint8_t>(wp.icon % 5u);
-            waypoints_.push_back(std::move(wp));
+            const std::uint32_t packed = static_cast<std::uint32_t>(column.id) |
+                                         (static_cast<std::uint32_t>(column.height) << 16u) |
+                                         (static_cast<std::uint32_t>(column.water) << 24u);
+            const std::uint16_t count = static_cast<std::uint16_t>(run);
+            const std::size_t pos = blob.size();
+            blob.resize(pos + 6u);
+            std::memcpy(blob.data() + pos, &packed, sizeof(packed));
+            std::memcpy(blob.data() + pos + 4u, &count, sizeof(count));
+            i += run;
         }
+        pagesOut.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+        index[key] = PageLocation{offset, static_cast<std::uint32_t>(blob.size())};
+        offset += blob.size();
     }
-    return true;
-}
-
-bool MapSystem::save(const std::filesystem::path &worldDir) const {
-    std::filesystem::create_directories(worldDir);
-    std::ofstream out(worldDir / "map.dat", std::ios::binary | std::ios::trunc);
-    if (!out) {
+    pagesOut.close();
+    if (!pagesOut) {
         return false;
     }
 
-    out.write(kMapMagicV3, sizeof(kMapMagicV3));
-    const std::uint32_t count = static_cast<std::uint32_t>(tiles_.size());
-    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
-    for (const auto &[key, id] : tiles_) {
-        const std::int32_t x = static_cast<std::int32_t>(key >> 32u);
-        const std::int32_t z = static_cast<std::int32_t>(key & 0xFFFFFFFFu);
-        const std::uint16_t rawId = static_cast<std::uint16_t>(id);
-        out.write(reinterpret_cast<const char *>(&x), sizeof(x));
-        out.write(reinterpret_cast<const char *>(&z), sizeof(z));
-        out.write(reinterpret_cast<const char *>(&rawId), sizeof(rawId));
-    }
-    const std::uint32_t waypointCount = static_cast<std::uint32_t>(waypoints_.size());
-    out.write(reinterpret_cast<const char *>(&waypointCount), sizeof(waypointCount));
-    for (const Waypoint &wp : waypoints_) {
-        const std::int32_t x = static_cast<std::int32_t>(wp.x);
-        const std::int32_t z = static_cast<std::int32_t>(wp.z);
-        const std::uint8_t icon = static_cast<std::uint8_t>(wp.icon % 5u);
-        const std::uint16_t nameLen =
-            static_cast<std::uint16_t>(std::min<std::size_t>(wp.name.size(), 64));
-        out.write(reinterpret_cast<const char *>(&x), sizeof(x));
-        out.write(reinterpret_cast<const char *>(&z), sizeof(z));
-        out.write(reinterpret_cast<const char *>(&wp.r), sizeof(std::uint8_t));
-        out.write(reinterpret_cast<const char *>(&wp.g), sizeof(std::uint8_t));
-        out.write(reinterpret_cast<const char *>(&wp.b), sizeof(std::uint8_t));
-        out.write(reinterpret_cast<const char *>(&icon), sizeof(icon));
-        const std::uint8_t visible = wp.visible ? 1u : 0u;
-        out.write(reinterpret_cast<const char *>(&visible), sizeof(visible));
-        out.write(reinterpret_cast<const char *>(&nameLen), sizeof(nameLen));
-        if (nameLen > 0) {
-            out.write(wp.name.data(), nameLen);
+    const std::filesystem::path indexTmpPath = worldDir / "map.dat.tmp";
+    {
+        std::ofstream out(indexTmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out.write(kMapMagicV4, sizeof(kMapMagicV4));
+        writeRaw(out, generation);
+        writeRaw(out, static_cast<std::uint32_t>(index.size()));
+        for (const auto &[key, location] : index) {
+            writeRaw(out, static_cast<std::int32_t>(key >> 32u));
+            writeRaw(out, static_cast<std::int32_t>(key & 0xFFFFFFFFu));
+            writeRaw(out, location.offset);
+            writeRaw(out, location.size);
+        }
+        writeWaypoints(out, waypoints_);
+        if (!out) {
+            return false;
         }
     }
-    return static_cast<bool>(out);
+    std::filesystem::rename(indexTmpPath, worldDir / "map.dat", ec);
+    if (ec) {
+        return false;
+    }
+    if (generation != pageFileGeneration_) {
+        std::filesystem::remove(pagesPath, ec);
+        pageFileGeneration_ = generation;
+    }
+    diskPages_ = std::move(index);
+    dirtyPages_.clear();
+    return true;
 }
 
 } // namespace game
@@ -0,0 +1,217 @@
+#include "game/MapTilePyramid.hpp"
+
+#include "game/MapSystem.hpp"
+#include "voxel/Chunk.hpp"
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace game {
+namespace {
+
+constexpr std::uint8_t kKnownAlpha = 245;
+
+int floorDiv(int a, int b) {
+    return (a >= 0) ? (a / b) : ((a - b + 1) / b);
+}
+
+int floorMod(int a, int b) {
+    const int m = a % b;
+    return (m < 0) ? (m + b) : m;
+}
+
+std::uint8_t toByte(float v) {
+    return static_cast<std::uint8_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f));
+}
+
+} // namespace
+
+std::uint64_t MapTilePyramid::keyFor(int level, int tx, int tz) {
+    constexpr std::uint64_t kMask = 0xFFFFFFFu;
+    const std::uint64_t ux = static_cast<std::uint64_t>(static_cast<std::uint32_t>(tx)) & kMask;
+    const std::uint64_t uz = static_cast<std::uint64_t>(static_cast<std::uint32_t>(tz)) & kMask;
+    return (static_cast<std::uint64_t>(level) << 56u) | (ux << 28u) | uz;
+}
+
+const MapTilePyramid::Tile *MapTilePyramid::find(int level, int tx, int tz) const {
+    const auto it = tiles_.find(keyFor(level, tx, tz));
+    return it == tiles_.end() ? nullptr : &it->second;
+}
+
+const std::uint8_t *MapTilePyramid::peek(int level, int gx, int gz) const {
+    const Tile *tile = find(level, floorDiv(gx, kTileSize), floorDiv(gz, kTileSize));
+    if (tile == nullptr) {
+        return nullptr;
+    }
+    const std::size_t px = static_cast<std::size_t>(floorMod(gx, kTileSize));
+    const std::size_t pz = static_cast<std::size_t>(floorMod(gz, kTileSize));
+    return tile->rgba.data() + (pz * kTileSize + px) * 4u;
+}
+
+std::uint8_t *MapTilePyramid::texel(int level, int gx, int gz, bool create) {
+    const int tx = floorDiv(gx, kTileSize);
+    const int tz = floorDiv(gz, kTileSize);
+    const std::uint64_t key = keyFor(level, tx, tz);
+    auto it = tiles_.find(key);
+    if (it == tiles_.end()) {
+        if (!create) {
+            return nullptr;
+        }
+        Tile tile;
+        tile.level = level;
+        tile.tx = tx;
+        tile.tz = tz;
+        tile.rgba.assign(static_cast<std::size_t>(kTileSize) * kTileSize * 4u, 0u);
+        it = tiles_.emplace(key, std::move(tile)).first;
+    }
+    it->second.version = ++versionCounter_;
+    const std::size_t px = static_cast<std::size_t>(floorMod(gx, kTileSize));
+    const std::size_t pz = static_cast<std::size_t>(floorMod(gz, kTileSize));
+    return it->second.rgba.data() + (pz * kTileSize + px) * 4u;
+}
+
+void MapTilePyramid::invalidateAll() {
+    needsFullRebuild_ = true;
+}
+
+void MapTilePyramid::enqueue(const world::ChunkCoord &cc) {
+    if (queued_.insert(cc).second) {
+        dirtyQueue_.push_back(cc);
+    }
+}
+
+int MapTilePyramid::update(const MapSystem &map, const ColorFn &colorOf, int maxChunks) {
+    std::vector<world::ChunkCoord> changed;
+    if (!needsFullRebuild_ && map.revision() != seenRevision_ &&
+        !map.changedChunksSince(seenRevision_, changed)) {
+        needsFullRebuild_ = true;
+    }
+    if (needsFullRebuild_) {
+        tiles_.clear();
+        dirtyQueue_.clear();
+        queued_.clear();
+        changed = map.knownChunks();
+        needsFullRebuild_ = false;
+        ++rebuildCount_;
+    }
+    seenRevision_ = map.revision();
+    for (const world::ChunkCoord &cc : changed) {
+        enqueue(cc);
+    }
+
+    int rasterised = 0;
+    while (rasterised < maxChunks && !dirtyQueue_.empty()) {
+        const world::ChunkCoord cc = dirtyQueue_.front();
+        dirtyQueue_.pop_front();
+        queued_.erase(cc);
+        rasterChunk(map, colorOf, cc);
+        ++rasterised;
+    }
+    return rasterised;
+}
+
+bool MapTilePyramid::shadeColumn(const MapSystem &map, const ColorFn &colorOf, int wx, int wz,
+                                 glm::vec3 &out) {
+    voxel::BlockId id = voxel::AIR;
+    if (!map.sample(wx, wz, id)) {
+        return false;
+    }
+    glm::vec3 c = colorOf(id);
+    int y = voxel::Chunk::SY / 2;
+    if (map.sampleHeight(wx, wz, y)) {
+        int yX1 = y;
+        int yX0 = y;
+        int yZ1 = y;
+        int yZ0 = y;
+        (void)map.sampleHeight(wx + 1, wz, yX1);
+        (void)map.sampleHeight(wx - 1, wz, yX0);
+        (void)map.sampleHeight(wx, wz + 1, yZ1);
+        (void)map.sampleHeight(wx, wz - 1, yZ0);
+        const float slope = static_cast<float>((yX1 - yX0) - (yZ1 - yZ0));
+        const float shade = std::clamp(0.84f + slope * 0.025f, 0.68f, 1.16f);
+        const float altitude =
+            std::clamp(0.90f + (static_cast<float>(y) / 127.0f) * 0.22f, 0.88f, 1.16f);
+        c *= shade * altitude;
+    }
+    bool waterCovered = false;
+    if (map.sampleWaterCover(wx, wz, waterCovered) && waterCovered) {
+        const glm::vec3 waterTint(0.22f, 0.46f, 0.86f);
+        const float tintMix = voxel::isWaterloggedPlant(id) ? 0.10f
+                             : (voxel::isPlant(id) ? 0.22f : 0.44f);
+        c = glm::mix(c, waterTint, tintMix);
+    }
+    out = c;
+    return true;
+}
+
+void MapTilePyramid::rasterChunk(const MapSystem &map, const ColorFn &colorOf,
+                                 const world::ChunkCoord &cc) {
+    // Slope shading reads neighbouring heights, so a changed chunk also
+    // refreshes the one-column rim of its neighbours.
+    const int wx0 = cc.x * voxel::Chunk::SX - 1;
+    const int wz0 = cc.z * voxel::Chunk::SZ - 1;
+    const int wx1 = cc.x * voxel::Chunk::SX + voxel::Chunk::SX;
+    const int wz1 = cc.z * voxel::Chunk::SZ + voxel::Chunk::SZ;
+    for (int wz = wz0; wz <= wz1; ++wz) {
+        for (int wx = wx0; wx <= wx1; ++wx) {
+            glm::vec3 c(0.0f);
+            if (!shadeColumn(map, colorOf, wx, wz, c)) {
+                if (std::uint8_t *out = texel(0, wx, wz, false)) {
+                    std::fill(out, out + 4, std::uint8_t{0});
+                }
+                continue;
+            }
+            std::uint8_t *out = texel(0, wx, wz, true);
+            out[0] = toByte(c.r);
+            out[1] = toByte(c.g);
+            out[2] = toByte(c.b);
+            out[3] = kKnownAlpha;
+        }
+    }
+    for (int level = 1; level < kLevels; ++level) {
+        downsample(level, wx0, wz0, wx1, wz1);
+    }
+}
+
+void MapTilePyramid::downsample(int level, int wx0, int wz0, int wx1, int wz1) {
+    const int span = texelSpan(level);
+    const int gx0 = floorDiv(wx0, span);
+    const int gz0 = floorDiv(wz0, span);
+    const int gx1 = floorDiv(wx1, span);
+    const int gz1 = floorDiv(wz1, span);
+    for (int gz = gz0; gz <= gz1; ++gz) {
+        for (int gx = gx0; gx <= gx1; ++gx) {
+            // Average the explored children; unexplored ones only thin alpha.
+            int sum[4] = {0, 0, 0, 0};
+            int known = 0;
+            for (int j = 0; j < 2; ++j) {
+                for (int i = 0; i < 2; ++i) {
+                    const std::uint8_t *child = peek(level - 1, gx * 2 + i, gz * 2 + j);
+                    if (child == nullptr || child[3] == 0) {
+                        continue;
+                    }
+                    for (int k = 0; k < 4; ++k) {
+                        sum[k] += child[k];
+                    }
+                    ++known;
+                }
+            }
+            std::uint8_t *out = texel(level, gx, gz, known > 0);
+            if (out == nullptr) {
+                continue;
+            }
+            if (known == 0) {
+                std::fill(out, out + 4, std::uint8_t{0});
+                continue;
+            }
+            for (int k = 0; k < 3; ++k) {
+                out[k] = static_cast<std::uint8_t>(sum[k] / known);
+            }
+            out[3] = static_cast<std::uint8_t>(sum[3] / 4);
+        }
+    }
+}
+
+} // namespace game
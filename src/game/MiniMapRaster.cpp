@@ -0,0 +1,146 @@
+#include "game/MiniMapRaster.hpp"
+
+#include "game/MapSystem.hpp"
+#include "voxel/Chunk.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+namespace game {
+namespace {
+
+constexpr std::uint8_t kKnownAlpha = 245;
+// Past this many pending rectangles a single full upload is cheaper.
+constexpr std::size_t kMaxDirtyRects = 32;
+
+std::uint8_t toByte(float v) {
+    return static_cast<std::uint8_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f));
+}
+
+} // namespace
+
+MiniMapRaster::MiniMapRaster()
+    : rgba_(static_cast<std::size_t>(kSize) * kSize * 4u, 0u) {}
+
+void MiniMapRaster::invalidateAll() {
+    valid_ = false;
+}
+
+std::vector<MiniMapRaster::Rect> MiniMapRaster::consumeDirtyRects() {
+    std::vector<Rect> out;
+    out.swap(dirty_);
+    return out;
+}
+
+void MiniMapRaster::markDirty(int wx0, int wz0, int wx1, int wz1) {
+    if (dirty_.size() == 1 && dirty_.front().w == kSize && dirty_.front().h == kSize) {
+        return;
+    }
+    if (dirty_.size() >= kMaxDirtyRects) {
+        dirty_.assign(1, Rect{0, 0, kSize, kSize});
+        return;
+    }
+    // A box no wider than the ring splits into at most two runs per axis.
+    const auto split = [](int w0, int w1, std::pair<int, int> (&runs)[2]) {
+        const int start = ringIndex(w0);
+        const int length = w1 - w0 + 1;
+        if (start + length <= kSize) {
+            runs[0] = {start, length};
+            runs[1] = {0, 0};
+        } else {
+            runs[0] = {start, kSize - start};
+            runs[1] = {0, length - (kSize - start)};
+        }
+    };
+    std::pair<int, int> xs[2];
+    std::pair<int, int> zs[2];
+    split(wx0, wx1, xs);
+    split(wz0, wz1, zs);
+    for (const auto &[z, h] : zs) {
+        for (const auto &[x, w] : xs) {
+            if (w > 0 && h > 0) {
+                dirty_.push_back(Rect{x, z, w, h});
+            }
+        }
+    }
+}
+
+int MiniMapRaster::paint(const MapSystem &map, const MapTilePyramid::ColorFn &colorOf, int wx0,
+                         int wz0, int wx1, int wz1) {
+    wx0 = std::max(wx0, originX_);
+    wz0 = std::max(wz0, originZ_);
+    wx1 = std::min(wx1, originX_ + kSize - 1);
+    wz1 = std::min(wz1, originZ_ + kSize - 1);
+    if (wx0 > wx1 || wz0 > wz1) {
+        return 0;
+    }
+    for (int wz = wz0; wz <= wz1; ++wz) {
+        std::uint8_t *row = rgba_.data() + static_cast<std::size_t>(ringIndex(wz)) * kSize * 4u;
+        for (int wx = wx0; wx <= wx1; ++wx) {
+            std::uint8_t *out = row + static_cast<std::size_t>(ringIndex(wx)) * 4u;
+            glm::vec3 c(0.0f);
+            if (!MapTilePyramid::shadeColumn(map, colorOf, wx, wz, c)) {
+                std::fill(out, out + 4, std::uint8_t{0});
+                continue;
+            }
+            out[0] = toByte(c.r);
+            out[1] = toByte(c.g);
+            out[2] = toByte(c.b);
+            out[3] = kKnownAlpha;
+        }
+    }
+    markDirty(wx0, wz0, wx1, wz1);
+    return (wx1 - wx0 + 1) * (wz1 - wz0 + 1);
+}
+
+int MiniMapRaster::update(const MapSystem &map, const MapTilePyramid::ColorFn &colorOf,
+                          int centerWX, int centerWZ) {
+    const int newX = centerWX - kSize / 2;
+    const int newZ = centerWZ - kSize / 2;
+    std::vector<world::ChunkCoord> changed;
+    const bool logValid = valid_ && (map.revision() == seenRevision_ ||
+                                     map.changedChunksSince(seenRevision_, changed));
+    seenRevision_ = map.revision();
+
+    const int dx = newX - originX_;
+    const int dz = newZ - originZ_;
+    if (!logValid || std::abs(dx) >= kSize || std::abs(dz) >= kSize) {
+        originX_ = newX;
+        originZ_ = newZ;
+        valid_ = true;
+        return paint(map, colorOf, newX, newZ, newX + kSize - 1, newZ + kSize - 1);
+    }
+
+    // Ring slots that scrolled out of the window are exactly the ones the
+    // newly exposed strips land in.
+    const int oldX = originX_;
+    const int oldZ = originZ_;
+    originX_ = newX;
+    originZ_ = newZ;
+    const int maxX = newX + kSize - 1;
+    const int maxZ = newZ + kSize - 1;
+    int painted = 0;
+    if (dx > 0) {
+        painted += paint(map, colorOf, oldX + kSize, newZ, maxX, maxZ);
+    } else if (dx < 0) {
+        painted += paint(map, colorOf, newX, newZ, oldX - 1, maxZ);
+    }
+    if (dz > 0) {
+        painted += paint(map, colorOf, newX, oldZ + kSize, maxX, maxZ);
+    } else if (dz < 0) {
+        painted += paint(map, colorOf, newX, newZ, maxX, oldZ - 1);
+    }
+
+    // Slope shading reads neighbours, so a chunk repaint includes its rim.
+    for (const world::ChunkCoord &cc : changed) {
+        const int wx0 = cc.x * voxel::Chunk::SX - 1;
+        const int wz0 = cc.z * voxel::Chunk::SZ - 1;
+        painted += paint(map, colorOf, wx0, wz0, wx0 + voxel::Chunk::SX + 1,
+                         wz0 + voxel::Chunk::SZ + 1);
+    }
+    return painted;
+}
+
+} // namespace game
@@ -1,6 +1,5 @@
 #include "game/Player.hpp"
 
-#include "game/Camera.hpp"
 #include "world/World.hpp"
 
 #include <glm/common.hpp>
@@ -25,8 +24,7 @@ void Player::setFromCamera(const glm::vec3 &cameraPos, const world::World &world
     controller_.setFromCamera(cameraPos, world, resolveIntersections);
 }
 
-void Player::update(GLFWwindow *window, const world::World &world, const Camera &camera, float dt,
-                    bool inputEnabled) {
+void Player::update(const world::World &world, const PlayerInput &input, float dt) {
     if (sprintExhausted_) {
         sprintStamina_ = std::min(kSprintStaminaMax, sprintStamina_ + kSprintRegenPerSec * dt);
         if (sprintStamina_ >= kSprintResumeThreshold) {
@@ -34,7 +32,7 @@ void Player::update(GLFWwindow *window, const world::World &world, const Camera
         }
     }
 
-    controller_.update(window, world, camera, dt, inputEnabled, !sprintExhausted_);
+    controller_.update(world, input, dt, !sprintExhausted_);
 
     if (controller_.sprinting()) {
         sprintStamina_ = std::max(0.0f, sprintStamina_ - kSprintDrainPerSec * dt);
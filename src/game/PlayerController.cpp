@@ -42,7 +42,6 @@ constexpr float kGroundFrictionMove = 3.1f;
 constexpr float kGroundFrictionIdle = 9.5f;
 constexpr float kIceFriction = 0.55f;
 constexpr float kAirDrag = 0.2f;
-constexpr float kEps = 0.001f;
 
 float approach(float current, float target, float maxDelta) {
     if (current < target) {
@@ -51,10 +50,20 @@ float approach(float current, float target, float maxDelta) {
     return std::max(current - maxDelta, target);
 }
 
+PlayerController::CellSource cellsOf(const world::World &world) {
+    return [&world](const glm::ivec3 &minCell, const glm::ivec3 &maxCell,
+                    world::VoxelWindow &out) { world.gatherVoxelWindow(minCell, maxCell, out); };
+}
+
 } // namespace
 
 void PlayerController::setFromCamera(const glm::vec3 &cameraPos, const world::World &world,
                                      bool resolveIntersections) {
+    setFromCamera(cameraPos, cellsOf(world), resolveIntersections);
+}
+
+void PlayerController::setFromCamera(const glm::vec3 &cameraPos, const CellSource &cells,
+                                     bool resolveIntersections) {
     feetPos_ = cameraPos - glm::vec3(0.0f, kEyeOffset, 0.0f);
     velocity_ = glm::vec3(0.0f);
     grounded_ = false;
@@ -67,7 +76,8 @@ void PlayerController::setFromCamera(const glm::vec3 &cameraPos, const world::Wo
     initialized_ = true;
 
     if (resolveIntersections) {
-        for (int i = 0; i < 8 && intersectsSolid(world, feetPos_); ++i) {
+        gatherWindow(cells, glm::vec3(0.0f, 9.0f, 0.0f));
+        for (int i = 0; i < 8 && intersectsSolid(feetPos_); ++i) {
             feetPos_.y += 1.0f;
         }
     }
@@ -77,21 +87,36 @@ glm::vec3 PlayerController::cameraPosition() const {
     return feetPos_ + glm::vec3(0.0f, kEyeOffset + crouchViewOffset_, 0.0f);
 }
 
-bool PlayerController::isWaterAt(const world::World &world, const glm::vec3 &pos) const {
+void PlayerController::gatherWindow(const CellSource &cells, const glm::vec3 &reach) {
+    const glm::vec3 boxMin = feetPos_ + glm::vec3(-kHalfWidth, 0.0f, -kHalfWidth) - reach;
+    const glm::vec3 boxMax = feetPos_ + glm::vec3(kHalfWidth, kHeight, kHalfWidth) + reach;
+    cells(glm::ivec3(glm::floor(boxMin)), glm::ivec3(glm::floor(boxMax)), window_);
+}
+
+void PlayerController::ensureWindow(const CellSource &cells, const glm::vec3 &boxMin,
+                                    const glm::vec3 &boxMax) {
+    const glm::ivec3 minCell(glm::floor(boxMin));
+    const glm::ivec3 maxCell(glm::floor(boxMax));
+    if (!window_.contains(minCell, maxCell)) {
+        cells(minCell - glm::ivec3(1), maxCell + glm::ivec3(1), window_);
+    }
+}
+
+bool PlayerController::isWaterAt(const glm::vec3 &pos) const {
     const int wx = static_cast<int>(std::floor(pos.x));
     const int wy = static_cast<int>(std::floor(pos.y));
     const int wz = static_cast<int>(std::floor(pos.z));
-    return voxel::isWaterLike(world.getBlock(wx, wy, wz));
+    return voxel::isWaterLike(window_.block(wx, wy, wz));
 }
 
-bool PlayerController::isLavaAt(const world::World &world, const glm::vec3 &pos) const {
+bool PlayerController::isLavaAt(const glm::vec3 &pos) const {
     const int wx = static_cast<int>(std::floor(pos.x));
     const int wy = static_cast<int>(std::floor(pos.y));
     const int wz = static_cast<int>(std::floor(pos.z));
-    return voxel::isLavaLike(world.getBlock(wx, wy, wz));
+    return voxel::isLavaLike(window_.block(wx, wy, wz));
 }
 
-bool PlayerController::isOnIce(const world::World &world, const glm::vec3 &feet) const {
+bool PlayerController::isOnIce(const glm::vec3 &feet) const {
     const float y = feet.y - 0.08f;
     const glm::vec3 samples[5] = {
         glm::vec3(feet.x, y, feet.z),
@@ -104,37 +129,19 @@ bool PlayerController::isOnIce(const world::World &world, const glm::vec3 &feet)
         const int wx = static_cast<int>(std::floor(p.x));
         const int wy = static_cast<int>(std::floor(p.y));
         const int wz = static_cast<int>(std::floor(p.z));
-        if (world.getBlock(wx, wy, wz) == voxel::ICE) {
+        if (window_.block(wx, wy, wz) == voxel::ICE) {
             return true;
         }
     }
     return false;
 }
 
-bool PlayerController::intersectsSolid(const world::World &world, const glm::vec3 &feet) const {
-    const glm::vec3 aabbMin = feet + glm::vec3(-kHalfWidth, 0.0f, -kHalfWidth);
-    const glm::vec3 aabbMax = feet + glm::vec3(kHalfWidth, kHeight, kHalfWidth);
-
-    const int minX = static_cast<int>(std::floor(aabbMin.x));
-    const int minY = static_cast<int>(std::floor(aabbMin.y));
-    const int minZ = static_cast<int>(std::floor(aabbMin.z));
-    const int maxX = static_cast<int>(std::floor(aabbMax.x - kEps));
-    const int maxY = static_cast<int>(std::floor(aabbMax.y - kEps));
-    const int maxZ = static_cast<int>(std::floor(aabbMax.z - kEps));
-
-    for (int y = minY; y <= maxY; ++y) {
-        for (int z = minZ; z <= maxZ; ++z) {
-            for (int x = minX; x <= maxX; ++x) {
-                if (world.isSolidBlock(x, y, z)) {
-                    return true;
-                }
-            }
-        }
-    }
-    return false;
+bool PlayerController::intersectsSolid(const glm::vec3 &feet) const {
+    return window_.intersectsSolid(feet + glm::vec3(-kHalfWidth, 0.0f, -kHalfWidth),
+                                   feet + glm::vec3(kHalfWidth, kHeight, kHalfWidth));
 }
 
-bool PlayerController::hasGroundSupport(const world::World &world, const glm::vec3 &feet) const {
+bool PlayerController::hasGroundSupport(const glm::vec3 &feet) const {
     const float probeY = feet.y - 0.08f;
     const float s = kHalfWidth - 0.02f;
     const glm::vec3 probes[5] = {
@@ -148,50 +155,93 @@ bool PlayerController::hasGroundSupport(const world::World &world, const glm::ve
         const int wx = static_cast<int>(std::floor(p.x));
         const int wy = static_cast<int>(std::floor(p.y));
         const int wz = static_cast<int>(std::floor(p.z));
-        if (world.isSolidBlock(wx, wy, wz)) {
+        if (window_.solid(wx, wy, wz)) {
             return true;
         }
     }
     return false;
 }
 
-void PlayerController::moveAxis(const world::World &world, int axis, float amount) {
+void PlayerController::moveAxis(const CellSource &cells, int axis, float amount) {
     if (amount == 0.0f) {
         return;
     }
-    const int steps = std::max(1, static_cast<int>(std::ceil(std::abs(amount) / kStep)));
-    const float step = amount / static_cast<float>(steps);
-
-    for (int i = 0; i < steps; ++i) {
-        feetPos_[axis] += step;
-        if (intersectsSolid(world, feetPos_)) {
-            feetPos_[axis] -= step;
-            if (axis == 1 && step < 0.0f) {
-                grounded_ = true;
+    const glm::vec3 aabbMin = feetPos_ + glm::vec3(-kHalfWidth, 0.0f, -kHalfWidth);
+    const glm::vec3 aabbMax = feetPos_ + glm::vec3(kHalfWidth, kHeight, kHalfWidth);
+    glm::vec3 sweptMin = aabbMin - glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::vec3 sweptMax = aabbMax;
+    if (amount < 0.0f) {
+        sweptMin[axis] += amount;
+    } else {
+        sweptMax[axis] += amount;
+    }
+    ensureWindow(cells, sweptMin, sweptMax);
+
+    float moved = window_.sweep(aabbMin, aabbMax, axis, amount);
+    bool stopped = moved != amount;
+    if (axis != 1 && crouching_ && grounded_ && !inWater_ && !inLava_) {
+        // Crouching never walks off an edge: keep the furthest step that
+        // still has ground under it.
+        const int steps = std::max(1, static_cast<int>(std::ceil(std::abs(moved) / kStep)));
+        const float step = moved / static_cast<float>(steps);
+        for (int i = 1; i <= steps; ++i) {
+            glm::vec3 probe = feetPos_;
+            probe[axis] += step * static_cast<float>(i);
+            if (!hasGroundSupport(probe)) {
+                moved = step * static_cast<float>(i - 1);
+                stopped = true;
+                break;
             }
-            velocity_[axis] = 0.0f;
-            break;
         }
-        if (axis != 1 && crouching_ && grounded_ && !inWater_ && !inLava_ &&
-            !hasGroundSupport(world, feetPos_)) {
-            feetPos_[axis] -= step;
-            velocity_[axis] = 0.0f;
-            break;
+    }
+
+    feetPos_[axis] += moved;
+    if (stopped) {
+        if (axis == 1 && amount < 0.0f) {
+            grounded_ = true;
         }
+        velocity_[axis] = 0.0f;
     }
 }
 
-void PlayerController::update(GLFWwindow *window, const world::World &world, const Camera &camera,
-                              float dt, bool inputEnabled, bool allowSprint) {
+PlayerInput PlayerInput::sample(GLFWwindow *window, const Camera &camera, bool inputEnabled) {
+    PlayerInput input;
+    input.viewPos = camera.position();
+    input.forward = camera.forward();
+    if (!inputEnabled) {
+        return input;
+    }
+    input.forwardKey = glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS;
+    input.backKey = glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS;
+    input.rightKey = glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS;
+    input.leftKey = glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS;
+    input.jump = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
+    input.sprint = (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS) ||
+                   (glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS);
+    input.crouch = (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS) ||
+                   (glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS);
+    return input;
+}
+
+void PlayerController::update(const world::World &world, const PlayerInput &input, float dt,
+                              bool allowSprint) {
+    update(cellsOf(world), input, dt, allowSprint);
+}
+
+void PlayerController::update(const CellSource &cells, const PlayerInput &input, float dt,
+                              bool allowSprint) {
     if (!initialized_) {
-        setFromCamera(camera.position(), world);
+        setFromCamera(input.viewPos, cells);
     }
-    grounded_ = intersectsSolid(world, feetPos_ + glm::vec3(0.0f, -0.05f, 0.0f));
+    // One copy of the nearby cells serves every probe and sweep below; the
+    // margin covers fluid-flow neighbours and this frame's travel.
+    gatherWindow(cells, glm::abs(velocity_) * dt + glm::vec3(2.0f));
+    grounded_ = intersectsSolid(feetPos_ + glm::vec3(0.0f, -0.05f, 0.0f));
     if (grounded_ && velocity_.y < 0.0f) {
         velocity_.y = 0.0f;
     }
 
-    glm::vec3 forward = camera.forward();
+    glm::vec3 forward = input.forward;
     forward.y = 0.0f;
     if (glm::dot(forward, forward) < 1e-6f) {
         forward = glm::vec3(0.0f, 0.0f, -1.0f);
@@ -201,50 +251,41 @@ void PlayerController::update(GLFWwindow *window, const world::World &world, con
     const glm::vec3 right = glm::normalize(glm::cross(forward, glm::vec3(0.0f, 1.0f, 0.0f)));
 
     glm::vec3 wish(0.0f);
-    bool jumpDown = false;
-    bool sprint = false;
-    bool crouch = false;
-    bool shiftDown = false;
-    bool descend = false;
-    if (inputEnabled) {
-        if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-            wish += forward;
-        if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-            wish -= forward;
-        if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-            wish += right;
-        if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-            wish -= right;
-        jumpDown = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
-        shiftDown = (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS) ||
-                    (glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS);
-        sprint = shiftDown;
-        crouch = (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS) ||
-                 (glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS);
-    }
+    if (input.forwardKey)
+        wish += forward;
+    if (input.backKey)
+        wish -= forward;
+    if (input.rightKey)
+        wish += right;
+    if (input.leftKey)
+        wish -= right;
+    const bool jumpDown = input.jump;
+    const bool shiftDown = input.sprint;
+    bool sprint = shiftDown;
+    const bool crouch = input.crouch;
 
     if (glm::dot(wish, wish) > 1e-6f) {
         wish = glm::normalize(wish);
     }
     const bool hasWish = glm::dot(wish, wish) > 1e-6f;
 
-    inWater_ = isWaterAt(world, feetPos_ + glm::vec3(0.0f, 0.10f, 0.0f)) ||
-               isWaterAt(world, feetPos_ + glm::vec3(0.0f, 0.90f, 0.0f)) ||
-               isWaterAt(world, feetPos_ + glm::vec3(0.0f, 1.45f, 0.0f));
-    inLava_ = isLavaAt(world, feetPos_ + glm::vec3(0.0f, 0.10f, 0.0f)) ||
-              isLavaAt(world, feetPos_ + glm::vec3(0.0f, 0.90f, 0.0f)) ||
-              isLavaAt(world, feetPos_ + glm::vec3(0.0f, 1.45f, 0.0f));
+    inWater_ = isWaterAt(feetPos_ + glm::vec3(0.0f, 0.10f, 0.0f)) ||
+               isWaterAt(feetPos_ + glm::vec3(0.0f, 0.90f, 0.0f)) ||
+               isWaterAt(feetPos_ + glm::vec3(0.0f, 1.45f, 0.0f));
+    inLava_ = isLavaAt(feetPos_ + glm::vec3(0.0f, 0.10f, 0.0f)) ||
+              isLavaAt(feetPos_ + glm::vec3(0.0f, 0.90f, 0.0f)) ||
+              isLavaAt(feetPos_ + glm::vec3(0.0f, 1.45f, 0.0f));
     const bool inFluid = inWater_ || inLava_;
     // Shift should sink in water; crouch key still descends in any fluid.
-    descend = crouch || (shiftDown && inWater_);
+    const bool descend = crouch || (shiftDown && inWater_);
     const glm::vec3 fluidProbeA = feetPos_ + glm::vec3(0.0f, 0.20f, 0.0f);
     const glm::vec3 fluidProbeB = feetPos_ + glm::vec3(0.0f, 0.95f, 0.0f);
     const glm::vec3 fluidProbeC = feetPos_ + glm::vec3(0.0f, 1.55f, 0.0f);
     const glm::vec3 fluidFlow =
-        (world.fluidCurrentAt(fluidProbeA) + world.fluidCurrentAt(fluidProbeB) +
-         world.fluidCurrentAt(fluidProbeC)) /
+        (window_.fluidCurrentAt(fluidProbeA) + window_.fluidCurrentAt(fluidProbeB) +
+         window_.fluidCurrentAt(fluidProbeC)) /
         3.0f;
-    const bool onIce = grounded_ && !inFluid && isOnIce(world, feetPos_);
+    const bool onIce = grounded_ && !inFluid && isOnIce(feetPos_);
 
     if (crouch) {
         sprint = false;
@@ -320,10 +361,10 @@ void PlayerController::update(GLFWwindow *window, const world::World &world, con
     }
     const bool wasGrounded = grounded_;
     const float preVerticalVelocity = velocity_.y;
-    moveAxis(world, 0, velocity_.x * dt);
+    moveAxis(cells, 0, velocity_.x * dt);
     grounded_ = false; // Recomputed by vertical collision resolution below.
-    moveAxis(world, 1, velocity_.y * dt);
-    moveAxis(world, 2, velocity_.z * dt);
+    moveAxis(cells, 1, velocity_.y * dt);
+    moveAxis(cells, 2, velocity_.z * dt);
 
     landedImpactSpeed_ = 0.0f;
     if (!inFluid && !wasGrounded && grounded_ && preVerticalVelocity < 0.0f) {
@@ -0,0 +1,124 @@
+#include "game/SearchIndex.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace game {
+
+std::string SearchIndex::toLower(std::string text) {
+    for (char &c : text) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return text;
+}
+
+std::uint32_t SearchIndex::gramKey(const char *chars, std::size_t length) {
+    std::uint32_t key = static_cast<std::uint32_t>(length) << 24;
+    for (std::size_t i = 0; i < length; ++i) {
+        key |= static_cast<std::uint32_t>(static_cast<unsigned char>(chars[i])) << (16 - 8 * i);
+    }
+    return key;
+}
+
+void SearchIndex::clear() {
+    texts_.clear();
+    all_.clear();
+    grams_.clear();
+    cache_.clear();
+}
+
+int SearchIndex::add(const std::vector<std::string> &texts) {
+    const int entry = static_cast<int>(texts_.size());
+    std::string joined;
+    for (const auto &text : texts) {
+        if (!joined.empty()) {
+            joined.push_back('\n');
+        }
+        joined += toLower(text);
+    }
+    for (std::size_t start = 0; start < joined.size(); ++start) {
+        for (std::size_t length = 1; length <= 3 && start + length <= joined.size(); ++length) {
+            if (joined[start + length - 1] == '\n') {
+                break;
+            }
+            auto &postings = grams_[gramKey(joined.data() + start, length)];
+            if (postings.empty() || postings.back() != entry) {
+                postings.push_back(entry);
+            }
+        }
+    }
+    texts_.push_back(std::move(joined));
+    all_.push_back(entry);
+    cache_.clear();
+    return entry;
+}
+
+bool SearchIndex::matches(int entry, const std::string &loweredQuery) const {
+    if (entry < 0 || entry >= static_cast<int>(texts_.size())) {
+        return false;
+    }
+    return texts_[entry].find(loweredQuery) != std::string::npos;
+}
+
+const std::vector<int> &SearchIndex::find(const std::string &query) {
+    if (query.empty()) {
+        return all_;
+    }
+    std::string lowered = toLower(query);
+    const auto cached = cache_.find(lowered);
+    if (cached != cache_.end()) {
+        return cached->second;
+    }
+
+    // Every match of the query also matches each of its prefixes. A newline
+    // would match across two texts of an entry.
+    std::vector<int> results;
+    bool resolved = lowered.find('\n') != std::string::npos;
+    for (std::size_t length = lowered.size() - 1; length > 0 && !resolved; --length) {
+        const auto prefix = cache_.find(lowered.substr(0, length));
+        if (prefix == cache_.end()) {
+            continue;
+        }
+        for (int entry : prefix->second) {
+            if (matches(entry, lowered)) {
+                results.push_back(entry);
+            }
+        }
+        resolved = true;
+    }
+    if (!resolved) {
+        results = search(lowered);
+    }
+
+    if (cache_.size() >= kMaxCachedQueries) {
+        cache_.clear();
+    }
+    return cache_.emplace(std::move(lowered), std::move(results)).first->second;
+}
+
+std::vector<int> SearchIndex::search(const std::string &query) const {
+    if (query.size() <= 3) {
+        const auto it = grams_.find(gramKey(query.data(), query.size()));
+        return it != grams_.end() ? it->second : std::vector<int>{};
+    }
+
+    const std::vector<int> *rarest = nullptr;
+    for (std::size_t start = 0; start + 3 <= query.size(); ++start) {
+        const auto it = grams_.find(gramKey(query.data() + start, 3));
+        if (it == grams_.end()) {
+            return {};
+        }
+        if (rarest == nullptr || it->second.size() < rarest->size()) {
+            rarest = &it->second;
+        }
+    }
+    std::vector<int> results;
+    for (int entry : *rarest) {
+        if (matches(entry, query)) {
+            results.push_back(entry);
+        }
+    }
+    return results;
+}
+
+} // namespace game
@@ -0,0 +1,158 @@
+#include "gfx/BufferSubAllocator.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace gfx {
+
+BufferSubAllocator::BufferSubAllocator(std::uint32_t capacity, std::uint32_t granularity)
+    : granularity_(std::max(1u, granularity)) {
+    grow(capacity);
+}
+
+std::uint32_t BufferSubAllocator::roundUp(std::uint32_t size) const {
+    return ((size + granularity_ - 1u) / granularity_) * granularity_;
+}
+
+int BufferSubAllocator::sizeClass(std::uint32_t size) {
+    return std::min(kSizeClassCount - 1, static_cast<int>(std::bit_width(size)) - 1);
+}
+
+void BufferSubAllocator::insertFree(std::uint32_t offset, std::uint32_t size) {
+    if (size == 0) {
+        return;
+    }
+    freeByOffset_[offset] = size;
+    freeByClass_[sizeClass(size)].insert(offset);
+}
+
+void BufferSubAllocator::eraseFree(std::uint32_t offset, std::uint32_t size) {
+    freeByOffset_.erase(offset);
+    freeByClass_[sizeClass(size)].erase(offset);
+}
+
+std::optional<BufferSubAllocator::Allocation> BufferSubAllocator::allocate(std::uint32_t size) {
+    if (size == 0) {
+        return std::nullopt;
+    }
+    const std::uint32_t rounded = roundUp(size);
+    if (rounded < size || rounded > freeUnits()) {
+        return std::nullopt;
+    }
+
+    // The request's own class holds blocks in [2^c, 2^(c+1)), so it needs a
+    // first-fit scan; any block in a higher class is guaranteed to fit.
+    std::optional<std::uint32_t> found;
+    const int firstClass = sizeClass(rounded);
+    for (const std::uint32_t offset : freeByClass_[firstClass]) {
+        if (freeByOffset_[offset] >= rounded) {
+            found = offset;
+            break;
+        }
+    }
+    for (int c = firstClass + 1; !found.has_value() && c < kSizeClassCount; ++c) {
+        if (!freeByClass_[c].empty()) {
+            found = *freeByClass_[c].begin();
+        }
+    }
+    if (!found.has_value()) {
+        return std::nullopt;
+    }
+
+    const std::uint32_t offset = *found;
+    const std::uint32_t blockSize = freeByOffset_[offset];
+    eraseFree(offset, blockSize);
+    insertFree(offset + rounded, blockSize - rounded);
+    live_[offset] = rounded;
+    used_ += rounded;
+    return Allocation{offset, rounded};
+}
+
+void BufferSubAllocator::release(const Allocation &allocation) {
+    const auto it = live_.find(allocation.offset);
+    if (it == live_.end()) {
+        return;
+    }
+    std::uint32_t offset = it->first;
+    std::uint32_t size = it->second;
+    live_.erase(it);
+    used_ -= size;
+
+    auto next = freeByOffset_.lower_bound(offset);
+    if (next != freeByOffset_.end() && next->first == offset + size) {
+        const std::uint32_t nextSize = next->second;
+        eraseFree(next->first, nextSize);
+        size += nextSize;
+        next = freeByOffset_.lower_bound(offset);
+    }
+    if (next != freeByOffset_.begin()) {
+        const auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            const std::uint32_t prevOffset = prev->first;
+            const std::uint32_t prevSize = prev->second;
+            eraseFree(prevOffset, prevSize);
+            offset = prevOffset;
+            size += prevSize;
+        }
+    }
+    insertFree(offset, size);
+}
+
+void BufferSubAllocator::grow(std::uint32_t newCapacity) {
+    newCapacity = (newCapacity / granularity_) * granularity_;
+    if (newCapacity <= capacity_) {
+        return;
+    }
+    std::uint32_t tailOffset = capacity_;
+    std::uint32_t tailSize = newCapacity - capacity_;
+    if (!freeByOffset_.empty()) {
+        const auto last = std::prev(freeByOffset_.end());
+        if (last->first + last->second == capacity_) {
+            tailOffset = last->first;
+            tailSize += last->second;
+            eraseFree(last->first, last->second);
+        }
+    }
+    capacity_ = newCapacity;
+    insertFree(tailOffset, tailSize);
+}
+
+std::vector<BufferSubAllocator::Move> BufferSubAllocator::compact() {
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> ordered(live_.begin(), live_.end());
+    std::sort(ordered.begin(), ordered.end());
+
+    std::vector<Move> moves;
+    std::unordered_map<std::uint32_t, std::uint32_t> packed;
+    packed.reserve(ordered.size());
+    std::uint32_t cursor = 0;
+    for (const auto &[offset, size] : ordered) {
+        if (offset != cursor) {
+            moves.push_back(Move{offset, cursor, size});
+        }
+        packed[cursor] = size;
+        cursor += size;
+    }
+
+    live_ = std::move(packed);
+    freeByOffset_.clear();
+    for (auto &bucket : freeByClass_) {
+        bucket.clear();
+    }
+    insertFree(cursor, capacity_ - cursor);
+    return moves;
+}
+
+std::uint32_t BufferSubAllocator::largestFreeBlock() const {
+    for (int c = kSizeClassCount - 1; c >= 0; --c) {
+        std::uint32_t best = 0;
+        for (const std::uint32_t offset : freeByClass_[c]) {
+            best = std::max(best, freeByOffset_.at(offset));
+        }
+        if (best > 0) {
+            return best;
+        }
+    }
+    return 0;
+}
+
+} // namespace gfx
@@ -0,0 +1,341 @@
+#include "gfx/ChunkGeometryArena.hpp"
+
+#include "gfx/ChunkMesh.hpp"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+namespace gfx {
+namespace {
+
+constexpr std::uint32_t kInitialVertexCapacity = 1u << 20;
+constexpr std::uint32_t kInitialIndexCapacity = 3u << 19;
+constexpr std::uint32_t kVertexGranularity = 256;
+constexpr std::uint32_t kIndexGranularity = 384;
+constexpr std::uint32_t kVertexStride = sizeof(Vertex);
+constexpr std::uint32_t kIndexStride = sizeof(std::uint32_t);
+
+} // namespace
+
+ChunkGeometryArena::~ChunkGeometryArena() {
+    if (glfwGetCurrentContext() == nullptr) {
+        return;
+    }
+    if (ebo_ != 0) {
+        glDeleteBuffers(1, &ebo_);
+    }
+    if (vbo_ != 0) {
+        glDeleteBuffers(1, &vbo_);
+    }
+    if (vao_ != 0) {
+        glDeleteVertexArrays(1, &vao_);
+    }
+}
+
+void ChunkGeometryArena::init() {
+    if (ready_) {
+        return;
+    }
+    vertexAlloc_ = BufferSubAllocator(kInitialVertexCapacity, kVertexGranularity);
+    indexAlloc_ = BufferSubAllocator(kInitialIndexCapacity, kIndexGranularity);
+
+    glGenVertexArrays(1, &vao_);
+    glGenBuffers(1, &vbo_);
+    glGenBuffers(1, &ebo_);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, vbo_);
+    glBufferData(GL_COPY_WRITE_BUFFER,
+                 static_cast<GLsizeiptr>(vertexAlloc_.capacity()) * kVertexStride, nullptr,
+                 GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, ebo_);
+    glBufferData(GL_COPY_WRITE_BUFFER,
+                 static_cast<GLsizeiptr>(indexAlloc_.capacity()) * kIndexStride, nullptr,
+                 GL_DYNAMIC_DRAW);
+    bindVertexLayout();
+    ready_ = true;
+}
+
+void ChunkGeometryArena::bindVertexLayout() const {
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(0));
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          reinterpret_cast<void *>(3 * sizeof(float)));
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          reinterpret_cast<void *>(6 * sizeof(float)));
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          reinterpret_cast<void *>(8 * sizeof(float)));
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          reinterpret_cast<void *>(9 * sizeof(float)));
+    glEnableVertexAttribArray(5);
+    glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          reinterpret_cast<void *>(10 * sizeof(float)));
+    glBindVertexArray(0);
+}
+
+ChunkGeometryArena::SlotHandle ChunkGeometryArena::createSlot() {
+    if (!freeSlots_.empty()) {
+        const SlotHandle handle = freeSlots_.back();
+        freeSlots_.pop_back();
+        slots_[handle] = Slot{};
+        slots_[handle].live = true;
+        return handle;
+    }
+    slots_.push_back(Slot{});
+    slots_.back().live = true;
+    return static_cast<SlotHandle>(slots_.size() - 1);
+}
+
+void ChunkGeometryArena::destroySlot(SlotHandle handle) {
+    if (handle >= slots_.size() || !slots_[handle].live) {
+        return;
+    }
+    releaseRanges(slots_[handle]);
+    slots_[handle].live = false;
+    freeSlots_.push_back(handle);
+}
+
+void ChunkGeometryArena::releaseRanges(Slot &slot) {
+    if (slot.vertices.size > 0) {
+        vertexAlloc_.release(slot.vertices);
+    }
+    if (slot.indices.size > 0) {
+        indexAlloc_.release(slot.indices);
+    }
+    slot.vertices = {};
+    slot.indices = {};
+    slot.indexCount = 0;
+}
+
+void ChunkGeometryArena::relocate(bool vertexBuffer, std::uint32_t newCapacity) {
+    BufferSubAllocator &alloc = vertexBuffer ? vertexAlloc_ : indexAlloc_;
+    unsigned int &buffer = vertexBuffer ? vbo_ : ebo_;
+    const std::uint32_t stride = vertexBuffer ? kVertexStride : kIndexStride;
+
+    const std::vector<BufferSubAllocator::Move> moves = alloc.compact();
+    alloc.grow(newCapacity);
+    std::unordered_map<std::uint32_t, std::uint32_t> remap;
+    remap.reserve(moves.size());
+    for (const BufferSubAllocator::Move &m : moves) {
+        remap[m.from] = m.to;
+    }
+
+    // Ranges may overlap after packing, so copy into a fresh buffer rather than
+    // sliding data inside the old one.
+    unsigned int fresh = 0;
+    glGenBuffers(1, &fresh);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, fresh);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(alloc.capacity()) * stride, nullptr,
+                 GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    for (Slot &slot : slots_) {
+        BufferSubAllocator::Allocation &range = vertexBuffer ? slot.vertices : slot.indices;
+        if (!slot.live || range.size == 0) {
+            continue;
+        }
+        const auto it = remap.find(range.offset);
+        const std::uint32_t dst = (it != remap.end()) ? it->second : range.offset;
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                            static_cast<GLintptr>(range.offset) * stride,
+                            static_cast<GLintptr>(dst) * stride,
+                            static_cast<GLsizeiptr>(range.size) * stride);
+        range.offset = dst;
+    }
+    glDeleteBuffers(1, &buffer);
+    buffer = fresh;
+    bindVertexLayout();
+    ++compactions_;
+}
+
+ChunkGeometryArena::Slot *ChunkGeometryArena::allocateRanges(SlotHandle handle,
+                                                             std::uint32_t vertexCount,
+                                                             std::uint32_t indexCount) {
+    if (handle >= slots_.size() || !slots_[handle].live) {
+        return nullptr;
+    }
+    init();
+    releaseRanges(slots_[handle]);
+    if (vertexCount == 0 || indexCount == 0) {
+        return nullptr;
+    }
+
+    const auto reserve = [this](bool vertexBuffer, std::uint32_t size) {
+        BufferSubAllocator &alloc = vertexBuffer ? vertexAlloc_ : indexAlloc_;
+        if (auto range = alloc.allocate(size)) {
+            return *range;
+        }
+        // Pack live ranges first; only grow when packing alone cannot make room.
+        std::uint32_t capacity = alloc.capacity();
+        const std::uint32_t slack = vertexBuffer ? kVertexGranularity : kIndexGranularity;
+        while (capacity < alloc.usedUnits() + size + slack) {
+            capacity *= 2u;
+        }
+        relocate(vertexBuffer, capacity);
+        return alloc.allocate(size).value_or(BufferSubAllocator::Allocation{});
+    };
+
+    const BufferSubAllocator::Allocation vertices = reserve(true, vertexCount);
+    const BufferSubAllocator::Allocation indices = reserve(false, indexCount);
+    Slot &slot = slots_[handle];
+    slot.vertices = vertices;
+    slot.indices = indices;
+    if (vertices.size == 0 || indices.size == 0) {
+        releaseRanges(slot);
+        return nullptr;
+    }
+    slot.indexCount = static_cast<int>(indexCount);
+    return &slot;
+}
+
+void ChunkGeometryArena::upload(SlotHandle handle, const CpuMesh &mesh) {
+    const auto vertexCount = static_cast<std::uint32_t>(mesh.vertices.size());
+    const auto indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+    const Slot *slot = allocateRanges(handle, vertexCount, indexCount);
+    if (slot == nullptr) {
+        return;
+    }
+
+    const std::uint32_t vertexBytes = vertexCount * kVertexStride;
+    const std::uint32_t indexBytes = indexCount * kIndexStride;
+    const auto stagedVertices = staging_.write(mesh.vertices.data(), vertexBytes);
+    const auto stagedIndices =
+        stagedVertices.has_value() ? staging_.write(mesh.indices.data(), indexBytes) : std::nullopt;
+    if (stagedVertices.has_value() && stagedIndices.has_value()) {
+        glBindBuffer(GL_COPY_READ_BUFFER, staging_.buffer());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, vbo_);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, stagedVertices->offset,
+                            static_cast<GLintptr>(slot->vertices.offset) * kVertexStride,
+                            vertexBytes);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, ebo_);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, stagedIndices->offset,
+                            static_cast<GLintptr>(slot->indices.offset) * kIndexStride,
+                            indexBytes);
+        stagedBytes_ += vertexBytes + indexBytes;
+        return;
+    }
+    // No persistent mapping, the ring is full of in-flight frames, or the mesh
+    // is larger than the ring: write straight into the arena.
+    glBindBuffer(GL_COPY_WRITE_BUFFER, vbo_);
+    glBufferSubData(GL_COPY_WRITE_BUFFER,
+                    static_cast<GLintptr>(slot->vertices.offset) * kVertexStride, vertexBytes,
+                    mesh.vertices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, ebo_);
+    glBufferSubData(GL_COPY_WRITE_BUFFER,
+                    static_cast<GLintptr>(slot->indices.offset) * kIndexStride, indexBytes,
+                    mesh.indices.data());
+    directBytes_ += vertexBytes + indexBytes;
+}
+
+void ChunkGeometryArena::uploadStaged(SlotHandle handle, const StagedMesh &staged) {
+    const Slot *slot = allocateRanges(handle, staged.vertexCount, staged.indexCount);
+    if (slot != nullptr) {
+        const std::uint32_t vertexBytes = staged.vertexCount * kVertexStride;
+        const std::uint32_t indexBytes = staged.indexCount * kIndexStride;
+        const std::uint32_t base = staged.slab.region.offset;
+        glBindBuffer(GL_COPY_READ_BUFFER, staging_.buffer());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, vbo_);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, base,
+                            static_cast<GLintptr>(slot->vertices.offset) * kVertexStride,
+                            vertexBytes);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, ebo_);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, base + staged.indexOffset,
+                            static_cast<GLintptr>(slot->indices.offset) * kIndexStride,
+                            indexBytes);
+        stagedBytes_ += vertexBytes + indexBytes;
+    }
+    staging_.release(staged.slab.region);
+}
+
+std::optional<StagingSlab> ChunkGeometryArena::reserveSlab(std::uint32_t bytes) {
+    const auto region = staging_.reserve(bytes);
+    if (!region.has_value()) {
+        return std::nullopt;
+    }
+    return StagingSlab{*region, staging_.data(*region)};
+}
+
+void ChunkGeometryArena::releaseSlab(const StagingSlab &slab) {
+    staging_.release(slab.region);
+}
+
+bool ChunkGeometryArena::stageMesh(const StagingSlab &slab, const CpuMesh &mesh, StagedMesh &out) {
+    const std::size_t vertexBytes = mesh.vertices.size() * kVertexStride;
+    const std::size_t indexBytes = mesh.indices.size() * kIndexStride;
+    // Index data stays 4-byte aligned because Vertex is a run of floats.
+    if (slab.memory == nullptr || vertexBytes + indexBytes > slab.region.size) {
+        return false;
+    }
+    std::memcpy(slab.memory, mesh.vertices.data(), vertexBytes);
+    std::memcpy(slab.memory + vertexBytes, mesh.indices.data(), indexBytes);
+    out.slab = slab;
+    out.vertexCount = static_cast<std::uint32_t>(mesh.vertices.size());
+    out.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+    out.indexOffset = static_cast<std::uint32_t>(vertexBytes);
+    return true;
+}
+
+void ChunkGeometryArena::endFrame() {
+    if (ready_) {
+        staging_.endFrame();
+    }
+}
+
+int ChunkGeometryArena::indexCount(SlotHandle handle) const {
+    if (handle >= slots_.size() || !slots_[handle].live) {
+        return 0;
+    }
+    return slots_[handle].indexCount;
+}
+
+void ChunkGeometryArena::appendDraw(SlotHandle handle, ChunkDrawBatch &batch) const {
+    if (handle >= slots_.size()) {
+        return;
+    }
+    const Slot &slot = slots_[handle];
+    if (!slot.live || slot.indexCount == 0) {
+        return;
+    }
+    batch.counts.push_back(slot.indexCount);
+    batch.indexOffsets.push_back(reinterpret_cast<const void *>(
+        static_cast<std::uintptr_t>(slot.indices.offset) * kIndexStride));
+    batch.baseVertices.push_back(static_cast<int>(slot.vertices.offset));
+}
+
+void ChunkGeometryArena::draw(const ChunkDrawBatch &batch) const {
+    if (!ready_ || batch.empty()) {
+        return;
+    }
+    glBindVertexArray(vao_);
+    glMultiDrawElementsBaseVertex(GL_TRIANGLES, batch.counts.data(), GL_UNSIGNED_INT,
+                                  batch.indexOffsets.data(),
+                                  static_cast<GLsizei>(batch.counts.size()),
+                                  batch.baseVertices.data());
+}
+
+ChunkGeometryArena::Stats ChunkGeometryArena::stats() const {
+    Stats out;
+    out.vertexCapacity = vertexAlloc_.capacity();
+    out.vertexUsed = vertexAlloc_.usedUnits();
+    out.indexCapacity = indexAlloc_.capacity();
+    out.indexUsed = indexAlloc_.usedUnits();
+    out.slots = static_cast<std::uint32_t>(slots_.size() - freeSlots_.size());
+    out.compactions = compactions_;
+    out.stagedBytes = stagedBytes_;
+    out.directBytes = directBytes_;
+    return out;
+}
+
+} // namespace gfx
@@ -1,72 +1,27 @@
 #include "gfx/ChunkMesh.hpp"
 
-#include <glad/glad.h>
-
 namespace gfx {
 
+ChunkMesh::ChunkMesh(ChunkGeometryArena &arena) : arena_(arena), slot_(arena.createSlot()) {}
+
 ChunkMesh::~ChunkMesh() {
-    if (ebo_ != 0) {
-        glDeleteBuffers(1, &ebo_);
-    }
-    if (vbo_ != 0) {
-        glDeleteBuffers(1, &vbo_);
-    }
-    if (vao_ != 0) {
-        glDeleteVertexArrays(1, &vao_);
-    }
+    arena_.destroySlot(slot_);
 }
 
 void ChunkMesh::upload(const CpuMesh &mesh) {
-    if (vao_ == 0) {
-        glGenVertexArrays(1, &vao_);
-    }
-    if (vbo_ == 0) {
-        glGenBuffers(1, &vbo_);
-    }
-    if (ebo_ == 0) {
-        glGenBuffers(1, &ebo_);
-    }
-
-    indexCount_ = static_cast<int>(mesh.indices.size());
-
-    glBindVertexArray(vao_);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(mesh.vertices.size() * sizeof(Vertex)),
-                 mesh.vertices.data(), GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                 static_cast<GLsizeiptr>(mesh.indices.size() * sizeof(std::uint32_t)),
-                 mesh.indices.data(), GL_STATIC_DRAW);
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void *>(0));
-
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          reinterpret_cast<void *>(3 * sizeof(float)));
+    arena_.upload(slot_, mesh);
+}
 
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          reinterpret_cast<void *>(6 * sizeof(float)));
+void ChunkMesh::uploadStaged(const StagedMesh &staged) {
+    arena_.uploadStaged(slot_, staged);
+}
 
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          reinterpret_cast<void *>(8 * sizeof(float)));
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          reinterpret_cast<void *>(9 * sizeof(float)));
-    glEnableVertexAttribArray(5);
-    glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          reinterpret_cast<void *>(10 * sizeof(float)));
+void ChunkMesh::appendTo(ChunkDrawBatch &batch) const {
+    arena_.appendDraw(slot_, batch);
 }
 
-void ChunkMesh::draw() const {
-    if (vao_ == 0 || indexCount_ == 0) {
-        return;
-    }
-    glBindVertexArray(vao_);
-    glDrawElements(GL_TRIANGLES, indexCount_, GL_UNSIGNED_INT, nullptr);
+int ChunkMesh::indexCount() const {
+    return arena_.indexCount(slot_);
 }
 
 } // namespace gfx
@@ -0,0 +1,160 @@
+#include "gfx/CloudLayerRenderer.hpp"
+#include "app/util/ShaderProgramUtils.hpp"
+#include "gfx/SceneUniforms.hpp"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+namespace gfx {
+namespace {
+
+std::uint32_t cloudHashU32(std::uint32_t x) {
+    x ^= x >> 16u;
+    x *= 0x7feb352du;
+    x ^= x >> 15u;
+    x *= 0x846ca68bu;
+    x ^= x >> 16u;
+    return x;
+}
+
+float cloudHash(int x, int z, int salt) {
+    const auto u32 = [](int v) { return static_cast<std::uint32_t>(v); };
+    const std::uint32_t h =
+        cloudHashU32(u32(x) ^ (cloudHashU32(u32(z) + 0x9e3779b9u) + u32(salt) * 0x85ebca6bu));
+    return static_cast<float>(h & 0x00ffffffu) * (1.0f / 16777215.0f);
+}
+
+bool cloudCellFilled(int gx, int gz) {
+    const int fx = static_cast<int>(std::floor(static_cast<float>(gx) * 0.5f));
+    const int fz = static_cast<int>(std::floor(static_cast<float>(gz) * 0.5f));
+    const float base = cloudHash(fx, fz, 503);
+    const float nE = cloudHash(fx + 1, fz, 503);
+    const float nW = cloudHash(fx - 1, fz, 503);
+    const float nN = cloudHash(fx, fz + 1, 503);
+    const float nS = cloudHash(fx, fz - 1, 503);
+    const bool core = base > 0.77f;
+    const bool fringe = (base > 0.69f) && (std::max(std::max(nE, nW), std::max(nN, nS)) > 0.78f);
+    return core || fringe;
+}
+
+} // namespace
+
+CloudLayerRenderer::~CloudLayerRenderer() {
+    if (glfwGetCurrentContext() == nullptr) {
+        return;
+    }
+    if (instanceVbo_ != 0) {
+        glDeleteBuffers(1, &instanceVbo_);
+    }
+    if (quadVbo_ != 0) {
+        glDeleteBuffers(1, &quadVbo_);
+    }
+    if (vao_ != 0) {
+        glDeleteVertexArrays(1, &vao_);
+    }
+    if (program_ != 0) {
+        glDeleteProgram(program_);
+    }
+}
+
+void CloudLayerRenderer::rebuild(int centerGX, int centerGZ) {
+    instances_.clear();
+    const int range = settings_.range;
+    for (int gz = centerGZ - range; gz <= centerGZ + range; ++gz) {
+        for (int gx = centerGX - range; gx <= centerGX + range; ++gx) {
+            if (cloudCellFilled(gx, gz)) {
+                instances_.emplace_back(static_cast<float>(gx), static_cast<float>(gz));
+            }
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo_);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(instances_.size() * sizeof(glm::vec2)),
+                 instances_.data(), GL_DYNAMIC_DRAW);
+    builtGX_ = centerGX;
+    builtGZ_ = centerGZ;
+    built_ = true;
+}
+
+void CloudLayerRenderer::draw(const glm::vec3 &cameraPos, float timeSeconds, float layerY,
+                              const glm::vec3 &color) {
+    init();
+    const glm::vec2 drift = settings_.driftSpeed * timeSeconds;
+    const int centerGX = static_cast<int>(std::floor((cameraPos.x - drift.x) / settings_.cellSize));
+    const int centerGZ = static_cast<int>(std::floor((cameraPos.z - drift.y) / settings_.cellSize));
+    if (!built_ || centerGX != builtGX_ || centerGZ != builtGZ_) {
+        rebuild(centerGX, centerGZ);
+    }
+    if (instances_.empty()) {
+        return;
+    }
+
+    glUseProgram(program_);
+    glUniform2f(uDrift_, drift.x, drift.y);
+    glUniform1f(uLayerY_, layerY);
+    glUniform1f(uCellSize_, settings_.cellSize);
+    glUniform1f(uRadius_, settings_.cellSize * settings_.quadRadius);
+    glUniform3f(uColor_, color.r, color.g, color.b);
+    glBindVertexArray(vao_);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(instances_.size()));
+}
+
+void CloudLayerRenderer::init() {
+    if (ready_) {
+        return;
+    }
+    const std::string vs = std::string("#version 330 core\n") + kSceneUniformBlockGlsl + R"(
+layout(location = 0) in vec2 aCorner;
+layout(location = 1) in vec2 aCell;
+uniform vec2 uDrift;
+uniform float uLayerY;
+uniform float uCellSize;
+uniform float uRadius;
+void main() {
+  vec2 centerXZ = aCell * uCellSize + uDrift;
+  vec3 worldPos = vec3(centerXZ.x + aCorner.x * uRadius, uLayerY, centerXZ.y + aCorner.y * uRadius);
+  gl_Position = uProj * uView * vec4(worldPos, 1.0);
+}
+)";
+    // Keep cloud tiles uniform so adjacent quads merge without visible seam patterns.
+    const char *fs = R"(
+#version 330 core
+uniform vec3 uColor;
+out vec4 FragColor;
+void main() {
+  FragColor = vec4(uColor, 0.82);
+}
+)";
+    program_ = app::util::linkInLineProgram(
+        app::util::compileInlineShader(GL_VERTEX_SHADER, vs.c_str()),
+        app::util::compileInlineShader(GL_FRAGMENT_SHADER, fs));
+    bindSceneUniformBlock(program_);
+    uDrift_ = glGetUniformLocation(program_, "uDrift");
+    uLayerY_ = glGetUniformLocation(program_, "uLayerY");
+    uCellSize_ = glGetUniformLocation(program_, "uCellSize");
+    uRadius_ = glGetUniformLocation(program_, "uRadius");
+    uColor_ = glGetUniformLocation(program_, "uColor");
+
+    const float quad[12] = {
+        -1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f,
+    };
+    glGenVertexArrays(1, &vao_);
+    glGenBuffers(1, &quadVbo_);
+    glGenBuffers(1, &instanceVbo_);
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, quadVbo_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVbo_);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), nullptr);
+    glVertexAttribDivisor(1, 1);
+    ready_ = true;
+}
+
+} // namespace gfx
@@ -0,0 +1,55 @@
+#include "gfx/HudGlyphCache.hpp"
+
+#include <stb_easy_font.h>
+
+#include <algorithm>
+
+namespace gfx {
+namespace {
+
+// stb_easy_font emits four of these per quad.
+struct StbVert {
+    float x;
+    float y;
+    float z;
+    unsigned char c[4];
+};
+
+constexpr std::size_t kScratchBytes = 99999;
+
+} // namespace
+
+HudGlyphCache::HudGlyphCache(std::size_t maxEntries)
+    : maxEntries_(std::max<std::size_t>(1, maxEntries)) {}
+
+const HudGlyphCache::Layout &HudGlyphCache::layout(std::string_view text) {
+    if (const auto it = layouts_.find(text); it != layouts_.end()) {
+        ++hits_;
+        return it->second;
+    }
+    ++misses_;
+    if (layouts_.size() >= maxEntries_) {
+        layouts_.clear();
+    }
+    if (scratch_.empty()) {
+        scratch_.resize(kScratchBytes);
+    }
+
+    std::string key(text);
+    unsigned char color[4] = {255, 255, 255, 255};
+    const int quads = stb_easy_font_print(0.0f, 0.0f, key.data(), color, scratch_.data(),
+                                          static_cast<int>(scratch_.size()));
+    Layout out;
+    out.quads.reserve(static_cast<std::size_t>(std::max(0, quads)));
+    const auto *verts = reinterpret_cast<const StbVert *>(scratch_.data());
+    for (int i = 0; i < quads; ++i) {
+        // Quads are axis-aligned: corner 0 is top-left, corner 2 bottom-right.
+        const StbVert &a = verts[i * 4 + 0];
+        const StbVert &c = verts[i * 4 + 2];
+        out.quads.push_back(Quad{a.x, a.y, c.x, c.y});
+    }
+    out.width = static_cast<float>(stb_easy_font_width(key.data()));
+    return layouts_.emplace(std::move(key), std::move(out)).first->second;
+}
+
+} // namespace gfx
@@ -11,7 +11,6 @@
 #include "voxel/Chunk.hpp"
 
 #include <glad/glad.h>
-#include <stb_easy_font.h>
 
 #include <glm/common.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -20,14 +19,88 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstring>
+#include <type_traits>
 #include <vector>
 
 namespace gfx {
 namespace {
 
-float textWidthPx(const std::string &text) {
-    return static_cast<float>(stb_easy_font_width(const_cast<char *>(text.c_str())));
-}
+// FNV-1a over the inputs a panel reads. Structs are fed field by field so
+// padding bytes never reach the hash.
+class InputHash {
+  public:
+    template <typename T> void add(const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        bytes(&value, sizeof(T));
+    }
+    template <typename T, std::size_t N> void add(const std::array<T, N> &values) {
+        for (const T &value : values) {
+            add(value);
+        }
+    }
+    void add(const std::string &text) {
+        add(text.size());
+        bytes(text.data(), text.size());
+    }
+    void add(const game::Inventory::Slot &slot) {
+        add(slot.id);
+        add(slot.count);
+    }
+    void add(const game::CraftingSystem::RecipeInfo::IngredientInfo &ingredient) {
+        add(ingredient.id);
+        add(ingredient.count);
+        add(ingredient.allowAnyWood);
+        add(ingredient.allowAnyPlanks);
+    }
+    void add(const game::CraftingSystem::RecipeInfo &recipe) {
+        add(recipe.label);
+        add(recipe.outputId);
+        add(recipe.outputCount);
+        add(recipe.minGridSize);
+        add(recipe.ingredients.size());
+        for (const auto &ingredient : recipe.ingredients) {
+            add(ingredient);
+        }
+        add(recipe.shapedCells.size());
+        for (const auto &cell : recipe.shapedCells) {
+            add(cell.slot);
+            add(cell.ingredient);
+        }
+    }
+    void add(const game::SmeltingSystem::Recipe &recipe) {
+        add(recipe.input);
+        add(recipe.output);
+        add(recipe.outputCount);
+    }
+    template <typename T> void addRange(const std::vector<T> &values) {
+        add(values.size());
+        for (const T &value : values) {
+            add(value);
+        }
+    }
+    void addRange(const std::vector<bool> &values) {
+        add(values.size());
+        for (const bool value : values) {
+            add(value);
+        }
+    }
+
+    std::uint64_t value() const {
+        return hash_;
+    }
+
+  private:
+    void bytes(const void *data, std::size_t size) {
+        const auto *p = static_cast<const unsigned char *>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash_ ^= p[i];
+            hash_ *= 1099511628211ull;
+        }
+    }
+
+    std::uint64_t hash_ = 1469598103934665603ull;
+};
 
 } // namespace
 
@@ -39,26 +112,41 @@ void HudRenderer::init2D() {
     const char *vs = R"(
 #version 330 core
 layout(location=0) in vec2 aPos;
-layout(location=1) in vec4 aColor;
+layout(location=1) in vec2 aUV;
+layout(location=2) in vec4 aColor;
 uniform vec2 uScreen;
+out vec2 vUV;
 out vec4 vColor;
 void main() {
   vec2 ndc = vec2((aPos.x / uScreen.x) * 2.0 - 1.0, 1.0 - (aPos.y / uScreen.y) * 2.0);
   gl_Position = vec4(ndc, 0.0, 1.0);
+  vUV = aUV;
   vColor = aColor;
 }
 )";
 
     const char *fs = R"(
 #version 330 core
+in vec2 vUV;
 in vec4 vColor;
+uniform sampler2D uAtlas;
 out vec4 FragColor;
-void main() { FragColor = vColor; }
+void main() {
+  if (vUV.x < 0.0) {
+    FragColor = vColor;
+    return;
+  }
+  vec4 c = texture(uAtlas, vUV);
+  if (c.a <= 0.01) discard;
+  FragColor = vec4(c.rgb * vColor.rgb, c.a * vColor.a);
+}
 )";
 
     uiShader_ = app::util::linkInLineProgram(
         app::util::compileInlineShader(GL_VERTEX_SHADER, vs),
         app::util::compileInlineShader(GL_FRAGMENT_SHADER, fs));
+    uiScreenLoc_ = glGetUniformLocation(uiShader_, "uScreen");
+    uiAtlasLoc_ = glGetUniformLocation(uiShader_, "uAtlas");
 
     glGenVertexArrays(1, &uiVao_);
     glGenBuffers(1, &uiVbo_);
@@ -68,8 +156,11 @@ void main() { FragColor = vColor; }
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(UiVertex), reinterpret_cast<void *>(0));
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(UiVertex),
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(UiVertex),
                           reinterpret_cast<void *>(2 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(UiVertex),
+                          reinterpret_cast<void *>(4 * sizeof(float)));
 
     uiReady_ = true;
 }
@@ -183,103 +274,57 @@ void main() {
     crackReady_ = true;
 }
 
-void HudRenderer::initIcons() {
-    if (iconReady_) {
-        return;
-    }
-
-    const char *vs = R"(
-#version 330 core
-layout(location=0) in vec2 aPos;
-layout(location=1) in vec2 aUV;
-layout(location=2) in float aLight;
-uniform vec2 uScreen;
-out vec2 vUV;
-out float vLight;
-void main() {
-  vec2 ndc = vec2((aPos.x / uScreen.x) * 2.0 - 1.0, 1.0 - (aPos.y / uScreen.y) * 2.0);
-  gl_Position = vec4(ndc, 0.0, 1.0);
-  vUV = aUV;
-  vLight = aLight;
-}
-)";
 
-    const char *fs = R"(
-#version 330 core
-in vec2 vUV;
-in float vLight;
-uniform sampler2D uAtlas;
-out vec4 FragColor;
-void main() {
-  vec4 c = texture(uAtlas, vUV);
-  if (c.a <= 0.01) discard;
-  FragColor = vec4(c.rgb * vLight, c.a);
-}
-)";
-
-    iconShader_ = app::util::linkInLineProgram(
-        app::util::compileInlineShader(GL_VERTEX_SHADER, vs),
-        app::util::compileInlineShader(GL_FRAGMENT_SHADER, fs));
-    glGenVertexArrays(1, &iconVao_);
-    glGenBuffers(1, &iconVbo_);
-    glBindVertexArray(iconVao_);
-    glBindBuffer(GL_ARRAY_BUFFER, iconVbo_);
-    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(IconVertex),
-                          reinterpret_cast<void *>(0));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(IconVertex),
-                          reinterpret_cast<void *>(2 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(IconVertex),
-                          reinterpret_cast<void *>(4 * sizeof(float)));
-    iconReady_ = true;
+bool HudRenderer::beginPanel(Panel panel, std::uint64_t key) {
+    activePanel_ = panel;
+    activeLayer_ = kLayerRects;
+    PanelCache &cache = panels_[panel];
+    if (cache.valid && cache.key == key) {
+        return false;
+    }
+    cache.key = key;
+    cache.valid = true;
+    for (std::vector<UiVertex> &verts : cache.layers) {
+        verts.clear();
+    }
+    cache.iconClips.clear();
+    cache.hoverSlots.clear();
+    firstDirtyPanel_ = std::min(firstDirtyPanel_, static_cast<int>(panel));
+    return true;
 }
 
 void HudRenderer::drawRect(float x, float y, float w, float h, float r, float g, float b, float a) {
-    const UiVertex v0{x, y, r, g, b, a};
-    const UiVertex v1{x + w, y, r, g, b, a};
-    const UiVertex v2{x + w, y + h, r, g, b, a};
-    const UiVertex v3{x, y + h, r, g, b, a};
-    verts_.push_back(v0);
-    verts_.push_back(v1);
-    verts_.push_back(v2);
-    verts_.push_back(v0);
-    verts_.push_back(v2);
-    verts_.push_back(v3);
+    const UiVertex v0{x, y, -1.0f, -1.0f, r, g, b, a};
+    const UiVertex v1{x + w, y, -1.0f, -1.0f, r, g, b, a};
+    const UiVertex v2{x + w, y + h, -1.0f, -1.0f, r, g, b, a};
+    const UiVertex v3{x, y + h, -1.0f, -1.0f, r, g, b, a};
+    std::vector<UiVertex> &out = layer(activeLayer_);
+    out.push_back(v0);
+    out.push_back(v1);
+    out.push_back(v2);
+    out.push_back(v0);
+    out.push_back(v2);
+    out.push_back(v3);
 }
 
 void HudRenderer::drawText(float x, float y, const std::string &text, unsigned char r,
                            unsigned char g, unsigned char b, unsigned char a) {
-    char buffer[99999];
-    unsigned char color[4] = {r, g, b, a};
-    const int quads =
-        stb_easy_font_print(x, y, const_cast<char *>(text.c_str()), color, buffer, sizeof(buffer));
-
-    struct StbVert {
-        float x;
-        float y;
-        float z;
-        unsigned char c[4];
-    };
-
-    const StbVert *q = reinterpret_cast<const StbVert *>(buffer);
-    for (int i = 0; i < quads; ++i) {
-        const StbVert &a0 = q[i * 4 + 0];
-        const StbVert &a1 = q[i * 4 + 1];
-        const StbVert &a2 = q[i * 4 + 2];
-        const StbVert &a3 = q[i * 4 + 3];
-        auto push = [&](const StbVert &v) {
-            verts_.push_back(UiVertex{v.x, v.y, v.c[0] / 255.0f, v.c[1] / 255.0f, v.c[2] / 255.0f,
-                                      v.c[3] / 255.0f});
-        };
-        push(a0);
-        push(a1);
-        push(a2);
-        push(a0);
-        push(a2);
-        push(a3);
+    const float cr = r / 255.0f;
+    const float cg = g / 255.0f;
+    const float cb = b / 255.0f;
+    const float ca = a / 255.0f;
+    std::vector<UiVertex> &out = layer(activeLayer_);
+    for (const HudGlyphCache::Quad &q : glyphs_.layout(text).quads) {
+        const float x0 = x + q.x0;
+        const float y0 = y + q.y0;
+        const float x1 = x + q.x1;
+        const float y1 = y + q.y1;
+        out.push_back(UiVertex{x0, y0, -1.0f, -1.0f, cr, cg, cb, ca});
+        out.push_back(UiVertex{x1, y0, -1.0f, -1.0f, cr, cg, cb, ca});
+        out.push_back(UiVertex{x1, y1, -1.0f, -1.0f, cr, cg, cb, ca});
+        out.push_back(UiVertex{x0, y0, -1.0f, -1.0f, cr, cg, cb, ca});
+        out.push_back(UiVertex{x1, y1, -1.0f, -1.0f, cr, cg, cb, ca});
+        out.push_back(UiVertex{x0, y1, -1.0f, -1.0f, cr, cg, cb, ca});
     }
 }
 
@@ -290,14 +335,14 @@ void HudRenderer::drawTooltipPanel(int width, int height, float uiScale, const s
     }
     const float padX = 8.0f * uiScale;
     const float tipH = 16.0f * uiScale;
-    const float tipW = textWidthPx(text) + padX * 2.0f;
+    const float tipW = glyphs_.width(text) + padX * 2.0f;
     const float tipX =
         std::clamp(rawX, 4.0f * uiScale, static_cast<float>(width) - tipW - 4.0f * uiScale);
     const float tipY =
         std::clamp(rawY, 4.0f * uiScale, static_cast<float>(height) - tipH - 4.0f * uiScale);
     drawRect(tipX, tipY, tipW, tipH, 0.04f, 0.06f, 0.08f, 0.90f);
     drawRect(tipX + 1.0f, tipY + 1.0f, tipW - 2.0f, tipH - 2.0f, 0.11f, 0.14f, 0.19f, 0.94f);
-    const float tx = tipX + (tipW - textWidthPx(text)) * 0.5f;
+    const float tx = tipX + (tipW - glyphs_.width(text)) * 0.5f;
     const float ty = tipY + (tipH - 8.0f) * 0.5f;
     drawText(tx + 1.0f, ty + 1.0f, text, 14, 16, 20, 220);
     drawText(tx, ty, text, 228, 234, 246, 255);
@@ -314,9 +359,9 @@ void HudRenderer::drawInfoPanel(float uiScale, float fps, const std::string &loo
     const float textH = 8.0f;
     const std::string fpsText =
         "FPS: " + std::to_string(static_cast<int>(std::lround(std::max(0.0f, fps))));
-    const float maxLineW = std::max(std::max(textWidthPx(lookedAtText), textWidthPx(modeText)),
-                                    std::max(std::max(textWidthPx(compassText), textWidthPx(biomeText)),
-                                             std::max(textWidthPx(coordText), textWidthPx(fpsText))));
+    const float maxLineW = std::max(std::max(glyphs_.width(lookedAtText), glyphs_.width(modeText)),
+                                    std::max(std::max(glyphs_.width(compassText), glyphs_.width(biomeText)),
+                                             std::max(glyphs_.width(coordText), glyphs_.width(fpsText))));
     const float panelW = maxLineW + panelPadX * 2.0f;
     const float panelH = panelPadY * 2.0f + textH + lineStep * 5.0f;
     drawRect(panelX, panelY, panelW, panelH, 0.03f, 0.04f, 0.05f, 0.58f);
@@ -332,83 +377,152 @@ void HudRenderer::drawInfoPanel(float uiScale, float fps, const std::string &loo
     drawText(panelX + panelPadX, panelY + panelPadY + lineStep * 5.0f, fpsText, 216, 222, 236, 255);
 }
 
-void HudRenderer::flushIconPass(int width, int height, const TextureAtlas &atlas,
-                                const std::vector<IconClipBatch> &iconClipBatches) {
-    glUseProgram(iconShader_);
-    glUniform2f(glGetUniformLocation(iconShader_, "uScreen"), static_cast<float>(width),
-                static_cast<float>(height));
-    glUniform1i(glGetUniformLocation(iconShader_, "uAtlas"), 0);
-    atlas.bind(0);
-    glBindVertexArray(iconVao_);
-    glBindBuffer(GL_ARRAY_BUFFER, iconVbo_);
-    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(iconVerts_.size() * sizeof(IconVertex)),
-                 iconVerts_.data(), GL_DYNAMIC_DRAW);
-    if (iconClipBatches.empty()) {
-        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(iconVerts_.size()));
-        return;
-    }
-
-    int viewport[4] = {0, 0, width, height};
-    glGetIntegerv(GL_VIEWPORT, viewport);
-    const float sx = (width > 0) ? (static_cast<float>(viewport[2]) / static_cast<float>(width)) : 1.0f;
-    const float sy =
-        (height > 0) ? (static_cast<float>(viewport[3]) / static_cast<float>(height)) : 1.0f;
-    std::size_t cursor = 0;
-    for (const IconClipBatch &batch : iconClipBatches) {
-        if (batch.start > cursor) {
-            glDrawArrays(GL_TRIANGLES, static_cast<GLint>(cursor),
-                         static_cast<GLsizei>(batch.start - cursor));
-        }
-        if (batch.count > 0) {
-            const int scX = viewport[0] + std::max(0, static_cast<int>(std::floor(batch.x * sx)));
-            const int scY = viewport[1] + std::max(0, static_cast<int>(std::floor(
-                                                      (static_cast<float>(height) - (batch.y + batch.h)) *
-                                                      sy)));
-            const int scW = std::max(0, static_cast<int>(std::ceil(batch.w * sx)));
-            const int scH = std::max(0, static_cast<int>(std::ceil(batch.h * sy)));
-            glEnable(GL_SCISSOR_TEST);
-            glScissor(scX, scY, scW, scH);
-            glDrawArrays(GL_TRIANGLES, static_cast<GLint>(batch.start),
-                         static_cast<GLsizei>(batch.count));
-            glDisable(GL_SCISSOR_TEST);
-        }
-        cursor = std::max(cursor, batch.start + batch.count);
-    }
-    if (cursor < iconVerts_.size()) {
-        glDrawArrays(GL_TRIANGLES, static_cast<GLint>(cursor),
-                     static_cast<GLsizei>(iconVerts_.size() - cursor));
-    }
-}
-
-void HudRenderer::drawLabelOverlay(int width, int height, float uiScale,
-                                   const std::vector<app::menus::RecipeNameLabel> &recipeNameLabels,
-                                   const std::vector<app::menus::SlotLabel> &slotLabels,
-                                   const app::menus::TooltipState &tooltip, bool suppressTooltip) {
-    verts_.clear();
+void HudRenderer::appendLabels(const std::vector<app::menus::RecipeNameLabel> &recipeNameLabels,
+                               const std::vector<app::menus::SlotLabel> &slotLabels) {
+    activeLayer_ = kLayerRecipeLabels;
     for (const app::menus::RecipeNameLabel &label : recipeNameLabels) {
         drawRect(label.x, label.y, label.w, label.h, 0.04f, 0.06f, 0.08f, 0.86f);
         drawRect(label.x + 1.0f, label.y + 1.0f, label.w - 2.0f, label.h - 2.0f, 0.11f, 0.14f, 0.19f,
                  0.92f);
-        const float textX = label.x + (label.w - textWidthPx(label.text)) * 0.5f;
+        const float textX = label.x + (label.w - glyphs_.width(label.text)) * 0.5f;
         const float textY = label.y + (label.h - 8.0f) * 0.5f;
         drawText(textX + 1.0f, textY + 1.0f, label.text, 14, 16, 20, 220);
         drawText(textX, textY, label.text, 228, 234, 246, 255);
     }
+    activeLayer_ = kLayerSlotLabels;
     for (const app::menus::SlotLabel &label : slotLabels) {
         drawText(label.x + 1.0f, label.y + 1.0f, label.text, 20, 20, 24, 220);
         drawText(label.x, label.y, label.text, 246, 247, 250, 255);
     }
-    if (!tooltip.text.empty() && !suppressTooltip) {
-        drawTooltipPanel(width, height, uiScale, tooltip.text, tooltip.x, tooltip.y);
+    activeLayer_ = kLayerRects;
+}
+
+void HudRenderer::uploadPanels() {
+    std::size_t total = 0;
+    std::size_t dirtyOffset = 0;
+    for (int p = 0; p < kPanelCount; ++p) {
+        if (p == firstDirtyPanel_) {
+            dirtyOffset = total;
+        }
+        for (const std::vector<UiVertex> &verts : panels_[p].layers) {
+            total += verts.size();
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, uiVbo_);
+    if (total > uiCapacity_) {
+        uiCapacity_ = std::max<std::size_t>({total, uiCapacity_ * 2, 4096});
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(uiCapacity_ * sizeof(UiVertex)),
+                     nullptr, GL_DYNAMIC_DRAW);
+        firstDirtyPanel_ = 0;
+        dirtyOffset = 0;
+    }
+    if (firstDirtyPanel_ >= kPanelCount) {
+        return;
+    }
+
+    // Clean panels ahead of the first dirty one keep their offsets, so only the
+    // tail of the buffer is rewritten.
+    staging_.clear();
+    for (int p = firstDirtyPanel_; p < kPanelCount; ++p) {
+        for (const std::vector<UiVertex> &verts : panels_[p].layers) {
+            staging_.insert(staging_.end(), verts.begin(), verts.end());
+        }
+    }
+    if (!staging_.empty()) {
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(dirtyOffset * sizeof(UiVertex)),
+                        static_cast<GLsizeiptr>(staging_.size() * sizeof(UiVertex)),
+                        staging_.data());
     }
+    firstDirtyPanel_ = kPanelCount;
+}
+
+void HudRenderer::drawPanels(int width, int height, const TextureAtlas &atlas) {
     glUseProgram(uiShader_);
-    glUniform2f(glGetUniformLocation(uiShader_, "uScreen"), static_cast<float>(width),
-                static_cast<float>(height));
+    glUniform2f(uiScreenLoc_, static_cast<float>(width), static_cast<float>(height));
+    glUniform1i(uiAtlasLoc_, 0);
+    atlas.bind(0);
     glBindVertexArray(uiVao_);
-    glBindBuffer(GL_ARRAY_BUFFER, uiVbo_);
-    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(verts_.size() * sizeof(UiVertex)),
-                 verts_.data(), GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(verts_.size()));
+
+    std::array<std::array<std::size_t, kLayerCount>, kPanelCount> base{};
+    std::size_t offset = 0;
+    for (int p = 0; p < kPanelCount; ++p) {
+        for (int l = 0; l < kLayerCount; ++l) {
+            base[p][l] = offset;
+            offset += panels_[p].layers[l].size();
+        }
+    }
+
+    int viewport[4] = {0, 0, width, height};
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    const float sx =
+        (width > 0) ? (static_cast<float>(viewport[2]) / static_cast<float>(width)) : 1.0f;
+    const float sy =
+        (height > 0) ? (static_cast<float>(viewport[3]) / static_cast<float>(height)) : 1.0f;
+
+    drawFirsts_.clear();
+    drawCounts_.clear();
+    const auto queue = [&](std::size_t first, std::size_t count) {
+        if (count == 0) {
+            return;
+        }
+        if (!drawFirsts_.empty() &&
+            static_cast<std::size_t>(drawFirsts_.back() + drawCounts_.back()) == first) {
+            drawCounts_.back() += static_cast<int>(count);
+            return;
+        }
+        drawFirsts_.push_back(static_cast<int>(first));
+        drawCounts_.push_back(static_cast<int>(count));
+    };
+    const auto flush = [&]() {
+        if (drawFirsts_.empty()) {
+            return;
+        }
+        glMultiDrawArrays(GL_TRIANGLES, drawFirsts_.data(), drawCounts_.data(),
+                          static_cast<GLsizei>(drawFirsts_.size()));
+        drawFirsts_.clear();
+        drawCounts_.clear();
+    };
+
+    // Layer-major order reproduces the immediate-mode pass order: all panels'
+    // rects, then icons, labels, tooltip and finally the dragged item.
+    for (int l = 0; l < kLayerCount; ++l) {
+        for (int p = 0; p < kPanelCount; ++p) {
+            const PanelCache &panel = panels_[p];
+            const std::size_t first = base[p][l];
+            const std::size_t count = panel.layers[l].size();
+            if (l != kLayerIcons || panel.iconClips.empty()) {
+                queue(first, count);
+                continue;
+            }
+            std::size_t cursor = 0;
+            for (const IconClipBatch &batch : panel.iconClips) {
+                if (batch.start > cursor) {
+                    queue(first + cursor, batch.start - cursor);
+                }
+                if (batch.count > 0) {
+                    flush();
+                    const float clipBottom = static_cast<float>(height) - (batch.y + batch.h);
+                    const int scX =
+                        viewport[0] + std::max(0, static_cast<int>(std::floor(batch.x * sx)));
+                    const int scY =
+                        viewport[1] + std::max(0, static_cast<int>(std::floor(clipBottom * sy)));
+                    const int scW = std::max(0, static_cast<int>(std::ceil(batch.w * sx)));
+                    const int scH = std::max(0, static_cast<int>(std::ceil(batch.h * sy)));
+                    glEnable(GL_SCISSOR_TEST);
+                    glScissor(scX, scY, scW, scH);
+                    glDrawArrays(GL_TRIANGLES, static_cast<GLint>(first + batch.start),
+                                 static_cast<GLsizei>(batch.count));
+                    glDisable(GL_SCISSOR_TEST);
+                }
+                cursor = std::max(cursor, batch.start + batch.count);
+            }
+            if (cursor < count) {
+                queue(first + cursor, count - cursor);
+            }
+        }
+    }
+    flush();
 }
 
 void HudRenderer::render2D(int width, int height, int selectedIndex,
@@ -443,40 +557,42 @@ void HudRenderer::render2D(int width, int height, int selectedIndex,
                            const std::string &coordText,
                            const voxel::BlockRegistry &registry, const TextureAtlas &atlas) {
     init2D();
-    initIcons();
-    verts_.clear();
-    iconVerts_.clear();
-    std::vector<IconClipBatch> iconClipBatches;
+    firstDirtyPanel_ = kPanelCount;
+    app::menus::TooltipState tooltip;
+    std::vector<app::menus::RecipeNameLabel> recipeNameLabels;
+    Layer iconLayer = kLayerIcons;
     auto beginIconClipBatch = [&](float x, float y, float w, float h) {
-        iconClipBatches.push_back({iconVerts_.size(), 0, x, y, w, h});
-        return iconClipBatches.size() - 1;
+        std::vector<IconClipBatch> &clips = panels_[activePanel_].iconClips;
+        clips.push_back({layer(kLayerIcons).size(), 0, x, y, w, h});
+        return clips.size() - 1;
     };
     auto endIconClipBatch = [&](std::size_t batchIndex) {
-        if (batchIndex < iconClipBatches.size()) {
-            iconClipBatches[batchIndex].count = iconVerts_.size() - iconClipBatches[batchIndex].start;
+        std::vector<IconClipBatch> &clips = panels_[activePanel_].iconClips;
+        if (batchIndex < clips.size()) {
+            clips[batchIndex].count = layer(kLayerIcons).size() - clips[batchIndex].start;
         }
     };
-    app::menus::TooltipState tooltip;
-    std::vector<app::menus::RecipeNameLabel> recipeNameLabels;
-    app::menus::DragIconState dragIcon;
     auto appendItemIcon = [&](float x0, float y0, float x1, float y1, const glm::vec4 &uv,
                               float light) {
-        iconVerts_.push_back({x0, y0, uv.x, uv.y, light});
-        iconVerts_.push_back({x1, y0, uv.z, uv.y, light});
-        iconVerts_.push_back({x1, y1, uv.z, uv.w, light});
-        iconVerts_.push_back({x0, y0, uv.x, uv.y, light});
-        iconVerts_.push_back({x1, y1, uv.z, uv.w, light});
-        iconVerts_.push_back({x0, y1, uv.x, uv.w, light});
+        std::vector<UiVertex> &out = layer(iconLayer);
+        out.push_back({x0, y0, uv.x, uv.y, light, light, light, 1.0f});
+        out.push_back({x1, y0, uv.z, uv.y, light, light, light, 1.0f});
+        out.push_back({x1, y1, uv.z, uv.w, light, light, light, 1.0f});
+        out.push_back({x0, y0, uv.x, uv.y, light, light, light, 1.0f});
+        out.push_back({x1, y1, uv.z, uv.w, light, light, light, 1.0f});
+        out.push_back({x0, y1, uv.x, uv.w, light, light, light, 1.0f});
     };
     auto appendSkewQuad = [&](const glm::vec2 &a, const glm::vec2 &b, const glm::vec2 &c,
                               const glm::vec2 &d, const glm::vec4 &uv, float light) {
-        iconVerts_.push_back({a.x, a.y, uv.x, uv.y, light});
-        iconVerts_.push_back({b.x, b.y, uv.z, uv.y, light});
-        iconVerts_.push_back({c.x, c.y, uv.z, uv.w, light});
-        iconVerts_.push_back({a.x, a.y, uv.x, uv.y, light});
-        iconVerts_.push_back({c.x, c.y, uv.z, uv.w, light});
-        iconVerts_.push_back({d.x, d.y, uv.x, uv.w, light});
+        std::vector<UiVertex> &out = layer(iconLayer);
+        out.push_back({a.x, a.y, uv.x, uv.y, light, light, light, 1.0f});
+        out.push_back({b.x, b.y, uv.z, uv.y, light, light, light, 1.0f});
+        out.push_back({c.x, c.y, uv.z, uv.w, light, light, light, 1.0f});
+        out.push_back({a.x, a.y, uv.x, uv.y, light, light, light, 1.0f});
+        out.push_back({c.x, c.y, uv.z, uv.w, light, light, light, 1.0f});
+        out.push_back({d.x, d.y, uv.x, uv.w, light, light, light, 1.0f});
     };
+    const auto textWidth = [this](const std::string &text) { return glyphs_.width(text); };
     auto appendCubeIcon = [&](float x, float y, float w, float h, const voxel::BlockDef &def) {
         const glm::vec4 uvTop = atlas.uvRect(def.topTile);
         const glm::vec4 uvSide = atlas.uvRect(def.sideTile);
@@ -546,6 +662,73 @@ void HudRenderer::render2D(int width, int height, int selectedIndex,
         tooltip.x = cursorX + 12.0f * uiScale;
         tooltip.y = cursorY - 8.0f * uiScale;
     };
+    auto markSlot = [&](int index, float x, float y, float size, voxel::BlockId id, int count) {
+        panels_[activePanel_].hoverSlots.push_back(HoverSlot{index, x, y, size, id, count});
+    };
+    auto drawSlotFrame = [&](float sx, float sy, float size) {
+        drawRect(sx + 2.0f, sy + 2.0f, size, size, 0.0f, 0.0f, 0.0f, 0.32f);
+        drawRect(sx, sy, size, size, 0.09f, 0.10f, 0.12f, 0.88f);
+        drawRect(sx + 2.0f, sy + 2.0f, size - 4.0f, size - 4.0f, 0.16f, 0.17f, 0.20f, 0.76f);
+    };
+    auto drawRectClipped = [&](float x, float y, float w, float h, float cx0, float cy0,
+                               float cx1, float cy1, float r, float g, float b, float a) {
+        const float x0 = std::max(x, cx0);
+        const float y0 = std::max(y, cy0);
+        const float x1 = std::min(x + w, cx1);
+        const float y1 = std::min(y + h, cy1);
+        if (x1 <= x0 || y1 <= y0) {
+            return;
+        }
+        drawRect(x0, y0, x1 - x0, y1 - y0, r, g, b, a);
+    };
+    auto drawTextClipped = [&](float x, float y, const std::string &text, float cx0, float cy0,
+                               float cx1, float cy1, unsigned char r, unsigned char g,
+                               unsigned char b, unsigned char a) {
+        const float cr = r / 255.0f;
+        const float cg = g / 255.0f;
+        const float cb = b / 255.0f;
+        const float ca = a / 255.0f;
+        std::vector<UiVertex> &out = layer(activeLayer_);
+        for (const HudGlyphCache::Quad &q : glyphs_.layout(text).quads) {
+            const float x0 = std::max(x + q.x0, cx0);
+            const float y0 = std::max(y + q.y0, cy0);
+            const float x1 = std::min(x + q.x1, cx1);
+            const float y1 = std::min(y + q.y1, cy1);
+            if (x1 <= x0 || y1 <= y0) {
+                continue;
+            }
+            out.push_back(UiVertex{x0, y0, -1.0f, -1.0f, cr, cg, cb, ca});
+            out.push_back(UiVertex{x1, y0, -1.0f, -1.0f, cr, cg, cb, ca});
+            out.push_back(UiVertex{x1, y1, -1.0f, -1.0f, cr, cg, cb, ca});
+            out.push_back(UiVertex{x0, y0, -1.0f, -1.0f, cr, cg, cb, ca});
+            out.push_back(UiVertex{x1, y1, -1.0f, -1.0f, cr, cg, cb, ca});
+            out.push_back(UiVertex{x0, y1, -1.0f, -1.0f, cr, cg, cb, ca});
+        }
+    };
+    static app::menus::CreativeMenu creativeMenu;
+    static app::menus::RecipeMenu recipeMenu;
+    const app::menus::HudDrawContext drawCtx{
+        [&](float x, float y, float w, float h, float r, float g, float b, float a) {
+            drawRect(x, y, w, h, r, g, b, a);
+        },
+        [&](float x, float y, const std::string &text, unsigned char r, unsigned char g,
+            unsigned char b, unsigned char a) { drawText(x, y, text, r, g, b, a); },
+        drawHoverOutline,
+        drawValidHintOutline,
+        drawSlotFrame,
+        drawRectClipped,
+        drawTextClipped,
+        [&](float x0, float y0, float x1, float y1, voxel::BlockId id, float light) {
+            const glm::vec4 uv = atlas.uvRect(registry.get(id).sideTile);
+            appendItemIcon(x0, y0, x1, y1, uv, light);
+        },
+        appendCubeIcon,
+        beginIconClipBatch,
+        endIconClipBatch,
+        textWidth,
+        isFlatItemId,
+        markSlot,
+    };
     const float kArmGap = 3.0f * uiScale;
     const float kArmLen = 6.0f * uiScale;
     const float kArmThick = 2.0f * uiScale;
@@ -570,8 +753,6 @@ void HudRenderer::render2D(int width, int height, int selectedIndex,
                  0.96f);
         drawRect(cx - 1.0f, cy - 1.0f, 2.0f, 2.0f, 1.0f, 1.0f, 1.0f, 0.98f);
     };
-    renderCrosshair();
-
     const float slot = 48.0f * uiScale;
     const float gap = 10.0f * uiScale;
     const float totalW =
@@ -600,7 +781,7 @@ void HudRenderer::render2D(int width, int height, int selectedIndex,
         }
         const int healthPct = static_cast<int>(std::round(healthFill * 100.0f));
         const std::string healthText = std::to_string(healthPct) + "%";
-        const float healthTextX = healthBarX + sideBarW * 0.5f - textWidthPx(healthText) * 0.5f;
+        const float healthTextX = healthBarX + sideBarW * 0.5f - glyphs_.width(healthText) * 0.5f;
         const float healthTextY = staminaBarY - 11.0f;
         drawText(healthTextX + 1.0f, healthTextY + 1.0f, healthText, 12, 8, 8, 220);
         drawText(healthTextX, healthTextY, healthText, 248, 206, 202, 255);
@@ -615,7 +796,7 @@ void HudRenderer::render2D(int width, int height, int selectedIndex,
         }
         const int staminaPct = static_cast<int>(std::round(staminaFill * 100.0f));
         const std::string staminaText = std::to_string(staminaPct) + "%";
-        const float staminaTextX = staminaBarX + sideBarW * 0.5f - textWidthPx(staminaText) * 0.5f;
+        const float staminaTextX = staminaBarX + sideBarW * 0.5f - glyphs_.width(staminaText) * 0.5f;
         const float staminaTextY = staminaBarY - 11.0f;
         drawText(staminaTextX + 1.0f, staminaTextY + 1.0f, staminaText, 12, 10, 8, 220);
         drawText(staminaTextX, staminaTextY, staminaText, 245, 224, 178, 255);
@@ -643,9 +824,8 @@ void HudRenderer::render2D(int width, int height, int selectedIndex,
             if (!showInventory && i == selectedIndex) {
                 drawSelectedOutline(x, y0, slot);
             }
-            if (showInventory && hoveredSlotIndex == i) {
-                drawHoverOutline(x, y0, slot);
-                setHoverTip(hotbar[i], hotbarCounts[i]);
+            if (showInventory) {
+                markSlot(i, x, y0, slot, hotbar[i], hotbarCounts[i]);
             }
             if (showInventory && hotbarCounts[i] > 0 &&
                 ((hintFurnaceInput && smeltRules.canSmelt(hotbar[i])) ||
@@ -665,8 +845,6 @@ void HudRenderer::render2D(int width, int height, int selectedIndex,
                  "1-9 Select  |  LMB Mine  |  RMB Place  |  E Inventory  |  F Creative  |  F2 HUD",
                  200, 206, 222, 255);
     };
-    renderHotbar();
-
     auto renderInventoryBody = [&]() {
         const int cols = game::Inventory::kColumns;
         const int rows =
@@ -733,43 +911,15 @@ void HudRenderer::render2D(int width, int height, int selectedIndex,
                      236, 248, 255);
         }
 
-        auto drawSlotFrame = [&](float sx, float sy, float size) {
-            drawRect(sx + 2.0f, sy + 2.0f, size, size, 0.0f, 0.0f, 0.0f, 0.32f);
-            drawRect(sx, sy, size, size, 0.09f, 0.10f, 0.12f, 0.88f);
-            drawRect(sx + 2.0f, sy + 2.0f, size - 4.0f, size - 4.0f, 0.16f, 0.17f, 0.20f, 0.76f);
-        };
-
-        const app::menus::HudDrawContext panelDrawCtx{
-            [&](float x, float y, float w, float h, float r, float g, float b, float a) {
-                drawRect(x, y, w, h, r, g, b, a);
-            },
-            [&](float x, float y, const std::string &text, unsigned char r, unsigned char g,
-                unsigned char b, unsigned char a) { drawText(x, y, text, r, g, b, a); },
-            drawHoverOutline,
-            drawValidHintOutline,
-            drawSlotFrame,
-            {},
-            {},
-            [&](float x0, float y0, float x1, float y1, voxel::BlockId id, float light) {
-                const glm::vec4 uv = atlas.uvRect(registry.get(id).sideTile);
-                appendItemIcon(x0, y0, x1, y1, uv, light);
-            },
-            appendCubeIcon,
-            {},
-            {},
-            textWidthPx,
-            isFlatItemId,
-        };
         static app::menus::CraftingMenu craftingMenu;
         static app::menus::FurnaceMenu furnaceMenu;
         if (usingFurnace) {
-            furnaceMenu.renderPanel(width, height, uiScale, hoveredSlotIndex, craftingGridSize,
-                                    smeltInput, smeltFuel, smeltOutput, smeltProgress01,
-                                    smeltFuel01, registry, panelDrawCtx, slotLabels, setHoverTip);
+            furnaceMenu.renderPanel(width, height, uiScale, craftingGridSize, smeltInput, smeltFuel,
+                                    smeltOutput, smeltProgress01, smeltFuel01, registry, drawCtx,
+                                    slotLabels);
         } else {
-            craftingMenu.renderPanel(width, height, uiScale, usingCraftingTable, hoveredSlotIndex,
-                                     craftingGridSize, craftInput, craftOutput, registry, panelDrawCtx,
-                                     slotLabels, setHoverTip);
+            craftingMenu.renderPanel(width, height, uiScale, usingCraftingTable, craftingGridSize,
+                                     craftInput, craftOutput, registry, drawCtx, slotLabels);
         }
 
         for (int row = 0; row < rows; ++row) {
@@ -801,10 +951,7 @@ void HudRenderer::render2D(int width, int height, int selectedIndex,
                     slotLabels.push_back(
                         app::menus::SlotLabel{sx + 5.0f, sy + invSlot - 13.0f, std::to_string(count)});
                 }
-                if (hoveredSlotIndex == slotIndex) {
-                    drawHoverOutline(sx, sy, invSlot);
-                    setHoverTip(allIds[slotIndex], allCounts[slotIndex]);
-                }
+                markSlot(slotIndex, sx, sy, invSlot, allIds[slotIndex], allCounts[slotIndex]);
                 if (showInventory && allCounts[slotIndex] > 0 &&
                     ((hintFurnaceInput && smeltRules.canSmelt(allIds[slotIndex])) ||
                      (hintFurnaceFuel && smeltRules.isFuel(allIds[slotIndex])))) {
@@ -813,172 +960,234 @@ void HudRenderer::render2D(int width, int height, int selectedIndex,
             }
         }
 
-        if (carryingCount > 0 && carryingId != voxel::AIR) {
-            const float dragSize = 34.0f * uiScale;
-            const float dx = cursorX + 10.0f * uiScale;
-            const float dy = cursorY + 8.0f * uiScale;
-            dragIcon.active = true;
-            dragIcon.id = carryingId;
-            dragIcon.count = carryingCount;
-            dragIcon.x = dx;
-            dragIcon.y = dy;
-            dragIcon.size = dragSize;
-            dragIcon.name = carryingName;
-        }
-
-        auto drawRectClipped = [&](float x, float y, float w, float h, float cx0, float cy0,
-                                   float cx1, float cy1, float r, float g, float b, float a) {
-            const float x0 = std::max(x, cx0);
-            const float y0 = std::max(y, cy0);
-            const float x1 = std::min(x + w, cx1);
-            const float y1 = std::min(y + h, cy1);
-            if (x1 <= x0 || y1 <= y0) {
-                return;
-            }
-            drawRect(x0, y0, x1 - x0, y1 - y0, r, g, b, a);
-        };
-        auto drawTextClipped = [&](float x, float y, const std::string &text, float cx0, float cy0,
-                                   float cx1, float cy1, unsigned char r, unsigned char g,
-                                   unsigned char b, unsigned char a) {
-            char buffer[99999];
-            unsigned char color[4] = {r, g, b, a};
-            const int quads =
-                stb_easy_font_print(x, y, const_cast<char *>(text.c_str()), color, buffer, sizeof(buffer));
-            struct StbVert {
-                float x;
-                float y;
-                float z;
-                unsigned char c[4];
-            };
-            const StbVert *q = reinterpret_cast<const StbVert *>(buffer);
-            for (int i = 0; i < quads; ++i) {
-                const StbVert &a0 = q[i * 4 + 0];
-                const StbVert &a2 = q[i * 4 + 2];
-                const float x0 = std::max(a0.x, cx0);
-                const float y0 = std::max(a0.y, cy0);
-                const float x1 = std::min(a2.x, cx1);
-                const float y1 = std::min(a2.y, cy1);
-                if (x1 <= x0 || y1 <= y0) {
-                    continue;
-                }
-                const float cr = r / 255.0f;
-                const float cg = g / 255.0f;
-                const float cb = b / 255.0f;
-                const float ca = a / 255.0f;
-                verts_.push_back(UiVertex{x0, y0, cr, cg, cb, ca});
-                verts_.push_back(UiVertex{x1, y0, cr, cg, cb, ca});
-                verts_.push_back(UiVertex{x1, y1, cr, cg, cb, ca});
-                verts_.push_back(UiVertex{x0, y0, cr, cg, cb, ca});
-                verts_.push_back(UiVertex{x1, y1, cr, cg, cb, ca});
-                verts_.push_back(UiVertex{x0, y1, cr, cg, cb, ca});
-            }
-        };
-        static app::menus::CreativeMenu creativeMenu;
-        static app::menus::RecipeMenu recipeMenu;
-        const app::menus::HudDrawContext drawCtx{
-            [&](float x, float y, float w, float h, float r, float g, float b, float a) {
-                drawRect(x, y, w, h, r, g, b, a);
-            },
-            [&](float x, float y, const std::string &text, unsigned char r, unsigned char g,
-                unsigned char b, unsigned char a) { drawText(x, y, text, r, g, b, a); },
-            drawHoverOutline,
-            drawValidHintOutline,
-            drawSlotFrame,
-            drawRectClipped,
-            drawTextClipped,
-            [&](float x0, float y0, float x1, float y1, voxel::BlockId id, float light) {
-                const glm::vec4 uv = atlas.uvRect(registry.get(id).sideTile);
-                appendItemIcon(x0, y0, x1, y1, uv, light);
-            },
-            appendCubeIcon,
-            beginIconClipBatch,
-            endIconClipBatch,
-            textWidthPx,
-            isFlatItemId,
-        };
         if (showCreativeMenu) {
-            creativeMenu.renderOverlay(width, height, uiScale, craftingGridSize, usingFurnace, cursorX,
-                                       cursorY, creativeScroll, uiTimeSeconds, creativeSearch,
-                                       creativeItems, registry, drawCtx, tooltip);
+            creativeMenu.renderOverlay(width, height, uiScale, craftingGridSize, usingFurnace,
+                                       creativeScroll, creativeSearch, creativeItems, registry,
+                                       drawCtx);
         }
         if (showRecipeMenu) {
-            recipeMenu.renderOverlay(width, height, uiScale, craftingGridSize, usingFurnace, cursorX,
-                                     cursorY, recipeScroll, uiTimeSeconds, recipeSearch,
-                                     recipeCraftableOnly, recipeIngredientFilter, recipes,
-                                     smeltingRecipes, recipeCraftable, registry, drawCtx,
-                                     recipeNameLabels, tooltip);
+            recipeMenu.renderOverlay(width, height, uiScale, craftingGridSize, usingFurnace,
+                                     recipeScroll, recipeSearch, recipeCraftableOnly,
+                                     recipeIngredientFilter, recipes, smeltingRecipes,
+                                     recipeCraftable, registry, drawCtx, recipeNameLabels);
         }
     };
-    if (showInventory) {
-        renderInventoryBody();
+
+    // Drag state only depends on the carried stack and the cursor, so it is
+    // resolved up front instead of inside the (possibly cached) inventory panel.
+    app::menus::DragIconState dragIcon;
+    if (showInventory && isDraggingItem) {
+        dragIcon.active = true;
+        dragIcon.id = carryingId;
+        dragIcon.count = carryingCount;
+        dragIcon.x = cursorX + 10.0f * uiScale;
+        dragIcon.y = cursorY + 8.0f * uiScale;
+        dragIcon.size = 34.0f * uiScale;
+        dragIcon.name = carryingName;
     }
+    const auto registryId = reinterpret_cast<std::uintptr_t>(&registry);
+    const auto atlasId = reinterpret_cast<std::uintptr_t>(&atlas);
+    const auto finishPanel = [&](std::vector<app::menus::SlotLabel> &labels) {
+        appendLabels(recipeNameLabels, labels);
+        recipeNameLabels.clear();
+        labels.clear();
+    };
 
-    drawInfoPanel(uiScale, fps, lookedAtText, modeText, compassText, biomeText, coordText);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_DEPTH_TEST);
+    InputHash hotbarKey;
+    hotbarKey.add(width);
+    hotbarKey.add(height);
+    hotbarKey.add(uiScale);
+    hotbarKey.add(showInventory);
+    hotbarKey.add(selectedIndex);
+    hotbarKey.add(hotbar);
+    hotbarKey.add(hotbarCounts);
+    hotbarKey.add(healthFill);
+    hotbarKey.add(staminaFill);
+    hotbarKey.add(hintFurnaceInput);
+    hotbarKey.add(hintFurnaceFuel);
+    hotbarKey.add(registryId);
+    hotbarKey.add(atlasId);
+    if (beginPanel(kPanelHotbar, hotbarKey.value())) {
+        renderCrosshair();
+        renderHotbar();
+        finishPanel(slotLabels);
+    }
 
-    glUseProgram(uiShader_);
-    glUniform2f(glGetUniformLocation(uiShader_, "uScreen"), static_cast<float>(width),
-                static_cast<float>(height));
-    glBindVertexArray(uiVao_);
-    glBindBuffer(GL_ARRAY_BUFFER, uiVbo_);
-    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(verts_.size() * sizeof(UiVertex)),
-                 verts_.data(), GL_DYNAMIC_DRAW);
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(verts_.size()));
-
-    flushIconPass(width, height, atlas, iconClipBatches);
-    drawLabelOverlay(width, height, uiScale, recipeNameLabels, slotLabels, tooltip, dragIcon.active);
-
-    if (dragIcon.active && dragIcon.id != voxel::AIR && dragIcon.count > 0) {
-        verts_.clear();
-        drawRect(dragIcon.x - 4.0f * uiScale, dragIcon.y - 3.0f * uiScale, dragIcon.size + 8.0f * uiScale,
-                 dragIcon.size + 8.0f * uiScale, 0.0f, 0.0f, 0.0f, 0.38f);
-        drawRect(dragIcon.x - 1.0f * uiScale, dragIcon.y - 1.0f * uiScale, dragIcon.size + 2.0f * uiScale,
-                 dragIcon.size + 2.0f * uiScale, 0.08f, 0.10f, 0.12f, 0.92f);
-        drawRect(dragIcon.x, dragIcon.y, dragIcon.size, dragIcon.size, 0.16f, 0.18f, 0.22f, 0.78f);
-
-        const std::string dragCountText = std::to_string(dragIcon.count);
-        const float chipW = textWidthPx(dragCountText) + 8.0f * uiScale;
-        const float chipH = 12.0f * uiScale;
-        const float chipX = dragIcon.x + dragIcon.size - chipW + 2.0f * uiScale;
-        const float chipY = dragIcon.y + dragIcon.size - chipH + 1.0f * uiScale;
-        drawRect(chipX, chipY, chipW, chipH, 0.04f, 0.06f, 0.08f, 0.92f);
-        drawRect(chipX + 1.0f, chipY + 1.0f, chipW - 2.0f, chipH - 2.0f, 0.12f, 0.15f, 0.20f, 0.95f);
-        const float countTx = chipX + (chipW - textWidthPx(dragCountText)) * 0.5f;
-        const float countTy = chipY + (chipH - 8.0f) * 0.5f;
-        drawText(countTx + 1.0f, countTy + 1.0f, dragCountText, 16, 18, 22, 220);
-        drawText(countTx, countTy, dragCountText, 238, 244, 252, 255);
-
-        if (!dragIcon.name.empty()) {
-            drawTooltipPanel(width, height, uiScale, dragIcon.name, dragIcon.x,
-                             dragIcon.y - 18.0f * uiScale);
+    InputHash inventoryKey;
+    inventoryKey.add(width);
+    inventoryKey.add(height);
+    inventoryKey.add(uiScale);
+    inventoryKey.add(showInventory);
+    if (showInventory) {
+        inventoryKey.add(hintFurnaceInput);
+        inventoryKey.add(hintFurnaceFuel);
+        inventoryKey.add(allIds);
+        inventoryKey.add(allCounts);
+        inventoryKey.add(craftInput);
+        inventoryKey.add(craftOutput);
+        inventoryKey.add(craftingGridSize);
+        inventoryKey.add(usingCraftingTable);
+        inventoryKey.add(usingFurnace);
+        inventoryKey.add(smeltInput);
+        inventoryKey.add(smeltFuel);
+        inventoryKey.add(smeltOutput);
+        inventoryKey.add(smeltProgress01);
+        inventoryKey.add(smeltFuel01);
+        inventoryKey.add(showRecipeMenu);
+        inventoryKey.add(showCreativeMenu);
+        inventoryKey.add(registryId);
+        inventoryKey.add(atlasId);
+        if (showRecipeMenu) {
+            inventoryKey.addRange(recipes);
+            inventoryKey.addRange(smeltingRecipes);
+            inventoryKey.addRange(recipeCraftable);
+            inventoryKey.add(recipeScroll);
+            inventoryKey.add(recipeSearch);
+            inventoryKey.add(recipeCraftableOnly);
+            inventoryKey.add(recipeIngredientFilter.has_value());
+            inventoryKey.add(recipeIngredientFilter.value_or(voxel::AIR));
         }
-        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(verts_.size() * sizeof(UiVertex)),
-                     verts_.data(), GL_DYNAMIC_DRAW);
-        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(verts_.size()));
-
-        iconVerts_.clear();
-        const voxel::BlockDef &dragDef = registry.get(dragIcon.id);
-        if (isFlatItemId(dragIcon.id)) {
-            const glm::vec4 uv = atlas.uvRect(dragDef.sideTile);
-            appendItemIcon(dragIcon.x, dragIcon.y, dragIcon.x + dragIcon.size, dragIcon.y + dragIcon.size, uv,
-                           1.0f);
-        } else {
-            appendCubeIcon(dragIcon.x, dragIcon.y, dragIcon.size, dragIcon.size, dragDef);
+        if (showCreativeMenu) {
+            inventoryKey.addRange(creativeItems);
+            inventoryKey.add(creativeScroll);
+            inventoryKey.add(creativeSearch);
+        }
+    }
+    if (beginPanel(kPanelInventory, inventoryKey.value())) {
+        if (showInventory) {
+            renderInventoryBody();
+        }
+        finishPanel(slotLabels);
+    }
+
+    // Hover state lives on the overlay so the panels above only rebuild when
+    // their contents change. Slot geometry comes from what they recorded.
+    HoverSlot hovered;
+    if (showInventory) {
+        for (const int panel : {kPanelHotbar, kPanelInventory}) {
+            for (const HoverSlot &candidate : panels_[panel].hoverSlots) {
+                if (candidate.index == hoveredSlotIndex) {
+                    hovered = candidate;
+                }
+            }
+        }
+    }
+    const bool menuOpen = showInventory && (showRecipeMenu || showCreativeMenu);
+    const bool slotTip = !isDraggingItem && hovered.id != voxel::AIR && hovered.count > 0;
+    InputHash overlayKey;
+    overlayKey.add(width);
+    overlayKey.add(height);
+    overlayKey.add(uiScale);
+    overlayKey.add(showInventory);
+    overlayKey.add(dragIcon.active);
+    if (dragIcon.active) {
+        overlayKey.add(dragIcon.id);
+        overlayKey.add(dragIcon.count);
+        overlayKey.add(dragIcon.x);
+        overlayKey.add(dragIcon.y);
+        overlayKey.add(dragIcon.name);
+        overlayKey.add(registryId);
+        overlayKey.add(atlasId);
+    }
+    overlayKey.add(hotbarKey.value());
+    overlayKey.add(inventoryKey.value());
+    overlayKey.add(hovered.index);
+    overlayKey.add(hovered.x);
+    overlayKey.add(hovered.y);
+    overlayKey.add(hovered.size);
+    overlayKey.add(hovered.id);
+    overlayKey.add(hovered.count);
+    if (slotTip || menuOpen) {
+        overlayKey.add(cursorX);
+        overlayKey.add(cursorY);
+    }
+    if (menuOpen) {
+        const float menuTime = std::max(0.0f, uiTimeSeconds);
+        overlayKey.add(std::floor(menuTime * app::menus::kMenuBlinkStepsPerSecond));
+        if (showRecipeMenu) {
+            overlayKey.add(std::floor(menuTime * app::menus::kMenuCycleStepsPerSecond));
+        }
+    }
+    if (beginPanel(kPanelOverlay, overlayKey.value())) {
+        if (hovered.index >= 0) {
+            drawHoverOutline(hovered.x, hovered.y, hovered.size);
+            setHoverTip(hovered.id, hovered.count);
+        }
+        if (showInventory && showCreativeMenu) {
+            creativeMenu.renderHover(width, height, uiScale, craftingGridSize, usingFurnace,
+                                     cursorX, cursorY, creativeScroll, uiTimeSeconds,
+                                     creativeSearch, creativeItems, drawCtx, tooltip);
         }
-        glUseProgram(iconShader_);
-        glUniform2f(glGetUniformLocation(iconShader_, "uScreen"), static_cast<float>(width),
-                    static_cast<float>(height));
-        glUniform1i(glGetUniformLocation(iconShader_, "uAtlas"), 0);
-        atlas.bind(0);
-        glBindVertexArray(iconVao_);
-        glBindBuffer(GL_ARRAY_BUFFER, iconVbo_);
-        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(iconVerts_.size() * sizeof(IconVertex)),
-                     iconVerts_.data(), GL_DYNAMIC_DRAW);
-        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(iconVerts_.size()));
+        if (showInventory && showRecipeMenu) {
+            recipeMenu.renderHover(width, height, uiScale, craftingGridSize, usingFurnace, cursorX,
+                                   cursorY, recipeScroll, uiTimeSeconds, recipeSearch, recipes,
+                                   smeltingRecipes, registry, drawCtx, tooltip);
+        }
+        if (!dragIcon.active && !tooltip.text.empty()) {
+            activeLayer_ = kLayerTooltip;
+            drawTooltipPanel(width, height, uiScale, tooltip.text, tooltip.x, tooltip.y);
+        }
+        if (dragIcon.active && dragIcon.id != voxel::AIR && dragIcon.count > 0) {
+            activeLayer_ = kLayerDragRects;
+            drawRect(dragIcon.x - 4.0f * uiScale, dragIcon.y - 3.0f * uiScale,
+                     dragIcon.size + 8.0f * uiScale, dragIcon.size + 8.0f * uiScale, 0.0f, 0.0f,
+                     0.0f, 0.38f);
+            drawRect(dragIcon.x - 1.0f * uiScale, dragIcon.y - 1.0f * uiScale,
+                     dragIcon.size + 2.0f * uiScale, dragIcon.size + 2.0f * uiScale, 0.08f, 0.10f,
+                     0.12f, 0.92f);
+            drawRect(dragIcon.x, dragIcon.y, dragIcon.size, dragIcon.size, 0.16f, 0.18f, 0.22f,
+                     0.78f);
+
+            const std::string dragCountText = std::to_string(dragIcon.count);
+            const float chipW = glyphs_.width(dragCountText) + 8.0f * uiScale;
+            const float chipH = 12.0f * uiScale;
+            const float chipX = dragIcon.x + dragIcon.size - chipW + 2.0f * uiScale;
+            const float chipY = dragIcon.y + dragIcon.size - chipH + 1.0f * uiScale;
+            drawRect(chipX, chipY, chipW, chipH, 0.04f, 0.06f, 0.08f, 0.92f);
+            drawRect(chipX + 1.0f, chipY + 1.0f, chipW - 2.0f, chipH - 2.0f, 0.12f, 0.15f, 0.20f,
+                     0.95f);
+            const float countTx = chipX + (chipW - glyphs_.width(dragCountText)) * 0.5f;
+            const float countTy = chipY + (chipH - 8.0f) * 0.5f;
+            drawText(countTx + 1.0f, countTy + 1.0f, dragCountText, 16, 18, 22, 220);
+            drawText(countTx, countTy, dragCountText, 238, 244, 252, 255);
+
+            if (!dragIcon.name.empty()) {
+                drawTooltipPanel(width, height, uiScale, dragIcon.name, dragIcon.x,
+                                 dragIcon.y - 18.0f * uiScale);
+            }
+
+            iconLayer = kLayerDragIcons;
+            const voxel::BlockDef &dragDef = registry.get(dragIcon.id);
+            if (isFlatItemId(dragIcon.id)) {
+                const glm::vec4 uv = atlas.uvRect(dragDef.sideTile);
+                appendItemIcon(dragIcon.x, dragIcon.y, dragIcon.x + dragIcon.size,
+                               dragIcon.y + dragIcon.size, uv, 1.0f);
+            } else {
+                appendCubeIcon(dragIcon.x, dragIcon.y, dragIcon.size, dragIcon.size, dragDef);
+            }
+            iconLayer = kLayerIcons;
+        }
+    }
+
+    // Last in the buffer: FPS and coordinates change often, and a dirty panel
+    // forces a re-upload of everything after it.
+    InputHash infoKey;
+    infoKey.add(uiScale);
+    infoKey.add(std::lround(std::max(0.0f, fps)));
+    infoKey.add(lookedAtText);
+    infoKey.add(modeText);
+    infoKey.add(compassText);
+    infoKey.add(biomeText);
+    infoKey.add(coordText);
+    if (beginPanel(kPanelInfo, infoKey.value())) {
+        drawInfoPanel(uiScale, fps, lookedAtText, modeText, compassText, biomeText, coordText);
     }
 
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_DEPTH_TEST);
+    uploadPanels();
+    drawPanels(width, height, atlas);
     glEnable(GL_DEPTH_TEST);
 }
 
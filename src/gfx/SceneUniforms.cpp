@@ -0,0 +1,35 @@
+#include "gfx/SceneUniforms.hpp"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+namespace gfx {
+
+void bindSceneUniformBlock(unsigned int program) {
+    const GLuint index = glGetUniformBlockIndex(program, "SceneBlock");
+    if (index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, index, kSceneUniformBinding);
+    }
+}
+
+SceneUniformBuffer::~SceneUniformBuffer() {
+    if (glfwGetCurrentContext() == nullptr) {
+        return;
+    }
+    if (ubo_ != 0) {
+        glDeleteBuffers(1, &ubo_);
+    }
+}
+
+void SceneUniformBuffer::update(const SceneUniforms &values) {
+    if (ubo_ == 0) {
+        glGenBuffers(1, &ubo_);
+        glBindBuffer(GL_UNIFORM_BUFFER, ubo_);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(SceneUniforms), nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, kSceneUniformBinding, ubo_);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo_);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(SceneUniforms), &values);
+}
+
+} // namespace gfx
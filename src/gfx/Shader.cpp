@@ -2,12 +2,15 @@
 
 #include "app/util/ShaderProgramUtils.hpp"
 #include "core/Logger.hpp"
+#include "gfx/SceneUniforms.hpp"
 
 #include <glad/glad.h>
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 namespace {
 std::string readFile(const std::string &path) {
@@ -31,6 +34,32 @@ Shader::Shader(const std::string &vertexPath, const std::string &fragmentPath) {
     program_ = app::util::linkInLineProgram(
         app::util::compileInlineShader(GL_VERTEX_SHADER, vs.c_str()),
         app::util::compileInlineShader(GL_FRAGMENT_SHADER, fs.c_str()));
+    cacheUniformLocations();
+    bindSceneUniformBlock(program_);
+}
+
+void Shader::cacheUniformLocations() {
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(program_, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> buffer(static_cast<std::size_t>(std::max(maxLength, 1)));
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program_, static_cast<GLuint>(i), maxLength, &length, &size, &type,
+                           buffer.data());
+        std::string name(buffer.data(), static_cast<std::size_t>(length));
+        if (const auto bracket = name.find('['); bracket != std::string::npos) {
+            name.resize(bracket);
+        }
+        // Uniform block members report -1 here and are skipped.
+        const GLint location = glGetUniformLocation(program_, name.c_str());
+        if (location >= 0) {
+            locations_.emplace(std::move(name), location);
+        }
+    }
 }
 
 Shader::~Shader() {
@@ -43,20 +72,41 @@ void Shader::use() const {
     glUseProgram(program_);
 }
 
+int Shader::uniformLocation(std::string_view name) const {
+    const auto it = locations_.find(name);
+    return (it != locations_.end()) ? it->second : -1;
+}
+
+void Shader::setInt(int location, int value) const {
+    glUniform1i(location, value);
+}
+
+void Shader::setFloat(int location, float value) const {
+    glUniform1f(location, value);
+}
+
+void Shader::setVec3(int location, const glm::vec3 &v) const {
+    glUniform3f(location, v.x, v.y, v.z);
+}
+
+void Shader::setMat4(int location, const glm::mat4 &m) const {
+    glUniformMatrix4fv(location, 1, GL_FALSE, &m[0][0]);
+}
+
 void Shader::setInt(const char *name, int value) const {
-    glUniform1i(glGetUniformLocation(program_, name), value);
+    setInt(uniformLocation(name), value);
 }
 
 void Shader::setFloat(const char *name, float value) const {
-    glUniform1f(glGetUniformLocation(program_, name), value);
+    setFloat(uniformLocation(name), value);
 }
 
 void Shader::setVec3(const char *name, const glm::vec3 &v) const {
-    glUniform3f(glGetUniformLocation(program_, name), v.x, v.y, v.z);
+    setVec3(uniformLocation(name), v);
 }
 
 void Shader::setMat4(const char *name, const glm::mat4 &m) const {
-    glUniformMatrix4fv(glGetUniformLocation(program_, name), 1, GL_FALSE, &m[0][0]);
+    setMat4(uniformLocation(name), m);
 }
 
 } // namespace gfx
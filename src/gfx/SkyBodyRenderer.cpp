@@ -1,9 +1,12 @@
 #include "gfx/SkyBodyRenderer.hpp"
 #include "app/util/ShaderProgramUtils.hpp"
+#include "gfx/SceneUniforms.hpp"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <string>
+
 namespace gfx {
 
 SkyBodyRenderer::~SkyBodyRenderer() {
@@ -21,19 +24,17 @@ SkyBodyRenderer::~SkyBodyRenderer() {
     }
 }
 
-void SkyBodyRenderer::draw(const glm::mat4 &proj, const glm::mat4 &view, const glm::vec3 &center,
-                           const glm::vec3 &camRight, const glm::vec3 &camUp, float radius,
-                           const glm::vec3 &color, float glow, BodyType type, float phase01) {
+void SkyBodyRenderer::draw(const glm::vec3 &center, const glm::vec3 &camRight,
+                           const glm::vec3 &camUp, float radius, const glm::vec3 &color,
+                           float glow, BodyType type, float phase01) {
     init();
     glUseProgram(program_);
-    glUniformMatrix4fv(glGetUniformLocation(program_, "uProj"), 1, GL_FALSE, &proj[0][0]);
-    glUniformMatrix4fv(glGetUniformLocation(program_, "uView"), 1, GL_FALSE, &view[0][0]);
-    glUniform3f(glGetUniformLocation(program_, "uCenter"), center.x, center.y, center.z);
-    glUniform3f(glGetUniformLocation(program_, "uRight"), camRight.x, camRight.y, camRight.z);
-    glUniform3f(glGetUniformLocation(program_, "uUp"), camUp.x, camUp.y, camUp.z);
-    glUniform1f(glGetUniformLocation(program_, "uRadius"), radius);
-    glUniform3f(glGetUniformLocation(program_, "uColor"), color.r, color.g, color.b);
-    glUniform1f(glGetUniformLocation(program_, "uGlow"), glow);
+    glUniform3f(uCenter_, center.x, center.y, center.z);
+    glUniform3f(uRight_, camRight.x, camRight.y, camRight.z);
+    glUniform3f(uUp_, camUp.x, camUp.y, camUp.z);
+    glUniform1f(uRadius_, radius);
+    glUniform3f(uColor_, color.r, color.g, color.b);
+    glUniform1f(uGlow_, glow);
     int bodyType = 0;
     switch (type) {
     case BodyType::Sun:
@@ -49,8 +50,8 @@ void SkyBodyRenderer::draw(const glm::mat4 &proj, const glm::mat4 &view, const g
         bodyType = 3;
         break;
     }
-    glUniform1i(glGetUniformLocation(program_, "uBodyType"), bodyType);
-    glUniform1f(glGetUniformLocation(program_, "uPhase01"), phase01);
+    glUniform1i(uBodyType_, bodyType);
+    glUniform1f(uPhase01_, phase01);
     glBindVertexArray(vao_);
     glDrawArrays(GL_TRIANGLES, 0, 6);
 }
@@ -59,11 +60,8 @@ void SkyBodyRenderer::init() {
     if (ready_) {
         return;
     }
-    const char *vs = R"(
-#version 330 core
+    const std::string vs = std::string("#version 330 core\n") + kSceneUniformBlockGlsl + R"(
 layout(location = 0) in vec2 aCorner;
-uniform mat4 uProj;
-uniform mat4 uView;
 uniform vec3 uCenter;
 uniform vec3 uRight;
 uniform vec3 uUp;
@@ -131,8 +129,17 @@ void main() {
 }
 )";
     program_ = app::util::linkInLineProgram(
-        app::util::compileInlineShader(GL_VERTEX_SHADER, vs),
+        app::util::compileInlineShader(GL_VERTEX_SHADER, vs.c_str()),
         app::util::compileInlineShader(GL_FRAGMENT_SHADER, fs));
+    bindSceneUniformBlock(program_);
+    uCenter_ = glGetUniformLocation(program_, "uCenter");
+    uRight_ = glGetUniformLocation(program_, "uRight");
+    uUp_ = glGetUniformLocation(program_, "uUp");
+    uRadius_ = glGetUniformLocation(program_, "uRadius");
+    uColor_ = glGetUniformLocation(program_, "uColor");
+    uGlow_ = glGetUniformLocation(program_, "uGlow");
+    uBodyType_ = glGetUniformLocation(program_, "uBodyType");
+    uPhase01_ = glGetUniformLocation(program_, "uPhase01");
 
     const float quad[12] = {
         -1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f,
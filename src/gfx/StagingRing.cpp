@@ -0,0 +1,134 @@
+#include "gfx/StagingRing.hpp"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <cstring>
+
+namespace gfx {
+namespace {
+
+constexpr std::uint32_t kRegionAlignment = 16;
+
+GLsync toSync(void *sync) {
+    return static_cast<GLsync>(sync);
+}
+
+} // namespace
+
+StagingRing::StagingRing(std::uint32_t capacityBytes)
+    : capacity_((capacityBytes / kRegionAlignment) * kRegionAlignment) {}
+
+StagingRing::~StagingRing() {
+    if (glfwGetCurrentContext() == nullptr) {
+        return;
+    }
+    for (const FrameFence &fence : fences_) {
+        glDeleteSync(toSync(fence.sync));
+    }
+    if (buffer_ != 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer_);
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+        glDeleteBuffers(1, &buffer_);
+    }
+}
+
+void StagingRing::init() {
+    if (ready_) {
+        return;
+    }
+    ready_ = true;
+    if (!GLAD_GL_VERSION_4_4 && !GLAD_GL_ARB_buffer_storage) {
+        return;
+    }
+    glGenBuffers(1, &buffer_);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer_);
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_COPY_READ_BUFFER, capacity_, nullptr, flags);
+    mapped_ = static_cast<unsigned char *>(
+        glMapBufferRange(GL_COPY_READ_BUFFER, 0, capacity_, flags));
+    if (mapped_ == nullptr) {
+        glDeleteBuffers(1, &buffer_);
+        buffer_ = 0;
+    }
+}
+
+void StagingRing::retire() {
+    while (!fences_.empty()) {
+        const GLenum status = glClientWaitSync(toSync(fences_.front().sync), 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        glDeleteSync(toSync(fences_.front().sync));
+        completedFrame_ = fences_.front().frame;
+        fences_.pop_front();
+    }
+    while (!spans_.empty() && spans_.front().released && spans_.front().frame <= completedFrame_) {
+        used_ -= spans_.front().bytes;
+        spans_.pop_front();
+    }
+}
+
+std::optional<StagingRing::Region> StagingRing::reserve(std::uint32_t bytes) {
+    if (bytes == 0 || bytes > capacity_) {
+        return std::nullopt;
+    }
+    init();
+    if (mapped_ == nullptr) {
+        return std::nullopt;
+    }
+    const std::uint32_t size =
+        ((bytes + kRegionAlignment - 1) / kRegionAlignment) * kRegionAlignment;
+
+    retire();
+    const bool wrap = head_ + size > capacity_;
+    const std::uint32_t tailWaste = wrap ? capacity_ - head_ : 0;
+    if (used_ + tailWaste + size > capacity_) {
+        return std::nullopt;
+    }
+    if (wrap) {
+        if (tailWaste > 0) {
+            // Nothing reads the skipped tail, so it retires as soon as it is oldest.
+            spans_.push_back(Span{head_, tailWaste, 0, true});
+            used_ += tailWaste;
+        }
+        head_ = 0;
+    }
+    const Region region{head_, size};
+    spans_.push_back(Span{head_, size, 0, false});
+    head_ += size;
+    used_ += size;
+    return region;
+}
+
+void StagingRing::release(const Region &region) {
+    for (Span &span : spans_) {
+        if (span.offset == region.offset && !span.released) {
+            span.released = true;
+            span.frame = frame_;
+            releasedThisFrame_ = true;
+            return;
+        }
+    }
+}
+
+std::optional<StagingRing::Region> StagingRing::write(const void *data, std::uint32_t bytes) {
+    const auto region = reserve(bytes);
+    if (!region.has_value()) {
+        return std::nullopt;
+    }
+    std::memcpy(mapped_ + region->offset, data, bytes);
+    release(*region);
+    return Region{region->offset, bytes};
+}
+
+void StagingRing::endFrame() {
+    if (!releasedThisFrame_) {
+        return;
+    }
+    fences_.push_back(FrameFence{frame_, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+    ++frame_;
+    releasedThisFrame_ = false;
+}
+
+} // namespace gfx
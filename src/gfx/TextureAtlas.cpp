@@ -1,11 +1,14 @@
 #include "gfx/TextureAtlas.hpp"
 
+#include "core/AssetPack.hpp"
+
 #include <glad/glad.h>
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
 #include <glm/vec3.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <stdexcept>
 #include <vector>
@@ -21,55 +24,34 @@ bool loadImageRgba(const std::string &path, int &width, int &height, unsigned ch
     return *data != nullptr;
 }
 
-std::vector<glm::vec3> computeTileAverageColors(const unsigned char *pixels, int width, int height,
-                                                int tileW, int tileH, int cols) {
+std::vector<glm::vec3> toVec3Colors(const float *rgb, std::size_t count) {
     std::vector<glm::vec3> out;
-    if (pixels == nullptr || width <= 0 || height <= 0 || tileW <= 0 || tileH <= 0 || cols <= 0) {
-        return out;
-    }
-    const int rows = height / tileH;
-    const int count = cols * rows;
-    out.resize(static_cast<std::size_t>(count), glm::vec3(0.5f, 0.5f, 0.5f));
-    for (int t = 0; t < count; ++t) {
-        const int tx = t % cols;
-        const int ty = t / cols;
-        const int x0 = tx * tileW;
-        const int y0 = ty * tileH;
-        std::uint64_t sumR = 0;
-        std::uint64_t sumG = 0;
-        std::uint64_t sumB = 0;
-        std::uint64_t sumA = 0;
-        for (int y = 0; y < tileH; ++y) {
-            for (int x = 0; x < tileW; ++x) {
-                const int ix = x0 + x;
-                const int iy = y0 + y;
-                if (ix < 0 || ix >= width || iy < 0 || iy >= height) {
-                    continue;
-                }
-                const int idx = (iy * width + ix) * 4;
-                const std::uint32_t a = pixels[idx + 3];
-                sumR += static_cast<std::uint64_t>(pixels[idx + 0]) * a;
-                sumG += static_cast<std::uint64_t>(pixels[idx + 1]) * a;
-                sumB += static_cast<std::uint64_t>(pixels[idx + 2]) * a;
-                sumA += a;
-            }
-        }
-        if (sumA > 0) {
-            out[static_cast<std::size_t>(t)] = glm::vec3(
-                static_cast<float>(sumR) / static_cast<float>(sumA) / 255.0f,
-                static_cast<float>(sumG) / static_cast<float>(sumA) / 255.0f,
-                static_cast<float>(sumB) / static_cast<float>(sumA) / 255.0f);
-        }
+    out.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        out.emplace_back(rgb[i * 3 + 0], rgb[i * 3 + 1], rgb[i * 3 + 2]);
     }
     return out;
 }
 
+std::vector<glm::vec3> computeTileAverageColors(const unsigned char *pixels, int width, int height,
+                                                int tileW, int tileH) {
+    const std::vector<float> rgb =
+        core::computeTileAverageColors(pixels, width, height, tileW, tileH);
+    return toVec3Colors(rgb.data(), rgb.size() / 3);
+}
+
 } // namespace
 
 TextureAtlas::TextureAtlas(const std::string &path, int tileW, int tileH)
     : tileW_(tileW), tileH_(tileH) {
+    // A packed atlas is already decoded and its tile colours precomputed; the
+    // loose PNG is only decoded when the pack is missing or was built with a
+    // different tile size.
+    core::ImageData packed;
+    const bool fromPack = core::AssetPack::instance().findImage(path, packed) &&
+                          packed.tileW == tileW && packed.tileH == tileH;
     unsigned char *data = nullptr;
-    const bool loaded = loadImageRgba(path, width_, height_, &data);
+    const bool loaded = fromPack || loadImageRgba(path, width_, height_, &data);
 
     glGenTextures(1, &tex_);
     glBindTexture(GL_TEXTURE_2D, tex_);
@@ -100,12 +82,25 @@ TextureAtlas::TextureAtlas(const std::string &path, int tileW, int tileH)
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width_, height_, 0, GL_RGBA, GL_UNSIGNED_BYTE,
                      fallback.data());
         tileAverageColors_ =
-            computeTileAverageColors(fallback.data(), width_, height_, tileW_, tileH_, cols_);
+            computeTileAverageColors(fallback.data(), width_, height_, tileW_, tileH_);
+    } else if (fromPack) {
+        width_ = packed.width;
+        height_ = packed.height;
+        cols_ = width_ / tileW_;
+        const int levels = static_cast<int>(packed.levels.size());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+        for (int level = 0; level < levels; ++level) {
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, std::max(1, width_ >> level),
+                         std::max(1, height_ >> level), 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                         packed.levels[static_cast<std::size_t>(level)]);
+        }
+        tileAverageColors_ =
+            toVec3Colors(packed.tileColors, static_cast<std::size_t>(packed.tileCount));
     } else {
         cols_ = width_ / tileW_;
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width_, height_, 0, GL_RGBA, GL_UNSIGNED_BYTE,
                      data);
-        tileAverageColors_ = computeTileAverageColors(data, width_, height_, tileW_, tileH_, cols_);
+        tileAverageColors_ = computeTileAverageColors(data, width_, height_, tileW_, tileH_);
         stbi_image_free(data);
     }
 
@@ -169,8 +164,9 @@ bool TextureAtlas::reload(const std::string &path) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, newW, newH, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-    tileAverageColors_ = computeTileAverageColors(data, newW, newH, tileW_, tileH_, newW / tileW_);
+    tileAverageColors_ = computeTileAverageColors(data, newW, newH, tileW_, tileH_);
     stbi_image_free(data);
 
     width_ = newW;
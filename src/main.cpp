@@ -4,10 +4,13 @@
 #include "app/menus/FurnaceMenu.hpp"
 #include "app/menus/MiniMapMenu.hpp"
 #include "app/menus/WorldMapMenu.hpp"
+#include "app/menus/LoadingScreen.hpp"
 #include "app/menus/PauseMenu.hpp"
 #include "app/menus/RecipeMenu.hpp"
 #include "app/menus/WorldSelectionMenu.hpp"
 #include "app/menus/TextInputMenu.hpp"
+#include "core/AssetLoader.hpp"
+#include "core/AssetPack.hpp"
 #include "core/Logger.hpp"
 #include "game/Camera.hpp"
 #include "game/CraftingSystem.hpp"
@@ -118,10 +121,16 @@ void shutdownWindowContext(AppWindowContext &ctx) {
 
 } // namespace
 
-int main() {
+int main(int argc, char **argv) {
     AppWindowContext appWindow;
     try {
         std::srand(static_cast<unsigned int>(std::time(nullptr)));
+        // The build writes the asset pack next to the executable, while the
+        // loose assets and shaders resolve from the working directory.
+        if (argc > 0 && argv[0] != nullptr) {
+            const std::filesystem::path exeDir = std::filesystem::path(argv[0]).parent_path();
+            core::AssetPack::setInstancePath((exeDir / core::AssetPack::kFileName).string());
+        }
         if (!initializeWindowContext(appWindow)) {
             return 1;
         }
@@ -131,6 +140,11 @@ int main() {
         gfx::Shader shader("shaders/chunk.vert", "shaders/chunk.frag");
         gfx::TextureAtlas atlas("assets/textures/atlas.png", 16, 16);
         gfx::HudRenderer hud;
+        // Sounds decode in the background while the title screen is up and
+        // keep streaming in during spawn loading; both loops pump uploads.
+        game::AudioSystem audio;
+        core::AssetLoader assetLoader;
+        audio.loadDefaultAssetsAsync(assetLoader);
         app::menus::WorldSelectionMenu worldSelectionMenu;
         app::menus::PauseMenu pauseMenu;
         app::menus::CraftingMenu craftingMenu;
@@ -139,9 +153,11 @@ int main() {
         app::menus::CreativeMenu creativeMenu;
         app::menus::WorldMapMenu worldMapMenu;
         app::menus::MiniMapMenu miniMapMenu;
+        app::menus::LoadingScreen loadingScreen;
         bool appRunning = true;
         while (appRunning && !glfwWindowShouldClose(window)) {
-            const app::menus::WorldSelection worldSelection = worldSelectionMenu.run(window, hud);
+            const app::menus::WorldSelection worldSelection =
+                worldSelectionMenu.run(window, hud, assetLoader);
             if (!worldSelection.start) {
                 appRunning = false;
                 break;
@@ -149,9 +165,10 @@ int main() {
             glfwSetWindowTitle(window, ("Voxel Clone - " + worldSelection.name).c_str());
             glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
             glfwSetCursor(window, nullptr);
-            app::GameSession session(window, arrowCursor, worldSelection, shader, atlas, hud,
-                                     pauseMenu, craftingMenu, furnaceMenu, recipeMenu,
-                                     creativeMenu, worldMapMenu, miniMapMenu);
+            app::GameSession session(window, arrowCursor, worldSelection, shader, atlas, hud, audio,
+                                     assetLoader, pauseMenu, craftingMenu, furnaceMenu,
+                                     recipeMenu, creativeMenu, worldMapMenu, miniMapMenu,
+                                     loadingScreen);
             const bool returnToTitle = session.run();
             if (returnToTitle && !glfwWindowShouldClose(window)) {
                 glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
@@ -0,0 +1,98 @@
+// Build step: decodes the texture atlas and every WAV under assets/ into a
+// single pack the game maps at startup instead of decoding loose files.
+//
+// Usage: asset_packer <source-root> <output-pack>
+// Entries are keyed by their path relative to <source-root> (for example
+// "assets/textures/atlas.png"), matching the paths the game opens.
+
+#include "core/AssetPack.hpp"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char *kAtlasPath = "assets/textures/atlas.png";
+constexpr int kAtlasTileSize = 16;
+
+bool readFile(const std::filesystem::path &path, std::vector<std::uint8_t> &out) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return false;
+    }
+    out.resize(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(reinterpret_cast<char *>(out.data()), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(in);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s <source-root> <output-pack>\n", argv[0]);
+        return 2;
+    }
+    const std::filesystem::path root = argv[1];
+    const std::string output = argv[2];
+    core::AssetPackWriter writer;
+
+    const std::filesystem::path atlas = root / kAtlasPath;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    stbi_set_flip_vertically_on_load(0);
+    unsigned char *pixels = stbi_load(atlas.string().c_str(), &width, &height, &channels, 4);
+    if (pixels != nullptr) {
+        writer.addImage(kAtlasPath, pixels, width, height, kAtlasTileSize, kAtlasTileSize);
+        stbi_image_free(pixels);
+    } else {
+        std::fprintf(stderr, "asset_packer: skipping %s\n", atlas.string().c_str());
+    }
+
+    // Sorted so the pack is byte-identical across runs.
+    std::vector<std::filesystem::path> sounds;
+    const std::filesystem::path audioRoot = root / "assets" / "audio";
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it(audioRoot, ec), end; !ec && it != end;
+         it.increment(ec)) {
+        if (it->is_regular_file() && it->path().extension() == ".wav") {
+            sounds.push_back(it->path());
+        }
+    }
+    std::sort(sounds.begin(), sounds.end());
+
+    std::vector<std::vector<std::uint8_t>> soundBytes;
+    soundBytes.reserve(sounds.size());
+    for (const auto &path : sounds) {
+        soundBytes.emplace_back();
+        core::SoundData sound;
+        std::string error;
+        if (!readFile(path, soundBytes.back()) ||
+            !core::parseWav(soundBytes.back().data(), soundBytes.back().size(), sound, error)) {
+            std::fprintf(stderr, "asset_packer: skipping %s %s\n", path.string().c_str(),
+                         error.c_str());
+            continue;
+        }
+        writer.addSound(path.lexically_relative(root).generic_string(), sound);
+    }
+
+    // The pack lands in the build directory, which may not exist yet for
+    // the executable's configuration.
+    const std::filesystem::path outputDir = std::filesystem::path(output).parent_path();
+    if (!outputDir.empty()) {
+        std::filesystem::create_directories(outputDir, ec);
+    }
+    std::string error;
+    if (!writer.write(output, error)) {
+        std::fprintf(stderr, "asset_packer: %s\n", error.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -147,6 +147,24 @@ void appendTorchCross(gfx::CpuMesh &mesh, float x0, float z0, float x1, float z1
     appendQuad(mesh, q0, q1, q2, q3, {0.0f, 1.0f, 0.0f}, uv, skyLight, blockLight);
 }
 
+void computeYBounds(gfx::CpuMesh &mesh) {
+    mesh.bounds = {};
+    mesh.sectionBounds.fill({});
+    // Every emitter appends whole quads, so vertices come in groups of four.
+    for (std::size_t i = 0; i + 3 < mesh.vertices.size(); i += 4) {
+        float lo = mesh.vertices[i].py;
+        float hi = lo;
+        for (std::size_t k = 1; k < 4; ++k) {
+            lo = std::min(lo, mesh.vertices[i + k].py);
+            hi = std::max(hi, mesh.vertices[i + k].py);
+        }
+        const int section =
+            std::clamp(static_cast<int>(lo) / kSectionSize, 0, kSectionsPerChunk - 1);
+        mesh.bounds.include(lo, hi);
+        mesh.sectionBounds[static_cast<std::size_t>(section)].include(lo, hi);
+    }
+}
+
 } // namespace
 
 void ChunkMesher::buildFaceCulledInto(gfx::CpuMesh &out, const Chunk &chunk,
@@ -621,6 +639,7 @@ void ChunkMesher::buildFaceCulledInto(gfx::CpuMesh &out, const Chunk &chunk,
             }
         }
     }
+    computeYBounds(out);
 }
 
 gfx::CpuMesh ChunkMesher::buildFaceCulled(const Chunk &chunk, const gfx::TextureAtlas &atlas,
@@ -636,4 +655,85 @@ gfx::CpuMesh ChunkMesher::buildFaceCulled(const Chunk &chunk, const gfx::Texture
     return out;
 }
 
+std::array<SectionVisibility, kSectionsPerChunk>
+ChunkMesher::buildSectionVisibility(const Chunk &chunk, const BlockRegistry &registry) {
+    constexpr int kCells = kSectionSize * kSectionSize * kSectionSize;
+    static_assert(Chunk::SX == kSectionSize && Chunk::SZ == kSectionSize);
+
+    std::array<SectionVisibility, kSectionsPerChunk> out{};
+    std::array<bool, kCells> open{};
+    std::array<bool, kCells> visited{};
+    std::array<int, kCells> stack{};
+    const auto cellIndex = [](int x, int y, int z) {
+        return x + kSectionSize * (z + kSectionSize * y);
+    };
+
+    for (int section = 0; section < kSectionsPerChunk; ++section) {
+        const int baseY = section * kSectionSize;
+        int openCount = 0;
+        for (int y = 0; y < kSectionSize; ++y) {
+            for (int z = 0; z < kSectionSize; ++z) {
+                for (int x = 0; x < kSectionSize; ++x) {
+                    const bool cellOpen =
+                        !isOpaque(registry, chunk.getUnchecked(x, baseY + y, z));
+                    open[static_cast<std::size_t>(cellIndex(x, y, z))] = cellOpen;
+                    openCount += cellOpen ? 1 : 0;
+                }
+            }
+        }
+        if (openCount == kCells) {
+            continue; // default is fully connected
+        }
+        out[static_cast<std::size_t>(section)] = SectionVisibility::none();
+        if (openCount == 0) {
+            continue;
+        }
+
+        visited.fill(false);
+        for (int start = 0; start < kCells; ++start) {
+            if (!open[static_cast<std::size_t>(start)] || visited[static_cast<std::size_t>(start)]) {
+                continue;
+            }
+            unsigned int faces = 0;
+            int top = 0;
+            stack[static_cast<std::size_t>(top++)] = start;
+            visited[static_cast<std::size_t>(start)] = true;
+            while (top > 0) {
+                const int cell = stack[static_cast<std::size_t>(--top)];
+                const int x = cell % kSectionSize;
+                const int z = (cell / kSectionSize) % kSectionSize;
+                const int y = cell / (kSectionSize * kSectionSize);
+                faces |= (x == 0 ? 1u << FACE_NEG_X : 0u) |
+                         (x == kSectionSize - 1 ? 1u << FACE_POS_X : 0u) |
+                         (y == 0 ? 1u << FACE_NEG_Y : 0u) |
+                         (y == kSectionSize - 1 ? 1u << FACE_POS_Y : 0u) |
+                         (z == 0 ? 1u << FACE_NEG_Z : 0u) |
+                         (z == kSectionSize - 1 ? 1u << FACE_POS_Z : 0u);
+                const std::array<glm::ivec3, 6> steps = {
+                    glm::ivec3{x - 1, y, z}, glm::ivec3{x + 1, y, z}, glm::ivec3{x, y - 1, z},
+                    glm::ivec3{x, y + 1, z}, glm::ivec3{x, y, z - 1}, glm::ivec3{x, y, z + 1}};
+                for (const glm::ivec3 &n : steps) {
+                    if (n.x < 0 || n.y < 0 || n.z < 0 || n.x >= kSectionSize ||
+                        n.y >= kSectionSize || n.z >= kSectionSize) {
+                        continue;
+                    }
+                    const auto next = static_cast<std::size_t>(cellIndex(n.x, n.y, n.z));
+                    if (open[next] && !visited[next]) {
+                        visited[next] = true;
+                        stack[static_cast<std::size_t>(top++)] = static_cast<int>(next);
+                    }
+                }
+            }
+            for (int a = 0; a < SECTION_FACE_COUNT; ++a) {
+                for (int b = 0; b < SECTION_FACE_COUNT; ++b) {
+                    if ((faces & (1u << a)) != 0 && (faces & (1u << b)) != 0) {
+                        out[static_cast<std::size_t>(section)].connect(a, b);
+                    }
+                }
+            }
+        }
+    }
+    return out;
+}
+
 } // namespace voxel
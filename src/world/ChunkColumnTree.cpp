@@ -0,0 +1,141 @@
+#include "world/ChunkColumnTree.hpp"
+
+#include "voxel/Chunk.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace world {
+namespace {
+
+ChunkCoord parentKey(ChunkCoord key) {
+    // Arithmetic shift floors negative coordinates as well.
+    return ChunkCoord{key.x >> 1, key.z >> 1};
+}
+
+float nodeSpanBlocks(int level) {
+    return static_cast<float>(voxel::Chunk::SX * (1 << level));
+}
+
+} // namespace
+
+void ChunkColumnTree::insert(ChunkCoord cc, float minY, float maxY) {
+    levels_[0][cc] = Node{1, minY, maxY};
+    refreshParents(cc);
+}
+
+void ChunkColumnTree::erase(ChunkCoord cc) {
+    if (levels_[0].erase(cc) == 0) {
+        return;
+    }
+    refreshParents(cc);
+}
+
+void ChunkColumnTree::clear() {
+    for (Level &level : levels_) {
+        level.clear();
+    }
+}
+
+void ChunkColumnTree::refreshParents(ChunkCoord leaf) {
+    ChunkCoord key = leaf;
+    for (int level = 1; level < kLevels; ++level) {
+        key = parentKey(key);
+        Node merged{};
+        bool any = false;
+        for (int dz = 0; dz < 2; ++dz) {
+            for (int dx = 0; dx < 2; ++dx) {
+                const auto it = levels_[level - 1].find(ChunkCoord{key.x * 2 + dx, key.z * 2 + dz});
+                if (it == levels_[level - 1].end()) {
+                    continue;
+                }
+                const Node &child = it->second;
+                merged.count += child.count;
+                merged.minY = any ? std::min(merged.minY, child.minY) : child.minY;
+                merged.maxY = any ? std::max(merged.maxY, child.maxY) : child.maxY;
+                any = true;
+            }
+        }
+        if (any) {
+            levels_[level][key] = merged;
+        } else {
+            levels_[level].erase(key);
+        }
+    }
+}
+
+void ChunkColumnTree::query(const FrustumPlanes &frustum, const glm::vec3 &cameraPos,
+                            float maxDist,
+                            const std::function<void(ChunkCoord, float, float)> &visit,
+                            QueryStats &stats) const {
+    constexpr int kTop = kLevels - 1;
+    const float span = nodeSpanBlocks(kTop);
+    const int x0 = static_cast<int>(std::floor((cameraPos.x - maxDist) / span));
+    const int x1 = static_cast<int>(std::floor((cameraPos.x + maxDist) / span));
+    const int z0 = static_cast<int>(std::floor((cameraPos.z - maxDist) / span));
+    const int z1 = static_cast<int>(std::floor((cameraPos.z + maxDist) / span));
+    const Level &top = levels_[kTop];
+    if (static_cast<std::size_t>((x1 - x0 + 1) * (z1 - z0 + 1)) > top.size()) {
+        for (const auto &[key, node] : top) {
+            queryNode(kTop, key, node, frustum, cameraPos, maxDist, visit, stats);
+        }
+        return;
+    }
+    for (int z = z0; z <= z1; ++z) {
+        for (int x = x0; x <= x1; ++x) {
+            const auto it = top.find(ChunkCoord{x, z});
+            if (it != top.end()) {
+                queryNode(kTop, it->first, it->second, frustum, cameraPos, maxDist, visit, stats);
+            }
+        }
+    }
+}
+
+void ChunkColumnTree::queryNode(int level, ChunkCoord key, const Node &node,
+                                const FrustumPlanes &frustum, const glm::vec3 &cameraPos,
+                                float maxDist,
+                                const std::function<void(ChunkCoord, float, float)> &visit,
+                                QueryStats &stats) const {
+    const float span = nodeSpanBlocks(level);
+    const float minX = static_cast<float>(key.x) * span;
+    const float minZ = static_cast<float>(key.z) * span;
+    if (level == 0) {
+        const float dx = minX + span * 0.5f - cameraPos.x;
+        const float dz = minZ + span * 0.5f - cameraPos.z;
+        if (dx * dx + dz * dz > maxDist * maxDist) {
+            ++stats.culled;
+            return;
+        }
+    } else {
+        // The nearest point of the rectangle is never further than any column
+        // centre inside it, so this cannot drop a column the leaf test keeps.
+        const float nx = std::clamp(cameraPos.x, minX, minX + span) - cameraPos.x;
+        const float nz = std::clamp(cameraPos.z, minZ, minZ + span) - cameraPos.z;
+        if (nx * nx + nz * nz > maxDist * maxDist) {
+            stats.culled += node.count;
+            return;
+        }
+    }
+    if (!aabbInFrustum(frustum, glm::vec3(minX, node.minY, minZ),
+                       glm::vec3(minX + span, node.maxY, minZ + span))) {
+        stats.culled += node.count;
+        return;
+    }
+    if (level == 0) {
+        ++stats.visited;
+        visit(key, node.minY, node.maxY);
+        return;
+    }
+    const Level &children = levels_[level - 1];
+    for (int dz = 0; dz < 2; ++dz) {
+        for (int dx = 0; dx < 2; ++dx) {
+            const auto it = children.find(ChunkCoord{key.x * 2 + dx, key.z * 2 + dz});
+            if (it != children.end()) {
+                queryNode(level - 1, it->first, it->second, frustum, cameraPos, maxDist, visit,
+                          stats);
+            }
+        }
+    }
+}
+
+} // namespace world
@@ -0,0 +1,63 @@
+#include "world/Frustum.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/vec4.hpp>
+
+namespace world {
+namespace {
+
+glm::vec4 row(const glm::mat4 &m, int r) {
+    return {m[0][r], m[1][r], m[2][r], m[3][r]};
+}
+
+FrustumPlane normalizePlane(const glm::vec4 &eq) {
+    const glm::vec3 n(eq.x, eq.y, eq.z);
+    const float len = glm::length(n);
+    if (len <= 1e-6f) {
+        return FrustumPlane{};
+    }
+    return FrustumPlane{n / len, eq.w / len};
+}
+
+} // namespace
+
+FrustumPlanes extractFrustumPlanes(const glm::mat4 &viewProj) {
+    const glm::vec4 r0 = row(viewProj, 0);
+    const glm::vec4 r1 = row(viewProj, 1);
+    const glm::vec4 r2 = row(viewProj, 2);
+    const glm::vec4 r3 = row(viewProj, 3);
+    FrustumPlanes out;
+    out.p[0] = normalizePlane(r3 + r0); // left
+    out.p[1] = normalizePlane(r3 - r0); // right
+    out.p[2] = normalizePlane(r3 + r1); // bottom
+    out.p[3] = normalizePlane(r3 - r1); // top
+    out.p[4] = normalizePlane(r3 + r2); // near
+    out.p[5] = normalizePlane(r3 - r2); // far
+    return out;
+}
+
+bool sphereInFrustum(const FrustumPlanes &frustum, const glm::vec3 &center, float radius) {
+    for (const FrustumPlane &pl : frustum.p) {
+        const float dist = glm::dot(pl.n, center) + pl.d;
+        if (dist < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool aabbInFrustum(const FrustumPlanes &frustum, const glm::vec3 &minCorner,
+                   const glm::vec3 &maxCorner) {
+    for (const FrustumPlane &pl : frustum.p) {
+        // Corner furthest along the plane normal.
+        const glm::vec3 positive(pl.n.x >= 0.0f ? maxCorner.x : minCorner.x,
+                                 pl.n.y >= 0.0f ? maxCorner.y : minCorner.y,
+                                 pl.n.z >= 0.0f ? maxCorner.z : minCorner.z);
+        if (glm::dot(pl.n, positive) + pl.d < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace world
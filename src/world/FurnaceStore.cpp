@@ -0,0 +1,110 @@
+#include "world/FurnaceStore.hpp"
+
+#include "voxel/Chunk.hpp"
+
+#include <utility>
+
+namespace world {
+namespace {
+
+int floorDiv(int a, int b) {
+    return (a >= 0) ? (a / b) : ((a - b + 1) / b);
+}
+
+} // namespace
+
+ChunkCoord FurnaceStore::chunkOf(const Key &key) {
+    return ChunkCoord{floorDiv(key.x, voxel::Chunk::SX), floorDiv(key.z, voxel::Chunk::SZ)};
+}
+
+const FurnaceState *FurnaceStore::find(const Key &key) const {
+    const auto it = slots_.find(key);
+    return it != slots_.end() ? &records_[it->second].state : nullptr;
+}
+
+std::size_t FurnaceStore::slotOf(const Key &key) const {
+    const auto it = slots_.find(key);
+    return it != slots_.end() ? it->second : records_.size();
+}
+
+void FurnaceStore::put(const Key &key, const FurnaceState &state) {
+    const auto it = slots_.find(key);
+    if (it == slots_.end()) {
+        slots_.emplace(key, records_.size());
+        records_.push_back(Record{key, state});
+        byChunk_[chunkOf(key)].insert(key);
+        wake(records_.size() - 1);
+        return;
+    }
+    Record &record = records_[it->second];
+    if (record.state == state) {
+        return;
+    }
+    record.state = state;
+    wake(it->second);
+}
+
+bool FurnaceStore::erase(const Key &key) {
+    const auto it = slots_.find(key);
+    if (it == slots_.end()) {
+        return false;
+    }
+    sleep(it->second);
+    swapSlots(it->second, records_.size() - 1);
+    records_.pop_back();
+    slots_.erase(key);
+    const auto bit = byChunk_.find(chunkOf(key));
+    if (bit != byChunk_.end()) {
+        bit->second.erase(key);
+        if (bit->second.empty()) {
+            byChunk_.erase(bit);
+        }
+    }
+    return true;
+}
+
+void FurnaceStore::eraseChunk(ChunkCoord cc) {
+    const auto bit = byChunk_.find(cc);
+    if (bit == byChunk_.end()) {
+        return;
+    }
+    // erase() edits the chunk's set, so walk a copy.
+    const std::unordered_set<Key, KeyHash> keys = std::move(bit->second);
+    byChunk_.erase(bit);
+    for (const Key &key : keys) {
+        erase(key);
+    }
+}
+
+const std::unordered_set<FurnaceStore::Key, FurnaceStore::KeyHash> *
+FurnaceStore::chunkKeys(ChunkCoord cc) const {
+    const auto bit = byChunk_.find(cc);
+    return bit != byChunk_.end() ? &bit->second : nullptr;
+}
+
+void FurnaceStore::swapSlots(std::size_t a, std::size_t b) {
+    if (a == b) {
+        return;
+    }
+    std::swap(records_[a], records_[b]);
+    slots_[records_[a].key] = a;
+    slots_[records_[b].key] = b;
+}
+
+void FurnaceStore::wake(std::size_t slot) {
+    if (slot < awake_) {
+        return;
+    }
+    swapSlots(slot, awake_);
+    ++awake_;
+}
+
+void FurnaceStore::sleep(std::size_t slot) {
+    if (slot >= awake_) {
+        return;
+    }
+    --awake_;
+    swapSlots(slot, awake_);
+}
+
+} // namespace world
@@ -0,0 +1,86 @@
+#include "world/OcclusionCuller.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace world {
+namespace {
+
+constexpr std::array<glm::ivec3, voxel::SECTION_FACE_COUNT> kFaceSteps = {
+    glm::ivec3{-1, 0, 0}, glm::ivec3{1, 0, 0},  glm::ivec3{0, -1, 0},
+    glm::ivec3{0, 1, 0},  glm::ivec3{0, 0, -1}, glm::ivec3{0, 0, 1}};
+
+std::uint64_t sectionKey(ChunkCoord cc, int section) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cc.x)) << 36) ^
+           (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cc.z)) << 4) ^
+           static_cast<std::uint64_t>(section);
+}
+
+int floorDiv(int a, int b) {
+    return (a >= 0) ? (a / b) : ((a - b + 1) / b);
+}
+
+} // namespace
+
+bool OcclusionCuller::compute(const glm::vec3 &cameraPos, const FrustumPlanes &frustum,
+                              float maxDist, const Lookup &lookup) {
+    visibleColumns_.clear();
+    visited_.clear();
+    queue_.clear();
+    visitedSections_ = 0;
+
+    const int camY = static_cast<int>(std::floor(cameraPos.y));
+    if (camY < 0 || camY >= voxel::Chunk::SY) {
+        return false;
+    }
+    const ChunkCoord start{floorDiv(static_cast<int>(std::floor(cameraPos.x)), voxel::Chunk::SX),
+                           floorDiv(static_cast<int>(std::floor(cameraPos.z)), voxel::Chunk::SZ)};
+    queue_.push_back(Step{start, camY / voxel::kSectionSize, -1, 0});
+    visited_.insert(sectionKey(start, camY / voxel::kSectionSize));
+
+    const float size = static_cast<float>(voxel::kSectionSize);
+    const float maxDist2 = maxDist * maxDist;
+    for (std::size_t head = 0; head < queue_.size(); ++head) {
+        const Step step = queue_[head];
+        visibleColumns_.insert(step.cc);
+        ++visitedSections_;
+        const voxel::SectionVisibility *visibility = lookup(step.cc, step.section);
+
+        for (int face = 0; face < voxel::SECTION_FACE_COUNT; ++face) {
+            if ((step.directions & (1u << voxel::oppositeFace(face))) != 0) {
+                continue;
+            }
+            if (step.enteredFrom >= 0 && visibility != nullptr &&
+                !visibility->connected(step.enteredFrom, face)) {
+                continue;
+            }
+            const glm::ivec3 &d = kFaceSteps[static_cast<std::size_t>(face)];
+            const ChunkCoord cc{step.cc.x + d.x, step.cc.z + d.z};
+            const int section = step.section + d.y;
+            if (section < 0 || section >= voxel::kSectionsPerChunk) {
+                continue;
+            }
+            const std::uint64_t key = sectionKey(cc, section);
+            if (visited_.count(key) > 0) {
+                continue;
+            }
+            const glm::vec3 minCorner(static_cast<float>(cc.x) * size,
+                                      static_cast<float>(section) * size,
+                                      static_cast<float>(cc.z) * size);
+            const float dx = minCorner.x + size * 0.5f - cameraPos.x;
+            const float dz = minCorner.z + size * 0.5f - cameraPos.z;
+            if (dx * dx + dz * dz > maxDist2) {
+                continue;
+            }
+            if (!aabbInFrustum(frustum, minCorner, minCorner + glm::vec3(size))) {
+                continue;
+            }
+            visited_.insert(key);
+            queue_.push_back(
+                Step{cc, section, voxel::oppositeFace(face), step.directions | (1u << face)});
+        }
+    }
+    return true;
+}
+
+} // namespace world
@@ -0,0 +1,200 @@
+#include "world/VoxelWindow.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace world {
+namespace {
+
+// Boxes ending exactly on a cell face do not overlap that cell; boxes stopped
+// against a lower face keep this gap so float error cannot sink them into it.
+constexpr float kFaceEps = 0.001f;
+
+int cellOf(float v) {
+    return static_cast<int>(std::floor(v));
+}
+
+} // namespace
+
+void VoxelWindow::reset(const glm::ivec3 &minCell, const glm::ivec3 &maxCell) {
+    min_ = minCell;
+    max_ = maxCell;
+    size_ = glm::ivec3(std::max(0, maxCell.x - minCell.x + 1),
+                       std::max(0, maxCell.y - minCell.y + 1),
+                       std::max(0, maxCell.z - minCell.z + 1));
+    const std::size_t count = static_cast<std::size_t>(size_.x) *
+                              static_cast<std::size_t>(size_.y) *
+                              static_cast<std::size_t>(size_.z);
+    blocks_.assign(count, voxel::AIR);
+    flags_.assign(count, 0);
+    fluidLevels_.assign(count, -1);
+}
+
+bool VoxelWindow::contains(const glm::ivec3 &minCell, const glm::ivec3 &maxCell) const {
+    return minCell.x >= min_.x && minCell.y >= min_.y && minCell.z >= min_.z &&
+           maxCell.x <= max_.x && maxCell.y <= max_.y && maxCell.z <= max_.z;
+}
+
+int VoxelWindow::index(int x, int y, int z) const {
+    if (x < min_.x || y < min_.y || z < min_.z || x > max_.x || y > max_.y || z > max_.z) {
+        return -1;
+    }
+    return (x - min_.x) + size_.x * ((z - min_.z) + size_.z * (y - min_.y));
+}
+
+void VoxelWindow::set(int x, int y, int z, voxel::BlockId id, bool solid, int fluidLevel) {
+    const int i = index(x, y, z);
+    if (i < 0) {
+        return;
+    }
+    blocks_[static_cast<std::size_t>(i)] = id;
+    flags_[static_cast<std::size_t>(i)] = solid ? kSolidFlag : 0;
+    fluidLevels_[static_cast<std::size_t>(i)] = static_cast<std::int8_t>(fluidLevel);
+}
+
+voxel::BlockId VoxelWindow::block(int x, int y, int z) const {
+    const int i = index(x, y, z);
+    return i < 0 ? voxel::AIR : blocks_[static_cast<std::size_t>(i)];
+}
+
+bool VoxelWindow::solid(int x, int y, int z) const {
+    const int i = index(x, y, z);
+    return i >= 0 && (flags_[static_cast<std::size_t>(i)] & kSolidFlag) != 0;
+}
+
+int VoxelWindow::fluidLevel(int x, int y, int z) const {
+    const int i = index(x, y, z);
+    return i < 0 ? -1 : fluidLevels_[static_cast<std::size_t>(i)];
+}
+
+bool VoxelWindow::intersectsSolid(const glm::vec3 &aabbMin, const glm::vec3 &aabbMax) const {
+    const int minX = cellOf(aabbMin.x);
+    const int minY = cellOf(aabbMin.y);
+    const int minZ = cellOf(aabbMin.z);
+    const int maxX = cellOf(aabbMax.x - kFaceEps);
+    const int maxY = cellOf(aabbMax.y - kFaceEps);
+    const int maxZ = cellOf(aabbMax.z - kFaceEps);
+    for (int y = minY; y <= maxY; ++y) {
+        for (int z = minZ; z <= maxZ; ++z) {
+            for (int x = minX; x <= maxX; ++x) {
+                if (solid(x, y, z)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+float VoxelWindow::sweep(const glm::vec3 &aabbMin, const glm::vec3 &aabbMax, int axis,
+                         float amount) const {
+    if (amount == 0.0f) {
+        return 0.0f;
+    }
+    const int axisU = (axis + 1) % 3;
+    const int axisV = (axis + 2) % 3;
+    const int minU = cellOf(aabbMin[axisU]);
+    const int maxU = cellOf(aabbMax[axisU] - kFaceEps);
+    const int minV = cellOf(aabbMin[axisV]);
+    const int maxV = cellOf(aabbMax[axisV] - kFaceEps);
+
+    auto slabBlocked = [&](int c) {
+        glm::ivec3 cell(0);
+        cell[axis] = c;
+        for (int u = minU; u <= maxU; ++u) {
+            cell[axisU] = u;
+            for (int v = minV; v <= maxV; ++v) {
+                cell[axisV] = v;
+                if (solid(cell.x, cell.y, cell.z)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    // Only slabs the leading face enters are tested; cells the box already
+    // overlaps are ignored so a box stuck in a block can still move out.
+    if (amount > 0.0f) {
+        const float lead = aabbMax[axis];
+        const int first = cellOf(lead - kFaceEps) + 1;
+        const int last = cellOf(lead + amount - kFaceEps);
+        for (int c = first; c <= last; ++c) {
+            if (slabBlocked(c)) {
+                return std::clamp(static_cast<float>(c) - lead, 0.0f, amount);
+            }
+        }
+        return amount;
+    }
+    const float lead = aabbMin[axis];
+    const int first = cellOf(lead) - 1;
+    const int last = cellOf(lead + amount);
+    for (int c = first; c >= last; --c) {
+        if (slabBlocked(c)) {
+            return std::clamp(static_cast<float>(c + 1) + kFaceEps - lead, amount, 0.0f);
+        }
+    }
+    return amount;
+}
+
+glm::vec3 VoxelWindow::fluidCurrentAt(const glm::vec3 &pos) const {
+    const int wx = cellOf(pos.x);
+    const int wy = cellOf(pos.y);
+    const int wz = cellOf(pos.z);
+
+    const voxel::BlockId id = block(wx, wy, wz);
+    const bool waterLike = voxel::isWaterLike(id);
+    const bool lavaLike = voxel::isLavaLike(id);
+    if (!waterLike && !lavaLike) {
+        return glm::vec3(0.0f);
+    }
+    const bool water = waterLike;
+    const int maxFlow = water ? kWaterMaxFlowLevel : kLavaMaxFlowLevel;
+
+    auto isSameFluidAt = [&](int x, int y, int z) {
+        const voxel::BlockId bid = block(x, y, z);
+        return water ? voxel::isWaterLike(bid) : voxel::isLavaLike(bid);
+    };
+    auto isOpenAt = [&](int x, int y, int z) {
+        const voxel::BlockId bid = block(x, y, z);
+        return bid == voxel::AIR || voxel::isPlant(bid) || voxel::isTorch(bid);
+    };
+    auto levelAt = [&](int x, int y, int z) -> int {
+        if (!isSameFluidAt(x, y, z)) {
+            return -1;
+        }
+        return fluidLevel(x, y, z);
+    };
+
+    const int centerLevel = std::max(0, levelAt(wx, wy, wz));
+    glm::vec3 flow(0.0f);
+    const std::array<glm::ivec3, 4> kDirs = {glm::ivec3{1, 0, 0}, glm::ivec3{-1, 0, 0},
+                                             glm::ivec3{0, 0, 1}, glm::ivec3{0, 0, -1}};
+    for (const glm::ivec3 &d : kDirs) {
+        const int nx = wx + d.x;
+        const int nz = wz + d.z;
+        const int nLevel = levelAt(nx, wy, nz);
+        const glm::vec3 dir(static_cast<float>(d.x), 0.0f, static_cast<float>(d.z));
+        if (nLevel >= 0) {
+            // Flow from stronger sources (low level) toward weaker cells (high level).
+            flow += dir * static_cast<float>(nLevel - centerLevel);
+        } else if (isOpenAt(nx, wy, nz)) {
+            flow += dir * static_cast<float>(maxFlow - centerLevel + 1);
+        }
+    }
+    if (!isSameFluidAt(wx, wy - 1, wz) && isOpenAt(wx, wy - 1, wz)) {
+        flow.y -= 1.5f;
+    }
+
+    const float len = glm::length(flow);
+    if (len <= 1e-5f) {
+        return glm::vec3(0.0f);
+    }
+    const float strength = water ? 16.0f : 8.0f;
+    return (flow / len) * strength;
+}
+
+} // namespace world
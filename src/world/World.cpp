@@ -2,6 +2,7 @@
 
 #include "app/SaveManager.hpp"
 #include "voxel/ChunkMesher.hpp"
+#include "world/Frustum.hpp"
 
 #include <glm/geometric.hpp>
 #include <glm/mat4x4.hpp>
@@ -11,7 +12,9 @@
 #include <algorithm>
 #include <array>
 #include <cerrno>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <cstdlib>
 #include <limits>
 #include <utility>
@@ -23,11 +26,15 @@ namespace {
 constexpr unsigned int kMinWorkerThreads = 2u;
 constexpr unsigned int kDefaultMaxWorkerThreads = 12u;
 constexpr int kMaxUnloadsPerUpdate = 2;
-constexpr int kDefaultMaxUploadsPerFrame = 6;
+constexpr int kDefaultUploadBudgetKiB = 2048;
+// Meshes larger than a slab are copied into the ring on the GL thread instead.
+constexpr std::uint32_t kStagingSlabBytes = 1u << 20;
+constexpr std::size_t kMaxStagingSlabs = 4;
+constexpr float kTransparentSortCell = 4.0f;
+constexpr float kTransparentYawStep = 3.14159265f / 32.0f;
+constexpr float kTransparentPitchStep = 3.14159265f / 16.0f;
 constexpr int kWaterTicksPerStep = 4;
 constexpr int kLavaTicksPerStep = 12;
-constexpr int kWaterMaxFlowLevel = 7;
-constexpr int kLavaMaxFlowLevel = 4;
 
 int chunkDistance(ChunkCoord a, ChunkCoord b) {
     return std::max(std::abs(a.x - b.x), std::abs(a.z - b.z));
@@ -109,53 +116,6 @@ bool chunkHasFluidLikeBlock(const voxel::Chunk *chunk) {
     return false;
 }
 
-struct FrustumPlane {
-    glm::vec3 n{0.0f};
-    float d = 0.0f;
-};
-
-struct FrustumPlanes {
-    std::array<FrustumPlane, 6> p{};
-};
-
-glm::vec4 row(const glm::mat4 &m, int r) {
-    return {m[0][r], m[1][r], m[2][r], m[3][r]};
-}
-
-FrustumPlane normalizePlane(const glm::vec4 &eq) {
-    const glm::vec3 n(eq.x, eq.y, eq.z);
-    const float len = glm::length(n);
-    if (len <= 1e-6f) {
-        return FrustumPlane{};
-    }
-    return FrustumPlane{n / len, eq.w / len};
-}
-
-FrustumPlanes extractFrustumPlanes(const glm::mat4 &viewProj) {
-    const glm::vec4 r0 = row(viewProj, 0);
-    const glm::vec4 r1 = row(viewProj, 1);
-    const glm::vec4 r2 = row(viewProj, 2);
-    const glm::vec4 r3 = row(viewProj, 3);
-    FrustumPlanes out;
-    out.p[0] = normalizePlane(r3 + r0); // left
-    out.p[1] = normalizePlane(r3 - r0); // right
-    out.p[2] = normalizePlane(r3 + r1); // bottom
-    out.p[3] = normalizePlane(r3 - r1); // top
-    out.p[4] = normalizePlane(r3 + r2); // near
-    out.p[5] = normalizePlane(r3 - r2); // far
-    return out;
-}
-
-bool sphereInFrustum(const FrustumPlanes &frustum, const glm::vec3 &center, float radius) {
-    for (const FrustumPlane &pl : frustum.p) {
-        const float dist = glm::dot(pl.n, center) + pl.d;
-        if (dist < -radius) {
-            return false;
-        }
-    }
-    return true;
-}
-
 int readEnvInt(const char *name, int fallback, int minValue, int maxValue) {
     const char *raw = std::getenv(name);
     if (raw == nullptr || raw[0] == '\0') {
@@ -176,14 +136,79 @@ unsigned int configuredMaxWorkerThreads() {
                                                 static_cast<int>(kDefaultMaxWorkerThreads), 1, 64));
 }
 
-int configuredMaxUploadsPerFrame() {
-    return readEnvInt("VOXEL_MAX_UPLOADS_PER_FRAME", kDefaultMaxUploadsPerFrame, 1, 64);
+// Calls fn(i) for every i in [0, count) across threadCount helper threads and
+// the caller, each taking the next index as it finishes one.
+template <typename Fn> void runParallel(std::size_t count, unsigned int threadCount, Fn &&fn) {
+    std::atomic<std::size_t> next{0};
+    const auto drain = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+    std::vector<std::thread> helpers;
+    const std::size_t helperCount =
+        std::min<std::size_t>(threadCount, count > 0 ? count - 1 : 0);
+    helpers.reserve(helperCount);
+    for (std::size_t i = 0; i < helperCount; ++i) {
+        helpers.emplace_back(drain);
+    }
+    drain();
+    for (std::thread &helper : helpers) {
+        helper.join();
+    }
+}
+
+// Like runParallel, but the caller only waits, calling tick(done) about once a
+// frame with the number of indices finished, and once more when all are.
+template <typename Fn, typename Tick>
+void runParallelTicking(std::size_t count, unsigned int threadCount, Fn &&fn, Tick &&tick) {
+    constexpr auto kTickInterval = std::chrono::milliseconds(16);
+    std::atomic<std::size_t> next{0};
+    std::mutex doneMutex;
+    std::condition_variable doneCv;
+    std::size_t done = 0;
+    const auto drain = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (++done == count) {
+                doneCv.notify_one();
+            }
+        }
+    };
+    std::vector<std::thread> helpers;
+    const std::size_t helperCount = std::min<std::size_t>(std::max(1u, threadCount), count);
+    helpers.reserve(helperCount);
+    for (std::size_t i = 0; i < helperCount; ++i) {
+        helpers.emplace_back(drain);
+    }
+    std::unique_lock<std::mutex> lock(doneMutex);
+    while (!doneCv.wait_for(lock, kTickInterval, [&]() { return done == count; })) {
+        const std::size_t soFar = done;
+        lock.unlock();
+        tick(soFar);
+        lock.lock();
+    }
+    lock.unlock();
+    for (std::thread &helper : helpers) {
+        helper.join();
+    }
+    tick(count);
+}
+
+std::size_t configuredUploadBudgetBytes() {
+    return static_cast<std::size_t>(
+               readEnvInt("VOXEL_UPLOAD_BUDGET_KB", kDefaultUploadBudgetKiB, 64, 65536)) *
+           1024u;
 }
 
 } // namespace
 
 World::World(const gfx::TextureAtlas &atlas, std::filesystem::path saveRoot, std::uint32_t seed)
-    : atlas_(atlas), gen_(seed), saveRoot_(std::move(saveRoot)) {
+    : atlas_(atlas), gen_(seed), saveRoot_(std::move(saveRoot)),
+      occlusionCullingEnabled_(readEnvInt("VOXEL_OCCLUSION_CULLING", 1, 0, 1) != 0) {
+    deltaChunkSaves_.store(readEnvInt("VOXEL_DELTA_CHUNK_SAVES", 0, 0, 1) != 0);
+    migrateFullChunks_.store(readEnvInt("VOXEL_MIGRATE_FULL_CHUNKS", 0, 0, 1) != 0);
     const unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
     const unsigned int maxWorkers = std::max(kMinWorkerThreads, configuredMaxWorkerThreads());
     const unsigned int workerCount =
@@ -205,38 +230,38 @@ World::~World() {
         }
     }
 
-    std::lock_guard<std::mutex> lock(chunksMutex_);
-    for (auto &[coord, entry] : chunks_) {
-        if (entry.chunk) {
-            std::vector<world::FurnaceRecordLocal> localFurnaces;
-            localFurnaces.reserve(4);
-            const auto fit = furnaceStateByChunk_.find(coord);
-            if (fit != furnaceStateByChunk_.end()) {
-                for (const FurnaceCoordKey &fKey : fit->second) {
-                    const auto stIt = furnaceStates_.find(fKey);
-                    if (stIt == furnaceStates_.end()) {
-                        continue;
-                    }
-                    if (fKey.y < 0 || fKey.y >= voxel::Chunk::SY) {
-                        continue;
-                    }
-                    const int lx = floorMod(fKey.x, voxel::Chunk::SX);
-                    const int lz = floorMod(fKey.z, voxel::Chunk::SZ);
-                    if (!voxel::isFurnace(entry.chunk->get(lx, fKey.y, lz))) {
-                        continue;
-                    }
-                    world::FurnaceRecordLocal rec{};
-                    rec.x = static_cast<std::uint8_t>(lx);
-                    rec.y = static_cast<std::uint8_t>(fKey.y);
-                    rec.z = static_cast<std::uint8_t>(lz);
-                    rec.state = stIt->second;
-                    localFurnaces.push_back(rec);
-                }
+    // Workers are gone: write queued saves and changed loaded chunks here, a
+    // loaded chunk replacing an older queued copy of itself.
+    std::unordered_map<ChunkCoord, PendingSave, ChunkCoordHash> toWrite;
+    {
+        std::lock_guard<std::mutex> lock(chunksMutex_);
+        toWrite = std::move(pendingSaves_);
+        pendingSaves_.clear();
+        for (const auto &[coord, entry] : chunks_) {
+            if (!entry.chunk) {
+                continue;
             }
-            app::SaveManager::saveChunk(saveRoot_, WorldGen::kGeneratorVersion, *entry.chunk, coord,
-                                        &localFurnaces);
-        }
-    }
+            auto localFurnaces = localFurnacesLocked(coord, *entry.chunk);
+            if (entry.contentRevision == entry.savedRevision && localFurnaces.empty()) {
+                continue;
+            }
+            toWrite[coord] = PendingSave{entry.chunk, std::move(localFurnaces), entry.edits};
+        }
+    }
+    std::vector<std::pair<ChunkCoord, const PendingSave *>> writes;
+    writes.reserve(toWrite.size());
+    for (const auto &[coord, pending] : toWrite) {
+        writes.emplace_back(coord, &pending);
+    }
+    const bool delta = deltaChunkSaves_.load(std::memory_order_relaxed);
+    runParallel(writes.size(), std::max(1u, std::thread::hardware_concurrency()) - 1,
+                [&](std::size_t i) {
+                    const auto &[coord, pending] = writes[i];
+                    app::SaveManager::saveChunk(
+                        saveRoot_, WorldGen::kGeneratorVersion, *pending->chunk, coord,
+                        &pending->furnaces,
+                        delta && pending->edits.overGenerated ? &pending->edits : nullptr);
+                });
 }
 
 int World::floorDiv(int a, int b) {
@@ -502,6 +527,7 @@ void World::processFluidFrontierLocked(
         const int lx = floorMod(wx, voxel::Chunk::SX);
         const int lz = floorMod(wz, voxel::Chunk::SZ);
         it->second.chunk->set(lx, wy, lz, voxel::BASALT);
+        markBlockChangedLocked(it->second, lx, wy, lz);
         clearFluidStateLocked(wx, wy, wz);
         appendFluidRemeshNeighborhoodLocked(cc, true, remeshChunks);
         enqueueFluidNeighborsLocked(wx, wy, wz);
@@ -563,6 +589,7 @@ void World::processFluidFrontierLocked(
                     const int lx = floorMod(cell.x, voxel::Chunk::SX);
                     const int lz = floorMod(cell.z, voxel::Chunk::SZ);
                     it->second.chunk->set(lx, wy, lz, voxel::AIR);
+                    markBlockChangedLocked(it->second, lx, wy, lz);
                     clearFluidStateLocked(cell.x, wy, cell.z);
                     appendFluidRemeshNeighborhoodLocked(cc, waterLikeFluid, remeshChunks);
                     enqueueFluidNeighborsLocked(cell.x, wy, cell.z);
@@ -594,6 +621,7 @@ void World::processFluidFrontierLocked(
                     const int lx = floorMod(cell.x, voxel::Chunk::SX);
                     const int lz = floorMod(cell.z, voxel::Chunk::SZ);
                     downIt->second.chunk->set(lx, wy - 1, lz, fluidId);
+                    markBlockChangedLocked(downIt->second, lx, wy - 1, lz);
                     setFluidStateLocked(fluidId, cell.x, wy - 1, cell.z, 0, false);
                     appendFluidRemeshNeighborhoodLocked(downCc, waterLikeFluid, remeshChunks);
                     enqueueFluidNeighborsLocked(cell.x, wy - 1, cell.z);
@@ -636,6 +664,7 @@ void World::processFluidFrontierLocked(
                 const int lx = floorMod(nx, voxel::Chunk::SX);
                 const int lz = floorMod(nz, voxel::Chunk::SZ);
                 nit->second.chunk->set(lx, wy, lz, fluidId);
+                markBlockChangedLocked(nit->second, lx, wy, lz);
                 setFluidStateLocked(fluidId, nx, wy, nz, static_cast<std::uint8_t>(outLevel),
                                     false);
                 appendFluidRemeshNeighborhoodLocked(ncc, waterLikeFluid, remeshChunks);
@@ -715,12 +744,16 @@ void World::enqueueRemesh(ChunkCoord cc, bool force, bool urgent) {
         pendingRemeshDirty_.erase(cc);
         return;
     }
+    scheduleWorkerJob(makeRemeshJobLocked(cc, it->second.chunk, urgent));
+}
 
+World::WorkerJob World::makeRemeshJobLocked(ChunkCoord cc, std::shared_ptr<voxel::Chunk> chunk,
+                                            bool urgent) const {
     WorkerJob job;
     job.type = JobType::Remesh;
     job.coord = cc;
     job.urgent = urgent;
-    job.chunkSnapshot = it->second.chunk;
+    job.chunkSnapshot = std::move(chunk);
 
     auto nit = chunks_.find(ChunkCoord{cc.x + 1, cc.z});
     if (nit != chunks_.end())
@@ -771,8 +804,7 @@ void World::enqueueRemesh(ChunkCoord cc, bool force, bool urgent) {
             job.lavaLevels.emplace(fc, fs.level);
         }
     }
-
-    scheduleWorkerJob(std::move(job));
+    return job;
 }
 
 void World::scheduleWorkerJob(WorkerJob job) {
@@ -789,6 +821,41 @@ std::unique_ptr<gfx::CpuMesh> World::acquireMeshBuffer() {
     return mesh;
 }
 
+void World::refillStagingSlabs() {
+    const std::size_t target = std::min(workers_.size() * 2, kMaxStagingSlabs);
+    std::lock_guard<std::mutex> lock(stagingSlabsMutex_);
+    while (stagingSlabs_.size() < target) {
+        const auto slab = geometryArena_.reserveSlab(kStagingSlabBytes);
+        if (!slab.has_value()) {
+            // The ring reclaims in order, so idle slabs would keep it full.
+            for (const gfx::StagingSlab &idle : stagingSlabs_) {
+                geometryArena_.releaseSlab(idle);
+            }
+            stagingSlabs_.clear();
+            return;
+        }
+        stagingSlabs_.push_back(*slab);
+    }
+}
+
+std::optional<gfx::StagingSlab> World::takeStagingSlab() {
+    std::lock_guard<std::mutex> lock(stagingSlabsMutex_);
+    if (stagingSlabs_.empty()) {
+        return std::nullopt;
+    }
+    const gfx::StagingSlab slab = stagingSlabs_.back();
+    stagingSlabs_.pop_back();
+    return slab;
+}
+
+void World::recycleResult(WorkerResult &result) {
+    if (result.staged.has_value()) {
+        geometryArena_.releaseSlab(result.staged->slab);
+        result.staged.reset();
+    }
+    recycleMeshBuffer(std::move(result.mesh));
+}
+
 void World::recycleMeshBuffer(std::unique_ptr<gfx::CpuMesh> mesh) {
     if (!mesh) {
         return;
@@ -810,6 +877,14 @@ void World::setStreamingRadii(int loadRadius, int unloadRadius) {
     streamDirty_.store(true, std::memory_order_relaxed);
 }
 
+void World::setDeltaChunkSaves(bool enabled) {
+    deltaChunkSaves_.store(enabled, std::memory_order_relaxed);
+}
+
+void World::setMigrateFullChunks(bool enabled) {
+    migrateFullChunks_.store(enabled, std::memory_order_relaxed);
+}
+
 void World::setSmoothLighting(bool enabled) {
     if (smoothLighting_.load(std::memory_order_relaxed) == enabled) {
         return;
@@ -838,9 +913,65 @@ WorldDebugStats World::debugStats() const {
         }
         stats.totalTriangles += entry.triangleCount;
     }
+    stats.drawnChunks = lastDrawnChunks_;
+    stats.culledChunks = lastCulledChunks_;
+    stats.occludedChunks = lastOccludedChunks_;
+    stats.timeToFirstPlayableMs = timeToFirstPlayableMs_;
+    stats.preloadedChunks = preloadedChunks_;
     return stats;
 }
 
+void World::markChunkChangedLocked(ChunkEntry &entry) {
+    entry.contentRevision = worldRevision_.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void World::markBlockChangedLocked(ChunkEntry &entry, int lx, int y, int lz) {
+    entry.edits.add(voxel::Chunk::index(lx, y, lz));
+    markChunkChangedLocked(entry);
+}
+
+std::vector<std::pair<ChunkCoord, std::uint64_t>> World::loadedChunkRevisions() const {
+    std::lock_guard<std::mutex> lock(chunksMutex_);
+    std::vector<std::pair<ChunkCoord, std::uint64_t>> out;
+    out.reserve(chunks_.size());
+    for (const auto &[cc, entry] : chunks_) {
+        if (entry.chunk) {
+            out.emplace_back(cc, entry.contentRevision);
+        }
+    }
+    return out;
+}
+
+std::uint64_t World::chunkRevision(ChunkCoord cc) const {
+    std::lock_guard<std::mutex> lock(chunksMutex_);
+    const auto it = chunks_.find(cc);
+    if (it == chunks_.end() || !it->second.chunk) {
+        return 0;
+    }
+    return it->second.contentRevision;
+}
+
+bool World::copyChunk(ChunkCoord cc, voxel::Chunk &out, std::uint64_t &outRevision) const {
+    std::lock_guard<std::mutex> lock(chunksMutex_);
+    const auto it = chunks_.find(cc);
+    if (it == chunks_.end() || !it->second.chunk) {
+        return false;
+    }
+    // Assign into the caller's buffer so repeated snapshots reuse its storage.
+    out.data() = it->second.chunk->data();
+    outRevision = it->second.contentRevision;
+    return true;
+}
+
+std::shared_ptr<const voxel::Chunk> World::chunkAt(ChunkCoord cc) const {
+    std::lock_guard<std::mutex> lock(chunksMutex_);
+    const auto it = chunks_.find(cc);
+    if (it == chunks_.end()) {
+        return nullptr;
+    }
+    return it->second.chunk;
+}
+
 std::vector<ChunkCoord> World::loadedChunkCoords() const {
     std::lock_guard<std::mutex> lock(chunksMutex_);
     std::vector<ChunkCoord> out;
@@ -853,6 +984,100 @@ std::vector<ChunkCoord> World::loadedChunkCoords() const {
     return out;
 }
 
+int World::preloadSpawnArea(const glm::vec3 &pos, int radius,
+                            const PreloadProgress &onProgress) {
+    const ChunkCoord center = worldToChunk(static_cast<int>(std::floor(pos.x)),
+                                           static_cast<int>(std::floor(pos.z)));
+    radius = std::max(0, radius);
+    playerChunkPacked_.store(packChunkCoord(center.x, center.z), std::memory_order_relaxed);
+    const unsigned int threadCount = static_cast<unsigned int>(workers_.size());
+
+    // The ring just outside radius is loaded but not meshed, so every inner
+    // chunk sees all eight neighbours and is meshed exactly once.
+    std::vector<ChunkCoord> toLoad;
+    {
+        std::lock_guard<std::mutex> lock(chunksMutex_);
+        for (int dz = -radius - 1; dz <= radius + 1; ++dz) {
+            for (int dx = -radius - 1; dx <= radius + 1; ++dx) {
+                const ChunkCoord cc{center.x + dx, center.z + dz};
+                if (chunks_.find(cc) == chunks_.end() &&
+                    pendingLoad_.find(cc) == pendingLoad_.end()) {
+                    toLoad.push_back(cc);
+                }
+            }
+        }
+    }
+    // Progress counts loads and then meshes; inner chunks that already had a
+    // mesh count as done when the mesh pass starts.
+    const int innerSide = 2 * radius + 1;
+    const int total = static_cast<int>(toLoad.size()) + innerSide * innerSide;
+    const auto forEach = [&](std::size_t count, int doneBefore, auto &&fn) {
+        if (!onProgress) {
+            runParallel(count, threadCount, fn);
+            return;
+        }
+        runParallelTicking(count, threadCount, fn, [&](std::size_t done) {
+            onProgress(doneBefore + static_cast<int>(done), total);
+        });
+    };
+
+    std::vector<std::shared_ptr<voxel::Chunk>> loaded(toLoad.size());
+    std::vector<ChunkEdits> loadedEdits(toLoad.size());
+    forEach(toLoad.size(), 0, [&](std::size_t i) {
+        loaded[i] = loadOrGenerateChunk(toLoad[i], loadedEdits[i]);
+    });
+
+    std::vector<WorkerJob> jobs;
+    {
+        std::lock_guard<std::mutex> lock(chunksMutex_);
+        for (std::size_t i = 0; i < toLoad.size(); ++i) {
+            ChunkEntry &entry = chunks_[toLoad[i]];
+            entry.chunk = std::move(loaded[i]);
+            entry.edits = std::move(loadedEdits[i]);
+            seedFluidFrontierForChunkLocked(toLoad[i], *entry.chunk);
+            markChunkChangedLocked(entry);
+            entry.savedRevision = entry.contentRevision;
+        }
+        for (int dz = -radius; dz <= radius; ++dz) {
+            for (int dx = -radius; dx <= radius; ++dx) {
+                const ChunkCoord cc{center.x + dx, center.z + dz};
+                const auto it = chunks_.find(cc);
+                if (it == chunks_.end() || !it->second.chunk || it->second.mesh ||
+                    !pendingRemesh_.insert(cc).second) {
+                    continue;
+                }
+                jobs.push_back(makeRemeshJobLocked(cc, it->second.chunk, true));
+            }
+        }
+    }
+    refillStagingSlabs();
+    std::vector<WorkerResult> meshes(jobs.size());
+    forEach(jobs.size(), total - static_cast<int>(jobs.size()),
+            [&](std::size_t i) { meshes[i] = buildMesh(jobs[i]); });
+
+    {
+        std::lock_guard<std::mutex> lock(chunksMutex_);
+        for (WorkerResult &result : meshes) {
+            pendingRemesh_.erase(result.coord);
+            const bool needsAnotherRemesh = (pendingRemeshDirty_.erase(result.coord) > 0);
+            const auto it = chunks_.find(result.coord);
+            if (it != chunks_.end()) {
+                installMeshLocked(it->second, result);
+                if (needsAnotherRemesh) {
+                    enqueueRemesh(result.coord, false, true);
+                }
+            }
+            recycleResult(result);
+        }
+        timeToFirstPlayableMs_ = std::chrono::duration<float, std::milli>(
+                                     std::chrono::steady_clock::now() - openedAt_)
+                                     .count();
+        preloadedChunks_ = static_cast<int>(meshes.size());
+    }
+    geometryArena_.endFrame();
+    return static_cast<int>(meshes.size());
+}
+
 void World::updateStream(const glm::vec3 &playerPos, const glm::vec3 &cameraForward) {
     const int pChunkX = floorDiv(static_cast<int>(std::floor(playerPos.x)), voxel::Chunk::SX);
     const int pChunkZ = floorDiv(static_cast<int>(std::floor(playerPos.z)), voxel::Chunk::SZ);
@@ -936,43 +1161,12 @@ void World::updateStream(const glm::vec3 &playerPos, const glm::vec3 &cameraForw
             continue;
         }
         if (it->second.chunk) {
-            std::vector<world::FurnaceRecordLocal> localFurnaces;
-            localFurnaces.reserve(4);
-            const auto fit = furnaceStateByChunk_.find(cc);
-            if (fit != furnaceStateByChunk_.end()) {
-                for (const FurnaceCoordKey &fKey : fit->second) {
-                    const auto stIt = furnaceStates_.find(fKey);
-                    if (stIt == furnaceStates_.end()) {
-                        continue;
-                    }
-                    if (fKey.y < 0 || fKey.y >= voxel::Chunk::SY) {
-                        continue;
-                    }
-                    const int lx = floorMod(fKey.x, voxel::Chunk::SX);
-                    const int lz = floorMod(fKey.z, voxel::Chunk::SZ);
-                    if (!voxel::isFurnace(it->second.chunk->get(lx, fKey.y, lz))) {
-                        continue;
-                    }
-                    world::FurnaceRecordLocal rec{};
-                    rec.x = static_cast<std::uint8_t>(lx);
-                    rec.y = static_cast<std::uint8_t>(fKey.y);
-                    rec.z = static_cast<std::uint8_t>(lz);
-                    rec.state = stIt->second;
-                    localFurnaces.push_back(rec);
-                }
-            }
-            app::SaveManager::saveChunk(saveRoot_, WorldGen::kGeneratorVersion, *it->second.chunk,
-                                        cc, &localFurnaces);
-            if (fit != furnaceStateByChunk_.end()) {
-                for (const FurnaceCoordKey &fKey : fit->second) {
-                    furnaceStates_.erase(fKey);
-                }
-                furnaceStateByChunk_.erase(fit);
-            }
+            saveChunkLocked(cc, it->second);
+            furnaces_.eraseChunk(cc);
         }
         chunks_.erase(it);
+        columnTree_.erase(cc);
         worldRevision_.fetch_add(1, std::memory_order_relaxed);
-        transparentCacheValid_ = false;
         pendingLoad_.erase(cc);
         pendingRemesh_.erase(cc);
         pendingRemeshDirty_.erase(cc);
@@ -1036,10 +1230,13 @@ void World::uploadReadyMeshes() {
         enqueueRemesh(ChunkCoord{cc.x - 1, cc.z - 1}, true);
     };
 
-    int uploadsThisFrame = 0;
-    const int maxUploadsPerFrame = configuredMaxUploadsPerFrame();
+    refillStagingSlabs();
+    // Budget is in bytes so a frame full of tiny remeshes is not throttled like
+    // one full of dense chunks. The mesh that crosses the budget still uploads.
+    std::size_t bytesThisFrame = 0;
+    const std::size_t uploadBudgetBytes = configuredUploadBudgetBytes();
     WorkerResult result;
-    while (uploadsThisFrame < maxUploadsPerFrame &&
+    while (bytesThisFrame < uploadBudgetBytes &&
            completed_.tryPopBest(result, [this](const WorkerResult &a, const WorkerResult &b) {
                if (a.urgent != b.urgent) {
                    return a.urgent;
@@ -1070,7 +1267,7 @@ void World::uploadReadyMeshes() {
             if (it == chunks_.end() || !it->second.chunk) {
                 pendingRemesh_.erase(result.coord);
                 pendingRemeshDirty_.erase(result.coord);
-                recycleMeshBuffer(std::move(result.mesh));
+                recycleResult(result);
                 continue;
             }
         }
@@ -1078,6 +1275,7 @@ void World::uploadReadyMeshes() {
         auto &entry = chunks_[result.coord];
         if (result.replaceChunk) {
             entry.chunk = std::move(result.chunk);
+            entry.edits = std::move(result.edits);
             pendingLoad_.erase(result.coord);
             if (entry.chunk) {
                 seedFluidFrontierForChunkLocked(result.coord, *entry.chunk);
@@ -1087,8 +1285,8 @@ void World::uploadReadyMeshes() {
             enqueueRemesh(result.coord, true);
             // New chunk may occlude neighbor border faces.
             enqueueNeighborRingRemesh(result.coord);
-            worldRevision_.fetch_add(1, std::memory_order_relaxed);
-            transparentCacheValid_ = false;
+            markChunkChangedLocked(entry);
+            entry.savedRevision = entry.contentRevision;
             // Don't spend mesh-upload budget on load completion records.
             recycleMeshBuffer(std::move(result.mesh));
             continue;
@@ -1100,114 +1298,206 @@ void World::uploadReadyMeshes() {
             continue;
         }
 
-        if (!entry.mesh) {
-            entry.mesh = std::make_unique<gfx::ChunkMesh>();
-        }
-        entry.mesh->upload(*result.mesh);
-        entry.triangleCount = static_cast<int>(result.mesh->indices.size() / 3);
-        worldRevision_.fetch_add(1, std::memory_order_relaxed);
-        transparentCacheValid_ = false;
+        bytesThisFrame += installMeshLocked(entry, result);
         if (needsAnotherRemesh) {
             enqueueRemesh(result.coord, false, result.urgent);
         }
-        recycleMeshBuffer(std::move(result.mesh));
-        ++uploadsThisFrame;
+        recycleResult(result);
     }
+    geometryArena_.endFrame();
 }
 
-void World::draw(const glm::vec3 &cameraPos, float maxDrawDistance, const glm::mat4 &viewProj) const {
-    std::lock_guard<std::mutex> lock(chunksMutex_);
-    const float maxDist = std::max(maxDrawDistance, static_cast<float>(voxel::Chunk::SX));
-    const float maxDist2 = maxDist * maxDist;
-    const FrustumPlanes frustum = extractFrustumPlanes(viewProj);
-    const float chunkRadius = 0.5f * std::sqrt(static_cast<float>(voxel::Chunk::SX * voxel::Chunk::SX +
-                                                                   voxel::Chunk::SY * voxel::Chunk::SY +
-                                                                   voxel::Chunk::SZ * voxel::Chunk::SZ));
-    for (const auto &[coord, entry] : chunks_) {
-        if (!entry.mesh) {
-            continue;
-        }
-        const float cx = static_cast<float>(coord.x * voxel::Chunk::SX + voxel::Chunk::SX / 2);
-        const float cy = static_cast<float>(voxel::Chunk::SY) * 0.5f;
-        const float cz = static_cast<float>(coord.z * voxel::Chunk::SZ + voxel::Chunk::SZ / 2);
-        const float dx = cx - cameraPos.x;
-        const float dz = cz - cameraPos.z;
-        if ((dx * dx + dz * dz) > maxDist2) {
-            continue;
-        }
-        if (!sphereInFrustum(frustum, glm::vec3(cx, cy, cz), chunkRadius)) {
-            continue;
-        }
-        entry.mesh->draw();
+std::size_t World::installMeshLocked(ChunkEntry &entry, WorkerResult &result) {
+    if (!entry.mesh) {
+        entry.mesh = std::make_unique<gfx::ChunkMesh>(geometryArena_);
     }
+    if (result.staged.has_value()) {
+        entry.mesh->uploadStaged(*result.staged);
+        result.staged.reset();
+    } else {
+        entry.mesh->upload(*result.mesh);
+    }
+    entry.triangleCount = static_cast<int>(result.mesh->indices.size() / 3);
+    entry.sectionBounds = result.mesh->sectionBounds;
+    entry.visibility = result.visibility;
+    if (result.mesh->bounds.empty()) {
+        columnTree_.erase(result.coord);
+    } else {
+        columnTree_.insert(result.coord, result.mesh->bounds.minY, result.mesh->bounds.maxY);
+    }
+    worldRevision_.fetch_add(1, std::memory_order_relaxed);
+    return result.mesh->vertices.size() * sizeof(gfx::Vertex) +
+           result.mesh->indices.size() * sizeof(std::uint32_t);
+}
+
+template <typename Visit>
+void World::forEachVisibleMeshLocked(const glm::vec3 &cameraPos, float maxDist,
+                                     const glm::mat4 &viewProj, Visit visit, int &drawn,
+                                     int &culled, int &occluded) const {
+    const FrustumPlanes frustum = extractFrustumPlanes(viewProj);
+    ChunkColumnTree::QueryStats query;
+    int sectionCulled = 0;
+    drawn = 0;
+    occluded = 0;
+    columnTree_.query(
+        frustum, cameraPos, maxDist,
+        [&](ChunkCoord coord, float, float) {
+            const auto it = chunks_.find(coord);
+            if (it == chunks_.end() || !it->second.mesh) {
+                return;
+            }
+            if (occlusionActive_ && !occlusion_.isColumnVisible(coord)) {
+                ++occluded;
+                return;
+            }
+            // The column box passed; reject it if none of its occupied sections do.
+            const float x0 = static_cast<float>(coord.x * voxel::Chunk::SX);
+            const float z0 = static_cast<float>(coord.z * voxel::Chunk::SZ);
+            bool anySection = false;
+            for (const gfx::MeshYBounds &section : it->second.sectionBounds) {
+                if (!section.empty() &&
+                    aabbInFrustum(frustum, glm::vec3(x0, section.minY, z0),
+                                  glm::vec3(x0 + voxel::Chunk::SX, section.maxY,
+                                            z0 + voxel::Chunk::SZ))) {
+                    anySection = true;
+                    break;
+                }
+            }
+            if (!anySection) {
+                ++sectionCulled;
+                return;
+            }
+            ++drawn;
+            visit(coord, *it->second.mesh);
+        },
+        query);
+    culled = query.culled + sectionCulled;
 }
 
-void World::drawTransparent(const glm::vec3 &cameraPos, const glm::vec3 &cameraForward,
-                            float maxDrawDistance, const glm::mat4 &viewProj) const {
+void World::prepareDrawLists(const glm::vec3 &cameraPos, const glm::vec3 &cameraForward,
+                             float maxDrawDistance, const glm::mat4 &viewProj) const {
     std::lock_guard<std::mutex> lock(chunksMutex_);
     const glm::vec3 fwd = (std::abs(cameraForward.x) < 1e-6f && std::abs(cameraForward.y) < 1e-6f &&
                            std::abs(cameraForward.z) < 1e-6f)
                               ? glm::vec3(0.0f, 0.0f, -1.0f)
                               : glm::normalize(cameraForward);
     const float maxDist = std::max(maxDrawDistance, static_cast<float>(voxel::Chunk::SX));
-    const float maxDist2 = maxDist * maxDist;
-    const FrustumPlanes frustum = extractFrustumPlanes(viewProj);
-    const float chunkRadius = 0.5f * std::sqrt(static_cast<float>(voxel::Chunk::SX * voxel::Chunk::SX +
-                                                                   voxel::Chunk::SY * voxel::Chunk::SY +
-                                                                   voxel::Chunk::SZ * voxel::Chunk::SZ));
-    const std::uint64_t revision = worldRevision_.load(std::memory_order_relaxed);
-    const glm::vec3 posDelta = cameraPos - transparentCachePos_;
-    const glm::vec3 forwardDelta = fwd - transparentCacheForward_;
-    const bool samePos = glm::dot(posDelta, posDelta) < 1e-8f;
-    const bool sameForward = glm::dot(forwardDelta, forwardDelta) < 1e-8f;
-    const bool sameMaxDist = std::abs(transparentCacheMaxDist_ - maxDist) < 1e-6f;
-    if (!transparentCacheValid_ || transparentCacheRevision_ != revision || !samePos || !sameForward ||
-        !sameMaxDist) {
-        transparentDrawCache_.clear();
-        transparentDrawCache_.reserve(chunks_.size());
-        for (const auto &[coord, entry] : chunks_) {
-            if (!entry.mesh) {
-                continue;
-            }
-            const float cx = static_cast<float>(coord.x * voxel::Chunk::SX + voxel::Chunk::SX / 2);
-            const float cy = static_cast<float>(voxel::Chunk::SY) * 0.5f;
-            const float cz = static_cast<float>(coord.z * voxel::Chunk::SZ + voxel::Chunk::SZ / 2);
-            const glm::vec3 toChunk(cx - cameraPos.x, 0.0f, cz - cameraPos.z);
-            const float dx = toChunk.x;
-            const float dz = toChunk.z;
-            const float dist2 = dx * dx + dz * dz;
-            if (dist2 > maxDist2) {
-                continue;
-            }
-            if (!sphereInFrustum(frustum, glm::vec3(cx, cy, cz), chunkRadius)) {
-                continue;
-            }
-            transparentDrawCache_.push_back(
-                TransparentDrawItem{entry.mesh.get(), coord, glm::dot(toChunk, fwd), dist2});
-        }
-        std::sort(transparentDrawCache_.begin(), transparentDrawCache_.end(),
-                  [](const TransparentDrawItem &a, const TransparentDrawItem &b) {
-                      if (a.depth != b.depth) {
-                          return a.depth > b.depth; // farther along view direction first
-                      }
-                      if (a.dist2 != b.dist2) {
-                          return a.dist2 > b.dist2;
-                      }
-                      if (a.coord.x != b.coord.x) {
-                          return a.coord.x < b.coord.x;
-                      }
-                      return a.coord.z < b.coord.z;
-                  });
-        transparentCachePos_ = cameraPos;
-        transparentCacheForward_ = fwd;
-        transparentCacheMaxDist_ = maxDist;
-        transparentCacheRevision_ = revision;
-        transparentCacheValid_ = true;
+    occlusionActive_ =
+        occlusionCullingEnabled_ &&
+        occlusion_.compute(cameraPos, extractFrustumPlanes(viewProj), maxDist,
+                           [this](ChunkCoord cc, int section) -> const voxel::SectionVisibility * {
+                               const auto it = chunks_.find(cc);
+                               if (it == chunks_.end() || !it->second.mesh) {
+                                   return nullptr;
+                               }
+                               return &it->second.visibility[static_cast<std::size_t>(section)];
+                           });
+    opaqueBatch_.clear();
+    visibleMeshes_.clear();
+    forEachVisibleMeshLocked(
+        cameraPos, maxDist, viewProj,
+        [this](ChunkCoord coord, const gfx::ChunkMesh &mesh) {
+            mesh.appendTo(opaqueBatch_);
+            visibleMeshes_.emplace(coord, &mesh);
+        },
+        lastDrawnChunks_, lastCulledChunks_, lastOccludedChunks_);
+
+    updateTransparentOrderLocked(cameraPos, fwd);
+    transparentBatch_.clear();
+    for (const TransparentDrawItem &item : transparentDrawCache_) {
+        item.mesh->appendTo(transparentBatch_);
     }
+}
 
-    for (const TransparentDrawItem &item : transparentDrawCache_) {
-        item.mesh->draw();
+void World::updateTransparentOrderLocked(const glm::vec3 &cameraPos, const glm::vec3 &fwd) const {
+    // Keep last frame's order for chunks that are still visible, refreshing
+    // their mesh pointers, then append newcomers for the sort to place.
+    std::size_t kept = 0;
+    for (TransparentDrawItem &item : transparentDrawCache_) {
+        const auto it = visibleMeshes_.find(item.coord);
+        if (it == visibleMeshes_.end()) {
+            continue;
+        }
+        item.mesh = it->second;
+        transparentDrawCache_[kept++] = item;
+        visibleMeshes_.erase(it);
+    }
+    const bool membershipChanged = kept != transparentDrawCache_.size() || !visibleMeshes_.empty();
+    transparentDrawCache_.resize(kept);
+    for (const auto &[coord, mesh] : visibleMeshes_) {
+        transparentDrawCache_.push_back(TransparentDrawItem{mesh, coord, 0.0f, 0.0f});
+    }
+
+    // Chunk-granular ordering barely changes inside a few blocks or a few
+    // degrees, so key the sort to quantised camera state rather than exact pose.
+    const float yaw = std::atan2(fwd.z, fwd.x);
+    const float pitch = std::asin(std::clamp(fwd.y, -1.0f, 1.0f));
+    const TransparentSortKey key{
+        static_cast<int>(std::floor(cameraPos.x / kTransparentSortCell)),
+        static_cast<int>(std::floor(cameraPos.y / kTransparentSortCell)),
+        static_cast<int>(std::floor(cameraPos.z / kTransparentSortCell)),
+        static_cast<int>(std::floor(yaw / kTransparentYawStep)),
+        static_cast<int>(std::floor(pitch / kTransparentPitchStep))};
+    if (transparentSortValid_ && !membershipChanged && key == transparentSortKey_) {
+        return;
+    }
+
+    const glm::vec3 cell = (glm::vec3(static_cast<float>(key.cellX), static_cast<float>(key.cellY),
+                                      static_cast<float>(key.cellZ)) +
+                            glm::vec3(0.5f)) *
+                           kTransparentSortCell;
+    const float qYaw = (static_cast<float>(key.yaw) + 0.5f) * kTransparentYawStep;
+    const float qPitch = (static_cast<float>(key.pitch) + 0.5f) * kTransparentPitchStep;
+    const glm::vec3 qFwd(std::cos(qPitch) * std::cos(qYaw), std::sin(qPitch),
+                         std::cos(qPitch) * std::sin(qYaw));
+    for (TransparentDrawItem &item : transparentDrawCache_) {
+        const float cx = static_cast<float>(item.coord.x * voxel::Chunk::SX + voxel::Chunk::SX / 2);
+        const float cz = static_cast<float>(item.coord.z * voxel::Chunk::SZ + voxel::Chunk::SZ / 2);
+        const glm::vec3 toChunk(cx - cell.x, 0.0f, cz - cell.z);
+        item.depth = glm::dot(toChunk, qFwd);
+        item.dist2 = toChunk.x * toChunk.x + toChunk.z * toChunk.z;
     }
+
+    const auto before = [](const TransparentDrawItem &a, const TransparentDrawItem &b) {
+        if (a.depth != b.depth) {
+            return a.depth > b.depth; // farther along view direction first
+        }
+        if (a.dist2 != b.dist2) {
+            return a.dist2 > b.dist2;
+        }
+        if (a.coord.x != b.coord.x) {
+            return a.coord.x < b.coord.x;
+        }
+        return a.coord.z < b.coord.z;
+    };
+    std::size_t descents = 0;
+    for (std::size_t i = 1; i < transparentDrawCache_.size(); ++i) {
+        descents += before(transparentDrawCache_[i], transparentDrawCache_[i - 1]) ? 1u : 0u;
+    }
+    if (descents * 4u > transparentDrawCache_.size()) {
+        std::sort(transparentDrawCache_.begin(), transparentDrawCache_.end(), before);
+    } else {
+        // Nearly sorted after a small camera step: insertion sort is linear here.
+        for (std::size_t i = 1; i < transparentDrawCache_.size(); ++i) {
+            TransparentDrawItem item = transparentDrawCache_[i];
+            std::size_t j = i;
+            while (j > 0 && before(item, transparentDrawCache_[j - 1])) {
+                transparentDrawCache_[j] = transparentDrawCache_[j - 1];
+                --j;
+            }
+            transparentDrawCache_[j] = item;
+        }
+    }
+    transparentSortKey_ = key;
+    transparentSortValid_ = true;
+}
+
+void World::draw() const {
+    geometryArena_.draw(opaqueBatch_);
+}
+
+void World::drawTransparent() const {
+    geometryArena_.draw(transparentBatch_);
 }
 
 voxel::BlockId World::getBlock(int wx, int wy, int wz) const {
@@ -1228,7 +1518,10 @@ voxel::BlockId World::getBlock(int wx, int wy, int wz) const {
 }
 
 bool World::isSolidBlock(int wx, int wy, int wz) const {
-    const voxel::BlockId id = getBlock(wx, wy, wz);
+    return isSolidBlockId(getBlock(wx, wy, wz));
+}
+
+bool World::isSolidBlockId(voxel::BlockId id) const {
     if (id == voxel::AIR || voxel::isFluid(id) || voxel::isPlant(id) || voxel::isTorch(id)) {
         return false;
     }
@@ -1236,7 +1529,10 @@ bool World::isSolidBlock(int wx, int wy, int wz) const {
 }
 
 bool World::isTargetBlock(int wx, int wy, int wz) const {
-    const voxel::BlockId id = getBlock(wx, wy, wz);
+    return isTargetBlockId(getBlock(wx, wy, wz));
+}
+
+bool World::isTargetBlockId(voxel::BlockId id) const {
     if (id == voxel::AIR || (voxel::isFluid(id) && !voxel::isWaterloggedPlant(id))) {
         return false;
     }
@@ -1251,66 +1547,40 @@ bool World::isChunkLoadedAt(int wx, int wz) const {
 }
 
 glm::vec3 World::fluidCurrentAt(const glm::vec3 &pos) const {
-    const int wx = static_cast<int>(std::floor(pos.x));
-    const int wy = static_cast<int>(std::floor(pos.y));
-    const int wz = static_cast<int>(std::floor(pos.z));
+    const glm::ivec3 cell(static_cast<int>(std::floor(pos.x)), static_cast<int>(std::floor(pos.y)),
+                          static_cast<int>(std::floor(pos.z)));
+    VoxelWindow window;
+    gatherVoxelWindow(cell - glm::ivec3(1, 1, 1), cell + glm::ivec3(1, 0, 1), window);
+    return window.fluidCurrentAt(pos);
+}
 
+void World::gatherVoxelWindow(const glm::ivec3 &minCell, const glm::ivec3 &maxCell,
+                              VoxelWindow &out) const {
+    out.reset(minCell, maxCell);
+    const int minY = std::max(minCell.y, 0);
+    const int maxY = std::min(maxCell.y, voxel::Chunk::SY - 1);
     std::lock_guard<std::mutex> lock(chunksMutex_);
-    const voxel::BlockId id = getBlockLoadedLocked(wx, wy, wz);
-    const bool waterLike = (isWaterBlock(id) || voxel::isWaterloggedPlant(id));
-    const bool lavaLike = isLavaBlock(id);
-    if (!waterLike && !lavaLike) {
-        return glm::vec3(0.0f);
-    }
-    const voxel::BlockId fluidId = lavaLike ? voxel::LAVA : voxel::WATER;
-    const int maxFlow = (fluidId == voxel::WATER) ? kWaterMaxFlowLevel : kLavaMaxFlowLevel;
-
-    auto isSameFluidAt = [&](int x, int y, int z) {
-        const voxel::BlockId bid = getBlockLoadedLocked(x, y, z);
-        return (fluidId == voxel::WATER) ? (isWaterBlock(bid) || voxel::isWaterloggedPlant(bid))
-                                         : isLavaBlock(bid);
-    };
-    auto isOpenAt = [&](int x, int y, int z) {
-        const voxel::BlockId bid = getBlockLoadedLocked(x, y, z);
-        if (bid == voxel::AIR || voxel::isPlant(bid) || voxel::isTorch(bid)) {
-            return true;
-        }
-        return false;
-    };
-    auto levelAt = [&](int x, int y, int z) -> int {
-        if (!isSameFluidAt(x, y, z)) {
-            return -1;
-        }
-        return fluidLevelAtLocked(fluidId, x, y, z);
-    };
-
-    const int centerLevel = std::max(0, levelAt(wx, wy, wz));
-    glm::vec3 flow(0.0f);
-    const std::array<glm::ivec2, 4> kDirs = {
-        glm::ivec2{1, 0}, glm::ivec2{-1, 0}, glm::ivec2{0, 1}, glm::ivec2{0, -1}};
-    for (const glm::ivec2 d : kDirs) {
-        const int nx = wx + d.x;
-        const int nz = wz + d.y;
-        const int nLevel = levelAt(nx, wy, nz);
-        if (nLevel >= 0) {
-            // Flow from stronger sources (low level) toward weaker cells (high level).
-            flow += glm::vec3(static_cast<float>(d.x), 0.0f, static_cast<float>(d.y)) *
-                    static_cast<float>(nLevel - centerLevel);
-        } else if (isOpenAt(nx, wy, nz)) {
-            flow += glm::vec3(static_cast<float>(d.x), 0.0f, static_cast<float>(d.y)) *
-                    static_cast<float>(maxFlow - centerLevel + 1);
+    for (int wz = minCell.z; wz <= maxCell.z; ++wz) {
+        for (int wx = minCell.x; wx <= maxCell.x; ++wx) {
+            const auto it = chunks_.find(worldToChunk(wx, wz));
+            if (it == chunks_.end() || !it->second.chunk) {
+                continue;
+            }
+            const voxel::Chunk &chunk = *it->second.chunk;
+            const int lx = floorMod(wx, voxel::Chunk::SX);
+            const int lz = floorMod(wz, voxel::Chunk::SZ);
+            for (int wy = minY; wy <= maxY; ++wy) {
+                const voxel::BlockId id = chunk.getUnchecked(lx, wy, lz);
+                int level = -1;
+                if (voxel::isWaterLike(id)) {
+                    level = fluidLevelAtLocked(voxel::WATER, wx, wy, wz);
+                } else if (voxel::isLavaLike(id)) {
+                    level = fluidLevelAtLocked(voxel::LAVA, wx, wy, wz);
+                }
+                out.set(wx, wy, wz, id, isSolidBlockId(id), level);
+            }
         }
     }
-    if (!isSameFluidAt(wx, wy - 1, wz) && isOpenAt(wx, wy - 1, wz)) {
-        flow.y -= 1.5f;
-    }
-
-    const float len = glm::length(flow);
-    if (len <= 1e-5f) {
-        return glm::vec3(0.0f);
-    }
-    const float strength = (fluidId == voxel::WATER) ? 16.0f : 8.0f;
-    return (flow / len) * strength;
 }
 
 std::string World::biomeLabelAt(int wx, int wz) const {
@@ -1366,6 +1636,7 @@ bool World::setBlock(int wx, int wy, int wz, voxel::BlockId id) {
         return true;
     }
     it->second.chunk->set(lx, wy, lz, nextId);
+    markBlockChangedLocked(it->second, lx, wy, lz);
     clearFluidStateLocked(wx, wy, wz);
     if (isWaterBlock(nextId) || isLavaBlock(nextId)) {
         // Player-placed fluid blocks are explicit sources.
@@ -1457,11 +1728,11 @@ bool World::getFurnaceState(int wx, int wy, int wz, FurnaceState &out) const {
         return false;
     }
     std::lock_guard<std::mutex> lock(chunksMutex_);
-    const auto it = furnaceStates_.find(makeFurnaceKey(wx, wy, wz));
-    if (it == furnaceStates_.end()) {
+    const FurnaceState *state = furnaces_.find(makeFurnaceKey(wx, wy, wz));
+    if (state == nullptr) {
         return false;
     }
-    out = it->second;
+    out = *state;
     return true;
 }
 
@@ -1470,47 +1741,150 @@ void World::setFurnaceState(int wx, int wy, int wz, const FurnaceState &state) {
         return;
     }
     std::lock_guard<std::mutex> lock(chunksMutex_);
-    const FurnaceCoordKey key = makeFurnaceKey(wx, wy, wz);
-    furnaceStates_[key] = state;
-    furnaceStateByChunk_[worldToChunk(wx, wz)].insert(key);
+    furnaces_.put(makeFurnaceKey(wx, wy, wz), state);
 }
 
 void World::clearFurnaceState(int wx, int wy, int wz) {
     std::lock_guard<std::mutex> lock(chunksMutex_);
-    const FurnaceCoordKey key = makeFurnaceKey(wx, wy, wz);
-    if (furnaceStates_.erase(key) <= 0) {
-        return;
-    }
-    const ChunkCoord cc = worldToChunk(wx, wz);
-    const auto bit = furnaceStateByChunk_.find(cc);
-    if (bit == furnaceStateByChunk_.end()) {
-        return;
+    furnaces_.erase(makeFurnaceKey(wx, wy, wz));
+}
+
+int World::tickFurnaces(const std::function<void(FurnaceState &)> &step) {
+    int stepped = 0;
+    {
+        std::lock_guard<std::mutex> lock(chunksMutex_);
+        furnaceBlockSwaps_.clear();
+        std::size_t slot = 0;
+        while (slot < furnaces_.awakeCount()) {
+            FurnaceStore::Record &record = furnaces_.at(slot);
+            const FurnaceCoordKey key = record.key;
+            const auto cit = chunks_.find(worldToChunk(key.x, key.z));
+            if (cit == chunks_.end() || !cit->second.chunk) {
+                // Restored by a load job whose chunk is not registered yet.
+                ++slot;
+                continue;
+            }
+            const voxel::BlockId blockId = cit->second.chunk->get(
+                floorMod(key.x, voxel::Chunk::SX), key.y, floorMod(key.z, voxel::Chunk::SZ));
+            if (!voxel::isFurnace(blockId)) {
+                furnaces_.sleep(slot);
+                continue;
+            }
+
+            const FurnaceState before = record.state;
+            step(record.state);
+            ++stepped;
+            const FurnaceState &after = record.state;
+            const voxel::BlockId desiredId = after.burnSecondsRemaining > 0.0f
+                                                 ? voxel::toLitFurnace(blockId)
+                                                 : voxel::toUnlitFurnace(blockId);
+            if (desiredId != blockId) {
+                furnaceBlockSwaps_.emplace_back(key, desiredId);
+            }
+
+            const bool hasItems = (after.input.id != voxel::AIR && after.input.count > 0) ||
+                                  (after.fuel.id != voxel::AIR && after.fuel.count > 0) ||
+                                  (after.output.id != voxel::AIR && after.output.count > 0);
+            const bool hasWork = after.progressSeconds > 0.0f ||
+                                 after.burnSecondsRemaining > 0.0f ||
+                                 after.burnSecondsCapacity > 0.0f;
+            if (!hasItems && !hasWork) {
+                furnaces_.erase(key);
+            } else if (after == before) {
+                furnaces_.sleep(slot);
+            } else {
+                ++slot;
+            }
+        }
     }
-    bit->second.erase(key);
-    if (bit->second.empty()) {
-        furnaceStateByChunk_.erase(bit);
+    for (const auto &[key, id] : furnaceBlockSwaps_) {
+        setBlock(key.x, key.y, key.z, id);
     }
+    return stepped;
 }
 
-std::vector<glm::ivec3> World::loadedFurnacePositions() const {
+std::size_t World::furnaceCount() const {
     std::lock_guard<std::mutex> lock(chunksMutex_);
-    std::vector<glm::ivec3> out;
-    out.reserve(furnaceStates_.size());
-    for (const auto &[k, st] : furnaceStates_) {
-        (void)st;
-        const ChunkCoord cc = worldToChunk(k.x, k.z);
-        const auto cit = chunks_.find(cc);
-        if (cit == chunks_.end() || !cit->second.chunk) {
+    return furnaces_.size();
+}
+
+std::size_t World::awakeFurnaceCount() const {
+    std::lock_guard<std::mutex> lock(chunksMutex_);
+    return furnaces_.awakeCount();
+}
+
+std::vector<world::FurnaceRecordLocal> World::localFurnacesLocked(ChunkCoord cc,
+                                                                 const voxel::Chunk &chunk) const {
+    std::vector<world::FurnaceRecordLocal> localFurnaces;
+    const auto *keys = furnaces_.chunkKeys(cc);
+    if (keys == nullptr) {
+        return localFurnaces;
+    }
+    localFurnaces.reserve(keys->size());
+    for (const FurnaceCoordKey &fKey : *keys) {
+        const FurnaceState *state = furnaces_.find(fKey);
+        if (state == nullptr || fKey.y < 0 || fKey.y >= voxel::Chunk::SY) {
             continue;
         }
-        const int lx = floorMod(k.x, voxel::Chunk::SX);
-        const int lz = floorMod(k.z, voxel::Chunk::SZ);
-        if (!voxel::isFurnace(cit->second.chunk->get(lx, k.y, lz))) {
+        const int lx = floorMod(fKey.x, voxel::Chunk::SX);
+        const int lz = floorMod(fKey.z, voxel::Chunk::SZ);
+        if (!voxel::isFurnace(chunk.get(lx, fKey.y, lz))) {
             continue;
         }
-        out.emplace_back(k.x, k.y, k.z);
+        world::FurnaceRecordLocal rec{};
+        rec.x = static_cast<std::uint8_t>(lx);
+        rec.y = static_cast<std::uint8_t>(fKey.y);
+        rec.z = static_cast<std::uint8_t>(lz);
+        rec.state = *state;
+        localFurnaces.push_back(rec);
+    }
+    return localFurnaces;
+}
+
+void World::saveChunkLocked(ChunkCoord cc, const ChunkEntry &entry) {
+    if (!entry.chunk) {
+        return;
+    }
+    auto localFurnaces = localFurnacesLocked(cc, *entry.chunk);
+    // Unchanged chunks already match their file, or regenerate identically.
+    if (entry.contentRevision == entry.savedRevision && localFurnaces.empty()) {
+        return;
+    }
+    // A worker already writing this chunk keeps its flag and writes this copy next.
+    PendingSave &pending = pendingSaves_[cc];
+    pending.chunk = entry.chunk;
+    pending.furnaces = std::move(localFurnaces);
+    pending.edits = entry.edits;
+    WorkerJob job;
+    job.type = JobType::Save;
+    job.coord = cc;
+    scheduleWorkerJob(std::move(job));
+}
+
+void World::writePendingSave(ChunkCoord cc) {
+    std::unique_lock<std::mutex> lock(chunksMutex_);
+    for (;;) {
+        const auto it = pendingSaves_.find(cc);
+        if (it == pendingSaves_.end() || it->second.writing) {
+            return;
+        }
+        it->second.writing = true;
+        const std::shared_ptr<const voxel::Chunk> chunk = it->second.chunk;
+        const std::vector<world::FurnaceRecordLocal> furnaces = it->second.furnaces;
+        const ChunkEdits edits = it->second.edits;
+        lock.unlock();
+        const bool delta =
+            deltaChunkSaves_.load(std::memory_order_relaxed) && edits.overGenerated;
+        app::SaveManager::saveChunk(saveRoot_, WorldGen::kGeneratorVersion, *chunk, cc, &furnaces,
+                                    delta ? &edits : nullptr);
+        lock.lock();
+        const auto done = pendingSaves_.find(cc);
+        if (done->second.chunk == chunk) {
+            pendingSaves_.erase(done);
+            return;
+        }
+        done->second.writing = false;
     }
-    return out;
 }
 
 void World::workerLoop() {
@@ -1538,70 +1912,114 @@ void World::workerLoop() {
 
         WorkerJob job = std::move(*maybeJob);
 
-        if (job.type == JobType::LoadOrGenerate) {
-            auto chunk = std::make_shared<voxel::Chunk>();
-            std::vector<world::FurnaceRecordLocal> loadedFurnaces;
-            if (!app::SaveManager::loadChunk(saveRoot_, WorldGen::kGeneratorVersion, *chunk,
-                                             job.coord, &loadedFurnaces)) {
-                gen_.fillChunk(*chunk, job.coord);
-            } else if (!loadedFurnaces.empty()) {
-                std::lock_guard<std::mutex> lock(chunksMutex_);
-                for (const auto &rec : loadedFurnaces) {
-                    const int wx = job.coord.x * voxel::Chunk::SX + static_cast<int>(rec.x);
-                    const int wy = static_cast<int>(rec.y);
-                    const int wz = job.coord.z * voxel::Chunk::SZ + static_cast<int>(rec.z);
-                    const FurnaceCoordKey key = makeFurnaceKey(wx, wy, wz);
-                    furnaceStates_[key] = rec.state;
-                    furnaceStateByChunk_[job.coord].insert(key);
-                }
-            }
+        if (job.type == JobType::Save) {
+            writePendingSave(job.coord);
+        } else if (job.type == JobType::LoadOrGenerate) {
             // Defer mesh build to remesh jobs after chunk registration so
             // neighbor-aware edge culling happens before any faces are rendered.
-            completed_.push(
-                WorkerResult{job.coord, job.urgent, std::move(chunk), nullptr, true});
+            WorkerResult result{job.coord, job.urgent, nullptr, nullptr, true};
+            result.chunk = loadOrGenerateChunk(job.coord, result.edits);
+            completed_.push(std::move(result));
         } else {
             if (!job.chunkSnapshot) {
                 continue;
             }
-            const voxel::ChunkMesher::NeighborChunks neighbors{
-                job.px.get(),   job.nx.get(),   job.pz.get(),   job.nz.get(),
-                job.pxpz.get(), job.pxnz.get(), job.nxpz.get(), job.nxnz.get()};
-            const auto fluidLevelLookup = [&](voxel::BlockId fluidId, int wx, int wy, int wz) -> int {
-                const auto &levels = (fluidId == voxel::LAVA) ? job.lavaLevels : job.waterLevels;
-                const auto it = levels.find(FluidCoord{wx, wy, wz});
-                if (it == levels.end()) {
-                    return -1;
-                }
-                return static_cast<int>(it->second);
-            };
-
-            const std::size_t reserveVertices =
-                static_cast<std::size_t>(meshReserveVertices_.load(std::memory_order_relaxed));
-            const std::size_t reserveIndices =
-                static_cast<std::size_t>(meshReserveIndices_.load(std::memory_order_relaxed));
-            auto mesh = acquireMeshBuffer();
-            voxel::ChunkMesher::buildFaceCulledInto(
-                *mesh, *job.chunkSnapshot, atlas_, blockRegistry_,
-                glm::ivec2(job.coord.x, job.coord.z), neighbors,
-                smoothLighting_.load(std::memory_order_relaxed), fluidLevelLookup,
-                reserveVertices, reserveIndices);
-            if (!mesh->vertices.empty()) {
-                const std::uint32_t prev = meshReserveVertices_.load(std::memory_order_relaxed);
-                const std::uint32_t curr = static_cast<std::uint32_t>(mesh->vertices.size());
-                const std::uint32_t blended =
-                    (prev * 7u + curr + 3u) / 8u; // smooth moving average
-                meshReserveVertices_.store(std::max(1024u, blended), std::memory_order_relaxed);
-            }
-            if (!mesh->indices.empty()) {
-                const std::uint32_t prev = meshReserveIndices_.load(std::memory_order_relaxed);
-                const std::uint32_t curr = static_cast<std::uint32_t>(mesh->indices.size());
-                const std::uint32_t blended =
-                    (prev * 7u + curr + 3u) / 8u; // smooth moving average
-                meshReserveIndices_.store(std::max(1536u, blended), std::memory_order_relaxed);
+            completed_.push(buildMesh(job));
+        }
+    }
+}
+
+std::shared_ptr<voxel::Chunk> World::loadOrGenerateChunk(ChunkCoord cc, ChunkEdits &edits) {
+    auto chunk = std::make_shared<voxel::Chunk>();
+    std::vector<world::FurnaceRecordLocal> loadedFurnaces;
+    bool loaded = false;
+    {
+        std::lock_guard<std::mutex> lock(chunksMutex_);
+        const auto pit = pendingSaves_.find(cc);
+        if (pit != pendingSaves_.end()) {
+            // Reloaded before its save was written; the queued copy is newest.
+            *chunk = *pit->second.chunk;
+            loadedFurnaces = pit->second.furnaces;
+            edits = pit->second.edits;
+            loaded = true;
+        }
+    }
+    if (!loaded) {
+        // Migration rewrites the file, so it also needs delta saves on.
+        const bool migrate = deltaChunkSaves_.load(std::memory_order_relaxed) &&
+                             migrateFullChunks_.load(std::memory_order_relaxed);
+        loaded = app::SaveManager::loadChunk(saveRoot_, WorldGen::kGeneratorVersion, *chunk, cc,
+                                             &loadedFurnaces, &gen_, &edits, migrate);
+    }
+    if (!loaded) {
+        // A failed load may have written part of a file into the chunk, and
+        // fillChunk expects an all-air one.
+        *chunk = voxel::Chunk();
+        edits = ChunkEdits();
+        gen_.fillChunk(*chunk, cc);
+    } else if (!loadedFurnaces.empty()) {
+        std::lock_guard<std::mutex> lock(chunksMutex_);
+        for (const auto &rec : loadedFurnaces) {
+            const int wx = cc.x * voxel::Chunk::SX + static_cast<int>(rec.x);
+            const int wy = static_cast<int>(rec.y);
+            const int wz = cc.z * voxel::Chunk::SZ + static_cast<int>(rec.z);
+            furnaces_.put(makeFurnaceKey(wx, wy, wz), rec.state);
+        }
+    }
+    return chunk;
+}
+
+World::WorkerResult World::buildMesh(const WorkerJob &job) {
+    const voxel::ChunkMesher::NeighborChunks neighbors{
+        job.px.get(),   job.nx.get(),   job.pz.get(),   job.nz.get(),
+        job.pxpz.get(), job.pxnz.get(), job.nxpz.get(), job.nxnz.get()};
+    const auto fluidLevelLookup = [&](voxel::BlockId fluidId, int wx, int wy, int wz) -> int {
+        const auto &levels = (fluidId == voxel::LAVA) ? job.lavaLevels : job.waterLevels;
+        const auto it = levels.find(FluidCoord{wx, wy, wz});
+        if (it == levels.end()) {
+            return -1;
+        }
+        return static_cast<int>(it->second);
+    };
+
+    const std::size_t reserveVertices =
+        static_cast<std::size_t>(meshReserveVertices_.load(std::memory_order_relaxed));
+    const std::size_t reserveIndices =
+        static_cast<std::size_t>(meshReserveIndices_.load(std::memory_order_relaxed));
+    auto mesh = acquireMeshBuffer();
+    voxel::ChunkMesher::buildFaceCulledInto(*mesh, *job.chunkSnapshot, atlas_, blockRegistry_,
+                                            glm::ivec2(job.coord.x, job.coord.z), neighbors,
+                                            smoothLighting_.load(std::memory_order_relaxed),
+                                            fluidLevelLookup, reserveVertices, reserveIndices);
+    if (!mesh->vertices.empty()) {
+        const std::uint32_t prev = meshReserveVertices_.load(std::memory_order_relaxed);
+        const std::uint32_t curr = static_cast<std::uint32_t>(mesh->vertices.size());
+        const std::uint32_t blended = (prev * 7u + curr + 3u) / 8u; // smooth moving average
+        meshReserveVertices_.store(std::max(1024u, blended), std::memory_order_relaxed);
+    }
+    if (!mesh->indices.empty()) {
+        const std::uint32_t prev = meshReserveIndices_.load(std::memory_order_relaxed);
+        const std::uint32_t curr = static_cast<std::uint32_t>(mesh->indices.size());
+        const std::uint32_t blended = (prev * 7u + curr + 3u) / 8u; // smooth moving average
+        meshReserveIndices_.store(std::max(1536u, blended), std::memory_order_relaxed);
+    }
+    WorkerResult result{job.coord, job.urgent, nullptr, std::move(mesh), false};
+    if (!result.mesh->indices.empty()) {
+        // Write the mesh into mapped staging memory here so the GL thread only
+        // issues the copies.
+        if (const auto slab = takeStagingSlab()) {
+            gfx::StagedMesh staged;
+            if (gfx::ChunkGeometryArena::stageMesh(*slab, *result.mesh, staged)) {
+                result.staged = staged;
+            } else {
+                std::lock_guard<std::mutex> lock(stagingSlabsMutex_);
+                stagingSlabs_.push_back(*slab);
             }
-            completed_.push(WorkerResult{job.coord, job.urgent, nullptr, std::move(mesh), false});
         }
     }
+    result.visibility =
+        voxel::ChunkMesher::buildSectionVisibility(*job.chunkSnapshot, blockRegistry_);
+    return result;
 }
 
 } // namespace world
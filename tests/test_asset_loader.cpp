@@ -0,0 +1,79 @@
+#include "core/AssetLoader.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+int main() {
+    // Decodes run on workers, uploads only on the pumping thread, and every
+    // job is counted once even when its decode fails.
+    {
+        core::AssetLoader loader(3);
+        assert(loader.done() && loader.progress() == 1.0f);
+
+        const std::thread::id mainThread = std::this_thread::get_id();
+        std::atomic<int> decodedOffMain{0};
+        std::vector<int> uploaded;
+        for (int i = 0; i < 64; ++i) {
+            loader.submit([&, i]() -> core::AssetLoader::Upload {
+                if (std::this_thread::get_id() != mainThread) {
+                    ++decodedOffMain;
+                }
+                if (i % 16 == 0) {
+                    return {};
+                }
+                return [&, i] {
+                    assert(std::this_thread::get_id() == mainThread);
+                    uploaded.push_back(i);
+                };
+            });
+        }
+        assert(loader.submittedCount() == 64);
+
+        float lastProgress = 0.0f;
+        while (!loader.done()) {
+            loader.pump(0.0);
+            const float progress = loader.progress();
+            assert(progress >= lastProgress);
+            lastProgress = progress;
+        }
+        assert(decodedOffMain == 64);
+        assert(uploaded.size() == 60);
+        assert(loader.completedCount() == 64 && loader.progress() == 1.0f);
+    }
+
+    // A zero budget runs one upload per pump; finish() drains the rest.
+    {
+        core::AssetLoader loader(2);
+        int uploads = 0;
+        for (int i = 0; i < 8; ++i) {
+            loader.submit([&]() -> core::AssetLoader::Upload { return [&] { ++uploads; }; });
+        }
+        while (loader.pump(0.0) == 0) {
+            std::this_thread::yield();
+        }
+        assert(uploads == 1);
+        loader.finish();
+        assert(uploads == 8 && loader.done());
+        assert(loader.pump(1.0) == 0);
+    }
+
+    // Destroying the loader with work queued neither blocks nor runs uploads.
+    {
+        int uploads = 0;
+        {
+            core::AssetLoader loader(1);
+            for (int i = 0; i < 16; ++i) {
+                loader.submit([&]() -> core::AssetLoader::Upload {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    return [&] { ++uploads; };
+                });
+            }
+        }
+        assert(uploads == 0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include "core/AssetPack.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+void putU16(std::vector<std::uint8_t> &out, std::uint16_t v) {
+    out.push_back(static_cast<std::uint8_t>(v & 0xFF));
+    out.push_back(static_cast<std::uint8_t>(v >> 8));
+}
+
+void putU32(std::vector<std::uint8_t> &out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<std::uint8_t>((v >> (8 * i)) & 0xFF));
+    }
+}
+
+void putTag(std::vector<std::uint8_t> &out, const char *tag) {
+    out.insert(out.end(), tag, tag + 4);
+}
+
+std::vector<std::uint8_t> makeWav(std::uint16_t channels, std::uint16_t bits, std::uint32_t rate,
+                                  const std::vector<std::uint8_t> &pcm, std::uint16_t format) {
+    std::vector<std::uint8_t> wav;
+    putTag(wav, "RIFF");
+    putU32(wav, 0);
+    putTag(wav, "WAVE");
+    // An unknown odd-sized chunk before fmt must be skipped with its pad byte.
+    putTag(wav, "LIST");
+    putU32(wav, 3);
+    wav.insert(wav.end(), {1, 2, 3, 0});
+    putTag(wav, "fmt ");
+    putU32(wav, 16);
+    putU16(wav, format);
+    putU16(wav, channels);
+    putU32(wav, rate);
+    putU32(wav, rate * channels * bits / 8);
+    putU16(wav, static_cast<std::uint16_t>(channels * bits / 8));
+    putU16(wav, bits);
+    putTag(wav, "data");
+    putU32(wav, static_cast<std::uint32_t>(pcm.size()));
+    wav.insert(wav.end(), pcm.begin(), pcm.end());
+    return wav;
+}
+
+} // namespace
+
+int main() {
+    const std::vector<std::uint8_t> pcm = {10, 20, 30, 40, 50, 60, 70, 80};
+
+    // WAV parsing reads the format and points at the data chunk in place.
+    {
+        const auto wav = makeWav(2, 16, 22050, pcm, 1);
+        core::SoundData sound;
+        std::string error;
+        assert(core::parseWav(wav.data(), wav.size(), sound, error));
+        assert(sound.channels == 2 && sound.bitsPerSample == 16 && sound.sampleRate == 22050);
+        assert(sound.sampleBytes == pcm.size());
+        assert(std::memcmp(sound.samples, pcm.data(), pcm.size()) == 0);
+
+        const auto adpcm = makeWav(1, 4, 22050, pcm, 2);
+        assert(!core::parseWav(adpcm.data(), adpcm.size(), sound, error));
+        auto truncated = wav;
+        truncated.resize(truncated.size() - 4);
+        assert(!core::parseWav(truncated.data(), truncated.size(), sound, error));
+    }
+
+    // Tile colours are alpha weighted; transparent tiles stay mid grey.
+    {
+        std::vector<std::uint8_t> rgba(4 * 2 * 4, 0);
+        for (int x = 0; x < 2; ++x) {
+            for (int y = 0; y < 2; ++y) {
+                std::uint8_t *p = &rgba[(y * 4 + x) * 4];
+                p[0] = 255;
+                p[3] = x == 0 ? 255 : 0;
+            }
+        }
+        const auto colors = core::computeTileAverageColors(rgba.data(), 4, 2, 2, 2);
+        assert(colors.size() == 6);
+        assert(colors[0] == 1.0f && colors[1] == 0.0f && colors[2] == 0.0f);
+        assert(colors[3] == 0.5f && colors[4] == 0.5f && colors[5] == 0.5f);
+    }
+
+    // A written pack reads back the same pixels, colours and samples.
+    {
+        const std::string path = "test_asset_pack.pack";
+        std::vector<std::uint8_t> rgba(32 * 16 * 4);
+        for (std::size_t i = 0; i < rgba.size(); ++i) {
+            rgba[i] = static_cast<std::uint8_t>(i * 7);
+        }
+        const auto wav = makeWav(1, 8, 11025, pcm, 1);
+        core::SoundData sound;
+        std::string error;
+        assert(core::parseWav(wav.data(), wav.size(), sound, error));
+
+        core::AssetPackWriter writer;
+        writer.addImage("assets/textures/atlas.png", rgba.data(), 32, 16, 16, 16);
+        writer.addSound("assets/audio/pickup/pickup.wav", sound);
+        assert(writer.write(path, error));
+
+        core::AssetPack pack;
+        assert(pack.open(path));
+        assert(pack.entryCount() == 2);
+
+        core::ImageData image;
+        assert(pack.findImage("assets/textures/atlas.png", image));
+        assert(image.width == 32 && image.height == 16 && image.tileCount == 2);
+        assert(image.levels.size() == 1);
+        assert(std::memcmp(image.levels[0], rgba.data(), rgba.size()) == 0);
+        const auto colors = core::computeTileAverageColors(rgba.data(), 32, 16, 16, 16);
+        assert(std::memcmp(image.tileColors, colors.data(), colors.size() * sizeof(float)) == 0);
+
+        core::SoundData packed;
+        assert(pack.findSound("assets/audio/pickup/pickup.wav", packed));
+        assert(packed.channels == 1 && packed.bitsPerSample == 8 && packed.sampleRate == 11025);
+        assert(packed.sampleBytes == pcm.size());
+        assert(std::memcmp(packed.samples, pcm.data(), pcm.size()) == 0);
+
+        // Lookups are by name and kind.
+        assert(!pack.findSound("assets/textures/atlas.png", packed));
+        assert(!pack.findImage("assets/textures/missing.png", image));
+
+        pack.close();
+        assert(!pack.isOpen());
+        std::remove(path.c_str());
+    }
+
+    // Missing or foreign files leave the pack closed so callers use loose files.
+    {
+        core::AssetPack pack;
+        assert(!pack.open("does_not_exist.pack"));
+        const std::string path = "test_asset_pack_bad.pack";
+        std::FILE *f = std::fopen(path.c_str(), "wb");
+        std::fputs("not a pack file at all", f);
+        std::fclose(f);
+        assert(!pack.open(path));
+        assert(!pack.isOpen());
+        std::remove(path.c_str());
+    }
+
+    return 0;
+}
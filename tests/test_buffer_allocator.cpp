@@ -0,0 +1,46 @@
+#include "gfx/BufferSubAllocator.hpp"
+
+#include <cassert>
+
+int main() {
+    gfx::BufferSubAllocator alloc(1024, 16);
+    assert(alloc.capacity() == 1024);
+
+    const auto a = alloc.allocate(10);
+    const auto b = alloc.allocate(100);
+    const auto c = alloc.allocate(40);
+    assert(a.has_value() && b.has_value() && c.has_value());
+    assert(a->offset == 0 && a->size == 16);
+    assert(b->offset == 16 && b->size == 112);
+    assert(c->offset == 128);
+    assert(alloc.usedUnits() == 16 + 112 + 48);
+
+    // Freed neighbors coalesce back into one block.
+    alloc.release(*b);
+    alloc.release(*a);
+    assert(alloc.freeBlockCount() == 2);
+    const auto reuse = alloc.allocate(120);
+    assert(reuse.has_value() && reuse->offset == 0);
+    alloc.release(*reuse);
+
+    assert(!alloc.allocate(2000).has_value());
+
+    // Compaction packs live ranges toward zero and reports the moves.
+    const auto moves = alloc.compact();
+    assert(moves.size() == 1);
+    assert(moves[0].from == 128 && moves[0].to == 0 && moves[0].size == 48);
+    assert(alloc.freeBlockCount() == 1);
+    assert(alloc.largestFreeBlock() == 1024 - 48);
+
+    alloc.grow(4096);
+    assert(alloc.freeBlockCount() == 1);
+    assert(alloc.largestFreeBlock() == 4096 - 48);
+    const auto big = alloc.allocate(3000);
+    assert(big.has_value() && big->offset == 48);
+    alloc.release(*big);
+    alloc.release(gfx::BufferSubAllocator::Allocation{0, 48});
+    assert(alloc.usedUnits() == 0 && alloc.liveCount() == 0);
+    assert(alloc.largestFreeBlock() == 4096);
+
+    return 0;
+}
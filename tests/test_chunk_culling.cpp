@@ -0,0 +1,85 @@
+#include "world/ChunkColumnTree.hpp"
+
+#include <cassert>
+#include <set>
+#include <utility>
+
+namespace {
+
+world::FrustumPlanes openFrustum() {
+    world::FrustumPlanes f;
+    for (world::FrustumPlane &pl : f.p) {
+        pl.n = glm::vec3(0.0f, 1.0f, 0.0f);
+        pl.d = 1.0e6f;
+    }
+    return f;
+}
+
+std::set<std::pair<int, int>> visibleColumns(const world::ChunkColumnTree &tree,
+                                             const world::FrustumPlanes &frustum,
+                                             const glm::vec3 &cameraPos, float maxDist,
+                                             world::ChunkColumnTree::QueryStats &stats) {
+    std::set<std::pair<int, int>> out;
+    tree.query(frustum, cameraPos, maxDist,
+               [&](world::ChunkCoord cc, float, float) { out.insert({cc.x, cc.z}); }, stats);
+    return out;
+}
+
+} // namespace
+
+int main() {
+    world::ChunkColumnTree tree;
+    for (int z = -20; z <= 20; ++z) {
+        for (int x = -20; x <= 20; ++x) {
+            // Columns with positive z sit high up; the rest are low terrain.
+            tree.insert(world::ChunkCoord{x, z}, z > 0 ? 80.0f : 10.0f, z > 0 ? 96.0f : 30.0f);
+        }
+    }
+    assert(tree.size() == 41u * 41u);
+
+    // Half-space x >= 0: column x = -1 touches the plane and is kept.
+    world::FrustumPlanes frustum = openFrustum();
+    frustum.p[0] = world::FrustumPlane{glm::vec3(1.0f, 0.0f, 0.0f), 0.0f};
+    world::ChunkColumnTree::QueryStats stats;
+    auto visible = visibleColumns(tree, frustum, glm::vec3(0.0f), 10000.0f, stats);
+    assert(visible.size() == 22u * 41u);
+    assert(stats.visited == static_cast<int>(visible.size()));
+    assert(stats.visited + stats.culled == 41 * 41);
+    for (const auto &[x, z] : visible) {
+        assert(x >= -1);
+    }
+
+    // Ceiling at y = 40 rejects every raised column through its vertical bounds.
+    frustum.p[1] = world::FrustumPlane{glm::vec3(0.0f, -1.0f, 0.0f), 40.0f};
+    stats = {};
+    visible = visibleColumns(tree, frustum, glm::vec3(0.0f), 10000.0f, stats);
+    assert(visible.size() == 22u * 21u);
+    for (const auto &[x, z] : visible) {
+        assert(z <= 0);
+    }
+
+    // Draw distance is measured from the camera to column centres.
+    stats = {};
+    visible = visibleColumns(tree, openFrustum(), glm::vec3(8.0f, 0.0f, 8.0f), 23.0f, stats);
+    assert(visible.size() == 9u);
+    assert(visible.count({-1, -1}) == 1 && visible.count({1, 1}) == 1);
+
+    // Erased columns drop out of the query and out of their ancestors.
+    tree.erase(world::ChunkCoord{0, 0});
+    assert(tree.size() == 41u * 41u - 1u);
+    stats = {};
+    visible = visibleColumns(tree, frustum, glm::vec3(0.0f), 10000.0f, stats);
+    assert(visible.size() == 22u * 21u - 1u);
+    assert(visible.count({0, 0}) == 0);
+
+    // Reinserting with new bounds replaces the old ones.
+    tree.insert(world::ChunkCoord{0, 0}, 100.0f, 120.0f);
+    stats = {};
+    visible = visibleColumns(tree, frustum, glm::vec3(0.0f), 10000.0f, stats);
+    assert(visible.count({0, 0}) == 0);
+
+    assert(world::aabbInFrustum(frustum, glm::vec3(0.0f), glm::vec3(16.0f, 40.0f, 16.0f)));
+    assert(!world::aabbInFrustum(frustum, glm::vec3(-32.0f, 0.0f, 0.0f),
+                                 glm::vec3(-16.0f, 40.0f, 16.0f)));
+    return 0;
+}
@@ -0,0 +1,236 @@
+#include "app/SaveManager.hpp"
+#include "voxel/Block.hpp"
+#include "voxel/Chunk.hpp"
+#include "world/ChunkCoord.hpp"
+#include "world/ChunkEdits.hpp"
+#include "world/FurnaceState.hpp"
+#include "world/WorldGen.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::uint32_t kVersion = world::WorldGen::kGeneratorVersion;
+
+std::filesystem::path chunkFile(const std::filesystem::path &dir, world::ChunkCoord cc) {
+    return dir / ("chunk_" + std::to_string(cc.x) + "_" + std::to_string(cc.z) + ".bin");
+}
+
+// A player's worth of changes: a few dug and placed blocks near the surface,
+// recorded in edits as World records them.
+void editLightly(voxel::Chunk &chunk, world::ChunkEdits &edits, std::mt19937 &rng, int count) {
+    std::uniform_int_distribution<int> xz(0, voxel::Chunk::SX - 1);
+    std::uniform_int_distribution<int> y(40, 90);
+    for (int i = 0; i < count; ++i) {
+        const int x = xz(rng);
+        const int yy = y(rng);
+        const int z = xz(rng);
+        const voxel::BlockId prev = chunk.get(x, yy, z);
+        chunk.set(x, yy, z, prev == voxel::AIR ? voxel::STONE : voxel::AIR);
+        edits.add(voxel::Chunk::index(x, yy, z));
+    }
+}
+
+std::vector<std::uint16_t> differingCells(const voxel::Chunk &a, const voxel::Chunk &b) {
+    std::vector<std::uint16_t> cells;
+    for (std::size_t i = 0; i < a.data().size(); ++i) {
+        if (a.data()[i] != b.data()[i]) {
+            cells.push_back(static_cast<std::uint16_t>(i));
+        }
+    }
+    return cells;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "voxel_test_chunk_delta";
+    std::filesystem::remove_all(dir);
+    const world::WorldGen gen(4242u);
+    const world::ChunkCoord cc{3, -2};
+
+    // A chunk only visited, never edited, takes no file.
+    voxel::Chunk generated;
+    gen.fillChunk(generated, cc);
+    const world::ChunkEdits untouched;
+    assert(app::SaveManager::saveChunk(dir, kVersion, generated, cc, nullptr, &untouched));
+    assert(!std::filesystem::exists(chunkFile(dir, cc)));
+    voxel::Chunk loaded;
+    assert(!app::SaveManager::loadChunk(dir, kVersion, loaded, cc, nullptr, &gen));
+
+    // A few edits and a furnace round-trip through a file of a few bytes each,
+    // and the edited cells come back for the next save.
+    std::mt19937 rng(75);
+    voxel::Chunk edited = generated;
+    world::ChunkEdits edits;
+    editLightly(edited, edits, rng, 12);
+    edited.set(5, 70, 6, voxel::GLASS);
+    edits.add(voxel::Chunk::index(5, 70, 6));
+    world::FurnaceRecordLocal furnace{};
+    furnace.x = 1;
+    furnace.y = 64;
+    furnace.z = 2;
+    furnace.state.fuel.id = voxel::COAL_ORE;
+    furnace.state.fuel.count = 3;
+    furnace.state.progressSeconds = 1.5f;
+    const std::vector<world::FurnaceRecordLocal> furnaces = {furnace};
+    assert(app::SaveManager::saveChunk(dir, kVersion, edited, cc, &furnaces, &edits));
+    assert(std::filesystem::file_size(chunkFile(dir, cc)) < 200);
+    std::vector<world::FurnaceRecordLocal> loadedFurnaces;
+    world::ChunkEdits loadedEdits;
+    assert(app::SaveManager::loadChunk(dir, kVersion, loaded, cc, &loadedFurnaces, &gen,
+                                       &loadedEdits));
+    assert(loaded.data() == edited.data());
+    assert(loadedEdits.overGenerated && loadedEdits.cells == edits.cells);
+    assert(loadedFurnaces.size() == 1);
+    assert(loadedFurnaces[0].y == 64 && loadedFurnaces[0].state.fuel.count == 3);
+    assert(loadedFurnaces[0].state.progressSeconds == 1.5f);
+
+    // Delta files cannot be read without the generator that made their base.
+    assert(!app::SaveManager::loadChunk(dir, kVersion, loaded, cc));
+
+    // Clearing the edits deletes the file again.
+    assert(app::SaveManager::saveChunk(dir, kVersion, generated, cc, nullptr, &untouched));
+    assert(!std::filesystem::exists(chunkFile(dir, cc)));
+
+    // Migration: a full chunk still loads and stays full, with no edits over
+    // generated terrain, unless migration is asked for; then it is diffed
+    // once and rewritten as a delta of exactly the differing cells.
+    assert(app::SaveManager::saveChunk(dir, kVersion, edited, cc, &furnaces));
+    const std::uintmax_t fullBytes = std::filesystem::file_size(chunkFile(dir, cc));
+    assert(app::SaveManager::loadChunk(dir, kVersion, loaded, cc, &loadedFurnaces, &gen,
+                                       &loadedEdits));
+    assert(loaded.data() == edited.data());
+    assert(!loadedEdits.overGenerated && loadedEdits.cells.empty());
+    assert(std::filesystem::file_size(chunkFile(dir, cc)) == fullBytes);
+    assert(app::SaveManager::loadChunk(dir, kVersion, loaded, cc, &loadedFurnaces, &gen,
+                                       &loadedEdits, true));
+    assert(loaded.data() == edited.data());
+    assert(loadedFurnaces.size() == 1);
+    assert(loadedEdits.overGenerated);
+    assert(loadedEdits.cells == differingCells(generated, edited));
+    assert(std::filesystem::file_size(chunkFile(dir, cc)) < fullBytes);
+    assert(app::SaveManager::loadChunk(dir, kVersion, loaded, cc, &loadedFurnaces, &gen));
+    assert(loaded.data() == edited.data());
+    assert(loadedFurnaces.size() == 1);
+
+    // A generator bump still discards full chunks, but deltas keep their
+    // edits on top of the new terrain: edited cells keep the saved block,
+    // every other cell follows the new generator.
+    assert(app::SaveManager::saveChunk(dir, kVersion - 1, edited, cc));
+    assert(!app::SaveManager::loadChunk(dir, kVersion, loaded, cc, nullptr, &gen));
+    assert(app::SaveManager::saveChunk(dir, kVersion - 1, edited, cc, nullptr, &edits));
+    const world::WorldGen bumpedGen(9001u);
+    voxel::Chunk bumped;
+    bumpedGen.fillChunk(bumped, cc);
+    assert(bumped.data() != generated.data());
+    loaded = voxel::Chunk();
+    assert(app::SaveManager::loadChunk(dir, kVersion, loaded, cc, nullptr, &bumpedGen));
+    int editedCells = 0;
+    for (std::size_t i = 0; i < edited.data().size(); ++i) {
+        if (edited.data()[i] != generated.data()[i]) {
+            assert(loaded.data()[i] == edited.data()[i]);
+            ++editedCells;
+        } else {
+            assert(loaded.data()[i] == bumped.data()[i]);
+        }
+    }
+    assert(editedCells > 0);
+
+    // Save size and load time for a lightly edited world: most chunks only
+    // visited, the rest with a handful of edits.
+    {
+        constexpr int kSide = 6;
+        constexpr int kEditedEvery = 4;
+        const std::filesystem::path fullDir = dir / "full";
+        const std::filesystem::path deltaDir = dir / "delta";
+        std::vector<world::ChunkCoord> coords;
+        std::vector<voxel::Chunk> chunks;
+        std::vector<world::ChunkEdits> chunkEdits;
+        for (int z = 0; z < kSide; ++z) {
+            for (int x = 0; x < kSide; ++x) {
+                const world::ChunkCoord c{x, z};
+                voxel::Chunk chunk;
+                world::ChunkEdits cells;
+                gen.fillChunk(chunk, c);
+                if (static_cast<int>(coords.size()) % kEditedEvery == 0) {
+                    editLightly(chunk, cells, rng, 24);
+                }
+                coords.push_back(c);
+                chunks.push_back(std::move(chunk));
+                chunkEdits.push_back(std::move(cells));
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < coords.size(); ++i) {
+            assert(app::SaveManager::saveChunk(fullDir, kVersion, chunks[i], coords[i]));
+        }
+        const double fullSave = secondsSince(start);
+        start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < coords.size(); ++i) {
+            assert(app::SaveManager::saveChunk(deltaDir, kVersion, chunks[i], coords[i], nullptr,
+                                               &chunkEdits[i]));
+        }
+        const double deltaSave = secondsSince(start);
+
+        auto folderBytes = [](const std::filesystem::path &folder, int &files) {
+            std::uintmax_t total = 0;
+            files = 0;
+            for (const auto &entry : std::filesystem::directory_iterator(folder)) {
+                total += entry.file_size();
+                ++files;
+            }
+            return total;
+        };
+        int fullFiles = 0;
+        int deltaFiles = 0;
+        const std::uintmax_t fullTotal = folderBytes(fullDir, fullFiles);
+        const std::uintmax_t deltaTotal = folderBytes(deltaDir, deltaFiles);
+        assert(deltaFiles * kEditedEvery == fullFiles);
+        assert(deltaTotal * 50 < fullTotal);
+
+        // The world loads every chunk; those without a file are generated.
+        voxel::Chunk out;
+        start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < coords.size(); ++i) {
+            assert(app::SaveManager::loadChunk(fullDir, kVersion, out, coords[i]));
+        }
+        const double fullLoad = secondsSince(start);
+        start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < coords.size(); ++i) {
+            if (!app::SaveManager::loadChunk(deltaDir, kVersion, out, coords[i], nullptr, &gen)) {
+                // fillChunk expects an all-air chunk, as World's fresh ones are.
+                out = voxel::Chunk();
+                gen.fillChunk(out, coords[i]);
+            }
+            assert(out.data() == chunks[i].data());
+        }
+        const double deltaLoad = secondsSince(start);
+
+        const double n = static_cast<double>(coords.size());
+        std::printf("chunk saves, %d chunks, 1 in %d lightly edited:\n", static_cast<int>(n),
+                    kEditedEvery);
+        std::printf("  full:  %d files, %llu bytes, save %.3f ms/chunk, load %.3f ms/chunk\n",
+                    fullFiles, static_cast<unsigned long long>(fullTotal),
+                    fullSave * 1000.0 / n, fullLoad * 1000.0 / n);
+        std::printf("  delta: %d files, %llu bytes, save %.3f ms/chunk, load %.3f ms/chunk\n",
+                    deltaFiles, static_cast<unsigned long long>(deltaTotal),
+                    deltaSave * 1000.0 / n, deltaLoad * 1000.0 / n);
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "world/FurnaceStore.hpp"
+
+#include <cassert>
+#include <cstddef>
+
+namespace {
+
+using Key = world::FurnaceStore::Key;
+
+world::FurnaceState smelting(int fuel) {
+    world::FurnaceState state;
+    state.input = {voxel::IRON_ORE, 4};
+    state.fuel = {voxel::COAL_ORE, fuel};
+    state.burnSecondsRemaining = 5.0f;
+    return state;
+}
+
+bool isAwake(const world::FurnaceStore &store, const Key &key) {
+    return store.slotOf(key) < store.awakeCount();
+}
+
+// Every slot maps back to its key, and every chunk lists exactly the
+// furnaces whose position falls in it.
+void checkConsistent(const world::FurnaceStore &store) {
+    assert(store.awakeCount() <= store.size());
+    for (std::size_t slot = 0; slot < store.size(); ++slot) {
+        const Key &key = store.at(slot).key;
+        assert(store.slotOf(key) == slot);
+        assert(store.find(key) == &store.at(slot).state);
+        const auto *keys = store.chunkKeys(world::FurnaceStore::chunkOf(key));
+        assert(keys != nullptr && keys->count(key) == 1);
+    }
+}
+
+} // namespace
+
+int main() {
+    world::FurnaceStore store;
+    const Key a{1, 64, 1};
+    const Key b{2, 64, 1};
+    const Key c{-3, 70, 5};
+    const Key d{20, 64, -1};
+    const Key e{21, 64, -2};
+
+    // New furnaces start awake.
+    store.put(a, smelting(3));
+    store.put(b, smelting(2));
+    store.put(c, smelting(1));
+    store.put(d, smelting(4));
+    store.put(e, smelting(5));
+    assert(store.size() == 5 && store.awakeCount() == 5);
+    checkConsistent(store);
+
+    // A tick that leaves a furnace unchanged moves it to the sleeping range;
+    // the slot it left now holds a furnace that has not been visited yet.
+    std::size_t slot = 0;
+    int visited = 0;
+    while (slot < store.awakeCount()) {
+        world::FurnaceStore::Record &record = store.at(slot);
+        ++visited;
+        if (record.key == b || record.key == d) {
+            store.sleep(slot);
+            continue;
+        }
+        record.state.burnSecondsRemaining -= 1.0f;
+        ++slot;
+    }
+    assert(visited == 5);
+    assert(store.awakeCount() == 3);
+    assert(!isAwake(store, b) && !isAwake(store, d));
+    assert(isAwake(store, a) && isAwake(store, c) && isAwake(store, e));
+    checkConsistent(store);
+
+    // Re-putting the same state leaves a sleeper asleep; a real change wakes it.
+    store.put(b, *store.find(b));
+    assert(!isAwake(store, b) && store.awakeCount() == 3);
+    store.put(b, smelting(7));
+    assert(isAwake(store, b) && store.awakeCount() == 4);
+    assert(store.find(b)->fuel.count == 7);
+    checkConsistent(store);
+
+    // Erasing from either range keeps every slot and chunk index in step.
+    assert(store.erase(a));
+    assert(!isAwake(store, d));
+    assert(store.erase(d));
+    assert(!store.erase(d));
+    assert(store.find(a) == nullptr && store.find(d) == nullptr);
+    assert(store.size() == 3 && store.awakeCount() == 3);
+    checkConsistent(store);
+
+    // Unloading a chunk drops only its own furnaces, awake or asleep.
+    store.put(d, smelting(4));
+    store.sleep(store.slotOf(e));
+    assert(world::FurnaceStore::chunkOf(d) == world::FurnaceStore::chunkOf(e));
+    assert(world::FurnaceStore::chunkOf(c) != world::FurnaceStore::chunkOf(b));
+    store.eraseChunk(world::FurnaceStore::chunkOf(e));
+    assert(store.find(d) == nullptr && store.find(e) == nullptr);
+    assert(store.chunkKeys(world::FurnaceStore::chunkOf(e)) == nullptr);
+    assert(store.find(b) != nullptr && store.find(c) != nullptr);
+    assert(store.size() == 2 && store.awakeCount() == 2);
+    checkConsistent(store);
+
+    store.eraseChunk(world::FurnaceStore::chunkOf(b));
+    store.eraseChunk(world::FurnaceStore::chunkOf(c));
+    assert(store.size() == 0 && store.awakeCount() == 0);
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include "gfx/HudGlyphCache.hpp"
+
+#include <cassert>
+#include <string>
+
+int main() {
+    gfx::HudGlyphCache cache(4);
+
+    const gfx::HudGlyphCache::Layout &hello = cache.layout("Hello");
+    assert(!hello.quads.empty());
+    assert(hello.width > 0.0f);
+    for (const gfx::HudGlyphCache::Quad &q : hello.quads) {
+        // Quads are relative to the text origin and never degenerate.
+        assert(q.x1 > q.x0 && q.y1 > q.y0);
+        assert(q.x0 >= 0.0f && q.y0 >= 0.0f);
+    }
+    const std::size_t helloQuads = hello.quads.size();
+    const float helloWidth = hello.width;
+    assert(cache.misses() == 1 && cache.hits() == 0);
+
+    // A repeat lookup is served from the cache with an identical layout.
+    const gfx::HudGlyphCache::Layout &again = cache.layout(std::string("Hello"));
+    assert(again.quads.size() == helloQuads);
+    assert(again.width == helloWidth);
+    assert(cache.hits() == 1 && cache.misses() == 1);
+
+    assert(cache.width("Hello world") > helloWidth);
+    assert(cache.layout("").quads.empty());
+    assert(cache.width("") == 0.0f);
+    assert(cache.size() == 3);
+
+    // Filling past capacity drops the working set instead of growing forever.
+    cache.layout("a");
+    cache.layout("b");
+    assert(cache.size() <= 4);
+    const std::uint64_t missesBefore = cache.misses();
+    assert(cache.layout("Hello").quads.size() == helloQuads);
+    assert(cache.misses() == missesBefore + 1);
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "game/ItemDropSystem.hpp"
+
+#include <cassert>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr float kDt = 1.0f / 20.0f;
+
+using ChunkRevisions = std::map<std::pair<int, int>, std::uint64_t>;
+
+// Flat floor: everything below y = 10 is solid unless the floor was removed.
+// Chunks missing from `revisions` are loaded and unchanged since revision 1.
+game::ItemDropSystem::Environment floorEnv(const bool &floorPresent,
+                                           const ChunkRevisions &revisions) {
+    game::ItemDropSystem::Environment env;
+    env.isSolid = [&floorPresent](int, int y, int) { return floorPresent && y < 10; };
+    env.fluidCurrent = [](const glm::vec3 &) { return glm::vec3(0.0f); };
+    env.chunkRevision = [&revisions](int cx, int cz) {
+        const auto it = revisions.find({cx, cz});
+        return it != revisions.end() ? it->second : std::uint64_t{1};
+    };
+    return env;
+}
+
+} // namespace
+
+int main() {
+    bool floorPresent = true;
+    game::ItemDropSystem drops;
+    const glm::vec3 farPlayer(500.0f, 100.0f, 500.0f);
+
+    // Many single drops at one spot fall, land, merge into full-size stacks
+    // and go to sleep without losing any items.
+    for (int i = 0; i < 2000; ++i) {
+        drops.spawn(voxel::STONE, glm::vec3(0.5f, 10.0f, 0.5f));
+    }
+    drops.spawn(voxel::DIRT, glm::vec3(0.5f, 10.0f, 0.5f), 5);
+    assert(drops.activeCount() == 2001);
+
+    ChunkRevisions revisions;
+    const game::ItemDropSystem::Environment env = floorEnv(floorPresent, revisions);
+    for (int tick = 0; tick < 100; ++tick) {
+        drops.update(env, farPlayer, kDt);
+    }
+    assert(drops.totalItemCount() == 2005);
+    assert(drops.activeCount() < 200);
+    assert(drops.stats().sleeping == drops.activeCount());
+
+    // Sleeping stacks cost no block queries while the world is unchanged.
+    drops.update(env, farPlayer, kDt);
+    assert(drops.stats().blockQueries == 0);
+    assert(drops.stats().sleeping == drops.activeCount());
+
+    // Block changes in a chunk away from the pile leave it asleep.
+    revisions[{5, 5}] = 2;
+    drops.update(env, farPlayer, kDt);
+    assert(drops.stats().blockQueries == 0);
+    assert(drops.stats().sleeping == drops.activeCount());
+
+    // Unloading a chunk under the pile does not wake it either.
+    revisions[{0, 0}] = 0;
+    drops.update(env, farPlayer, kDt);
+    assert(drops.stats().blockQueries == 0);
+    assert(drops.stats().sleeping == drops.activeCount());
+
+    // A change in the pile's chunk re-checks support; with the floor gone
+    // everything falls.
+    floorPresent = false;
+    revisions[{0, 0}] = 3;
+    drops.update(env, farPlayer, kDt);
+    assert(drops.stats().sleeping == 0);
+    assert(drops.stats().blockQueries > 0);
+
+    // Restore the floor and let the stacks settle again.
+    floorPresent = true;
+    revisions[{0, 0}] = 4;
+    for (int tick = 0; tick < 100; ++tick) {
+        drops.update(env, farPlayer, kDt);
+    }
+    assert(drops.totalItemCount() == 2005);
+
+    // Walking over the pile collects whole stacks with their counts.
+    const glm::vec3 nearPlayer(0.5f, 10.0f + 1.25f, 0.5f);
+    drops.update(env, nearPlayer, kDt);
+    const std::vector<game::ItemDropSystem::Pickup> picked = drops.consumePickups();
+    int stone = 0;
+    int dirt = 0;
+    for (const game::ItemDropSystem::Pickup &p : picked) {
+        assert(p.count > 0 && p.count <= 64);
+        (p.id == voxel::STONE ? stone : dirt) += p.count;
+    }
+    assert(stone == 2000 && dirt == 5);
+    assert(drops.activeCount() == 0);
+    assert(drops.consumePickups().empty());
+
+    // Large counts are split into stacks no bigger than an inventory slot.
+    drops.spawn(voxel::STONE, glm::vec3(0.5f, 10.0f, 0.5f), 130);
+    assert(drops.activeCount() == 3);
+    assert(drops.totalItemCount() == 130);
+    return 0;
+}
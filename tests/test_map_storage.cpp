@@ -0,0 +1,183 @@
+#include "game/MapSystem.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Column {
+    std::int32_t x;
+    std::int32_t z;
+    std::uint16_t id;
+};
+
+void writeLegacyMap(const std::filesystem::path &dir, const std::vector<Column> &columns) {
+    std::filesystem::create_directories(dir);
+    std::ofstream out(dir / "map.dat", std::ios::binary | std::ios::trunc);
+    out.write("VXM3", 4);
+    const std::uint32_t count = static_cast<std::uint32_t>(columns.size());
+    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for (const Column &c : columns) {
+        out.write(reinterpret_cast<const char *>(&c.x), sizeof(c.x));
+        out.write(reinterpret_cast<const char *>(&c.z), sizeof(c.z));
+        out.write(reinterpret_cast<const char *>(&c.id), sizeof(c.id));
+    }
+    // One hidden waypoint named "camp" at (5, -7).
+    const std::uint32_t waypointCount = 1;
+    const std::int32_t wx = 5;
+    const std::int32_t wz = -7;
+    const std::uint8_t rgbIconVisible[5] = {10, 20, 30, 2, 0};
+    const std::uint16_t nameLen = 4;
+    out.write(reinterpret_cast<const char *>(&waypointCount), sizeof(waypointCount));
+    out.write(reinterpret_cast<const char *>(&wx), sizeof(wx));
+    out.write(reinterpret_cast<const char *>(&wz), sizeof(wz));
+    out.write(reinterpret_cast<const char *>(rgbIconVisible), sizeof(rgbIconVisible));
+    out.write(reinterpret_cast<const char *>(&nameLen), sizeof(nameLen));
+    out.write("camp", 4);
+}
+
+bool hasColumn(const game::MapSystem &map, const Column &c) {
+    voxel::BlockId id = voxel::AIR;
+    return map.sample(c.x, c.z, id) && id == c.id;
+}
+
+std::vector<std::filesystem::path> pageFiles(const std::filesystem::path &dir) {
+    std::vector<std::filesystem::path> out;
+    for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+        if (entry.path().filename().string().rfind("map_pages.", 0) == 0) {
+            out.push_back(entry.path());
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+int main() {
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "voxel_test_map_storage";
+    std::filesystem::remove_all(dir);
+
+    // Three pages far apart: a stone chunk at the origin, a dirt chunk ten
+    // pages out and a lone grass column in negative coordinates.
+    std::vector<Column> columns;
+    for (int z = 0; z < 16; ++z) {
+        for (int x = 0; x < 16; ++x) {
+            columns.push_back(Column{x, z, voxel::STONE});
+            columns.push_back(Column{640 + x, 640 + z, voxel::DIRT});
+        }
+    }
+    const Column grass{-300, 200, voxel::GRASS};
+    columns.push_back(grass);
+    writeLegacyMap(dir, columns);
+
+    // A legacy flat file loads whole and migrates on the next save.
+    {
+        game::MapSystem map;
+        assert(map.load(dir));
+        assert(map.residentPageCount() == 3);
+        assert(map.dirtyPageCount() == 3);
+        assert(map.save(dir));
+        assert(map.dirtyPageCount() == 0);
+    }
+    {
+        std::ifstream in(dir / "map.dat", std::ios::binary);
+        char magic[4] = {};
+        in.read(magic, sizeof(magic));
+        assert(std::string(magic, 4) == "VXM4");
+        assert(std::filesystem::exists(dir / "map_pages.1.dat"));
+    }
+
+    // Opening reads only the index; pages arrive when their region is asked for.
+    game::MapSystem map;
+    assert(map.load(dir));
+    assert(map.residentPageCount() == 0);
+    assert(map.knownChunks().empty());
+    assert(!hasColumn(map, columns.front()));
+    assert(map.waypoints().size() == 1);
+    const game::MapSystem::Waypoint &wp = map.waypoints().front();
+    assert(wp.name == "camp" && wp.x == 5 && wp.z == -7 && wp.icon == 2 && !wp.visible);
+
+    const std::uint64_t before = map.revision();
+    map.requestRegion(-8, -8, 8, 8);
+    assert(map.residentPageCount() == 1);
+    assert(map.revision() > before);
+    std::vector<world::ChunkCoord> changed;
+    assert(map.changedChunksSince(before, changed));
+    assert(changed.size() == 1 && changed.front().x == 0 && changed.front().z == 0);
+    assert(hasColumn(map, Column{3, 4, voxel::STONE}));
+    assert(!hasColumn(map, Column{640, 640, voxel::DIRT}));
+
+    // Nothing changed, so saving leaves the page file untouched.
+    const auto pagesBytes = std::filesystem::file_size(dir / "map_pages.1.dat");
+    assert(map.save(dir));
+    assert(std::filesystem::file_size(dir / "map_pages.1.dat") == pagesBytes);
+
+    map.requestRegion(-400, -400, 700, 700);
+    assert(map.residentPageCount() == 3);
+    for (const Column &c : columns) {
+        assert(hasColumn(map, c));
+    }
+    voxel::BlockId unexplored = voxel::AIR;
+    assert(!map.sample(16, 0, unexplored));
+    assert(!map.sample(grass.x + 1, grass.z, unexplored));
+
+    // Saving elsewhere copies every page, resident or not.
+    game::MapSystem partial;
+    assert(partial.load(dir));
+    partial.requestRegion(-8, -8, 8, 8);
+    const std::filesystem::path copyDir = dir / "copy";
+    assert(partial.save(copyDir));
+    game::MapSystem copy;
+    assert(copy.load(copyDir));
+    copy.requestRegion(-400, -400, 700, 700);
+    for (const Column &c : columns) {
+        assert(hasColumn(copy, c));
+    }
+    assert(copy.waypoints().size() == 1 && copy.waypoints().front().name == "camp");
+
+    // A rewrite goes to the next page file generation and swaps only the
+    // index, then deletes the old page file.
+    const std::filesystem::path oldIndex = dir / "old_map.dat";
+    const std::filesystem::path oldPages = dir / "old_map_pages.dat";
+    std::filesystem::copy_file(dir / "map.dat", oldIndex);
+    std::filesystem::copy_file(dir / "map_pages.1.dat", oldPages);
+    assert(copy.save(dir));
+    const std::vector<std::filesystem::path> newPages = pageFiles(dir);
+    assert(newPages.size() == 1 && newPages.front().filename() != "map_pages.1.dat");
+
+    // A crash before the index swap leaves the old index and page file intact.
+    const auto overwrite = std::filesystem::copy_options::overwrite_existing;
+    std::filesystem::copy_file(oldIndex, dir / "map.dat", overwrite);
+    std::filesystem::copy_file(oldPages, dir / "map_pages.1.dat", overwrite);
+    {
+        game::MapSystem crashed;
+        assert(crashed.load(dir));
+        crashed.requestRegion(-400, -400, 700, 700);
+        for (const Column &c : columns) {
+            assert(hasColumn(crashed, c));
+        }
+    }
+
+    // The old index against a compacted page file is rejected, not misread.
+    std::filesystem::copy_file(newPages.front(), dir / "map_pages.1.dat", overwrite);
+    {
+        game::MapSystem stale;
+        assert(!stale.load(dir));
+        stale.requestRegion(-400, -400, 700, 700);
+        assert(stale.residentPageCount() == 0);
+        assert(stale.knownChunks().empty());
+    }
+    std::filesystem::remove(dir / "map_pages.1.dat");
+    {
+        game::MapSystem stale;
+        assert(!stale.load(dir));
+    }
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "game/MapSystem.hpp"
+#include "game/MapTilePyramid.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+struct Column {
+    std::int32_t x;
+    std::int32_t z;
+    std::uint16_t id;
+};
+
+void writeMap(const std::filesystem::path &dir, const std::vector<Column> &columns) {
+    std::filesystem::create_directories(dir);
+    std::ofstream out(dir / "map.dat", std::ios::binary | std::ios::trunc);
+    out.write("VXM1", 4);
+    const std::uint32_t count = static_cast<std::uint32_t>(columns.size());
+    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for (const Column &c : columns) {
+        out.write(reinterpret_cast<const char *>(&c.x), sizeof(c.x));
+        out.write(reinterpret_cast<const char *>(&c.z), sizeof(c.z));
+        out.write(reinterpret_cast<const char *>(&c.id), sizeof(c.id));
+    }
+}
+
+const std::uint8_t *texelAt(const game::MapTilePyramid &pyramid, int level, int gx, int gz) {
+    const int size = game::MapTilePyramid::kTileSize;
+    const int tx = gx >= 0 ? gx / size : (gx - size + 1) / size;
+    const int tz = gz >= 0 ? gz / size : (gz - size + 1) / size;
+    const game::MapTilePyramid::Tile *tile = pyramid.find(level, tx, tz);
+    if (tile == nullptr) {
+        return nullptr;
+    }
+    const int px = gx - tx * size;
+    const int pz = gz - tz * size;
+    return tile->rgba.data() + (static_cast<std::size_t>(pz) * size + px) * 4u;
+}
+
+} // namespace
+
+int main() {
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "voxel_test_map_tile_pyramid";
+    std::filesystem::remove_all(dir);
+
+    // Two stone chunks side by side plus one grass column across the origin.
+    std::vector<Column> columns;
+    for (int z = 0; z < 16; ++z) {
+        for (int x = 0; x < 32; ++x) {
+            columns.push_back(Column{x, z, voxel::STONE});
+        }
+    }
+    columns.push_back(Column{-1, -1, voxel::GRASS});
+    writeMap(dir, columns);
+
+    game::MapSystem map;
+    assert(map.load(dir));
+    assert(map.knownChunks().size() == 3);
+    std::vector<world::ChunkCoord> changed;
+    assert(!map.changedChunksSince(0, changed));
+
+    int colorCalls = 0;
+    const game::MapTilePyramid::ColorFn colorOf = [&](voxel::BlockId id) {
+        ++colorCalls;
+        return id == voxel::STONE ? glm::vec3(0.5f, 0.5f, 0.5f) : glm::vec3(0.2f, 0.8f, 0.2f);
+    };
+
+    // The budget bounds work per update; the rest stays queued.
+    game::MapTilePyramid pyramid;
+    assert(pyramid.update(map, colorOf, 1) == 1);
+    assert(pyramid.rebuildCount() == 1);
+    assert(pyramid.pendingChunks() == 2);
+    assert(pyramid.update(map, colorOf, 16) == 2);
+    assert(pyramid.pendingChunks() == 0);
+    assert(pyramid.update(map, colorOf, 16) == 0);
+
+    // Explored columns are opaque and uniformly shaded; the rest stay clear.
+    const std::uint8_t *a = texelAt(pyramid, 0, 3, 4);
+    const std::uint8_t *b = texelAt(pyramid, 0, 20, 9);
+    assert(a != nullptr && b != nullptr);
+    assert(a[3] > 0);
+    for (int k = 0; k < 4; ++k) {
+        assert(a[k] == b[k]);
+    }
+    assert(texelAt(pyramid, 0, 40, 4)[3] == 0);
+    const std::uint8_t *grass = texelAt(pyramid, 0, -1, -1);
+    assert(grass != nullptr && grass[3] > 0 && grass[1] > grass[0]);
+
+    // Coarser levels average the explored children; a half-explored texel
+    // keeps the colour but loses alpha.
+    for (int level = 1; level < game::MapTilePyramid::kLevels; ++level) {
+        const std::uint8_t *m = texelAt(pyramid, level, 0, 0);
+        assert(m != nullptr);
+        assert(m[0] == a[0] && m[3] == a[3]);
+    }
+    const std::uint8_t *edge = texelAt(pyramid, 1, -1, -1);
+    assert(edge != nullptr && edge[1] == grass[1] && edge[3] > 0 && edge[3] < grass[3]);
+
+    // Reloading invalidates the change log and forces a rebuild.
+    const std::uint64_t before = map.revision();
+    assert(map.load(dir));
+    assert(map.revision() > before);
+    colorCalls = 0;
+    assert(pyramid.update(map, colorOf, 16) == 3);
+    assert(pyramid.rebuildCount() == 2);
+    assert(colorCalls > 0);
+
+    // Saving from the paged store round-trips every explored column.
+    const std::filesystem::path copyDir = dir / "copy";
+    assert(map.save(copyDir));
+    game::MapSystem copy;
+    assert(copy.load(copyDir));
+    copy.requestRegion(-64, -64, 64, 64);
+    assert(copy.knownChunks().size() == 3);
+    for (const Column &c : columns) {
+        voxel::BlockId id = voxel::AIR;
+        assert(copy.sample(c.x, c.z, id) && id == c.id);
+    }
+    voxel::BlockId unexplored = voxel::AIR;
+    assert(!copy.sample(32, 0, unexplored));
+    assert(!copy.sample(-2, -1, unexplored));
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "game/MapSystem.hpp"
+#include "game/MiniMapRaster.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+struct Column {
+    std::int32_t x;
+    std::int32_t z;
+    std::uint16_t id;
+};
+
+void writeMap(const std::filesystem::path &dir, const std::vector<Column> &columns) {
+    std::filesystem::create_directories(dir);
+    std::ofstream out(dir / "map.dat", std::ios::binary | std::ios::trunc);
+    out.write("VXM1", 4);
+    const std::uint32_t count = static_cast<std::uint32_t>(columns.size());
+    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for (const Column &c : columns) {
+        out.write(reinterpret_cast<const char *>(&c.x), sizeof(c.x));
+        out.write(reinterpret_cast<const char *>(&c.z), sizeof(c.z));
+        out.write(reinterpret_cast<const char *>(&c.id), sizeof(c.id));
+    }
+}
+
+const std::uint8_t *texelAt(const game::MiniMapRaster &raster, int wx, int wz) {
+    const std::size_t row = static_cast<std::size_t>(game::MiniMapRaster::ringIndex(wz));
+    const std::size_t col = static_cast<std::size_t>(game::MiniMapRaster::ringIndex(wx));
+    const std::size_t index = row * game::MiniMapRaster::kSize + col;
+    return raster.rgba().data() + index * 4u;
+}
+
+int dirtyArea(game::MiniMapRaster &raster) {
+    int area = 0;
+    for (const game::MiniMapRaster::Rect &rect : raster.consumeDirtyRects()) {
+        assert(rect.x >= 0 && rect.z >= 0);
+        assert(rect.x + rect.w <= game::MiniMapRaster::kSize);
+        assert(rect.z + rect.h <= game::MiniMapRaster::kSize);
+        area += rect.w * rect.h;
+    }
+    return area;
+}
+
+} // namespace
+
+int main() {
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "voxel_test_mini_map_raster";
+    std::filesystem::remove_all(dir);
+
+    // One stone chunk at the origin, saved in the paged format so it only
+    // becomes resident on request.
+    std::vector<Column> columns;
+    for (int z = 0; z < 16; ++z) {
+        for (int x = 0; x < 16; ++x) {
+            columns.push_back(Column{x, z, voxel::STONE});
+        }
+    }
+    writeMap(dir, columns);
+    {
+        game::MapSystem legacy;
+        assert(legacy.load(dir));
+        assert(legacy.save(dir));
+    }
+
+    game::MapSystem map;
+    assert(map.load(dir));
+    const game::MapTilePyramid::ColorFn colorOf = [](voxel::BlockId) {
+        return glm::vec3(0.5f, 0.5f, 0.5f);
+    };
+    constexpr int kArea = game::MiniMapRaster::kSize * game::MiniMapRaster::kSize;
+
+    // The first update paints the whole window once; standing still is free.
+    game::MiniMapRaster raster;
+    assert(raster.update(map, colorOf, 0, 0) == kArea);
+    assert(dirtyArea(raster) == kArea);
+    assert(texelAt(raster, 3, 4)[3] == 0);
+    assert(raster.update(map, colorOf, 0, 0) == 0);
+    assert(dirtyArea(raster) == 0);
+
+    // Pages arriving from disk patch only the chunk and its rim.
+    map.requestRegion(-8, -8, 8, 8);
+    assert(raster.update(map, colorOf, 0, 0) == 18 * 18);
+    assert(dirtyArea(raster) == 18 * 18);
+    const std::uint8_t stoneRed = texelAt(raster, 3, 4)[0];
+    assert(texelAt(raster, 3, 4)[3] > 0);
+    glm::vec3 expected(0.0f);
+    assert(game::MapTilePyramid::shadeColumn(map, colorOf, 3, 4, expected));
+    assert(stoneRed == static_cast<std::uint8_t>(std::lround(expected.r * 255.0f)));
+    assert(texelAt(raster, 16, 4)[3] == 0);
+
+    // Scrolling repaints just the exposed strips, wrapped into the ring.
+    assert(raster.update(map, colorOf, 5, 0) == 5 * game::MiniMapRaster::kSize);
+    assert(dirtyArea(raster) == 5 * game::MiniMapRaster::kSize);
+    assert(raster.update(map, colorOf, 3, -2) == 4 * game::MiniMapRaster::kSize);
+    assert(dirtyArea(raster) == 4 * game::MiniMapRaster::kSize);
+    assert(texelAt(raster, 3, 4)[3] > 0);
+
+    // Columns that leave the window and come back are repainted correctly.
+    assert(raster.update(map, colorOf, 300, 0) == kArea);
+    assert(dirtyArea(raster) == kArea);
+    assert(texelAt(raster, 3, 4)[3] == 0);
+    assert(raster.update(map, colorOf, 100, 0) == 200 * game::MiniMapRaster::kSize);
+    assert(dirtyArea(raster) == 200 * game::MiniMapRaster::kSize);
+    assert(texelAt(raster, 3, 4)[3] > 0);
+    assert(texelAt(raster, 3, 4)[0] == stoneRed);
+
+    std::filesystem::remove_all(dir);
+    return 0;
+}
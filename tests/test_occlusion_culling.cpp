@@ -0,0 +1,102 @@
+#include "voxel/ChunkMesher.hpp"
+#include "world/OcclusionCuller.hpp"
+
+#include <cassert>
+#include <map>
+#include <utility>
+
+namespace {
+
+world::FrustumPlanes openFrustum() {
+    world::FrustumPlanes f;
+    for (world::FrustumPlane &pl : f.p) {
+        pl.n = glm::vec3(0.0f, 1.0f, 0.0f);
+        pl.d = 1.0e6f;
+    }
+    return f;
+}
+
+void fillSection(voxel::Chunk &chunk, int section, voxel::BlockId id) {
+    for (int y = 0; y < voxel::kSectionSize; ++y) {
+        for (int z = 0; z < voxel::Chunk::SZ; ++z) {
+            for (int x = 0; x < voxel::Chunk::SX; ++x) {
+                chunk.set(x, section * voxel::kSectionSize + y, z, id);
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    const voxel::BlockRegistry registry;
+    voxel::Chunk chunk;
+    fillSection(chunk, 0, voxel::AIR);
+    fillSection(chunk, 1, voxel::STONE);
+    fillSection(chunk, 2, voxel::STONE);
+    fillSection(chunk, 3, voxel::AIR);
+    // Section 2: a one-block tunnel running along x.
+    for (int x = 0; x < voxel::Chunk::SX; ++x) {
+        chunk.set(x, 40, 8, voxel::AIR);
+    }
+    // Section 3: a full stone floor splits it into an upper and lower half.
+    for (int z = 0; z < voxel::Chunk::SZ; ++z) {
+        for (int x = 0; x < voxel::Chunk::SX; ++x) {
+            chunk.set(x, 52, z, voxel::STONE);
+        }
+    }
+    for (int s = 4; s < voxel::kSectionsPerChunk; ++s) {
+        fillSection(chunk, s, voxel::AIR);
+    }
+
+    const auto vis = voxel::ChunkMesher::buildSectionVisibility(chunk, registry);
+    assert(vis[0] == voxel::SectionVisibility{});
+    assert(vis[1] == voxel::SectionVisibility::none());
+    assert(vis[2].connected(voxel::FACE_NEG_X, voxel::FACE_POS_X));
+    assert(!vis[2].connected(voxel::FACE_NEG_X, voxel::FACE_POS_Y));
+    assert(!vis[2].connected(voxel::FACE_NEG_Z, voxel::FACE_POS_Z));
+    assert(vis[3].connected(voxel::FACE_NEG_X, voxel::FACE_POS_Z));
+    assert(!vis[3].connected(voxel::FACE_NEG_Y, voxel::FACE_POS_Y));
+
+    // A cave: every section is solid except a tunnel along x through section 2.
+    std::map<std::pair<int, int>, std::array<voxel::SectionVisibility, voxel::kSectionsPerChunk>>
+        columns;
+    for (int z = -6; z <= 6; ++z) {
+        for (int x = -6; x <= 6; ++x) {
+            auto &column = columns[{x, z}];
+            column.fill(voxel::SectionVisibility::none());
+            if (z == 0) {
+                column[2] = vis[2];
+            }
+        }
+    }
+    const world::OcclusionCuller::Lookup lookup =
+        [&](world::ChunkCoord cc, int section) -> const voxel::SectionVisibility * {
+        const auto it = columns.find({cc.x, cc.z});
+        return it == columns.end() ? nullptr : &it->second[static_cast<std::size_t>(section)];
+    };
+
+    world::OcclusionCuller culler;
+    const glm::vec3 camera(8.5f, 40.5f, 8.5f);
+    assert(culler.compute(camera, openFrustum(), 64.0f, lookup));
+    // The camera section sees its six neighbours; beyond them only the tunnel continues.
+    for (const world::ChunkCoord cc : culler.visibleColumns()) {
+        assert(cc.z == 0 || (cc.x == 0 && (cc.z == 1 || cc.z == -1)));
+    }
+    assert(culler.isColumnVisible(world::ChunkCoord{4, 0}));
+    assert(culler.isColumnVisible(world::ChunkCoord{-3, 0}));
+    assert(!culler.isColumnVisible(world::ChunkCoord{0, 2}));
+    assert(culler.visibleColumns().size() < columns.size() / 8);
+
+    // Without connectivity data everything within range is potentially visible.
+    const world::OcclusionCuller::Lookup unknown = [](world::ChunkCoord, int) {
+        return static_cast<const voxel::SectionVisibility *>(nullptr);
+    };
+    assert(culler.compute(camera, openFrustum(), 40.0f, unknown));
+    assert(culler.isColumnVisible(world::ChunkCoord{2, 1}));
+    assert(!culler.isColumnVisible(world::ChunkCoord{4, 0}));
+
+    // Above the world the walk is skipped.
+    assert(!culler.compute(glm::vec3(0.0f, 200.0f, 0.0f), openFrustum(), 64.0f, lookup));
+    return 0;
+}
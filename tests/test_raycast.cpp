@@ -1,6 +1,101 @@
 #include "voxel/Raycaster.hpp"
 
 #include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Stands in for World: chunks in a locked map, looked up per cell by the
+// callback path and per column crossed by ChunkCursor.
+struct TestWorld {
+    std::map<std::pair<int, int>, std::shared_ptr<voxel::Chunk>> chunks;
+    mutable std::mutex mutex;
+
+    static int floorDiv(int v, int d) {
+        return (v >= 0) ? (v / d) : ((v - d + 1) / d);
+    }
+
+    std::shared_ptr<const voxel::Chunk> chunkAt(int cx, int cz) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = chunks.find({cx, cz});
+        return it != chunks.end() ? it->second : nullptr;
+    }
+
+    voxel::BlockId getBlock(int x, int y, int z) const {
+        if (y < 0 || y >= voxel::Chunk::SY) {
+            return voxel::AIR;
+        }
+        const int cx = floorDiv(x, voxel::Chunk::SX);
+        const int cz = floorDiv(z, voxel::Chunk::SZ);
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = chunks.find({cx, cz});
+        if (it == chunks.end()) {
+            return voxel::AIR;
+        }
+        return it->second->get(x - cx * voxel::Chunk::SX, y, z - cz * voxel::Chunk::SZ);
+    }
+};
+
+struct TestSource {
+    const TestWorld *world = nullptr;
+    std::shared_ptr<const voxel::Chunk> operator()(int cx, int cz) const {
+        return world->chunkAt(cx, cz);
+    }
+};
+
+void buildTerrain(TestWorld &world, std::mt19937 &rng, int radius) {
+    for (int cx = -radius; cx < radius; ++cx) {
+        for (int cz = -radius; cz < radius; ++cz) {
+            auto chunk = std::make_shared<voxel::Chunk>();
+            for (int x = 0; x < voxel::Chunk::SX; ++x) {
+                for (int z = 0; z < voxel::Chunk::SZ; ++z) {
+                    const int height = 60 + static_cast<int>(rng() % 8);
+                    for (int y = 0; y < height; ++y) {
+                        chunk->set(x, y, z, voxel::STONE);
+                    }
+                    if (rng() % 40 == 0) {
+                        chunk->set(x, height + static_cast<int>(rng() % 6), z, voxel::STONE);
+                    }
+                }
+            }
+            world.chunks[{cx, cz}] = chunk;
+        }
+    }
+}
+
+std::vector<voxel::Ray> randomRays(std::mt19937 &rng, int count, float spread) {
+    std::uniform_real_distribution<float> pos(-spread, spread);
+    std::uniform_real_distribution<float> height(64.0f, 75.0f);
+    std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+    std::vector<voxel::Ray> rays;
+    for (int i = 0; i < count; ++i) {
+        voxel::Ray ray;
+        ray.origin = glm::vec3(pos(rng), height(rng), pos(rng));
+        ray.dir = glm::vec3(axis(rng), axis(rng) - 0.4f, axis(rng));
+        if (i % 10 == 0) {
+            ray.dir = glm::vec3(0.0f, 0.0f, (i % 20 == 0) ? 1.0f : -1.0f);
+        }
+        ray.maxDist = 6.0f + static_cast<float>(i % 4) * 8.0f;
+        rays.push_back(ray);
+    }
+    return rays;
+}
+
+bool sameHit(const std::optional<voxel::RayHit> &a, const std::optional<voxel::RayHit> &b) {
+    if (a.has_value() != b.has_value()) {
+        return false;
+    }
+    return !a.has_value() || (a->block == b->block && a->normal == b->normal && a->t == b->t);
+}
+
+} // namespace
 
 int main() {
     auto isSolid = [](int x, int y, int z) { return x == 3 && y == 2 && z == 1; };
@@ -18,5 +113,84 @@ int main() {
                                              glm::vec3(0.0f, 1.0f, 0.0f), 2.0f, isSolid);
     assert(!miss.has_value());
 
+    std::mt19937 rng(7);
+    TestWorld world;
+    buildTerrain(world, rng, 4);
+    const auto rays = randomRays(rng, 2000, 60.0f);
+    auto notAir = [](voxel::BlockId id) { return id != voxel::AIR; };
+    auto callback = [&](int x, int y, int z) { return world.getBlock(x, y, z) != voxel::AIR; };
+
+    // Chunk-cursor casts match per-cell lookups, including across chunk
+    // borders, at negative coordinates and off the loaded area.
+    {
+        voxel::ChunkCursor<TestSource> cursor(TestSource{&world});
+        int hits = 0;
+        for (const auto &ray : rays) {
+            const auto expected =
+                voxel::Raycaster::cast(ray.origin, ray.dir, ray.maxDist, callback);
+            const auto actual =
+                voxel::Raycaster::cast(cursor, ray.origin, ray.dir, ray.maxDist, notAir);
+            assert(sameHit(expected, actual));
+            hits += expected.has_value() ? 1 : 0;
+        }
+        assert(hits > 0 && hits < static_cast<int>(rays.size()));
+    }
+
+    // A ray inside one column resolves its chunk once.
+    {
+        voxel::ChunkCursor<TestSource> cursor(TestSource{&world});
+        const auto down = voxel::Raycaster::cast(cursor, glm::vec3(5.5f, 100.0f, 5.5f),
+                                                 glm::vec3(0.0f, -1.0f, 0.0f), 64.0f, notAir);
+        assert(down.has_value() && down->normal == glm::ivec3(0, 1, 0));
+        assert(cursor.lookups() == 1);
+    }
+
+    // A batch matches individual casts.
+    {
+        voxel::ChunkCursor<TestSource> cursor(TestSource{&world});
+        const auto batch = voxel::Raycaster::castMany(cursor, rays, notAir);
+        assert(batch.size() == rays.size());
+        for (std::size_t i = 0; i < rays.size(); ++i) {
+            assert(sameHit(batch[i],
+                           voxel::Raycaster::cast(rays[i].origin, rays[i].dir, rays[i].maxDist,
+                                                  callback)));
+        }
+    }
+
+    // Benchmark: crosshair-length rays against locked per-cell lookups.
+    {
+        const auto benchRays = randomRays(rng, 20000, 40.0f);
+        int callbackHits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto &ray : benchRays) {
+            callbackHits +=
+                voxel::Raycaster::cast(ray.origin, ray.dir, ray.maxDist, callback).has_value();
+        }
+        const std::chrono::duration<double, std::micro> callbackTime =
+            std::chrono::steady_clock::now() - start;
+
+        int cursorHits = 0;
+        start = std::chrono::steady_clock::now();
+        for (const auto &ray : benchRays) {
+            voxel::ChunkCursor<TestSource> cursor(TestSource{&world});
+            cursorHits += voxel::Raycaster::cast(cursor, ray.origin, ray.dir, ray.maxDist, notAir)
+                              .has_value();
+        }
+        const std::chrono::duration<double, std::micro> cursorTime =
+            std::chrono::steady_clock::now() - start;
+
+        voxel::ChunkCursor<TestSource> shared(TestSource{&world});
+        start = std::chrono::steady_clock::now();
+        const auto batch = voxel::Raycaster::castMany(shared, benchRays, notAir);
+        const std::chrono::duration<double, std::micro> batchTime =
+            std::chrono::steady_clock::now() - start;
+
+        assert(callbackHits == cursorHits);
+        assert(batch.size() == benchRays.size());
+        const double n = static_cast<double>(benchRays.size());
+        std::printf("raycast: callback %.3f us, chunk cursor %.3f us, castMany %.3f us per ray\n",
+                    callbackTime.count() / n, cursorTime.count() / n, batchTime.count() / n);
+    }
+
     return 0;
 }
@@ -0,0 +1,244 @@
+#include "game/CraftingSystem.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+using game::CraftingSystem;
+using game::Inventory;
+using game::Recipe;
+
+const std::vector<voxel::BlockId> kGridIds = {
+    voxel::AIR, voxel::WOOD, voxel::SPRUCE_WOOD, voxel::BIRCH_WOOD,
+    voxel::OAK_PLANKS, voxel::SPRUCE_PLANKS, voxel::BIRCH_PLANKS, voxel::STICK,
+    voxel::COAL_ORE, voxel::SAND, voxel::STONE, voxel::DIRT};
+
+CraftingSystem::State randomGrid(std::mt19937 &rng, int gridSize,
+                                 const std::vector<voxel::BlockId> &ids, int fillPercent) {
+    CraftingSystem::State state{};
+    const int inputCount = CraftingSystem::activeInputCount(gridSize);
+    for (int i = 0; i < inputCount; ++i) {
+        if (static_cast<int>(rng() % 100) >= fillPercent) {
+            continue;
+        }
+        const voxel::BlockId id = ids[rng() % ids.size()];
+        if (id != voxel::AIR) {
+            state.input[i] = {id, 1 + static_cast<int>(rng() % 3)};
+        }
+    }
+    return state;
+}
+
+// Lays a synthetic shaped recipe out at the top-left of the grid.
+CraftingSystem::State gridFor(const Recipe &recipe, int gridSize) {
+    CraftingSystem::State state{};
+    const int base = recipe.minGridSize();
+    for (const auto &cell : recipe.shapedCells()) {
+        const int slot = (cell.slot / base) * gridSize + (cell.slot % base);
+        state.input[slot] = {cell.ingredient.id, cell.ingredient.count};
+    }
+    return state;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(1234);
+
+    // Indexed matching agrees with the linear scan on the starter recipes,
+    // including wildcard wood and planks families.
+    {
+        CraftingSystem crafting;
+        for (int iter = 0; iter < 20000; ++iter) {
+            const int gridSize = (iter % 2 == 0) ? CraftingSystem::kGridSizeInventory
+                                                 : CraftingSystem::kGridSizeTable;
+            const auto state = randomGrid(rng, gridSize, kGridIds, 20 + iter % 80);
+            assert(crafting.findMatch(state, gridSize) ==
+                   crafting.findMatchLinear(state, gridSize));
+        }
+
+        CraftingSystem::State sticks{};
+        sticks.input[1] = {voxel::SPRUCE_PLANKS, 1};
+        sticks.input[3] = {voxel::BIRCH_PLANKS, 1};
+        const Recipe *match = crafting.findMatch(sticks, CraftingSystem::kGridSizeInventory);
+        assert(match != nullptr && match->output().id == voxel::STICK);
+
+        CraftingSystem::State furnace{};
+        for (int slot : {0, 1, 2, 3, 5, 6, 7, 8}) {
+            furnace.input[slot] = {voxel::STONE, 1};
+        }
+        match = crafting.findMatch(furnace, CraftingSystem::kGridSizeTable);
+        assert(match != nullptr && match->output().id == voxel::FURNACE);
+        assert(crafting.findMatch(furnace, CraftingSystem::kGridSizeInventory) == nullptr);
+    }
+
+    // Count-based craftability agrees with simulating the recipe fill, and is
+    // only recomputed when the inventory or grid size changes.
+    {
+        CraftingSystem crafting;
+        const int recipeCount = static_cast<int>(crafting.recipeInfos().size());
+        for (int iter = 0; iter < 2000; ++iter) {
+            Inventory inventory;
+            for (int i = 0; i < Inventory::kSlotCount; ++i) {
+                inventory.slot(i) = {};
+            }
+            const int stacks = static_cast<int>(rng() % 6);
+            for (int n = 0; n < stacks; ++n) {
+                const voxel::BlockId id = kGridIds[1 + rng() % (kGridIds.size() - 1)];
+                inventory.slot(static_cast<int>(rng() % Inventory::kSlotCount)) = {
+                    id, 1 + static_cast<int>(rng() % 9)};
+            }
+            const int gridSize = (iter % 2 == 0) ? CraftingSystem::kGridSizeInventory
+                                                 : CraftingSystem::kGridSizeTable;
+            const auto counts = crafting.countItems(inventory);
+            for (int r = 0; r < recipeCount; ++r) {
+                const auto &info = crafting.recipeInfos()[r];
+                bool expected = false;
+                if (gridSize >= info.minGridSize) {
+                    Inventory invSim = inventory;
+                    CraftingSystem::State craftSim{};
+                    expected = crafting.tryAddRecipeSet(
+                        info, invSim, craftSim, CraftingSystem::activeInputCount(gridSize));
+                }
+                assert(crafting.canCraftFrom(counts, r, gridSize) == expected);
+            }
+        }
+
+        Inventory inventory;
+        for (int i = 0; i < Inventory::kSlotCount; ++i) {
+            inventory.slot(i) = {};
+        }
+        inventory.slot(0) = {voxel::SAND, 3};
+        CraftingSystem::Craftability state;
+        assert(crafting.refreshCraftability(state, inventory, CraftingSystem::kGridSizeTable));
+        assert(!crafting.refreshCraftability(state, inventory, CraftingSystem::kGridSizeTable));
+        int sandstone = -1;
+        for (int r = 0; r < recipeCount; ++r) {
+            if (crafting.recipeInfos()[r].outputId == voxel::SANDSTONE) {
+                sandstone = r;
+            }
+        }
+        assert(sandstone >= 0 && state.flags[sandstone] == 0);
+        inventory.slot(7) = {voxel::SAND, 1};
+        assert(crafting.refreshCraftability(state, inventory, CraftingSystem::kGridSizeTable));
+        assert(state.flags[sandstone] == 1);
+        // Moving a stack between slots leaves the totals, and the flags, alone.
+        inventory.slot(8) = inventory.slot(7);
+        inventory.slot(7) = {};
+        assert(!crafting.refreshCraftability(state, inventory, CraftingSystem::kGridSizeTable));
+    }
+
+    // Benchmark: a large synthetic recipe set, matched by signature and by
+    // the linear scan over grids that hit, miss and collide.
+    {
+        CraftingSystem crafting;
+        constexpr int kSynthetic = 4000;
+        constexpr voxel::BlockId kFirstId = 1000;
+        constexpr int kIdRange = 40;
+        std::vector<Recipe> shapedRecipes;
+        for (int n = 0; n < kSynthetic; ++n) {
+            CraftingSystem::RecipeInfo info{};
+            info.outputId = voxel::STONE;
+            info.outputCount = 1;
+            info.label = "Synthetic";
+            info.minGridSize = CraftingSystem::kGridSizeTable;
+            if (n % 2 == 0) {
+                std::vector<Recipe::ShapedCell> cells;
+                const int cellCount = 2 + static_cast<int>(rng() % 5);
+                for (int slot = 0; slot < 9 && static_cast<int>(cells.size()) < cellCount;
+                     ++slot) {
+                    if (rng() % 2 == 0) {
+                        const auto id = static_cast<voxel::BlockId>(kFirstId + rng() % kIdRange);
+                        cells.push_back({slot, {id, false, 1}});
+                        info.shapedCells.push_back({slot, {id, 1, false}});
+                    }
+                }
+                if (cells.empty()) {
+                    cells.push_back({4, {kFirstId, false, 1}});
+                    info.shapedCells.push_back({4, {kFirstId, 1, false}});
+                }
+                shapedRecipes.emplace_back(cells, Inventory::Slot{voxel::STONE, 1},
+                                           CraftingSystem::kGridSizeTable);
+                crafting.addRecipe(shapedRecipes.back(), std::move(info));
+            } else {
+                std::vector<Recipe::Ingredient> ingredients;
+                const int ingredientCount = 1 + static_cast<int>(rng() % 4);
+                for (int i = 0; i < ingredientCount; ++i) {
+                    const auto id = static_cast<voxel::BlockId>(kFirstId + rng() % kIdRange);
+                    ingredients.push_back({id, false, 1});
+                    info.ingredients.push_back({id, 1, false});
+                }
+                crafting.addRecipe(Recipe(ingredients, Inventory::Slot{voxel::STONE, 1},
+                                          CraftingSystem::kGridSizeTable),
+                                   std::move(info));
+            }
+        }
+
+        std::vector<voxel::BlockId> syntheticIds{voxel::AIR};
+        for (int i = 0; i < kIdRange; ++i) {
+            syntheticIds.push_back(static_cast<voxel::BlockId>(kFirstId + i));
+        }
+        std::vector<CraftingSystem::State> grids;
+        for (int i = 0; i < 2000; ++i) {
+            if (i % 2 == 0) {
+                const auto &recipe = shapedRecipes[rng() % shapedRecipes.size()];
+                grids.push_back(gridFor(recipe, CraftingSystem::kGridSizeTable));
+            } else {
+                grids.push_back(
+                    randomGrid(rng, CraftingSystem::kGridSizeTable, syntheticIds, 30 + i % 60));
+            }
+        }
+
+        int hits = 0;
+        for (const auto &grid : grids) {
+            const Recipe *indexed = crafting.findMatch(grid, CraftingSystem::kGridSizeTable);
+            assert(indexed == crafting.findMatchLinear(grid, CraftingSystem::kGridSizeTable));
+            hits += indexed != nullptr ? 1 : 0;
+        }
+        assert(hits > 0);
+
+        auto timeMatches = [&](auto &&match) {
+            const auto start = std::chrono::steady_clock::now();
+            int found = 0;
+            for (int pass = 0; pass < 5; ++pass) {
+                for (const auto &grid : grids) {
+                    found += match(grid) != nullptr ? 1 : 0;
+                }
+            }
+            const std::chrono::duration<double, std::micro> elapsed =
+                std::chrono::steady_clock::now() - start;
+            assert(found == hits * 5);
+            return elapsed.count() / (5.0 * static_cast<double>(grids.size()));
+        };
+        const double indexedUs = timeMatches([&](const CraftingSystem::State &grid) {
+            return crafting.findMatch(grid, CraftingSystem::kGridSizeTable);
+        });
+        const double linearUs = timeMatches([&](const CraftingSystem::State &grid) {
+            return crafting.findMatchLinear(grid, CraftingSystem::kGridSizeTable);
+        });
+        std::printf("recipe match over %zu recipes: indexed %.3f us, linear %.3f us\n",
+                    crafting.recipeInfos().size(), indexedUs, linearUs);
+
+        Inventory inventory;
+        for (int i = 0; i < Inventory::kSlotCount; ++i) {
+            inventory.slot(i) = {static_cast<voxel::BlockId>(kFirstId + i % kIdRange), 4};
+        }
+        CraftingSystem::Craftability state;
+        const auto start = std::chrono::steady_clock::now();
+        bool refreshed = crafting.refreshCraftability(state, inventory,
+                                                      CraftingSystem::kGridSizeTable);
+        const std::chrono::duration<double, std::micro> refreshUs =
+            std::chrono::steady_clock::now() - start;
+        assert(refreshed);
+        refreshed = crafting.refreshCraftability(state, inventory, CraftingSystem::kGridSizeTable);
+        assert(!refreshed);
+        std::printf("craftability refresh over %zu recipes: %.1f us\n", state.flags.size(),
+                    refreshUs.count());
+    }
+
+    return 0;
+}
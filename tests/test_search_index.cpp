@@ -0,0 +1,88 @@
+#include "game/SearchIndex.hpp"
+
+#include <cassert>
+#include <cctype>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const std::vector<std::string> kWords = {"Oak",   "Spruce", "Birch", "Planks", "Wood",  "Stone",
+                                         "Sand",  "Coal",   "Ore",   "Iron",   "Ingot", "Stick",
+                                         "Torch", "Glass",  "Brick", "Table",  "Log",   "Moss"};
+
+std::vector<int> bruteForce(const std::vector<std::vector<std::string>> &entries,
+                            const std::string &query) {
+    const std::string needle = game::SearchIndex::toLower(query);
+    std::vector<int> results;
+    for (int i = 0; i < static_cast<int>(entries.size()); ++i) {
+        for (const auto &text : entries[i]) {
+            if (game::SearchIndex::toLower(text).find(needle) != std::string::npos) {
+                results.push_back(i);
+                break;
+            }
+        }
+    }
+    return results;
+}
+
+std::vector<std::vector<std::string>> makeEntries(std::mt19937 &rng, int count) {
+    std::vector<std::vector<std::string>> entries;
+    for (int i = 0; i < count; ++i) {
+        std::vector<std::string> texts;
+        const int textCount = 1 + static_cast<int>(rng() % 4);
+        for (int t = 0; t < textCount; ++t) {
+            std::string text = kWords[rng() % kWords.size()];
+            if (rng() % 2 == 0) {
+                text += " " + kWords[rng() % kWords.size()];
+            }
+            texts.push_back(text);
+        }
+        entries.push_back(texts);
+    }
+    return entries;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(99);
+
+    // Index results equal a case-insensitive substring scan, for fresh
+    // queries, queries extending a cached one and queries after backspace.
+    {
+        const auto entries = makeEntries(rng, 300);
+        game::SearchIndex index;
+        for (const auto &texts : entries) {
+            index.add(texts);
+        }
+        assert(index.size() == entries.size());
+        assert(index.find("").size() == entries.size());
+
+        for (int iter = 0; iter < 200; ++iter) {
+            const std::string word = kWords[rng() % kWords.size()] + " " +
+                                     kWords[rng() % kWords.size()];
+            const std::size_t start = rng() % word.size();
+            std::string typed;
+            for (std::size_t i = start; i < word.size(); ++i) {
+                const auto c = static_cast<unsigned char>(word[i]);
+                typed.push_back(static_cast<char>(rng() % 2 == 0 ? c : std::toupper(c)));
+                assert(index.find(typed) == bruteForce(entries, typed));
+            }
+            while (!typed.empty()) {
+                typed.pop_back();
+                assert(index.find(typed) == bruteForce(entries, typed));
+            }
+        }
+        assert(index.find("zzz").empty());
+        assert(index.find("oak\nspruce").empty());
+
+        // Adding an entry drops cached results.
+        const auto before = index.find("moss").size();
+        index.add({"Mossy Cobblestone"});
+        assert(index.find("moss").size() == before + 1);
+    }
+
+    return 0;
+}
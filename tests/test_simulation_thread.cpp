@@ -0,0 +1,252 @@
+#include "core/SimulationThread.hpp"
+#include "core/SnapshotBuffer.hpp"
+#include "core/TickCounter.hpp"
+#include "game/PlayerController.hpp"
+#include "voxel/Block.hpp"
+#include "world/VoxelWindow.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr float kTickDt = 1.0f / 20.0f;
+constexpr int kStepsPerTick = 3;
+constexpr float kStepDt = kTickDt / static_cast<float>(kStepsPerTick);
+
+// Stands in for World: a stone floor at y 64 with an ice strip to the east,
+// a wall to the north, and a pool with a flowing edge to the west.
+struct TestCell {
+    voxel::BlockId id = voxel::AIR;
+    int fluidLevel = -1;
+};
+
+TestCell cellAt(int x, int y, int z) {
+    if (x >= -30 && x <= -10 && y >= 60 && y <= 63) {
+        return {voxel::WATER, 0};
+    }
+    if (x == -9 && y == 63) {
+        return {voxel::WATER, 3};
+    }
+    if (y == 63 && x >= 4 && x <= 12) {
+        return {voxel::ICE, -1};
+    }
+    if (y < 64 || (z == -20 && y <= 65)) {
+        return {voxel::STONE, -1};
+    }
+    return {};
+}
+
+void gatherCells(const glm::ivec3 &minCell, const glm::ivec3 &maxCell, world::VoxelWindow &out) {
+    out.reset(minCell, maxCell);
+    for (int z = minCell.z; z <= maxCell.z; ++z) {
+        for (int y = std::max(minCell.y, 0); y <= maxCell.y; ++y) {
+            for (int x = minCell.x; x <= maxCell.x; ++x) {
+                const TestCell cell = cellAt(x, y, z);
+                if (cell.id != voxel::AIR) {
+                    out.set(x, y, z, cell.id, cell.fluidLevel < 0, cell.fluidLevel);
+                }
+            }
+        }
+    }
+}
+
+// Keys held for two seconds at a time: run into the wall, slide on the ice,
+// then sprint into the pool and swim, the same script for every run.
+game::PlayerInput scriptedInput(std::uint64_t step) {
+    constexpr std::uint64_t kPhaseSteps = 120;
+    game::PlayerInput input;
+    input.viewPos = glm::vec3(0.5f, 65.62f, 0.5f);
+    switch ((step / kPhaseSteps) % 8) {
+    case 0:
+        input.forwardKey = true;
+        break;
+    case 1:
+        input.forwardKey = input.sprint = input.jump = true;
+        break;
+    case 2:
+        input.forward = glm::vec3(1.0f, 0.0f, 0.0f);
+        input.forwardKey = true;
+        break;
+    case 3:
+        input.forward = glm::vec3(1.0f, 0.0f, 0.0f);
+        input.backKey = input.crouch = true;
+        break;
+    case 4:
+        input.forward = glm::vec3(-1.0f, 0.0f, 0.0f);
+        input.forwardKey = input.sprint = true;
+        break;
+    case 5:
+        input.forward = glm::vec3(-1.0f, 0.0f, 0.0f);
+        input.forwardKey = input.jump = true;
+        break;
+    case 6:
+        input.forward = glm::vec3(-0.6f, 0.0f, 0.8f);
+        input.leftKey = input.crouch = true;
+        break;
+    default:
+        break;
+    }
+    return input;
+}
+
+// What a run leaves behind, compared exactly between runs. pathSum folds in
+// every step's camera position, so runs that diverge and meet again differ.
+struct SimSummary {
+    glm::vec3 camera{0.0f};
+    bool grounded = false;
+    bool inWater = false;
+    bool sprinting = false;
+    bool crouching = false;
+    float pathSum = 0.0f;
+    float landedSpeed = 0.0f;
+    std::uint64_t steps = 0;
+    std::uint64_t ticks = 0;
+    std::uint64_t waterSteps = 0;
+
+    bool operator==(const SimSummary &) const = default;
+};
+
+// The player stepped like GameSession's player steps, with a 20 Hz tick.
+struct SimState {
+    game::PlayerController player;
+    SimSummary summary;
+};
+
+void step(SimState &s, std::uint64_t index) {
+    s.player.update(gatherCells, scriptedInput(index), kStepDt);
+    SimSummary &sum = s.summary;
+    sum.camera = s.player.cameraPosition();
+    sum.grounded = s.player.grounded();
+    sum.inWater = s.player.inWater();
+    sum.sprinting = s.player.sprinting();
+    sum.crouching = s.player.crouching();
+    sum.pathSum += sum.camera.x + sum.camera.y + sum.camera.z;
+    sum.landedSpeed += s.player.consumeLandedImpactSpeed();
+    sum.waterSteps += sum.inWater ? 1 : 0;
+    ++sum.steps;
+    if ((index + 1) % kStepsPerTick == 0) {
+        ++sum.ticks;
+    }
+}
+
+SimSummary runSteps(std::uint64_t count) {
+    SimState s;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        step(s, i);
+    }
+    return s.summary;
+}
+
+// Drives the simulation from a sequence of frame times, the way a render loop
+// would, stopping after exactly stepCount steps.
+SimSummary runFrames(const std::vector<float> &frameTimes, std::uint64_t stepCount,
+                     int maxStepsPerFrame) {
+    core::TickCounter counter(kStepDt, maxStepsPerFrame);
+    SimState s;
+    std::uint64_t done = 0;
+    std::size_t frame = 0;
+    while (done < stepCount) {
+        const float dt = frameTimes[frame % frameTimes.size()];
+        ++frame;
+        const int due = counter.consume(dt);
+        for (int i = 0; i < due && done < stepCount; ++i) {
+            step(s, done);
+            ++done;
+        }
+    }
+    return s.summary;
+}
+
+} // namespace
+
+int main() {
+    // The same number of steps gives the same state whatever the frame rate,
+    // including slow frames that run several steps and capped catch-up.
+    {
+        constexpr std::uint64_t kSteps = 1800;
+        const SimSummary reference = runSteps(kSteps);
+        assert(reference.ticks == kSteps / kStepsPerTick);
+        assert(reference.landedSpeed > 0.0f);
+        assert(reference.waterSteps > 0);
+
+        std::mt19937 rng(73);
+        std::uniform_real_distribution<float> jitter(0.001f, 0.120f);
+        std::vector<float> jittered(257);
+        for (float &dt : jittered) {
+            dt = jitter(rng);
+        }
+        const std::vector<std::vector<float>> patterns = {
+            {1.0f / 240.0f}, {1.0f / 60.0f}, {1.0f / 30.0f}, {1.0f / 7.0f},
+            {1.0f / 144.0f, 1.0f / 144.0f, 0.25f}, jittered};
+        for (const auto &pattern : patterns) {
+            assert(runFrames(pattern, kSteps, 0) == reference);
+            assert(runFrames(pattern, kSteps, core::SimulationThread::kMaxCatchUpSteps) ==
+                   reference);
+        }
+    }
+
+    // Snapshots: reset fills both slots, publish keeps the last two in order,
+    // and alpha is how far the simulation clock is past the current one.
+    {
+        core::SnapshotBuffer<int> snapshots;
+        snapshots.reset(5, 0.0);
+        auto view = snapshots.read(0.0);
+        assert(view.previous == 5 && view.current == 5 && view.published == 0);
+        snapshots.publish(6, 1.0);
+        snapshots.publish(7, 2.0);
+        view = snapshots.read(2.25);
+        assert(view.previous == 6 && view.current == 7 && view.published == 2);
+        assert(view.alpha == 0.25f);
+        assert(snapshots.read(1.5).alpha == 0.0f);
+        assert(snapshots.read(3.5).alpha == 1.0f);
+    }
+
+    // The thread runs the same steps: whatever count it reached, the state
+    // matches the headless run, and published snapshots stay consecutive.
+    {
+        SimState state;
+        core::SnapshotBuffer<SimSummary> snapshots;
+        core::SimulationThread sim(kStepDt, [&](std::uint64_t index) {
+            step(state, index);
+            snapshots.publish(state.summary, static_cast<double>(index + 1));
+        });
+        assert(sim.stepCount() == 0 && sim.clockSteps() == 0.0);
+        sim.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        {
+            auto lock = sim.lock();
+            const std::uint64_t held = sim.stepCount();
+            assert(held > 0);
+            const auto view = snapshots.read(sim.clockSteps());
+            assert(view.current == state.summary);
+            assert(view.published == held);
+            // A reader holding the lock keeps steps from running, but the
+            // clock runs on, so the view stays at the current snapshot.
+            std::this_thread::sleep_for(std::chrono::milliseconds(80));
+            assert(sim.stepCount() == held);
+            assert(sim.clockSteps() >= static_cast<double>(held + 1));
+            assert(snapshots.read(sim.clockSteps()).alpha == 1.0f);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        sim.stop();
+        const std::uint64_t steps = sim.stepCount();
+        // Roughly 380 ms of wall time at 60 Hz; loose bounds for busy machines.
+        assert(steps >= 8);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        assert(sim.stepCount() == steps);
+        assert(state.summary == runSteps(steps));
+        const auto view = snapshots.read(sim.clockSteps());
+        assert(view.previous == runSteps(steps - 1));
+        sim.stop();
+    }
+
+    return 0;
+}
@@ -0,0 +1,361 @@
+#include "game/PlayerController.hpp"
+#include "world/VoxelWindow.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <random>
+
+namespace {
+
+constexpr float kHalfWidth = 0.30f;
+constexpr float kHeight = 1.80f;
+constexpr float kEyeOffset = 1.62f;
+constexpr float kStepDt = 1.0f / 60.0f;
+
+glm::vec3 boxMin(const glm::vec3 &feet) {
+    return feet + glm::vec3(-kHalfWidth, 0.0f, -kHalfWidth);
+}
+
+glm::vec3 boxMax(const glm::vec3 &feet) {
+    return feet + glm::vec3(kHalfWidth, kHeight, kHalfWidth);
+}
+
+bool near(float a, float b, float tolerance = 0.002f) {
+    return std::abs(a - b) <= tolerance;
+}
+
+void setSolid(world::VoxelWindow &window, int x, int y, int z) {
+    window.set(x, y, z, voxel::STONE, true, -1);
+}
+
+// Serves the controller's cell requests from a fixed window, the way
+// World::gatherVoxelWindow serves them from loaded chunks.
+game::PlayerController::CellSource cellsFrom(const world::VoxelWindow &window) {
+    return [&window](const glm::ivec3 &minCell, const glm::ivec3 &maxCell,
+                     world::VoxelWindow &out) {
+        out.reset(minCell, maxCell);
+        for (int z = minCell.z; z <= maxCell.z; ++z) {
+            for (int y = minCell.y; y <= maxCell.y; ++y) {
+                for (int x = minCell.x; x <= maxCell.x; ++x) {
+                    const voxel::BlockId id = window.block(x, y, z);
+                    if (id != voxel::AIR) {
+                        out.set(x, y, z, id, window.solid(x, y, z), window.fluidLevel(x, y, z));
+                    }
+                }
+            }
+        }
+    };
+}
+
+// A controller with its feet at feet, not nudged out of blocks. Cases start
+// a little above a floor and let the player settle: feet recovered from the
+// camera can round to a hair inside the block below.
+game::PlayerController placeAt(const game::PlayerController::CellSource &cells,
+                               const glm::vec3 &feet) {
+    game::PlayerController player;
+    player.setFromCamera(feet + glm::vec3(0.0f, kEyeOffset, 0.0f), cells, false);
+    return player;
+}
+
+// Feet position; only meaningful while standing, since crouching lowers the
+// camera.
+glm::vec3 feetOf(const game::PlayerController &player) {
+    return player.cameraPosition() - glm::vec3(0.0f, kEyeOffset, 0.0f);
+}
+
+game::PlayerInput walking(const glm::vec3 &forward) {
+    game::PlayerInput input;
+    input.forward = forward;
+    input.forwardKey = true;
+    return input;
+}
+
+void run(game::PlayerController &player, const game::PlayerController::CellSource &cells,
+         const game::PlayerInput &input, int steps, float dt = kStepDt) {
+    for (int i = 0; i < steps; ++i) {
+        player.update(cells, input, dt);
+    }
+}
+
+// The furthest distance along axis (at resolution step) the box can move
+// without overlapping a solid cell, found by testing each position.
+float steppedSweep(const world::VoxelWindow &window, const glm::vec3 &feet, int axis, float amount,
+                   float step) {
+    const float dir = amount < 0.0f ? -1.0f : 1.0f;
+    float reached = 0.0f;
+    for (float d = step; d <= std::abs(amount); d += step) {
+        glm::vec3 probe = feet;
+        probe[axis] += d * dir;
+        if (window.intersectsSolid(boxMin(probe), boxMax(probe))) {
+            break;
+        }
+        reached = d;
+    }
+    return reached * dir;
+}
+
+} // namespace
+
+int main() {
+    // Collision cases drive the real PlayerController over a fixed window.
+    const game::PlayerInput idle;
+    const glm::vec3 east(1.0f, 0.0f, 0.0f);
+
+    // Falling onto a floor lands flush on its top face and stays there.
+    {
+        world::VoxelWindow window;
+        window.reset(glm::ivec3(-4, 0, -4), glm::ivec3(4, 8, 4));
+        for (int z = -4; z <= 4; ++z) {
+            for (int x = -4; x <= 4; ++x) {
+                setSolid(window, x, 0, z);
+            }
+        }
+        const auto cells = cellsFrom(window);
+        auto player = placeAt(cells, glm::vec3(0.5f, 3.4f, 0.5f));
+        float landed = 0.0f;
+        for (int i = 0; i < 60; ++i) {
+            player.update(cells, idle, kStepDt);
+            landed += player.consumeLandedImpactSpeed();
+        }
+        assert(player.grounded());
+        assert(landed > 0.0f);
+        assert(near(feetOf(player).y, 1.0f));
+        run(player, cells, idle, 30);
+        assert(near(feetOf(player).y, 1.0f));
+    }
+
+    // A fall many blocks per step still stops on a one-block floor.
+    {
+        world::VoxelWindow window;
+        window.reset(glm::ivec3(-2, 0, -2), glm::ivec3(2, 200, 2));
+        setSolid(window, 0, 10, 0);
+        const auto cells = cellsFrom(window);
+        auto player = placeAt(cells, glm::vec3(0.5f, 180.0f, 0.5f));
+        run(player, cells, idle, 40, 0.2f);
+        assert(player.grounded());
+        assert(near(feetOf(player).y, 11.0f));
+    }
+
+    // Jumping into a ceiling stops the head on its bottom face.
+    {
+        world::VoxelWindow window;
+        window.reset(glm::ivec3(-2, 0, -2), glm::ivec3(2, 8, 2));
+        for (int z = -2; z <= 2; ++z) {
+            for (int x = -2; x <= 2; ++x) {
+                setSolid(window, x, 0, z);
+            }
+        }
+        setSolid(window, 0, 4, 0);
+        const auto cells = cellsFrom(window);
+        auto player = placeAt(cells, glm::vec3(0.5f, 1.05f, 0.5f));
+        run(player, cells, idle, 30);
+        game::PlayerInput jump;
+        jump.jump = true;
+        player.update(cells, jump, kStepDt);
+        float highestHead = 0.0f;
+        for (int i = 0; i < 60; ++i) {
+            player.update(cells, idle, kStepDt);
+            highestHead = std::max(highestHead, feetOf(player).y + kHeight);
+        }
+        assert(near(highestHead, 4.0f));
+        assert(near(feetOf(player).y, 1.0f));
+    }
+
+    // Walking into a wall ends flush against it.
+    {
+        world::VoxelWindow window;
+        window.reset(glm::ivec3(0, 0, -2), glm::ivec3(12, 4, 2));
+        for (int x = 0; x <= 12; ++x) {
+            for (int z = -2; z <= 2; ++z) {
+                setSolid(window, x, 0, z);
+            }
+        }
+        for (int y = 1; y <= 3; ++y) {
+            setSolid(window, 5, y, 0);
+        }
+        const auto cells = cellsFrom(window);
+        auto player = placeAt(cells, glm::vec3(1.3f, 1.05f, 0.5f));
+        run(player, cells, walking(east), 120);
+        assert(near(feetOf(player).x + kHalfWidth, 5.0f));
+        auto back = placeAt(cells, glm::vec3(8.7f, 1.05f, 0.5f));
+        run(back, cells, walking(-east), 120);
+        assert(near(feetOf(back).x - kHalfWidth, 6.0f));
+    }
+
+    // Walking diagonally into an inside corner ends against both walls.
+    {
+        world::VoxelWindow window;
+        window.reset(glm::ivec3(0, 0, 0), glm::ivec3(8, 4, 8));
+        for (int z = 0; z <= 8; ++z) {
+            for (int x = 0; x <= 8; ++x) {
+                setSolid(window, x, 0, z);
+            }
+        }
+        for (int i = 0; i <= 5; ++i) {
+            setSolid(window, 5, 1, i);
+            setSolid(window, i, 1, 5);
+        }
+        const auto cells = cellsFrom(window);
+        auto player = placeAt(cells, glm::vec3(2.5f, 1.05f, 2.5f));
+        run(player, cells, walking(glm::vec3(1.0f, 0.0f, 1.0f)), 120);
+        assert(near(feetOf(player).x + kHalfWidth, 5.0f));
+        assert(near(feetOf(player).z + kHalfWidth, 5.0f));
+    }
+
+    // Brushing an outside corner slides past it; overlapping it by a sliver
+    // is stopped.
+    {
+        world::VoxelWindow window;
+        window.reset(glm::ivec3(0, 0, 0), glm::ivec3(12, 4, 10));
+        for (int z = 0; z <= 10; ++z) {
+            for (int x = 0; x <= 12; ++x) {
+                setSolid(window, x, 0, z);
+            }
+        }
+        setSolid(window, 5, 1, 5);
+        const auto cells = cellsFrom(window);
+        auto past = placeAt(cells, glm::vec3(2.5f, 1.05f, 6.0f + kHalfWidth));
+        run(past, cells, walking(east), 60);
+        assert(feetOf(past).x > 7.0f);
+        assert(near(feetOf(past).z, 6.0f + kHalfWidth));
+        auto clipped = placeAt(cells, glm::vec3(2.5f, 1.05f, 6.0f + kHalfWidth - 0.01f));
+        run(clipped, cells, walking(east), 60);
+        assert(near(feetOf(clipped).x + kHalfWidth, 5.0f));
+    }
+
+    // A one-block ledge blocks a walk but not a jump onto it; the controller
+    // has no automatic step-up.
+    {
+        world::VoxelWindow window;
+        window.reset(glm::ivec3(0, 0, -2), glm::ivec3(10, 6, 2));
+        for (int x = 0; x <= 10; ++x) {
+            setSolid(window, x, 0, 0);
+        }
+        for (int x = 3; x <= 10; ++x) {
+            setSolid(window, x, 1, 0);
+        }
+        const auto cells = cellsFrom(window);
+        auto player = placeAt(cells, glm::vec3(1.5f, 1.05f, 0.5f));
+        run(player, cells, walking(east), 60);
+        assert(near(feetOf(player).x + kHalfWidth, 3.0f));
+        assert(near(feetOf(player).y, 1.0f));
+        game::PlayerInput hop = walking(east);
+        hop.jump = true;
+        run(player, cells, hop, 20);
+        run(player, cells, walking(east), 40);
+        assert(player.grounded());
+        assert(near(feetOf(player).y, 2.0f));
+        assert(feetOf(player).x > 3.5f);
+    }
+
+    // Crouching stops at a platform edge; walking on goes over it.
+    {
+        world::VoxelWindow window;
+        window.reset(glm::ivec3(0, 0, -2), glm::ivec3(8, 4, 2));
+        for (int x = 0; x <= 3; ++x) {
+            for (int z = -2; z <= 2; ++z) {
+                setSolid(window, x, 0, z);
+            }
+        }
+        const auto cells = cellsFrom(window);
+        game::PlayerInput sneak = walking(east);
+        sneak.crouch = true;
+        auto crouched = placeAt(cells, glm::vec3(1.5f, 1.05f, 0.5f));
+        run(crouched, cells, idle, 30);
+        run(crouched, cells, sneak, 120);
+        assert(crouched.crouching() && crouched.grounded());
+        const float edgeX = crouched.cameraPosition().x;
+        assert(edgeX > 4.0f && edgeX - (kHalfWidth - 0.02f) < 4.0f);
+        run(crouched, cells, sneak, 30);
+        assert(crouched.cameraPosition().x == edgeX);
+        auto walker = placeAt(cells, glm::vec3(1.5f, 1.05f, 0.5f));
+        run(walker, cells, walking(east), 120);
+        assert(feetOf(walker).y < 0.0f);
+    }
+
+    // A box already overlapping a block can still walk out of it.
+    {
+        world::VoxelWindow window;
+        window.reset(glm::ivec3(-2, 0, -2), glm::ivec3(4, 4, 2));
+        for (int z = -2; z <= 2; ++z) {
+            for (int x = -2; x <= 4; ++x) {
+                setSolid(window, x, 0, z);
+            }
+        }
+        setSolid(window, 0, 1, 0);
+        const glm::vec3 feet(0.5f, 1.05f, 0.5f);
+        assert(window.intersectsSolid(boxMin(feet), boxMax(feet)));
+        const auto cells = cellsFrom(window);
+        auto player = placeAt(cells, feet);
+        run(player, cells, walking(east), 30);
+        assert(feetOf(player).x > 1.0f + kHalfWidth);
+        assert(!window.intersectsSolid(boxMin(feetOf(player)), boxMax(feetOf(player))));
+    }
+
+    // Cells outside the window read as air: unloaded chunks never block.
+    {
+        world::VoxelWindow window;
+        window.reset(glm::ivec3(0, 0, 0), glm::ivec3(1, 1, 1));
+        assert(window.block(5, 0, 0) == voxel::AIR);
+        assert(!window.solid(-1, 0, 0));
+        assert(window.fluidLevel(0, 9, 0) == -1);
+        assert(window.contains(glm::ivec3(0, 0, 0), glm::ivec3(1, 1, 1)));
+        assert(!window.contains(glm::ivec3(0, 0, 0), glm::ivec3(2, 1, 1)));
+    }
+
+    // Water pushes from the stronger neighbour toward the weaker one.
+    {
+        world::VoxelWindow window;
+        window.reset(glm::ivec3(-2, 0, -2), glm::ivec3(2, 2, 2));
+        for (int z = -2; z <= 2; ++z) {
+            for (int x = -2; x <= 2; ++x) {
+                setSolid(window, x, 0, z);
+                setSolid(window, x, 1, z);
+            }
+        }
+        window.set(-1, 1, 0, voxel::WATER, false, 1);
+        window.set(0, 1, 0, voxel::WATER, false, 2);
+        window.set(1, 1, 0, voxel::WATER, false, 3);
+        const glm::vec3 flow = window.fluidCurrentAt(glm::vec3(0.5f, 1.5f, 0.5f));
+        assert(flow.x > 15.9f && near(flow.y, 0.0f) && near(flow.z, 0.0f));
+        assert(near(glm::length(window.fluidCurrentAt(glm::vec3(0.5f, 2.5f, 0.5f))), 0.0f));
+    }
+
+    // The analytic sweep agrees with stepping the box through random terrain.
+    std::mt19937 rng(11);
+    world::VoxelWindow terrain;
+    terrain.reset(glm::ivec3(-16, 0, -16), glm::ivec3(16, 16, 16));
+    std::uniform_int_distribution<int> coin(0, 99);
+    for (int y = 0; y <= 16; ++y) {
+        for (int z = -16; z <= 16; ++z) {
+            for (int x = -16; x <= 16; ++x) {
+                if (coin(rng) < 8) {
+                    setSolid(terrain, x, y, z);
+                }
+            }
+        }
+    }
+    std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> height(2.0f, 12.0f);
+    std::uniform_real_distribution<float> dist(-4.0f, 4.0f);
+    std::uniform_int_distribution<int> axisPick(0, 2);
+    int compared = 0;
+    while (compared < 2000) {
+        const glm::vec3 feet(pos(rng), height(rng), pos(rng));
+        if (terrain.intersectsSolid(boxMin(feet), boxMax(feet))) {
+            continue;
+        }
+        const int axis = axisPick(rng);
+        const float amount = dist(rng);
+        const float analytic = terrain.sweep(boxMin(feet), boxMax(feet), axis, amount);
+        const float stepped = steppedSweep(terrain, feet, axis, amount, 0.005f);
+        assert(std::abs(analytic) <= std::abs(amount));
+        assert(near(analytic, stepped, 0.005f + 0.002f));
+        glm::vec3 moved = feet;
+        moved[axis] += analytic;
+        assert(!terrain.intersectsSolid(boxMin(moved), boxMax(moved)));
+        ++compared;
+    }
+
+    return 0;
+}
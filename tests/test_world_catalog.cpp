@@ -0,0 +1,129 @@
+#include "app/SaveManager.hpp"
+#include "app/WorldCatalog.hpp"
+#include "game/MapSystem.hpp"
+#include "voxel/Chunk.hpp"
+#include "world/ChunkCoord.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void writeBytes(const std::filesystem::path &path, std::size_t count) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const std::string bytes(count, 'x');
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+void writeMeta(const std::filesystem::path &dir, const std::string &name, std::uint32_t seed) {
+    std::filesystem::create_directories(dir);
+    std::ofstream out(dir / "world.meta", std::ios::trunc);
+    out << "version=1\nname=" << name << "\nseed=" << seed << "\n";
+}
+
+void writeMap(const std::filesystem::path &dir) {
+    std::ofstream out(dir / "map.dat", std::ios::binary | std::ios::trunc);
+    out.write("VXM1", 4);
+    const std::uint32_t count = 256;
+    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for (std::int32_t i = 0; i < 256; ++i) {
+        const std::int32_t x = i % 16;
+        const std::int32_t z = i / 16;
+        const std::uint16_t id = voxel::STONE;
+        out.write(reinterpret_cast<const char *>(&x), sizeof(x));
+        out.write(reinterpret_cast<const char *>(&z), sizeof(z));
+        out.write(reinterpret_cast<const char *>(&id), sizeof(id));
+    }
+}
+
+} // namespace
+
+int main() {
+    const std::filesystem::path base =
+        std::filesystem::temp_directory_path() / "voxel_test_world_catalog";
+    std::filesystem::remove_all(base);
+    const std::filesystem::path root = base / "worlds";
+    const std::filesystem::path alpha = root / "alpha";
+    const std::filesystem::path legacy = base / "world";
+
+    // A named world with three chunks, a folder that is not a world, and a
+    // legacy world that only has chunk files.
+    writeMeta(alpha, "Alpha", 42u);
+    for (int i = 0; i < 3; ++i) {
+        writeBytes(alpha / ("chunk_" + std::to_string(i) + "_0.bin"), 100);
+    }
+    writeBytes(alpha / "player.dat", 50);
+    std::filesystem::create_directories(root / "empty");
+    writeBytes(legacy / "chunk_0_0.bin", 10);
+
+    assert(app::WorldCatalog::readIndex(root).empty());
+
+    // The first refresh scans each world once and leaves catalogs behind.
+    std::vector<app::WorldCatalogEntry> worlds = app::WorldCatalog::refresh(root, legacy);
+    assert(worlds.size() == 2);
+    assert(worlds[0].name == "Alpha" && worlds[0].seed == 42u);
+    const std::uint64_t alphaBytes = 350u + std::filesystem::file_size(alpha / "world.meta");
+    assert(worlds[0].chunkCount == 3 && worlds[0].sizeBytes == alphaBytes);
+    assert(worlds[0].lastPlayed > 0);
+    assert(worlds[1].name == "Legacy World" && worlds[1].chunkCount == 1);
+    assert(std::filesystem::exists(alpha / "catalog.dat"));
+
+    // The root index alone is enough to list them again.
+    const std::vector<app::WorldCatalogEntry> indexed = app::WorldCatalog::readIndex(root);
+    assert(indexed.size() == 2);
+    assert(indexed[0].path == worlds[0].path && indexed[0].chunkCount == 3);
+    assert(indexed[0].catalogStamp == worlds[0].catalogStamp);
+
+    // A cancelled refresh returns nothing and leaves the index alone.
+    const std::atomic<bool> cancelled{true};
+    assert(app::WorldCatalog::refresh(root, legacy, &cancelled).empty());
+    assert(app::WorldCatalog::readIndex(root).size() == 2);
+
+    // Chunk saves are folded in without rescanning the folder, each world
+    // from its own record; rewriting a file counts only the size change.
+    voxel::Chunk chunk;
+    const world::ChunkCoord cc{5, 5};
+    assert(app::SaveManager::saveChunk(alpha, 1u, chunk, cc));
+    assert(app::SaveManager::saveChunk(alpha, 1u, chunk, cc));
+    const std::uint64_t chunkBytes = std::filesystem::file_size(alpha / "chunk_5_5.bin");
+    assert(app::SaveManager::saveChunk(legacy, 1u, chunk, cc));
+    app::WorldCatalog::flushChunkWrites(alpha);
+    app::WorldCatalogEntry entry;
+    assert(app::WorldCatalog::loadCatalog(alpha, entry));
+    assert(entry.chunkCount == 4 && entry.sizeBytes == alphaBytes + chunkBytes);
+    assert(app::WorldCatalog::loadCatalog(legacy, entry) && entry.chunkCount == 1);
+    app::WorldCatalog::flushChunkWrites(legacy);
+    assert(app::WorldCatalog::loadCatalog(legacy, entry) && entry.chunkCount == 2);
+    app::WorldCatalog::flushChunkWrites(alpha);
+    assert(app::WorldCatalog::loadCatalog(alpha, entry) && entry.chunkCount == 4);
+
+    // A changed catalog replaces the stale index row on the next refresh.
+    worlds = app::WorldCatalog::refresh(root, legacy);
+    assert(worlds.size() == 2 && worlds[0].chunkCount == 4 && worlds[1].chunkCount == 2);
+    assert(app::WorldCatalog::readIndex(root)[0].chunkCount == 4);
+
+    // Saving from a session stamps the name and a thumbnail of the map.
+    writeMap(alpha);
+    game::MapSystem map;
+    assert(map.load(alpha));
+    const game::MapTilePyramid::ColorFn grey = [](voxel::BlockId) {
+        return glm::vec3(0.5f, 0.5f, 0.5f);
+    };
+    assert(app::WorldCatalog::update(alpha, "Alpha Renamed", 42u, map, 8, 8, grey));
+    assert(app::WorldCatalog::loadCatalog(alpha, entry));
+    assert(entry.name == "Alpha Renamed" && entry.chunkCount == 4);
+    constexpr std::size_t kThumb = app::WorldCatalog::kThumbnailSize;
+    assert(entry.thumbnail.size() == kThumb * kThumb * 4u);
+    const std::size_t center = ((kThumb / 2) * kThumb + kThumb / 2) * 4u;
+    assert(entry.thumbnail[center + 3] == 255u);
+    assert(entry.thumbnail[3] == 0u);
+
+    std::filesystem::remove_all(base);
+    return 0;
+}